@@ -0,0 +1,170 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+#include "Mathematical/Representation/Tensor.hpp"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A process-wide cache for AO two-electron integrals, so that the integrals over a given pair of shell sets are only calculated once when they are requested multiple times (e.g. for the alpha and beta components of unrestricted or generalized spinor bases).
+ * 
+ *  The cached integrals are identified by a key for the operator (and its parameters) and by the shell sets that appear on the left and right of the operator. Only a limited number of the most recently used integral sets are remembered.
+ * 
+ *  The cache doesn't keep any integrals alive by itself: it only holds weak references to the calculated integrals, so that they are shared for as long as some caller still uses them, and are freed as soon as the last caller releases them. Callers that need an owning (modifiable) copy should use release(), which moves the integrals out instead of copying them if nobody else shares them.
+ * 
+ *  The integrals are calculated without holding the lock of the cache, so that a long calculation only blocks the requests for the same integrals, which wait for its result instead of calculating the integrals a second time.
+ */
+class AOIntegralCache {
+private:
+    /**
+     *  A cached set of integrals, together with the information that identifies it
+     */
+    struct Entry {
+        std::string operator_key;  // a key that identifies the operator and its parameters
+        ShellSet<GTOShell> left_shell_set;  // the shells that appear on the left of the operator
+        ShellSet<GTOShell> right_shell_set;  // the shells that appear on the right of the operator
+        size_t id;  // a number that uniquely identifies this entry
+        std::shared_future<std::shared_ptr<const Tensor<double, 4>>> calculation;  // the ongoing calculation of the integrals, which is reset as soon as the calculation has finished
+        std::weak_ptr<const Tensor<double, 4>> integrals;  // the calculated integrals, which aren't kept alive by the cache
+    };
+
+
+private:
+    size_t capacity;  // the maximum number of integral sets that are kept in the cache
+    std::vector<Entry> entries;  // the cached integral sets, the most recently used one at the back
+    size_t next_id = 0;  // the identifier for the next entry
+
+    mutable std::mutex mutex;  // guards the access to the entries
+
+
+private:
+    // PRIVATE METHODS - SINGLETON
+
+    /**
+     *  Private constructor as required by the singleton class design
+     */
+    AOIntegralCache();
+
+
+    // PRIVATE STATIC METHODS
+
+    /**
+     *  @param lhs          the left-hand side shell set
+     *  @param rhs          the right-hand side shell set
+     *
+     *  @return if the two shell sets contain the same shells, such that they produce the same integrals
+     */
+    static bool areEqual(const ShellSet<GTOShell>& lhs, const ShellSet<GTOShell>& rhs);
+
+
+    // PRIVATE METHODS
+
+    /**
+     *  Replace the calculation of the entry with the given identifier by a weak reference to its result, if the entry is still in the cache.
+     * 
+     *  @param id               the identifier of the entry
+     *  @param integrals        the calculated integrals
+     */
+    void finish(const size_t id, const std::shared_ptr<const Tensor<double, 4>>& integrals);
+
+    /**
+     *  Remove the entry with the given identifier, if it is still in the cache.
+     * 
+     *  @param id               the identifier of the entry
+     */
+    void remove(const size_t id);
+
+
+public:
+    // PUBLIC METHODS - SINGLETON
+
+    /**
+     *  @return the static singleton instance
+     */
+    static AOIntegralCache& get();
+
+    /**
+     *  Remove the public copy constructor and the public assignment operator
+     */
+    AOIntegralCache(AOIntegralCache const& ao_integral_cache) = delete;
+    void operator=(AOIntegralCache const& ao_integral_cache) = delete;
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @return the maximum number of integral sets that are kept in the cache
+     */
+    size_t maximumNumberOfEntries() const;
+
+    /**
+     *  @param capacity         the maximum number of integral sets that should be kept in the cache. A capacity of zero disables the cache.
+     */
+    void setMaximumNumberOfEntries(const size_t capacity);
+
+    /**
+     *  Remove all the integral sets from the cache.
+     */
+    void clear();
+
+    /**
+     *  Look up the integrals over the given operator and shell sets, and only calculate them if they aren't in the cache yet.
+     * 
+     *  @param operator_key             a key that identifies the operator and its parameters
+     *  @param left_shell_set           the shells that appear on the left of the operator
+     *  @param right_shell_set          the shells that appear on the right of the operator
+     *  @param calculate                a function that calculates the integrals, which is only called on a cache miss
+     * 
+     *  @return the (shared) integrals over the given operator and shell sets
+     * 
+     *  @note If the same integrals are being calculated by another thread, this call waits for that calculation to finish. If the calculation throws, the exception is propagated to all the waiting callers and nothing is cached.
+     * 
+     *  @note The integrals are only found in the cache while another caller still holds them.
+     */
+    std::shared_ptr<const Tensor<double, 4>> findOrCalculate(const std::string& operator_key, const ShellSet<GTOShell>& left_shell_set, const ShellSet<GTOShell>& right_shell_set, const std::function<Tensor<double, 4>()>& calculate);
+
+    /**
+     *  @return the number of integral sets that are currently in the cache
+     */
+    size_t numberOfEntries() const;
+
+    /**
+     *  Give up the shared ownership of integrals that were returned by findOrCalculate(), in exchange for an owning tensor.
+     * 
+     *  @param integrals        the shared integrals, which are reset by this call
+     * 
+     *  @return the integrals: they are moved out if the given pointer was their only owner, and are copied otherwise
+     */
+    Tensor<double, 4> release(std::shared_ptr<const Tensor<double, 4>>& integrals);
+};
+
+
+}  // namespace GQCP
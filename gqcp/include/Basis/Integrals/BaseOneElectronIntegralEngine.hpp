@@ -19,6 +19,7 @@
 
 
 #include "Basis/Integrals/BaseOneElectronIntegralBuffer.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
 
 #include <memory>
 
@@ -60,6 +61,33 @@ public:
      *  @return a buffer containing the calculated integrals
      */
     virtual std::shared_ptr<BaseOneElectronIntegralBuffer<IntegralScalar, N>> calculate(const Shell& shell1, const Shell& shell2) = 0;
+
+
+    // PUBLIC VIRTUAL METHODS
+
+    /**
+     *  Prepare this engine for the calculation of integrals over the shells in the given shell sets. Engines can override this method to pre-process the shells once, instead of for every call to calculate().
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator
+     */
+    virtual void prepare(const ShellSet<Shell>& left_shell_set, const ShellSet<Shell>& right_shell_set) {}
+
+    /**
+     *  Calculate all the integrals over the shells with the given indices in the given shell sets. The default implementation forwards the shells themselves to calculate().
+     *  @note This method is not marked const to allow the Engine's internals to be changed
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator, which should be the one that was given to prepare()
+     *  @param left_shell_index         the index of the left shell inside the left shell set
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator, which should be the one that was given to prepare()
+     *  @param right_shell_index        the index of the right shell inside the right shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     */
+    virtual std::shared_ptr<BaseOneElectronIntegralBuffer<IntegralScalar, N>> calculateOverShellIndices(const ShellSet<Shell>& left_shell_set, const size_t left_shell_index, const ShellSet<Shell>& right_shell_set, const size_t right_shell_index) {
+
+        return this->calculate(left_shell_set.asVector()[left_shell_index], right_shell_set.asVector()[right_shell_index]);
+    }
 };
 
 
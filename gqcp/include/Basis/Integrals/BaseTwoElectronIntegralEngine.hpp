@@ -19,6 +19,9 @@
 
 
 #include "Basis/Integrals/BaseTwoElectronIntegralBuffer.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+
+#include <memory>
 
 
 namespace GQCP {
@@ -61,6 +64,37 @@ public:
      *  @return a buffer containing the calculated integrals
      */
     virtual std::shared_ptr<BaseTwoElectronIntegralBuffer<IntegralScalar, N>> calculate(const Shell& shell1, const Shell& shell2, const Shell& shell3, const Shell& shell4) = 0;
+
+
+    // PUBLIC VIRTUAL METHODS
+
+    /**
+     *  Prepare this engine for the calculation of integrals over the shells in the given shell sets. Engines can override this method to pre-process the shells once, instead of for every call to calculate().
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator
+     */
+    virtual void prepare(const ShellSet<Shell>& left_shell_set, const ShellSet<Shell>& right_shell_set) {}
+
+    /**
+     *  Calculate all the integrals over the shells with the given indices in the given shell sets. The default implementation forwards the shells themselves to calculate().
+     *  @note This method is not marked const to allow the Engine's internals to be changed
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator, which should be the one that was given to prepare()
+     *  @param left_shell_index1        the index of the first shell inside the left shell set
+     *  @param left_shell_index2        the index of the second shell inside the left shell set
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator, which should be the one that was given to prepare()
+     *  @param right_shell_index1       the index of the third shell inside the right shell set
+     *  @param right_shell_index2       the index of the fourth shell inside the right shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     */
+    virtual std::shared_ptr<BaseTwoElectronIntegralBuffer<IntegralScalar, N>> calculateOverShellIndices(const ShellSet<Shell>& left_shell_set, const size_t left_shell_index1, const size_t left_shell_index2, const ShellSet<Shell>& right_shell_set, const size_t right_shell_index1, const size_t right_shell_index2) {
+
+        const auto& left_shells = left_shell_set.asVector();
+        const auto& right_shells = right_shell_set.asVector();
+        return this->calculate(left_shells[left_shell_index1], left_shells[left_shell_index2], right_shells[right_shell_index1], right_shells[right_shell_index2]);
+    }
 };
 
 
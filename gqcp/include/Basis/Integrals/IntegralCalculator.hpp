@@ -18,20 +18,26 @@
 #pragma once
 
 
+#include "Basis/Integrals/AOIntegralCache.hpp"
 #include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/Integrals/Interfaces/LibintThreeCenterIntegralEngine.hpp"
+#include "Basis/Integrals/Interfaces/LibintTwoCenterIntegralEngine.hpp"
 #include "Basis/Integrals/Interfaces/LibcintInterfacer.hpp"
 #include "Basis/Integrals/IntegralEngine.hpp"
 #include "Basis/Integrals/BaseOneElectronIntegralEngine.hpp"
 #include "Basis/Integrals/BaseTwoElectronIntegralEngine.hpp"
 #include "Basis/ScalarBasis/ScalarBasis.hpp"
 #include "Basis/ScalarBasis/ShellSet.hpp"
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
 #include "Mathematical/Representation/QCMatrix.hpp"
 #include "Mathematical/Representation/QCRankFourTensor.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
 #include "Operator/FirstQuantized/Operator.hpp"
 
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <string>
 
 
 namespace GQCP {
@@ -71,21 +77,19 @@ public:
         }
 
 
-        // Loop over all left and right shells and let the engine calculate the integrals over the pairs of shells.
+        // Loop over all left and right shells and let the engine calculate the integrals over the pairs of shells. The engine is allowed to pre-process the shell sets once, before the loops.
+        engine.prepare(left_shell_set, right_shell_set);
+
         const auto nsh_left = left_shell_set.numberOfShells();
-        const auto left_shells = left_shell_set.asVector();
         const auto nsh_right = right_shell_set.numberOfShells();
-        const auto right_shells = right_shell_set.asVector();
 
         for (size_t left_shell_index = 0; left_shell_index < nsh_left; left_shell_index++) {
             const auto left_bf_index = left_shell_set.basisFunctionIndex(left_shell_index);
-            const auto left_shell = left_shells[left_shell_index];
 
             for (size_t right_shell_index = 0; right_shell_index < nsh_right; right_shell_index++) {
                 const auto right_bf_index = right_shell_set.basisFunctionIndex(right_shell_index);
-                const auto right_shell = right_shells[right_shell_index];
 
-                const auto buffer = engine.calculate(left_shell, right_shell);
+                const auto buffer = engine.calculateOverShellIndices(left_shell_set, left_shell_index, right_shell_set, right_shell_index);
 
                 // Only if the integrals are not all zero, place them inside the full matrices.
                 if (buffer->areIntegralsAllZero()) {
@@ -124,29 +128,25 @@ public:
         }
 
 
-        // Loop over all left and right shells and let the engine calculate the integrals over the 4-tuple of shells.
+        // Loop over all left and right shells and let the engine calculate the integrals over the 4-tuple of shells. The engine is allowed to pre-process the shell sets once, before the loops.
+        engine.prepare(left_shell_set, right_shell_set);
+
         const auto nsh_left = left_shell_set.numberOfShells();
-        const auto left_shells = left_shell_set.asVector();
         const auto nsh_right = right_shell_set.numberOfShells();
-        const auto right_shells = right_shell_set.asVector();
 
         for (size_t left_shell_index1 = 0; left_shell_index1 < nsh_left; left_shell_index1++) {
             const auto left_bf1_index = left_shell_set.basisFunctionIndex(left_shell_index1);
-            const auto left_shell1 = left_shells[left_shell_index1];
 
             for (size_t left_shell_index2 = 0; left_shell_index2 < nsh_left; left_shell_index2++) {
                 const auto left_bf2_index = left_shell_set.basisFunctionIndex(left_shell_index2);
-                const auto left_shell2 = left_shells[left_shell_index2];
 
                 for (size_t right_shell_index1 = 0; right_shell_index1 < nsh_right; right_shell_index1++) {
                     const auto right_bf1_index = right_shell_set.basisFunctionIndex(right_shell_index1);
-                    const auto right_shell1 = right_shells[right_shell_index1];
 
                     for (size_t right_shell_index2 = 0; right_shell_index2 < nsh_right; right_shell_index2++) {
                         const auto right_bf2_index = right_shell_set.basisFunctionIndex(right_shell_index2);
-                        const auto right_shell2 = right_shells[right_shell_index2];
 
-                        const auto buffer = engine.calculate(left_shell1, left_shell2, right_shell1, right_shell2);
+                        const auto buffer = engine.calculateOverShellIndices(left_shell_set, left_shell_index1, left_shell_index2, right_shell_set, right_shell_index1, right_shell_index2);
 
                         // Only if the integrals are not all zero, place them inside the full matrices
                         if (buffer->areIntegralsAllZero()) {
@@ -269,7 +269,8 @@ public:
      */
     static QCRankFourTensor<double> calculateLibintIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& scalar_basis) {
 
-        return QCRankFourTensor<double>{IntegralCalculator::calculateLibintIntegrals(fq_two_op, scalar_basis, scalar_basis)};  // the same scalar basis appear on the left and right of the operator
+        auto integrals = IntegralCalculator::calculateLibintIntegrals(fq_two_op, scalar_basis, scalar_basis);  // the same scalar basis appear on the left and right of the operator
+        return QCRankFourTensor<double>{AOIntegralCache::get().release(integrals)};  // moved out of the shared integrals, unless another caller still uses them
     }
 
 
@@ -280,22 +281,192 @@ public:
      *  @param left_scalar_basis                    the scalar basis that contains the shells that should appear to the left of the operator
      *  @param right_scalar_basis                   the scalar basis that contains the shells that should appear to the right of the operator
      * 
-     *  @return the matrix representation (integrals) of the given first-quantized operator in this scalar basis
+     *  @return the matrix representation (integrals) of the given first-quantized operator in this scalar basis, which is shared with the AOIntegralCache (rather than copied), so that callers only copy the integrals when they need to modify them
+     * 
+     *  @note The integrals are looked up in the AOIntegralCache first, so that the integrals over the same shell sets are only calculated once, e.g. for the different spin components of unrestricted and generalized spinor bases.
      */
-    static Tensor<double, 4> calculateLibintIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& left_scalar_basis, const ScalarBasis<GTOShell>& right_scalar_basis) {
+    static std::shared_ptr<const Tensor<double, 4>> calculateLibintIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& left_scalar_basis, const ScalarBasis<GTOShell>& right_scalar_basis) {
 
         const auto left_shell_set = left_scalar_basis.shellSet();
         const auto right_shell_set = right_scalar_basis.shellSet();
 
+        return AOIntegralCache::get().findOrCalculate("Coulomb (Libint)", left_shell_set, right_shell_set, [&fq_two_op, &left_shell_set, &right_shell_set] () {
+
+            // Construct the libint engine
+            const auto max_nprim = std::max(left_shell_set.maximumNumberOfPrimitives(), right_shell_set.maximumNumberOfPrimitives());
+            const auto max_l = std::max(left_shell_set.maximumAngularMomentum(), right_shell_set.maximumAngularMomentum());
+            auto engine = IntegralEngine::Libint(fq_two_op, max_nprim, max_l);
+
+
+            // Calculate the integrals using the engine
+            return IntegralCalculator::calculate(engine, left_shell_set, right_shell_set)[0];
+        });
+    }
+
+
+    /**
+     *  Calculate the integrals over the given (first-quantized) two-electron operator, within a given scalar basis, using Libint2, and write them straight into a memory-mapped file.
+     * 
+     *  @param fq_two_op                    the first-quantized operator
+     *  @param scalar_basis                 the scalar basis that contains the shells over which the integrals should be calculated
+     *  @param filename                     the name of the file that should contain the integrals
+     * 
+     *  @return the memory-mapped integrals, which never have to fit in memory as a whole
+     * 
+     *  @note Only the shell quartets (M N|R S) with M >= N and R >= S are calculated, since these contain all the elements that are stored by a MemoryMappedRankFourTensor. The shells M are distributed over the available threads, each of which uses its own libint engine and writes to its own rows of the memory-mapped supermatrix.
+     */
+    static MemoryMappedRankFourTensor calculateLibintIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& scalar_basis, const std::string& filename) {
+
+        const auto shell_set = scalar_basis.shellSet();
+        const auto K = shell_set.numberOfBasisFunctions();
+        const auto nsh = shell_set.numberOfShells();
+
+        const auto max_nprim = shell_set.maximumNumberOfPrimitives();
+        const auto max_l = shell_set.maximumAngularMomentum();
+
+        auto g = MemoryMappedRankFourTensor::Create(filename, K);
+
+        #pragma omp parallel
+        {
+            // Libint engines are not thread-safe, so every thread constructs its own
+            auto engine = IntegralEngine::Libint(fq_two_op, max_nprim, max_l);
+            engine.prepare(shell_set, shell_set);
+
+            #pragma omp for schedule(dynamic)
+            for (size_t shell_index1 = 0; shell_index1 < nsh; shell_index1++) {
+                const auto bf1_index = shell_set.basisFunctionIndex(shell_index1);
+
+                for (size_t shell_index2 = 0; shell_index2 <= shell_index1; shell_index2++) {  // (p q|r s) = (q p|r s)
+                    const auto bf2_index = shell_set.basisFunctionIndex(shell_index2);
+
+                    for (size_t shell_index3 = 0; shell_index3 < nsh; shell_index3++) {
+                        const auto bf3_index = shell_set.basisFunctionIndex(shell_index3);
+
+                        for (size_t shell_index4 = 0; shell_index4 <= shell_index3; shell_index4++) {  // (p q|r s) = (p q|s r)
+                            const auto bf4_index = shell_set.basisFunctionIndex(shell_index4);
+
+                            const auto buffer = engine.calculateOverShellIndices(shell_set, shell_index1, shell_index2, shell_set, shell_index3, shell_index4);
+                            if (buffer->areIntegralsAllZero()) {
+                                continue;  // the file was created with all elements zero
+                            }
+
+                            for (size_t f1 = 0; f1 < buffer->numberOfBasisFunctionsInShell1(); f1++) {
+                                for (size_t f2 = 0; f2 < buffer->numberOfBasisFunctionsInShell2(); f2++) {
+                                    for (size_t f3 = 0; f3 < buffer->numberOfBasisFunctionsInShell3(); f3++) {
+                                        for (size_t f4 = 0; f4 < buffer->numberOfBasisFunctionsInShell4(); f4++) {
+                                            g(bf1_index + f1, bf2_index + f2, bf3_index + f3, bf4_index + f4) = buffer->value(0, f1, f2, f3, f4);
+                                        }
+                                    }
+                                }
+                            }
+                        }  // shell_index4
+                    }  // shell_index3
+                }  // shell_index2
+            }  // shell_index1
+        }  // omp parallel
+
+        g.flush();
+        return g;
+    }
+
+
+
+    /*
+     *  PUBLIC METHODS - LIBINT2 DENSITY FITTING INTEGRALS
+     */
+
+    /**
+     *  Calculate the two-center Coulomb integrals (P|Q) over the functions of an auxiliary basis, i.e. the Coulomb metric that is used in density fitting, using Libint2.
+     * 
+     *  @param fq_two_op                    the first-quantized operator
+     *  @param auxiliary_scalar_basis       the auxiliary scalar basis
+     * 
+     *  @return the Coulomb metric J(P,Q) = (P|Q)
+     */
+    static SquareMatrix<double> calculateLibintTwoCenterIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& auxiliary_scalar_basis) {
+
+        const auto auxiliary_shell_set = auxiliary_scalar_basis.shellSet();
+
         // Construct the libint engine
-        const auto max_nprim = std::max(left_shell_set.maximumNumberOfPrimitives(), right_shell_set.maximumNumberOfPrimitives());
-        const auto max_l = std::max(left_shell_set.maximumAngularMomentum(), right_shell_set.maximumAngularMomentum());
-        auto engine = IntegralEngine::Libint(fq_two_op, max_nprim, max_l);
+        const auto max_nprim = auxiliary_shell_set.maximumNumberOfPrimitives();
+        const auto max_l = auxiliary_shell_set.maximumAngularMomentum();
+        LibintTwoCenterIntegralEngine engine (fq_two_op, max_nprim, max_l);
 
 
-        // Calculate the integrals using the engine
-        const auto integrals = IntegralCalculator::calculate(engine, left_shell_set, right_shell_set);
-        return integrals[0];
+        // Calculate the integrals using the engine: (P|Q) has the same structure as a one-electron operator
+        const auto integrals = IntegralCalculator::calculate(engine, auxiliary_shell_set, auxiliary_shell_set);
+        return SquareMatrix<double>(integrals[0]);
+    }
+
+
+    /**
+     *  Calculate the three-center Coulomb integrals (mu nu|P), in which P is a function of an auxiliary basis, using Libint2.
+     * 
+     *  @param fq_two_op                    the first-quantized operator
+     *  @param auxiliary_scalar_basis       the auxiliary scalar basis
+     *  @param scalar_basis                 the (orbital) scalar basis
+     * 
+     *  @return the three-center integrals as a (K*K)xN_aux matrix, whose column P contains the KxK matrix (mu nu|P) in column-major order
+     * 
+     *  @note Only the integrals with mu >= nu are calculated. The auxiliary shells are distributed over the available threads, each of which uses its own libint engine.
+     */
+    static MatrixX<double> calculateLibintThreeCenterIntegrals(const CoulombRepulsionOperator& fq_two_op, const ScalarBasis<GTOShell>& auxiliary_scalar_basis, const ScalarBasis<GTOShell>& scalar_basis) {
+
+        const auto auxiliary_shell_set = auxiliary_scalar_basis.shellSet();
+        const auto shell_set = scalar_basis.shellSet();
+
+        const auto K = shell_set.numberOfBasisFunctions();
+        const auto N_aux = auxiliary_shell_set.numberOfBasisFunctions();
+        const auto nsh_aux = auxiliary_shell_set.numberOfShells();
+        const auto nsh = shell_set.numberOfShells();
+
+        const auto max_nprim = std::max(auxiliary_shell_set.maximumNumberOfPrimitives(), shell_set.maximumNumberOfPrimitives());
+        const auto max_l = std::max(auxiliary_shell_set.maximumAngularMomentum(), shell_set.maximumAngularMomentum());
+
+        MatrixX<double> integrals = MatrixX<double>::Zero(K * K, N_aux);
+
+        #pragma omp parallel
+        {
+            // Libint engines are not thread-safe, so every thread constructs its own
+            LibintThreeCenterIntegralEngine engine (fq_two_op, max_nprim, max_l);
+            engine.prepare(auxiliary_shell_set, shell_set);
+
+            #pragma omp for schedule(dynamic)
+            for (size_t auxiliary_shell_index = 0; auxiliary_shell_index < nsh_aux; auxiliary_shell_index++) {
+                const auto P_index = auxiliary_shell_set.basisFunctionIndex(auxiliary_shell_index);
+
+                for (size_t shell_index1 = 0; shell_index1 < nsh; shell_index1++) {
+                    const auto bf1_index = shell_set.basisFunctionIndex(shell_index1);
+
+                    for (size_t shell_index2 = 0; shell_index2 <= shell_index1; shell_index2++) {  // (P|mu nu) = (P|nu mu)
+                        const auto bf2_index = shell_set.basisFunctionIndex(shell_index2);
+
+                        const auto buffer = engine.calculateOverShellIndices(auxiliary_shell_set, auxiliary_shell_index, shell_set, shell_index1, shell_index2);
+                        if (buffer->areIntegralsAllZero()) {
+                            continue;
+                        }
+
+                        // Place the calculated integrals inside the column of their auxiliary basis function, for both orderings of the orbital shells
+                        for (size_t fP = 0; fP < buffer->numberOfBasisFunctionsInShell1(); fP++) {
+                            auto column = integrals.col(P_index + fP);
+
+                            for (size_t f1 = 0; f1 < buffer->numberOfBasisFunctionsInShell3(); f1++) {
+                                const auto mu = bf1_index + f1;
+                                for (size_t f2 = 0; f2 < buffer->numberOfBasisFunctionsInShell4(); f2++) {
+                                    const auto nu = bf2_index + f2;
+
+                                    const auto value = buffer->value(0, fP, 0, f1, f2);
+                                    column(mu + K * nu) = value;
+                                    column(nu + K * mu) = value;
+                                }
+                            }
+                        }
+                    }  // shell_index2
+                }  // shell_index1
+            }  // auxiliary_shell_index
+        }  // omp parallel
+
+        return integrals;
     }
 
 
@@ -105,6 +105,13 @@ public:
      */
     libint2::BasisSet interface(const ShellSet<GTOShell>& shellset) const;
 
+    /**
+     *  @param shellset     the GQCP ShellSet that should be interfaced
+     *
+     *  @return the libint2::Shells (whose renorm()alization has been undone) that correspond to the shells in the given GQCP ShellSet, in the same order
+     */
+    std::vector<libint2::Shell> interfaceShells(const ShellSet<GTOShell>& shellset) const;
+
 
     // PUBLIC METHODS - INTERFACING (LIBINT TO GQCP)
     /**
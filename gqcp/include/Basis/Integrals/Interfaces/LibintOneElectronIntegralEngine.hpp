@@ -21,10 +21,14 @@
 #include "Basis/Integrals/BaseOneElectronIntegralEngine.hpp"
 
 #include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
 #include "Basis/Integrals/Interfaces/LibintOneElectronIntegralBuffer.hpp"
 #include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
 #include "Operator/FirstQuantized/Operator.hpp"
 
+#include <vector>
+
 
 namespace GQCP {
 
@@ -49,6 +53,10 @@ private:
     size_t component_offset = 0;  // the number of libint components that should be skipped during access of calculated values (libint2::Operator::emultipole1 has 4 libint2 components, but in reality there should only be 1)
     double scaling_factor = 1.0;  // a factor that is multiplied to all of the calculated integrals
 
+    // The libint2 shells that correspond to the prepared shell sets, so that they only have to be interfaced once
+    LibintPreparedShells left_prepared_shells;
+    LibintPreparedShells right_prepared_shells;
+
 
 public:
     /*
@@ -118,6 +126,47 @@ public:
         this->libint2_engine.compute(libint_shell1, libint_shell2);
         return std::make_shared<LibintOneElectronIntegralBuffer<N>>(libint2_buffer, shell1.numberOfBasisFunctions(), shell2.numberOfBasisFunctions(), this->component_offset, this->scaling_factor);
     }
+
+
+    /**
+     *  Interface the shells of the given shell sets to libint2 shells once, so that they can be re-used in calculateOverShellIndices().
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator
+     */
+    void prepare(const ShellSet<GTOShell>& left_shell_set, const ShellSet<GTOShell>& right_shell_set) override {
+
+        this->left_prepared_shells = LibintPreparedShells(left_shell_set);
+        this->right_prepared_shells = (&left_shell_set == &right_shell_set) ? this->left_prepared_shells : LibintPreparedShells(right_shell_set);
+    }
+
+
+    /**
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator, which should be the one that was given to prepare()
+     *  @param left_shell_index         the index of the left shell inside the left shell set
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator, which should be the one that was given to prepare()
+     *  @param right_shell_index        the index of the right shell inside the right shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     * 
+     *  This method is not marked const to allow the Engine's internals to be changed
+     */
+    std::shared_ptr<BaseOneElectronIntegralBuffer<IntegralScalar, N>> calculateOverShellIndices(const ShellSet<GTOShell>& left_shell_set, const size_t left_shell_index, const ShellSet<GTOShell>& right_shell_set, const size_t right_shell_index) override {
+
+        // Fall back to interfacing the shells for every call if this engine hasn't been prepared for exactly the given shells
+        const auto prepared_shell1 = this->left_prepared_shells.find(left_shell_set, left_shell_index);
+        const auto prepared_shell2 = this->right_prepared_shells.find(right_shell_set, right_shell_index);
+        if (!prepared_shell1 || !prepared_shell2) {
+            return this->calculate(left_shell_set.asVector()[left_shell_index], right_shell_set.asVector()[right_shell_index]);
+        }
+
+        const auto& libint_shell1 = *prepared_shell1;
+        const auto& libint_shell2 = *prepared_shell2;
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_shell1, libint_shell2);
+        return std::make_shared<LibintOneElectronIntegralBuffer<N>>(libint2_buffer, libint_shell1.size(), libint_shell2.size(), this->component_offset, this->scaling_factor);
+    }
 };
 
 
@@ -0,0 +1,88 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+
+#include <libint2.hpp>
+
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  The libint2 shells that correspond to a prepared set of shells, so that the shells only have to be interfaced once for all the integral calculations over them.
+ * 
+ *  A copy of the prepared shells is kept, so that every lookup can check that the requested shell is still the one that was prepared: an engine that is re-used with another shell set (e.g. at another geometry) may never compute integrals over stale shells.
+ */
+class LibintPreparedShells {
+private:
+    std::vector<GTOShell> shells;  // the shells that were prepared
+    std::vector<libint2::Shell> libint_shells;  // the libint2 shells that correspond to the prepared shells
+
+
+public:
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  Prepare no shells at all.
+     */
+    LibintPreparedShells() = default;
+
+    /**
+     *  @param shell_set            the shells that should be interfaced to libint2 shells
+     */
+    LibintPreparedShells(const ShellSet<GTOShell>& shell_set);
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @param shell_set            the set of shells that contains the requested shell
+     *  @param shell_index          the index of the requested shell inside the shell set
+     * 
+     *  @return the prepared libint2 shell that corresponds to the requested shell, or nullptr if the requested shell isn't identical to the prepared shell at the same index
+     */
+    const libint2::Shell* find(const ShellSet<GTOShell>& shell_set, const size_t shell_index) const;
+
+
+    /*
+     *  PUBLIC STATIC METHODS
+     */
+
+    /**
+     *  @param lhs                  the left-hand side shell
+     *  @param rhs                  the right-hand side shell
+     * 
+     *  @return if the two shells are exactly equal, i.e. if they produce exactly the same integrals
+     * 
+     *  @note Contrary to GTOShell::operator==, no tolerance is used and the normalization conventions are also compared.
+     */
+    static bool areIdentical(const GTOShell& lhs, const GTOShell& rhs);
+};
+
+
+}  // namespace GQCP
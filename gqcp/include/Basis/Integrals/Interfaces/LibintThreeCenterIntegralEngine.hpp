@@ -0,0 +1,144 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
+#include "Basis/Integrals/Interfaces/LibintTwoElectronIntegralBuffer.hpp"
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+#include "Operator/FirstQuantized/Operator.hpp"
+
+#include <memory>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  An integral engine that uses libint as its backend to calculate three-center two-electron integrals (P|mu nu) over the Coulomb repulsion operator, in which P is an auxiliary basis function, as needed for density fitting
+ * 
+ *  The calculated integrals are returned in a two-electron integral buffer of which the second shell is the unit shell, i.e. with dimensions (nbf_P, 1, nbf_mu, nbf_nu).
+ */
+class LibintThreeCenterIntegralEngine {
+public:
+    using IntegralScalar = double;  // the scalar representation of an integral for libint is always a real number
+    static constexpr auto N = 1;  // the number of components the operator has
+
+
+private:
+    libint2::Engine libint2_engine;
+
+    // The libint2 shells that correspond to the prepared shell sets, so that they only have to be interfaced once
+    LibintPreparedShells auxiliary_prepared_shells;
+    LibintPreparedShells prepared_shells;
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param op               the Coulomb repulsion operator
+     *  @param max_nprim        the maximum number of primitives per contracted Gaussian shell, over both the auxiliary and the orbital shells
+     *  @param max_l            the maximum angular momentum of Gaussian shell, over both the auxiliary and the orbital shells
+     */
+    LibintThreeCenterIntegralEngine(const CoulombRepulsionOperator& op, const size_t max_nprim, const size_t max_l) :
+        libint2_engine (LibintInterfacer::get().createEngine(op, max_nprim, max_l))
+    {
+        this->libint2_engine.set(libint2::BraKet::xs_xx);  // (P|mu nu) is calculated as (P 1|mu nu), in which 1 is the unit shell
+    }
+
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @param auxiliary_shell      the auxiliary shell
+     *  @param shell1               the first orbital shell
+     *  @param shell2               the second orbital shell
+     * 
+     *  @return a buffer containing the calculated integrals
+     * 
+     *  This method is not marked const to allow the Engine's internals to be changed
+     */
+    std::shared_ptr<LibintTwoElectronIntegralBuffer<N>> calculate(const GTOShell& auxiliary_shell, const GTOShell& shell1, const GTOShell& shell2) {
+
+        const auto libint_auxiliary_shell = LibintInterfacer::get().interface(auxiliary_shell);
+        const auto libint_shell1 = LibintInterfacer::get().interface(shell1);
+        const auto libint_shell2 = LibintInterfacer::get().interface(shell2);
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_auxiliary_shell, libint2::Shell::unit(), libint_shell1, libint_shell2);
+        return std::make_shared<LibintTwoElectronIntegralBuffer<N>>(libint2_buffer, auxiliary_shell.numberOfBasisFunctions(), 1, shell1.numberOfBasisFunctions(), shell2.numberOfBasisFunctions());
+    }
+
+
+    /**
+     *  Interface the shells of the given shell sets to libint2 shells once, so that they can be re-used in calculateOverShellIndices().
+     * 
+     *  @param auxiliary_shell_set      the set of auxiliary shells
+     *  @param shell_set                the set of orbital shells
+     */
+    void prepare(const ShellSet<GTOShell>& auxiliary_shell_set, const ShellSet<GTOShell>& shell_set) {
+
+        this->auxiliary_prepared_shells = LibintPreparedShells(auxiliary_shell_set);
+        this->prepared_shells = LibintPreparedShells(shell_set);
+    }
+
+
+    /**
+     *  @param auxiliary_shell_set      the set of auxiliary shells, which should be the one that was given to prepare()
+     *  @param auxiliary_shell_index    the index of the shell inside the auxiliary shell set
+     *  @param shell_set                the set of orbital shells, which should be the one that was given to prepare()
+     *  @param shell_index1             the index of the first orbital shell inside the orbital shell set
+     *  @param shell_index2             the index of the second orbital shell inside the orbital shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     * 
+     *  This method is not marked const to allow the Engine's internals to be changed
+     */
+    std::shared_ptr<LibintTwoElectronIntegralBuffer<N>> calculateOverShellIndices(const ShellSet<GTOShell>& auxiliary_shell_set, const size_t auxiliary_shell_index, const ShellSet<GTOShell>& shell_set, const size_t shell_index1, const size_t shell_index2) {
+
+        // Fall back to interfacing the shells for every call if this engine hasn't been prepared for exactly the given shells
+        const auto prepared_auxiliary_shell = this->auxiliary_prepared_shells.find(auxiliary_shell_set, auxiliary_shell_index);
+        const auto prepared_shell1 = this->prepared_shells.find(shell_set, shell_index1);
+        const auto prepared_shell2 = this->prepared_shells.find(shell_set, shell_index2);
+        if (!prepared_auxiliary_shell || !prepared_shell1 || !prepared_shell2) {
+            const auto& shells = shell_set.asVector();
+            return this->calculate(auxiliary_shell_set.asVector()[auxiliary_shell_index], shells[shell_index1], shells[shell_index2]);
+        }
+
+        const auto& libint_auxiliary_shell = *prepared_auxiliary_shell;
+        const auto& libint_shell1 = *prepared_shell1;
+        const auto& libint_shell2 = *prepared_shell2;
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_auxiliary_shell, libint2::Shell::unit(), libint_shell1, libint_shell2);
+        return std::make_shared<LibintTwoElectronIntegralBuffer<N>>(libint2_buffer, libint_auxiliary_shell.size(), 1, libint_shell1.size(), libint_shell2.size());
+    }
+};
+
+
+}  // namespace GQCP
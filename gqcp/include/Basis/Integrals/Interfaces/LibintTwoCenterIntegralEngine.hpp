@@ -0,0 +1,135 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/Integrals/BaseOneElectronIntegralEngine.hpp"
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
+#include "Basis/Integrals/Interfaces/LibintOneElectronIntegralBuffer.hpp"
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+#include "Operator/FirstQuantized/Operator.hpp"
+
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  An integral engine that uses libint as its backend to calculate two-center two-electron integrals (P|Q) over the Coulomb repulsion operator, as needed for the metric of density fitting
+ * 
+ *  Since (P|Q) only has two shell indices, this engine can be used in the same loops as the one-electron integral engines.
+ */
+class LibintTwoCenterIntegralEngine : public BaseOneElectronIntegralEngine<GTOShell, 1, double> {
+public:
+    using IntegralScalar = double;  // the scalar representation of an integral for libint is always a real number
+    static constexpr auto N = 1;  // the number of components the operator has
+
+
+private:
+    libint2::Engine libint2_engine;
+
+    // The libint2 shells that correspond to the prepared shell sets, so that they only have to be interfaced once
+    LibintPreparedShells left_prepared_shells;
+    LibintPreparedShells right_prepared_shells;
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param op               the Coulomb repulsion operator
+     *  @param max_nprim        the maximum number of primitives per contracted Gaussian shell
+     *  @param max_l            the maximum angular momentum of Gaussian shell
+     */
+    LibintTwoCenterIntegralEngine(const CoulombRepulsionOperator& op, const size_t max_nprim, const size_t max_l) :
+        libint2_engine (LibintInterfacer::get().createEngine(op, max_nprim, max_l))
+    {
+        this->libint2_engine.set(libint2::BraKet::xs_xs);  // (P|Q) is calculated as (P 1|Q 1), in which 1 is the unit shell
+    }
+
+
+
+    /*
+     *  PUBLIC OVERRIDDEN METHODS
+     */
+
+    /**
+     *  @param shell1           the first (auxiliary) shell
+     *  @param shell2           the second (auxiliary) shell
+     */
+    std::shared_ptr<BaseOneElectronIntegralBuffer<IntegralScalar, N>> calculate(const GTOShell& shell1, const GTOShell& shell2) override {
+
+        const auto libint_shell1 = LibintInterfacer::get().interface(shell1);
+        const auto libint_shell2 = LibintInterfacer::get().interface(shell2);
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_shell1, libint2::Shell::unit(), libint_shell2, libint2::Shell::unit());
+        return std::make_shared<LibintOneElectronIntegralBuffer<N>>(libint2_buffer, shell1.numberOfBasisFunctions(), shell2.numberOfBasisFunctions());
+    }
+
+
+    /**
+     *  Interface the shells of the given shell sets to libint2 shells once, so that they can be re-used in calculateOverShellIndices().
+     * 
+     *  @param left_shell_set           the set of (auxiliary) shells that should appear on the left of the operator
+     *  @param right_shell_set          the set of (auxiliary) shells that should appear on the right of the operator
+     */
+    void prepare(const ShellSet<GTOShell>& left_shell_set, const ShellSet<GTOShell>& right_shell_set) override {
+
+        this->left_prepared_shells = LibintPreparedShells(left_shell_set);
+        this->right_prepared_shells = (&left_shell_set == &right_shell_set) ? this->left_prepared_shells : LibintPreparedShells(right_shell_set);
+    }
+
+
+    /**
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator, which should be the one that was given to prepare()
+     *  @param left_shell_index         the index of the left shell inside the left shell set
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator, which should be the one that was given to prepare()
+     *  @param right_shell_index        the index of the right shell inside the right shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     * 
+     *  This method is not marked const to allow the Engine's internals to be changed
+     */
+    std::shared_ptr<BaseOneElectronIntegralBuffer<IntegralScalar, N>> calculateOverShellIndices(const ShellSet<GTOShell>& left_shell_set, const size_t left_shell_index, const ShellSet<GTOShell>& right_shell_set, const size_t right_shell_index) override {
+
+        // Fall back to interfacing the shells for every call if this engine hasn't been prepared for exactly the given shells
+        const auto prepared_shell1 = this->left_prepared_shells.find(left_shell_set, left_shell_index);
+        const auto prepared_shell2 = this->right_prepared_shells.find(right_shell_set, right_shell_index);
+        if (!prepared_shell1 || !prepared_shell2) {
+            return this->calculate(left_shell_set.asVector()[left_shell_index], right_shell_set.asVector()[right_shell_index]);
+        }
+
+        const auto& libint_shell1 = *prepared_shell1;
+        const auto& libint_shell2 = *prepared_shell2;
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_shell1, libint2::Shell::unit(), libint_shell2, libint2::Shell::unit());
+        return std::make_shared<LibintOneElectronIntegralBuffer<N>>(libint2_buffer, libint_shell1.size(), libint_shell2.size());
+    }
+};
+
+
+}  // namespace GQCP
@@ -18,7 +18,9 @@
 #pragma once
 
 
-#include "Basis/Integrals/BaseOneElectronIntegralBuffer.hpp"
+#include "Basis/Integrals/BaseTwoElectronIntegralBuffer.hpp"
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
 
 
 namespace GQCP {
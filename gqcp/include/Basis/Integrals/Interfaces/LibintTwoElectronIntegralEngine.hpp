@@ -20,8 +20,13 @@
 
 #include "Basis/Integrals/BaseTwoElectronIntegralEngine.hpp"
 
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
 #include "Basis/Integrals/Interfaces/LibintTwoElectronIntegralBuffer.hpp"
 #include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+
+#include <vector>
 
 
 namespace GQCP {
@@ -42,6 +47,10 @@ public:
 private:
     libint2::Engine libint2_engine;
 
+    // The libint2 shells that correspond to the prepared shell sets, so that they only have to be interfaced once
+    LibintPreparedShells left_prepared_shells;
+    LibintPreparedShells right_prepared_shells;
+
 
 public:
 
@@ -83,6 +92,55 @@ public:
         this->libint2_engine.compute(libint_shell1, libint_shell2, libint_shell3, libint_shell4);
         return std::make_shared<LibintTwoElectronIntegralBuffer<N>>(libint2_buffer, shell1.numberOfBasisFunctions(), shell2.numberOfBasisFunctions(), shell3.numberOfBasisFunctions(), shell4.numberOfBasisFunctions());
     }
+
+
+    /**
+     *  Interface the shells of the given shell sets to libint2 shells once, so that they can be re-used in calculateOverShellIndices().
+     * 
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator
+     */
+    void prepare(const ShellSet<GTOShell>& left_shell_set, const ShellSet<GTOShell>& right_shell_set) override {
+
+        this->left_prepared_shells = LibintPreparedShells(left_shell_set);
+        this->right_prepared_shells = (&left_shell_set == &right_shell_set) ? this->left_prepared_shells : LibintPreparedShells(right_shell_set);
+    }
+
+
+    /**
+     *  @param left_shell_set           the set of shells that should appear on the left of the operator, which should be the one that was given to prepare()
+     *  @param left_shell_index1        the index of the first shell inside the left shell set
+     *  @param left_shell_index2        the index of the second shell inside the left shell set
+     *  @param right_shell_set          the set of shells that should appear on the right of the operator, which should be the one that was given to prepare()
+     *  @param right_shell_index1       the index of the third shell inside the right shell set
+     *  @param right_shell_index2       the index of the fourth shell inside the right shell set
+     * 
+     *  @return a buffer containing the calculated integrals
+     * 
+     *  This method is not marked const to allow the Engine's internals to be changed
+     */
+    std::shared_ptr<BaseTwoElectronIntegralBuffer<IntegralScalar, N>> calculateOverShellIndices(const ShellSet<GTOShell>& left_shell_set, const size_t left_shell_index1, const size_t left_shell_index2, const ShellSet<GTOShell>& right_shell_set, const size_t right_shell_index1, const size_t right_shell_index2) override {
+
+        // Fall back to interfacing the shells for every call if this engine hasn't been prepared for exactly the given shells
+        const auto prepared_shell1 = this->left_prepared_shells.find(left_shell_set, left_shell_index1);
+        const auto prepared_shell2 = this->left_prepared_shells.find(left_shell_set, left_shell_index2);
+        const auto prepared_shell3 = this->right_prepared_shells.find(right_shell_set, right_shell_index1);
+        const auto prepared_shell4 = this->right_prepared_shells.find(right_shell_set, right_shell_index2);
+        if (!prepared_shell1 || !prepared_shell2 || !prepared_shell3 || !prepared_shell4) {
+            const auto& left_shells = left_shell_set.asVector();
+            const auto& right_shells = right_shell_set.asVector();
+            return this->calculate(left_shells[left_shell_index1], left_shells[left_shell_index2], right_shells[right_shell_index1], right_shells[right_shell_index2]);
+        }
+
+        const auto& libint_shell1 = *prepared_shell1;
+        const auto& libint_shell2 = *prepared_shell2;
+        const auto& libint_shell3 = *prepared_shell3;
+        const auto& libint_shell4 = *prepared_shell4;
+
+        const auto& libint2_buffer = this->libint2_engine.results();
+        this->libint2_engine.compute(libint_shell1, libint_shell2, libint_shell3, libint_shell4);
+        return std::make_shared<LibintTwoElectronIntegralBuffer<N>>(libint2_buffer, libint_shell1.size(), libint_shell2.size(), libint_shell3.size(), libint_shell4.size());
+    }
 };
 
 
@@ -58,6 +58,8 @@ public:
      *  @param nuclear_framework            the nuclear framework containing the nuclei on which the shells should be centered
      * 
      *  @return the shell set by placing the shells corresponding to the basisset information on every nucleus of the nuclear framework
+     * 
+     *  @note The basisset file is only parsed the first time that the shells for an element are requested, after which they are taken from the GTOBasisSetCache.
      */
     ShellSet<GTOShell> generate(const NuclearFramework& nuclear_framework) const;
 
@@ -0,0 +1,113 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A process-wide cache of parsed basisset definitions, so that every basisset file is only parsed once for every element.
+ * 
+ *  The shells of a basisset are stored per element, centered on a nucleus at the origin. Generating the shells for a nuclear framework then only consists of placing copies of these shells on its nuclei.
+ */
+class GTOBasisSetCache {
+private:
+    std::map<std::pair<std::string, size_t>, std::vector<GTOShell>> element_shells;  // the shells for every pair of a (lowercase) basisset name and an atomic number, centered on a nucleus at the origin
+
+    mutable std::mutex mutex;  // guards the access to the cached shells
+
+
+private:
+    // PRIVATE METHODS - SINGLETON
+
+    /**
+     *  Private constructor as required by the singleton class design
+     */
+    GTOBasisSetCache() = default;
+
+
+    // PRIVATE STATIC METHODS
+
+    /**
+     *  @param basisset_name        the name of the basisset
+     *
+     *  @return the name under which the basisset is cached. Since basisset names are case-insensitive, this is the lowercase name.
+     */
+    static std::string key(const std::string& basisset_name);
+
+    /**
+     *  Parse the basisset file for one element.
+     * 
+     *  @param basisset_name        the name of the basisset
+     *  @param Z                    the atomic number of the element
+     *
+     *  @return the shells of the basisset for the given element, centered on a nucleus at the origin
+     */
+    static std::vector<GTOShell> parse(const std::string& basisset_name, const size_t Z);
+
+
+public:
+    // PUBLIC METHODS - SINGLETON
+
+    /**
+     *  @return the static singleton instance
+     */
+    static GTOBasisSetCache& get();
+
+    /**
+     *  Remove the public copy constructor and the public assignment operator
+     */
+    GTOBasisSetCache(GTOBasisSetCache const& gto_basisset_cache) = delete;
+    void operator=(GTOBasisSetCache const& gto_basisset_cache) = delete;
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  Remove all the parsed basisset definitions from the cache.
+     */
+    void clear();
+
+    /**
+     *  @return the number of (basisset, element) pairs whose shells are currently in the cache
+     */
+    size_t numberOfEntries() const;
+
+    /**
+     *  Look up the shells of the given basisset for the given element, and only parse the basisset file if they aren't in the cache yet.
+     * 
+     *  @param basisset_name        the name of the basisset
+     *  @param Z                    the atomic number of the element
+     * 
+     *  @return the shells of the basisset for the given element, centered on a nucleus at the origin
+     */
+    std::vector<GTOShell> shells(const std::string& basisset_name, const size_t Z);
+};
+
+
+}  // namespace GQCP
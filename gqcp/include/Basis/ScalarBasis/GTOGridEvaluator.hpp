@@ -0,0 +1,138 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ScalarBasis.hpp"
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that evaluates the basis functions of a scalar basis of GTOShells on a set of real-space points
+ * 
+ *  The points are handled in blocks: for every block, all basis functions of a shell are evaluated at once, and shells whose cutoff radius does not reach any point of the block are skipped. The blocks are distributed over the available threads.
+ * 
+ *  @note The basis functions follow the conventions of the integral engines: Cartesian components are in the standard libint2 order (xx, xy, xz, yy, yz, zz, ...) and share the normalization factor of the axis-aligned component; spherical components are the real solid harmonics ordered from m = -l to m = l.
+ */
+class GTOGridEvaluator {
+private:
+
+    /**
+     *  The information of a shell that is needed to evaluate its basis functions
+     */
+    struct ShellData {
+        size_t l;  // the angular momentum
+        size_t offset;  // the index of the first basis function of the shell
+        size_t number_of_basis_functions;
+        Vector<double, 3> center;
+        std::vector<double> exponents;
+        std::vector<double> coefficients;  // the contraction coefficients, with the normalization factors of the primitives embedded
+        double cutoff_radius_squared;  // beyond this (squared) distance from the center, every basis function of the shell is considered to be zero
+        MatrixX<double> T;  // the transformation matrix from Cartesian to spherical components (Cartesian x spherical), empty for Cartesian shells
+    };
+
+
+private:
+    size_t K;  // the number of basis functions
+    size_t block_size;  // the number of points that are evaluated at once
+    std::vector<ShellData> shells;
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param scalar_basis         the scalar basis whose basis functions should be evaluated
+     *  @param threshold            the value below which the basis functions of a shell are considered to be zero, determining the cutoff radius of every shell
+     *  @param block_size           the number of points that are evaluated at once
+     */
+    GTOGridEvaluator(const ScalarBasis<GTOShell>& scalar_basis, const double threshold = 1.0e-12, const size_t block_size = 128);
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @return the number of points that are evaluated at once
+     */
+    size_t blockSize() const { return this->block_size; }
+
+    /**
+     *  @param shell_index          the index of a shell in the scalar basis
+     * 
+     *  @return the distance from the center of the shell beyond which its basis functions are considered to be zero
+     */
+    double cutoffRadius(const size_t shell_index) const { return std::sqrt(this->shells[shell_index].cutoff_radius_squared); }
+
+    /**
+     *  @param points               the points at which the basis functions should be evaluated, as rows of a (N x 3)-matrix
+     * 
+     *  @return the values of the basis functions at the given points, as a (N x K)-matrix
+     */
+    MatrixX<double> evaluate(const MatrixX<double>& points) const;
+
+    /**
+     *  @param points               the points at which the density should be evaluated, as rows of a (N x 3)-matrix
+     *  @param D                    the density matrix expressed in the scalar basis
+     * 
+     *  @return the values of the electron density at the given points
+     */
+    VectorX<double> evaluateDensity(const MatrixX<double>& points, const SquareMatrix<double>& D) const;
+
+    /**
+     *  @param points               the points at which the orbitals should be evaluated, as rows of a (N x 3)-matrix
+     *  @param C                    the coefficient matrix of the orbitals, i.e. the orbitals are the columns of C, expanded in the scalar basis
+     * 
+     *  @return the values of the orbitals at the given points, as a (N x number of orbitals)-matrix
+     */
+    MatrixX<double> evaluateOrbitals(const MatrixX<double>& points, const MatrixX<double>& C) const;
+
+    /**
+     *  @return the number of basis functions that are evaluated
+     */
+    size_t numberOfBasisFunctions() const { return this->K; }
+
+
+private:
+
+    /*
+     *  PRIVATE METHODS
+     */
+
+    /**
+     *  Evaluate all basis functions at a contiguous block of points and write the results in the corresponding rows of the given matrix
+     * 
+     *  @param points               the points at which the basis functions should be evaluated, as rows of a (N x 3)-matrix
+     *  @param start                the index of the first point of the block
+     *  @param size                 the number of points in the block
+     *  @param values               the (N x K)-matrix in which the values are stored
+     */
+    void evaluateBlock(const MatrixX<double>& points, const size_t start, const size_t size, MatrixX<double>& values) const;
+};
+
+
+}  // namespace GQCP
@@ -312,10 +312,16 @@ public:
         //  3. Transform the operator using the current coefficient matrix.
 
         // 1. Calculate the Coulomb integrals in the underlying scalar bases.
-        const auto g_aaaa = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::ALPHA));
-        const auto g_aabb = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::ALPHA), this->scalarBasis(SpinComponent::BETA));
-        const auto g_bbaa = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::BETA), this->scalarBasis(SpinComponent::ALPHA));
-        const auto g_bbbb = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::BETA));
+        //  The integrals are shared with the AOIntegralCache, so equal scalar bases don't lead to additional copies.
+        const auto g_aaaa_ptr = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::ALPHA), this->scalarBasis(SpinComponent::ALPHA));
+        const auto g_aabb_ptr = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::ALPHA), this->scalarBasis(SpinComponent::BETA));
+        const auto g_bbaa_ptr = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::BETA), this->scalarBasis(SpinComponent::ALPHA));
+        const auto g_bbbb_ptr = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), this->scalarBasis(SpinComponent::BETA), this->scalarBasis(SpinComponent::BETA));
+
+        const auto& g_aaaa = *g_aaaa_ptr;
+        const auto& g_aabb = *g_aabb_ptr;
+        const auto& g_bbaa = *g_bbaa_ptr;
+        const auto& g_bbbb = *g_bbbb_ptr;
 
 
         // 2. Place the calculated integrals as 'blocks' in the larger representation
@@ -205,8 +205,7 @@ public:
         using ResultScalar = product_t<CoulombRepulsionOperator::Scalar, ExpansionScalar>;
         using ResultOperator = SQTwoElectronOperator<ResultScalar, CoulombRepulsionOperator::Components>;
 
-        const auto one_op_par = IntegralCalculator::calculateLibintIntegrals(fq_op, this->scalarBasis());
-        ResultOperator op {one_op_par};  // op for 'operator'
+        ResultOperator op {IntegralCalculator::calculateLibintIntegrals(fq_op, this->scalarBasis())};  // op for 'operator', which takes over the storage of the AO integrals
         op.transform(this->coefficientMatrix());
         return op;
     }
@@ -20,8 +20,9 @@
 
 #include "Mathematical/Optimization/LinearEquation/LinearEquationEnvironment.hpp"
 #include "Mathematical/Optimization/LinearEquation/LinearEquationSolver.hpp"
-#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
 
+#include <algorithm>
 #include <vector>
 
 
@@ -38,6 +39,12 @@ class DIIS {
 public:
     using Scalar = _Scalar;
 
+
+private:
+    SquareMatrix<Scalar> previous_B;  // the (non-augmented) B matrix of the errors that were used in the previous calculation of the DIIS coefficients
+    size_t previous_first_index = 0;  // the index of the first of those errors in the sequence of all errors, i.e. its generation
+
+
 public:
 
     /*
@@ -45,45 +52,146 @@ public:
      */
 
     /**
-     *  @param subject              the subject
+     *  @param subjects             the subjects that correspond to the given errors
+     *  @param errors               the errors for which the DIIS coefficients should be calculated
      * 
      *  @return the DIIS-accelerated subject
      */
     template <typename Subject>
     Subject accelerate(const std::vector<Subject>& subjects, const std::vector<VectorX<Scalar>>& errors) const {
 
-        const auto diis_coefficients = this->calculateDIISCoefficients(errors);
+        return DIIS<Scalar>::combine(subjects, this->calculateDIISCoefficients(errors));
+    }
 
-        // Construct and return the DIIS-accelerated subject
-        Subject accelerated_subject = diis_coefficients(0) * subjects.at(0);  // defaultly initializing may cause problems: the default constructor for a Matrix is a 0x0-matrix
-        for (size_t i = 1; i < errors.size(); i++) {
-            accelerated_subject += diis_coefficients(i) * subjects.at(i);
-        }
-        return accelerated_subject;
+
+    /**
+     *  @param subjects             the subjects that correspond to the given errors
+     *  @param errors               the errors for which the DIIS coefficients should be calculated
+     *  @param first_index          the index of the first of the given errors in the sequence of all errors
+     * 
+     *  @return the DIIS-accelerated subject
+     * 
+     *  @note See calculateDIISCoefficients(const std::vector<VectorX<Scalar>>&, const size_t) for the re-use of the inner products between the errors.
+     */
+    template <typename Subject>
+    Subject accelerate(const std::vector<Subject>& subjects, const std::vector<VectorX<Scalar>>& errors, const size_t first_index) {
+
+        return DIIS<Scalar>::combine(subjects, this->calculateDIISCoefficients(errors, first_index));
     }
 
 
     /**
      *  Find the linear combination of errors that minimizes the total error measure in the least squares sense (i.e. according to the DIIS algorithm).
      * 
+     *  @param errors               the errors for which the DIIS coefficients should be calculated
+     * 
      *  @return the coefficients that minimize the error measure
      */
     VectorX<Scalar> calculateDIISCoefficients(const std::vector<VectorX<Scalar>>& errors) const {
 
+        return DIIS<Scalar>::solve(DIIS<Scalar>::calculateInnerProducts(errors, SquareMatrix<Scalar>::Zero(0, 0)));
+    }
+
+
+    /**
+     *  Find the linear combination of errors that minimizes the total error measure in the least squares sense (i.e. according to the DIIS algorithm).
+     * 
+     *  @param errors               the errors for which the DIIS coefficients should be calculated
+     *  @param first_index          the index of the first of the given errors in the sequence of all errors
+     * 
+     *  @return the coefficients that minimize the error measure
+     * 
+     *  @note The errors are identified by their index in the sequence of all errors, so that the inner products between the errors that were also used in the previous call can be re-used, and only the inner products with the new errors have to be calculated. This is the case when the errors form a sliding window over the iterations.
+     */
+    VectorX<Scalar> calculateDIISCoefficients(const std::vector<VectorX<Scalar>>& errors, const size_t first_index) {
+
+        // Only a window that has moved forward can share errors with the previous one. As a safeguard against a sequence of errors that was restarted, the inner product of the first shared error with itself is checked against the one that was stored.
+        const auto previous_n = static_cast<size_t>(this->previous_B.rows());
+        const auto previous_end = this->previous_first_index + previous_n;
+
+        size_t m = 0;  // the number of leading errors that were also used in the previous call
+        size_t offset = 0;  // the position of the first of those errors in the previous call
+        if ((first_index >= this->previous_first_index) && (first_index < previous_end) && !errors.empty()) {
+            offset = first_index - this->previous_first_index;
+
+            if (errors[0].dot(errors[0]) == this->previous_B(offset, offset)) {
+                m = std::min(previous_end - first_index, errors.size());
+            }
+        }
+
+        const SquareMatrix<Scalar> known_B = this->previous_B.block(offset, offset, m, m);
+        const auto B_errors = DIIS<Scalar>::calculateInnerProducts(errors, known_B);
+
+        this->previous_B = B_errors;
+        this->previous_first_index = first_index;
+
+        return DIIS<Scalar>::solve(B_errors);
+    }
+
+
+private:
+
+    /*
+     *  PRIVATE STATIC METHODS
+     */
+
+    /**
+     *  @param errors               the errors
+     *  @param known_B              the inner products between the leading errors, which are already known
+     * 
+     *  @return the (non-augmented) B matrix, i.e. the matrix of the inner products between the errors
+     */
+    static SquareMatrix<Scalar> calculateInnerProducts(const std::vector<VectorX<Scalar>>& errors, const SquareMatrix<Scalar>& known_B) {
+
         const auto n = errors.size();
+        const auto m = static_cast<size_t>(known_B.rows());
 
-        // Initialize and calculate the augmented B matrix
-        SquareMatrix<Scalar> B = -1 * SquareMatrix<Scalar>::Ones(n+1,n+1);  // +1 for the Lagrange multiplier
-        B(n,n) = 0;
-        for (size_t i = 0; i < n; i++) {
+        SquareMatrix<Scalar> B = SquareMatrix<Scalar>::Zero(n, n);
+        B.topLeftCorner(m, m) = known_B;
+        for (size_t i = m; i < n; i++) {
             const auto& error_i = errors[i];
 
-            for (size_t j = 0; j < n; j++) {
-                const auto& error_j = errors[j];
-                B(i,j) = error_i.dot(error_j);
+            for (size_t j = 0; j <= i; j++) {
+                B(i,j) = error_i.dot(errors[j]);
+                B(j,i) = B(i,j);  // B is symmetric
             }
         }
 
+        return B;
+    }
+
+
+    /**
+     *  @param subjects             the subjects
+     *  @param diis_coefficients    the DIIS coefficients, of which the last one is the Lagrange multiplier
+     * 
+     *  @return the linear combination of the subjects with the DIIS coefficients
+     */
+    template <typename Subject>
+    static Subject combine(const std::vector<Subject>& subjects, const VectorX<Scalar>& diis_coefficients) {
+
+        Subject accelerated_subject = diis_coefficients(0) * subjects.at(0);  // defaultly initializing may cause problems: the default constructor for a Matrix is a 0x0-matrix
+        for (size_t i = 1; i < subjects.size(); i++) {
+            accelerated_subject += diis_coefficients(i) * subjects.at(i);
+        }
+        return accelerated_subject;
+    }
+
+
+    /**
+     *  @param B_errors             the (non-augmented) B matrix, i.e. the matrix of the inner products between the errors
+     * 
+     *  @return the coefficients that minimize the error measure
+     */
+    static VectorX<Scalar> solve(const SquareMatrix<Scalar>& B_errors) {
+
+        const auto n = B_errors.rows();
+
+        // Initialize the augmented B matrix
+        SquareMatrix<Scalar> B = -1 * SquareMatrix<Scalar>::Ones(n+1,n+1);  // +1 for the Lagrange multiplier
+        B(n,n) = 0;
+        B.topLeftCorner(n, n) = B_errors;
+
         // Initialize the RHS of the system of equations
         VectorX<Scalar> b = VectorX<Scalar>::Zero(n+1);  // +1 for the multiplier
         b(n) = -1;  // the last entry of b is accessed through n: dimension of b is n+1 - 1 because of computers
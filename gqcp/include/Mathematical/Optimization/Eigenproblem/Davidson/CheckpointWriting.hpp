@@ -0,0 +1,90 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
+
+#include <stdexcept>
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that periodically writes the state of an iterative diagonalization to a checkpoint file, so that an unfinished diagonalization can be continued later on.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
+ */
+template <typename _Scalar>
+class CheckpointWriting :
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
+
+private:
+    std::string filename;  // the name of the checkpoint file
+    size_t interval;  // the number of iterations between two consecutive checkpoints
+    size_t number_of_executions = 0;  // the number of times this step has been executed
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param filename                 the name of the checkpoint file
+     *  @param interval                 the number of iterations between two consecutive checkpoints
+     */
+    CheckpointWriting(const std::string& filename, const size_t interval = 1) :
+        filename (filename),
+        interval (interval)
+    {
+        if (interval == 0) {
+            throw std::invalid_argument("CheckpointWriting<Scalar>::CheckpointWriting(const std::string&, const size_t): The checkpoint interval must be at least 1.");
+        }
+    }
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Write the current subspace, its matrix-vector products and the current eigenvector guesses to the checkpoint file, once every interval iterations.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        this->number_of_executions++;
+        if (this->number_of_executions % this->interval == 0) {
+            environment.writeCheckpoint(this->filename);
+        }
+    }
+};
+
+
+}  // namespace GQCP
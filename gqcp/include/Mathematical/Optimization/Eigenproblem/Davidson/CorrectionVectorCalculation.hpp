@@ -27,9 +27,17 @@ namespace GQCP {
 
 /**
  *  A step that calculates correction vectors by solving the residual equations.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class CorrectionVectorCalculation :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 private:
     size_t number_of_requested_eigenpairs;
@@ -57,7 +65,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         const auto dim = environment.dimension;
 
@@ -71,16 +79,17 @@ public:
 
         // Solve the residual equations to find the correction vectors.
         // The implementation of these equations is adapted from Klaas Gunst's DOCI code (https://github.com/klgunst/doci)
-        environment.Delta = MatrixX<double>::Zero(dim, this->number_of_requested_eigenpairs);
+        const Scalar correction_threshold = this->correction_threshold;
+        environment.Delta = MatrixX<Scalar>::Zero(dim, this->number_of_requested_eigenpairs);
         for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
 
-            VectorX<double> denominator = diagonal - VectorX<double>::Constant(dim, Lambda(column_index));
+            VectorX<Scalar> denominator = diagonal - VectorX<Scalar>::Constant(dim, Lambda(column_index));
 
             // If the denominator is large enough, the correction vector is the residual vector dividided by the denominator.
             // If it isn't, the correction vector is the residual vector divided by the threshold.
-            environment.Delta.col(column_index) = (denominator.array().abs() > this->correction_threshold).select( 
+            environment.Delta.col(column_index) = (denominator.array().abs() > correction_threshold).select( 
                 R.col(column_index).array() / denominator.array().abs(),
-                R.col(column_index) / this->correction_threshold
+                R.col(column_index) / correction_threshold
             );
             environment.Delta.col(column_index).normalize();
         }
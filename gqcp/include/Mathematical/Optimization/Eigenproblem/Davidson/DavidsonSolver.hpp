@@ -20,15 +20,23 @@
 
 #include "Mathematical/Algorithm/IterativeAlgorithm.hpp"
 #include "Mathematical/Algorithm/StepCollection.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/CheckpointWriting.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/CorrectionVectorCalculation.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/GuessVectorUpdate.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/MatrixVectorProductCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/OlsenCorrectionVectorCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/ReferenceSpaceCorrectionVectorCalculation.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/ResidualVectorCalculation.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/ResidualVectorConvergence.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/SinglePrecisionPreconvergence.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceMatrixCalculation.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceMatrixDiagonalization.hpp"
 #include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceUpdate.hpp"
 #include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
+#include "Utilities/type_traits.hpp"
+
+#include <string>
+#include <type_traits>
 
 
 namespace GQCP {
@@ -36,33 +44,100 @@ namespace EigenproblemSolver {
 
 
 /**
+ *  @tparam CorrectionStep                      the type of the step that calculates the correction vectors, i.e. that applies the preconditioner
+ * 
+ *  @param correction_vector_calculation        the step that calculates the correction vectors, e.g. CorrectionVectorCalculation, OlsenCorrectionVectorCalculation or ReferenceSpaceCorrectionVectorCalculation
  *  @param number_of_requested_eigenpairs       the number of solutions the Davidson solver should find
  *  @param maximum_subspace_dimension           the maximum dimension of the subspace before collapsing
  *  @param convergence_threshold                the threshold that is used in determining the norm on the residuals, which determines convergence
- *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
  *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
  *  @param inclusion_threshold                  the threshold on the norm used for determining if a new projected correction vector should be added to the subspace
+ *  @param checkpoint_filename                  the name of the file to which the state of the diagonalization is periodically written; if empty, no checkpoints are written
+ *  @param checkpoint_interval                  the number of iterations between two consecutive checkpoints
  * 
- *  @return an iterative algorithm that can find the lowest n eigenvectors of a matrix using Davidson's algorithm
+ *  @return an iterative algorithm that can find the lowest n eigenvectors of a matrix using Davidson's algorithm, with the given preconditioner
  */
-IterativeAlgorithm<EigenproblemEnvironment> Davidson(const size_t number_of_requested_eigenpairs = 1, const size_t maximum_subspace_dimension = 15, const double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, const size_t maximum_number_of_iterations = 128, const double inclusion_threshold = 1.0e-03) {
+template <typename CorrectionStep>
+enable_if_t<std::is_base_of<Step<EigenproblemEnvironment<typename CorrectionStep::Scalar>>, CorrectionStep>::value, IterativeAlgorithm<EigenproblemEnvironment<typename CorrectionStep::Scalar>>> Davidson(const CorrectionStep& correction_vector_calculation, const size_t number_of_requested_eigenpairs = 1, const size_t maximum_subspace_dimension = 15, const double convergence_threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128, const double inclusion_threshold = 1.0e-03, const std::string& checkpoint_filename = "", const size_t checkpoint_interval = 1) {
+
+    using Scalar = typename CorrectionStep::Scalar;
 
     // Create the iteration cycle that effectively 'defines' our Davidson solver
-    StepCollection<EigenproblemEnvironment> davidson_cycle {};
-    davidson_cycle.add(MatrixVectorProductCalculation())
-                  .add(SubspaceMatrixCalculation())
-                  .add(SubspaceMatrixDiagonalization(number_of_requested_eigenpairs))
-                  .add(GuessVectorUpdate())
-                  .add(ResidualVectorCalculation(number_of_requested_eigenpairs))
-                  .add(CorrectionVectorCalculation(number_of_requested_eigenpairs, correction_threshold))  // this solves the residual equations
-                  .add(SubspaceUpdate(maximum_subspace_dimension, inclusion_threshold));
+    StepCollection<EigenproblemEnvironment<Scalar>> davidson_cycle {};
+    davidson_cycle.add(MatrixVectorProductCalculation<Scalar>())
+                  .add(SubspaceMatrixCalculation<Scalar>())
+                  .add(SubspaceMatrixDiagonalization<Scalar>(number_of_requested_eigenpairs))
+                  .add(GuessVectorUpdate<Scalar>())
+                  .add(ResidualVectorCalculation<Scalar>(number_of_requested_eigenpairs))
+                  .add(correction_vector_calculation)  // this solves the (preconditioned) residual equations
+                  .add(SubspaceUpdate<Scalar>(maximum_subspace_dimension, inclusion_threshold));
+
+    // Periodically write the state of the diagonalization, so that it can be continued if it doesn't converge (in time)
+    if (!checkpoint_filename.empty()) {
+        davidson_cycle.add(CheckpointWriting<Scalar>(checkpoint_filename, checkpoint_interval));
+    }
 
     // Create a convergence criterion on the norm of the residual vectors
-    const ResidualVectorConvergence<EigenproblemEnvironment> convergence_criterion (convergence_threshold);
+    const ResidualVectorConvergence<EigenproblemEnvironment<Scalar>> convergence_criterion (convergence_threshold);
 
-    return IterativeAlgorithm<EigenproblemEnvironment>(davidson_cycle, convergence_criterion, maximum_number_of_iterations);
+    return IterativeAlgorithm<EigenproblemEnvironment<Scalar>>(davidson_cycle, convergence_criterion, maximum_number_of_iterations);
 }
 
 
+/**
+ *  @tparam Scalar                              the scalar type in which the diagonalization is carried out
+ * 
+ *  @param number_of_requested_eigenpairs       the number of solutions the Davidson solver should find
+ *  @param maximum_subspace_dimension           the maximum dimension of the subspace before collapsing
+ *  @param convergence_threshold                the threshold that is used in determining the norm on the residuals, which determines convergence
+ *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
+ *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+ *  @param inclusion_threshold                  the threshold on the norm used for determining if a new projected correction vector should be added to the subspace
+ *  @param checkpoint_filename                  the name of the file to which the state of the diagonalization is periodically written; if empty, no checkpoints are written
+ *  @param checkpoint_interval                  the number of iterations between two consecutive checkpoints
+ * 
+ *  @return an iterative algorithm that can find the lowest n eigenvectors of a matrix using Davidson's algorithm, with the diagonal preconditioner
+ */
+template <typename Scalar = double>
+IterativeAlgorithm<EigenproblemEnvironment<Scalar>> Davidson(const size_t number_of_requested_eigenpairs = 1, const size_t maximum_subspace_dimension = 15, const double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, const size_t maximum_number_of_iterations = 128, const double inclusion_threshold = 1.0e-03, const std::string& checkpoint_filename = "", const size_t checkpoint_interval = 1) {
+
+    return EigenproblemSolver::Davidson(CorrectionVectorCalculation<Scalar>(number_of_requested_eigenpairs, correction_threshold), number_of_requested_eigenpairs, maximum_subspace_dimension, convergence_threshold, maximum_number_of_iterations, inclusion_threshold, checkpoint_filename, checkpoint_interval);
+}
+
+
+/**
+ *  @param number_of_requested_eigenpairs       the number of solutions the Davidson solver should find
+ *  @param maximum_subspace_dimension           the maximum dimension of the subspace before collapsing
+ *  @param convergence_threshold                the threshold that is used in determining the norm on the residuals, which determines convergence
+ *  @param switch_threshold                     the threshold on the norm of the residuals at which the diagonalization switches from single to double precision
+ *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
+ *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform (in both precisions)
+ *  @param inclusion_threshold                  the threshold on the norm used for determining if a new projected correction vector should be added to the subspace
+ * 
+ *  @return an iterative algorithm that can find the lowest n eigenvectors of a matrix using Davidson's algorithm, performing the first iterations in single precision
+ * 
+ *  @note The environment that this algorithm is performed on should provide a single-precision matrix-vector product.
+ */
+inline IterativeAlgorithm<EigenproblemEnvironment<double>> MixedPrecisionDavidson(const size_t number_of_requested_eigenpairs = 1, const size_t maximum_subspace_dimension = 15, const double convergence_threshold = 1.0e-08, const double switch_threshold = 1.0e-04, double correction_threshold = 1.0e-12, const size_t maximum_number_of_iterations = 128, const double inclusion_threshold = 1.0e-03) {
+
+    // Create the iteration cycle: before the first double-precision iteration, the guesses are converged in single precision
+    StepCollection<EigenproblemEnvironment<double>> davidson_cycle {};
+    davidson_cycle.add(SinglePrecisionPreconvergence(number_of_requested_eigenpairs, maximum_subspace_dimension, switch_threshold, correction_threshold, maximum_number_of_iterations, inclusion_threshold))
+                  .add(MatrixVectorProductCalculation<double>())
+                  .add(SubspaceMatrixCalculation<double>())
+                  .add(SubspaceMatrixDiagonalization<double>(number_of_requested_eigenpairs))
+                  .add(GuessVectorUpdate<double>())
+                  .add(ResidualVectorCalculation<double>(number_of_requested_eigenpairs))
+                  .add(CorrectionVectorCalculation<double>(number_of_requested_eigenpairs, correction_threshold))  // this solves the residual equations
+                  .add(SubspaceUpdate<double>(maximum_subspace_dimension, inclusion_threshold));
+
+    // Create a convergence criterion on the norm of the (double-precision) residual vectors
+    const ResidualVectorConvergence<EigenproblemEnvironment<double>> convergence_criterion (convergence_threshold);
+
+    return IterativeAlgorithm<EigenproblemEnvironment<double>>(davidson_cycle, convergence_criterion, maximum_number_of_iterations);
+}
+
+
+
 }  // namespace EigenproblemSolver
 }  // namespace GQCP
@@ -27,9 +27,17 @@ namespace GQCP {
 
 /**
  *  A step that calculates new guesses for the eigenvectors from the diagonalized subspace matrix.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class GuessVectorUpdate :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 public:
 
@@ -42,7 +50,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         // X contains the new guesses for the eigenvectors, V is the subspace and Z are the eigenvectors of the subspace matrix
         environment.X = environment.V * environment.Z;  // X is a linear combination of the current subspace vectors
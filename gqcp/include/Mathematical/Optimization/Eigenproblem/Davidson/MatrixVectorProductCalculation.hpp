@@ -21,6 +21,8 @@
 #include "Mathematical/Algorithm/Step.hpp"
 #include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
 
+#include <cmath>
+#include <limits>
 #include <type_traits>
 
 
@@ -29,9 +31,17 @@ namespace GQCP {
 
 /**
  *  An iteration step that calculates the matrix-vector products for all (new) guess vectors.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class MatrixVectorProductCalculation :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 public:
 
@@ -44,10 +54,10 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         const auto& V = environment.V;   // the subspace of guess vectors
-        assert((V.transpose() * V).isApprox(MatrixX<double>::Identity(V.cols(), V.cols()), 1.0e-08));  // make sure that the subspace vectors are orthonormal
+        assert((V.transpose() * V).isApprox(MatrixX<Scalar>::Identity(V.cols(), V.cols()), std::sqrt(std::numeric_limits<Scalar>::epsilon())));  // make sure that the subspace vectors are orthonormal (up to the working precision)
 
 
         auto& VA = environment.VA;  // VA = A * V (implicitly calculated through the matrix-vector product)
@@ -0,0 +1,108 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
+
+#include <cmath>
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that calculates correction vectors using Olsen's correction, i.e. the diagonally preconditioned residual vectors made orthogonal to the current eigenvector guesses (in the metric of the preconditioner).
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
+ */
+template <typename _Scalar>
+class OlsenCorrectionVectorCalculation :
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
+
+private:
+    size_t number_of_requested_eigenpairs;
+    double correction_threshold;  // the smallest absolute value of the denominators in the preconditioner
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param number_of_requested_eigenpairs               the number of eigenpairs that should be found by the algorithm
+     *  @param correction_threshold                         the smallest absolute value of the denominators in the preconditioner
+     */
+    OlsenCorrectionVectorCalculation(const size_t number_of_requested_eigenpairs = 1, const double correction_threshold = 1.0e-12) :
+        number_of_requested_eigenpairs (number_of_requested_eigenpairs),
+        correction_threshold (correction_threshold)
+    {}
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate the correction vectors delta = (D - lambda)^{-1} (r - epsilon x), in which epsilon is chosen such that delta is orthogonal to the eigenvector guess x.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        const auto dim = environment.dimension;
+
+        const auto& diagonal = environment.diagonal;  // the diagonal of the matrix
+        const auto& Lambda = environment.Lambda;  // the (requested number of) eigenvalues of the subspace matrix S
+        const auto& X = environment.X;  // contains the new guesses for the eigenvectors (as a linear combination of the current subspace V)
+        const auto& R = environment.R;  // the residual vectors
+
+        const Scalar correction_threshold = this->correction_threshold;
+        environment.Delta = MatrixX<Scalar>::Zero(dim, this->number_of_requested_eigenpairs);
+        for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
+
+            // Keep the denominators away from zero, without changing their sign.
+            const VectorX<Scalar> denominator = diagonal - VectorX<Scalar>::Constant(dim, Lambda(column_index));
+            const VectorX<Scalar> safe_denominator = denominator.unaryExpr([correction_threshold] (const Scalar d) { return (std::abs(d) > correction_threshold) ? d : std::copysign(correction_threshold, d); });
+
+            const VectorX<Scalar> preconditioned_residual = R.col(column_index).array() / safe_denominator.array();
+            const VectorX<Scalar> preconditioned_guess = X.col(column_index).array() / safe_denominator.array();
+
+            // Olsen's epsilon makes the correction vector orthogonal to the eigenvector guess. If the guess is (numerically) annihilated by the preconditioner, fall back to the diagonal correction.
+            const Scalar norm = X.col(column_index).dot(preconditioned_guess);
+            Scalar epsilon = 0.0;
+            if (std::abs(norm) > correction_threshold) {
+                epsilon = X.col(column_index).dot(preconditioned_residual) / norm;
+            }
+
+            environment.Delta.col(column_index) = preconditioned_residual - epsilon * preconditioned_guess;
+            environment.Delta.col(column_index).normalize();
+        }
+    }
+};
+
+
+}  // namespace GQCP
@@ -0,0 +1,191 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that calculates correction vectors using a block-diagonal preconditioner: inside a reference space, spanned by the basis vectors with the lowest diagonal elements, the matrix is represented exactly; outside of it, only the diagonal is used.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
+ * 
+ *  @note The reference space block is set up from the matrix elements, the first time this step is executed for a matrix. The environment should therefore either contain the dense matrix or provide a matrix element function.
+ */
+template <typename _Scalar>
+class ReferenceSpaceCorrectionVectorCalculation :
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
+
+private:
+    size_t number_of_requested_eigenpairs;
+    size_t reference_space_dimension;  // the (maximum) number of basis vectors in the reference space
+    double correction_threshold;  // the smallest absolute value of the denominators in the preconditioner
+
+    // The diagonalized reference space block, which is set up lazily for the matrix with the diagonal that is stored here
+    VectorX<Scalar> diagonal;
+    std::vector<size_t> reference_indices;  // the indices of the basis vectors that span the reference space
+    VectorX<Scalar> reference_eigenvalues;
+    MatrixX<Scalar> reference_eigenvectors;
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param number_of_requested_eigenpairs               the number of eigenpairs that should be found by the algorithm
+     *  @param reference_space_dimension                    the (maximum) number of basis vectors in the reference space
+     *  @param correction_threshold                         the smallest absolute value of the denominators in the preconditioner
+     */
+    ReferenceSpaceCorrectionVectorCalculation(const size_t number_of_requested_eigenpairs = 1, const size_t reference_space_dimension = 100, const double correction_threshold = 1.0e-12) :
+        number_of_requested_eigenpairs (number_of_requested_eigenpairs),
+        reference_space_dimension (reference_space_dimension),
+        correction_threshold (correction_threshold)
+    {}
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate the correction vectors delta = (M - lambda)^{-1} (r - epsilon x), in which M is the block-diagonal preconditioner and epsilon is chosen such that delta is orthogonal to the eigenvector guess x.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        if ((this->diagonal.size() != environment.diagonal.size()) || (this->diagonal != environment.diagonal)) {
+            this->setUpReferenceSpace(environment);
+        }
+
+        const auto dim = environment.dimension;
+        const auto reference_dim = this->reference_indices.size();
+
+        const auto& Lambda = environment.Lambda;  // the (requested number of) eigenvalues of the subspace matrix S
+        const auto& X = environment.X;  // contains the new guesses for the eigenvectors (as a linear combination of the current subspace V)
+        const auto& R = environment.R;  // the residual vectors
+
+        // Keep the denominators away from zero, without changing their sign.
+        const Scalar correction_threshold = this->correction_threshold;
+        const auto safe_inverse = [correction_threshold] (const VectorX<Scalar>& denominator) {
+            const VectorX<Scalar> safe_denominator = denominator.unaryExpr([correction_threshold] (const Scalar d) { return (std::abs(d) > correction_threshold) ? d : std::copysign(correction_threshold, d); });
+            const VectorX<Scalar> inverse = safe_denominator.array().inverse();
+            return inverse;
+        };
+
+        environment.Delta = MatrixX<Scalar>::Zero(dim, this->number_of_requested_eigenpairs);
+        for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
+            const Scalar lambda = Lambda(column_index);
+            const VectorX<Scalar> inverse_shifted_diagonal = safe_inverse(environment.diagonal - VectorX<Scalar>::Constant(dim, lambda));
+            const VectorX<Scalar> inverse_shifted_eigenvalues = safe_inverse(this->reference_eigenvalues - VectorX<Scalar>::Constant(reference_dim, lambda));
+
+            // Apply the inverse of the shifted preconditioner: outside of the reference space, it is diagonal. Inside of the reference space, solve (A_PP - lambda) y_P = v_P through the eigendecomposition of A_PP.
+            const auto precondition = [this, reference_dim, &inverse_shifted_diagonal, &inverse_shifted_eigenvalues] (const VectorX<Scalar>& v) {
+                VectorX<Scalar> y = v.cwiseProduct(inverse_shifted_diagonal);
+
+                VectorX<Scalar> v_P (reference_dim);
+                for (size_t i = 0; i < reference_dim; i++) {
+                    v_P(i) = v(this->reference_indices[i]);
+                }
+
+                const VectorX<Scalar> y_P = this->reference_eigenvectors * inverse_shifted_eigenvalues.cwiseProduct(this->reference_eigenvectors.transpose() * v_P);
+                for (size_t i = 0; i < reference_dim; i++) {
+                    y(this->reference_indices[i]) = y_P(i);
+                }
+                return y;
+            };
+
+            const VectorX<Scalar> preconditioned_residual = precondition(R.col(column_index));
+            const VectorX<Scalar> preconditioned_guess = precondition(X.col(column_index));
+
+            // The reference space block is (close to) exact, so the preconditioned residual is nearly parallel to the eigenvector guess. Olsen's epsilon removes that component, so that the correction vector doesn't vanish after projection onto the orthogonal complement of the subspace.
+            const Scalar norm = X.col(column_index).dot(preconditioned_guess);
+            Scalar epsilon = 0.0;
+            if (std::abs(norm) > correction_threshold) {
+                epsilon = X.col(column_index).dot(preconditioned_residual) / norm;
+            }
+
+            environment.Delta.col(column_index) = preconditioned_residual - epsilon * preconditioned_guess;
+            environment.Delta.col(column_index).normalize();
+        }
+    }
+
+
+private:
+
+    /**
+     *  Select the reference space for the matrix in the given environment, and diagonalize the corresponding block of the matrix.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void setUpReferenceSpace(const Environment& environment) {
+
+        const auto dim = environment.dimension;
+        this->diagonal = environment.diagonal;
+
+        // The reference space is spanned by the basis vectors with the lowest diagonal elements.
+        const size_t reference_dim = std::min(this->reference_space_dimension, dim);
+        std::vector<size_t> indices (dim);
+        std::iota(indices.begin(), indices.end(), 0);
+        std::partial_sort(indices.begin(), indices.begin() + reference_dim, indices.end(), [this] (const size_t i, const size_t j) { return this->diagonal(i) < this->diagonal(j); });
+        this->reference_indices.assign(indices.begin(), indices.begin() + reference_dim);
+
+
+        // Set up the reference space block of the matrix from its elements, which are taken either from the dense matrix or from the matrix element function.
+        if ((environment.A.size() == 0) && !environment.matrix_element_function) {
+            throw std::invalid_argument("ReferenceSpaceCorrectionVectorCalculation::setUpReferenceSpace(const EigenproblemEnvironment<Scalar>&): The environment provides neither the dense matrix nor its matrix elements.");
+        }
+
+        MatrixX<Scalar> A_PP (reference_dim, reference_dim);
+        for (size_t j = 0; j < reference_dim; j++) {
+            for (size_t i = 0; i < reference_dim; i++) {
+                const auto I = this->reference_indices[i];
+                const auto J = this->reference_indices[j];
+                A_PP(i, j) = (environment.A.size() > 0) ? environment.A(I, J) : environment.matrix_element_function(I, J);
+            }
+        }
+
+        const Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> eigensolver (A_PP);
+        this->reference_eigenvalues = eigensolver.eigenvalues();
+        this->reference_eigenvectors = eigensolver.eigenvectors();
+    }
+};
+
+
+}  // namespace GQCP
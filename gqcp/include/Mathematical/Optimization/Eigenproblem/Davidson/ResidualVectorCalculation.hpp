@@ -27,9 +27,17 @@ namespace GQCP {
 
 /**
  *  A step that calculates the residual vectors from the new guesses for the eigenvectors.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class ResidualVectorCalculation :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 private:
     size_t number_of_requested_eigenpairs;
@@ -54,7 +62,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         const auto dim = environment.dimension;
 
@@ -64,7 +72,7 @@ public:
         const auto& X = environment.X;  // contains the new guesses for the eigenvectors (as a linear combination of the current subspace V)
 
         // Calculate the residual vectors: r_i = VA * z_i - Lambda * x_i
-        environment.R = MatrixX<double>::Zero(dim, this->number_of_requested_eigenpairs);
+        environment.R = MatrixX<Scalar>::Zero(dim, this->number_of_requested_eigenpairs);
         for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
             environment.R.col(column_index) = VA * Z.col(column_index) - Lambda(column_index) * X.col(column_index);
         }
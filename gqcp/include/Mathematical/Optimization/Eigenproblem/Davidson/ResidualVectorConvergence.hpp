@@ -70,7 +70,7 @@ public:
         const auto& R = environment.R;  // the residual vectors
 
         if (R.cols() > 0) {  // if there are residual vectors available
-            const auto are_any_values_larger = (R.colwise().norm().array() > this->threshold).any();
+            const auto are_any_values_larger = (R.colwise().norm().array().template cast<double>() > this->threshold).any();
             return !are_any_values_larger;
         }
 
@@ -0,0 +1,142 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/IterativeAlgorithm.hpp"
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Algorithm/StepCollection.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/CorrectionVectorCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/GuessVectorUpdate.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/MatrixVectorProductCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/ResidualVectorCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/ResidualVectorConvergence.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceMatrixCalculation.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceMatrixDiagonalization.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/SubspaceUpdate.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemEnvironment.hpp"
+
+#include <Eigen/QR>
+
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that, before the first double-precision Davidson iteration, converges the eigenvector guesses with a single-precision Davidson diagonalization. The single-precision subspace and its matrix-vector products take up half the memory of their double-precision counterparts.
+ * 
+ *  The single-precision iterations use the environment's single-precision matrix-vector product, which should therefore be set (e.g. by CIEnvironment::Iterative for FCI and Hubbard).
+ */
+class SinglePrecisionPreconvergence :
+    public Step<EigenproblemEnvironment<double>> {
+
+public:
+    using Environment = EigenproblemEnvironment<double>;
+
+
+private:
+    size_t number_of_requested_eigenpairs;
+    size_t maximum_subspace_dimension;
+    double switch_threshold;  // the threshold on the norm of the single-precision residual vectors at which the diagonalization switches to double precision
+    double correction_threshold;
+    size_t maximum_number_of_iterations;  // the maximum number of single-precision iterations
+    double inclusion_threshold;
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param number_of_requested_eigenpairs       the number of solutions the Davidson solver should find
+     *  @param maximum_subspace_dimension           the maximum dimension of the subspace before collapsing
+     *  @param switch_threshold                     the threshold on the norm of the single-precision residual vectors at which the diagonalization switches to double precision
+     *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
+     *  @param maximum_number_of_iterations         the maximum number of single-precision iterations
+     *  @param inclusion_threshold                  the threshold on the norm used for determining if a new projected correction vector should be added to the subspace
+     */
+    SinglePrecisionPreconvergence(const size_t number_of_requested_eigenpairs = 1, const size_t maximum_subspace_dimension = 15, const double switch_threshold = 1.0e-04, const double correction_threshold = 1.0e-12, const size_t maximum_number_of_iterations = 128, const double inclusion_threshold = 1.0e-03) :
+        number_of_requested_eigenpairs (number_of_requested_eigenpairs),
+        maximum_subspace_dimension (maximum_subspace_dimension),
+        switch_threshold (switch_threshold),
+        correction_threshold (correction_threshold),
+        maximum_number_of_iterations (maximum_number_of_iterations),
+        inclusion_threshold (inclusion_threshold)
+    {}
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Converge the current subspace in single precision until the norms of the residual vectors drop below the switch threshold, and replace the subspace with the resulting eigenvector guesses. Once residual vectors have been calculated in double precision, this step does nothing.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        if (environment.R.cols() > 0) {  // the diagonalization has already switched to double precision
+            return;
+        }
+
+
+        // Set up a single-precision environment.
+        if (!environment.single_precision_matrix_vector_product_function) {
+            throw std::invalid_argument("SinglePrecisionPreconvergence::execute(EigenproblemEnvironment<double>&): The environment doesn't provide a single-precision matrix-vector product.");
+        }
+
+        const VectorX<float> diagonal = environment.diagonal.cast<float>();
+        const MatrixX<float> V = environment.V.cast<float>();
+        auto single_precision_environment = EigenproblemEnvironment<float>::Iterative(environment.single_precision_matrix_vector_product_function, diagonal, V);
+
+
+        // Iterate in single precision, using the switch threshold as the convergence threshold.
+        StepCollection<EigenproblemEnvironment<float>> davidson_cycle {};
+        davidson_cycle.add(MatrixVectorProductCalculation<float>())
+                      .add(SubspaceMatrixCalculation<float>())
+                      .add(SubspaceMatrixDiagonalization<float>(this->number_of_requested_eigenpairs))
+                      .add(GuessVectorUpdate<float>())
+                      .add(ResidualVectorCalculation<float>(this->number_of_requested_eigenpairs))
+                      .add(CorrectionVectorCalculation<float>(this->number_of_requested_eigenpairs, this->correction_threshold))
+                      .add(SubspaceUpdate<float>(this->maximum_subspace_dimension, this->inclusion_threshold));
+
+        const ResidualVectorConvergence<EigenproblemEnvironment<float>> convergence_criterion (this->switch_threshold);
+        IterativeAlgorithm<EigenproblemEnvironment<float>> single_precision_davidson (davidson_cycle, convergence_criterion, this->maximum_number_of_iterations);
+
+        try {
+            single_precision_davidson.perform(single_precision_environment);
+        } catch (const std::runtime_error&) {
+            // If the single-precision residuals stagnate above the switch threshold, the double-precision iterations continue from the current eigenvector guesses.
+        }
+
+
+        // Continue in double precision from the (re-orthonormalized) single-precision eigenvector guesses.
+        const Eigen::MatrixXd X = single_precision_environment.X.cast<double>();
+        const Eigen::HouseholderQR<Eigen::MatrixXd> qr (X);
+        environment.V = qr.householderQ() * Eigen::MatrixXd::Identity(X.rows(), X.cols());
+        environment.VA = MatrixX<double>::Zero(environment.dimension, 0);
+    }
+};
+
+
+}  // namespace GQCP
@@ -29,9 +29,17 @@ namespace GQCP {
 
 /**
  *  An iteration step that calculates the subspace matrix, i.e. the projection of the matrix A onto the subspace spanned by the vectors in V.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class SubspaceMatrixCalculation :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 public:
 
@@ -44,7 +52,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         const auto& V = environment.V;   // the subspace of guess vectors
         const auto& VA = environment.VA;   // VA = A * V (implicitly calculated through the matrix-vector product)
@@ -31,9 +31,17 @@ namespace GQCP {
 
 /**
  *  An iteration step that diagonalizes the subspace matrix, i.e. the projection of the matrix A onto the subspace spanned by the vectors in V.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class SubspaceMatrixDiagonalization :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 private:
     size_t number_of_requested_eigenpairs;
@@ -62,7 +70,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         // Diagonalize the subspace matrix and find the r (this->number_of_requested_eigenpairs) lowest eigenpairs
         // Lambda contains the requested number of eigenvalues, Z contains the corresponding eigenvectors
@@ -70,8 +78,8 @@ public:
 
         // Use our own dense diagonalization algorithm to find the number of requested eigenpairs
         const auto& S = environment.S;
-        auto dense_environment = EigenproblemEnvironment::Dense(S);
-        auto dense_diagonalizer = EigenproblemSolver::Dense();
+        auto dense_environment = EigenproblemEnvironment<Scalar>::Dense(S);
+        auto dense_diagonalizer = EigenproblemSolver::Dense<Scalar>();
         dense_diagonalizer.perform(dense_environment);
 
 
@@ -27,10 +27,16 @@ namespace GQCP {
 
 /**
  *  A step that adds projected correction vectors to the subspace (if their norm is large enough) and collapses the subspace if it becomes too large.
-
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class SubspaceUpdate :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
 
 
 private:
@@ -63,7 +69,7 @@ public:
      * 
      *  @param environment              the environment that acts as a sort of calculation space
      */
-    void execute(EigenproblemEnvironment& environment) override {
+    void execute(Environment& environment) override {
 
         auto& V = environment.V;
         const auto& Delta = environment.Delta;
@@ -77,7 +83,8 @@ public:
         // Update the current subspace V with new vectors: add the normalized orthogonal projection of the correction vectors if their norm is large enough.
         // Note that we can't add more than one vector simultaneously, as the inclusion of one vector changes the subspace, which in turn changes its orthogonal complement.
         for (size_t column_index = 0; column_index < Delta.cols(); column_index++) {
-            VectorX<double> v = Delta.col(column_index) - V * (V.transpose() * Delta.col(column_index));  // project the correction vector on the orthogonal complement of V
+            VectorX<Scalar> v = Delta.col(column_index) - V * (V.transpose() * Delta.col(column_index));  // project the correction vector on the orthogonal complement of V
+            v -= V * (V.transpose() * v);  // project a second time, since one projection loses orthogonality in finite (in particular single) precision
             const double norm = v.norm();
             v.normalize();
 
@@ -29,9 +29,17 @@ namespace GQCP {
 
 /**
  *  A step that performs a dense diagonalization.
+ * 
+ *  @tparam _Scalar            the scalar type in which the diagonalization is carried out
  */
+template <typename _Scalar>
 class DenseDiagonalization :
-    public Step<EigenproblemEnvironment> {
+    public Step<EigenproblemEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = EigenproblemEnvironment<Scalar>;
+
 
 private:
     size_t number_of_requested_eigenpairs;
@@ -51,7 +59,7 @@ public:
     void execute(Environment& environment) override {
 
         const auto& A = environment.A;  // a self-adjoint matrix
-        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);  // this solves the eigenvalue problem
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> eigensolver (A);  // this solves the eigenvalue problem
 
         // Write the eigenvalues and eigenvectors to the environment
         environment.eigenvalues = eigensolver.eigenvalues();
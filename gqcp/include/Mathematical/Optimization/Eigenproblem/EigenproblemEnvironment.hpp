@@ -22,33 +22,51 @@
 #include "Mathematical/Representation/Matrix.hpp"
 #include "Mathematical/Representation/SquareMatrix.hpp"
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
 
 namespace GQCP {
 
 
 /**
  *  An environment used to solve eigenvalue problems for self-adjoint matrices.
+ * 
+ *  @tparam _Scalar             the scalar type in which the (iterative) diagonalization is carried out
  */
+template <typename _Scalar>
 class EigenproblemEnvironment {
 public:
-    VectorFunction<double> matrix_vector_product_function;  // a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
-    SquareMatrix<double> A;  // the self-adjoint matrix whose eigenvalue problem should be solved
-    VectorX<double> diagonal;  // the diagonal of the matrix
+    using Scalar = _Scalar;
+
+
+public:
+    VectorFunction<Scalar> matrix_vector_product_function;  // a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
+    VectorFunction<float> single_precision_matrix_vector_product_function;  // an (optional) vector function that returns the matrix-vector product in single precision, which is used in the single-precision iterations of a mixed-precision diagonalization
+    std::function<Scalar (const size_t, const size_t)> matrix_element_function;  // an (optional) function that returns the matrix element A(i,j), which is used to set up exact blocks of the matrix (e.g. for a reference space preconditioner)
+    SquareMatrix<Scalar> A;  // the self-adjoint matrix whose eigenvalue problem should be solved
+    VectorX<Scalar> diagonal;  // the diagonal of the matrix
     size_t dimension;  // the dimension of the diagonalization problem (the dimension of one eigenvector)
 
-    VectorX<double> eigenvalues;  // the eigenvalues of the matrix A
-    MatrixX<double> eigenvectors;  // the eigenvectors of the matrix A
+    VectorX<Scalar> eigenvalues;  // the eigenvalues of the matrix A
+    MatrixX<Scalar> eigenvectors;  // the eigenvectors of the matrix A
 
-    SquareMatrix<double> S;  // the "subspace matrix": the projection of the matrix A onto the subspace spanned by the vectors in V
-    VectorX<double> Lambda;  // the (requested number of) eigenvalues of the subspace matrix S
-    MatrixX<double> Z;  // the (requested number of) eigenvectors of the subspace matrix S
+    SquareMatrix<Scalar> S;  // the "subspace matrix": the projection of the matrix A onto the subspace spanned by the vectors in V
+    VectorX<Scalar> Lambda;  // the (requested number of) eigenvalues of the subspace matrix S
+    MatrixX<Scalar> Z;  // the (requested number of) eigenvectors of the subspace matrix S
 
-    MatrixX<double> V;  // the subspace of guess vectors in an iterative diagonalization algorithm
-    MatrixX<double> VA;  // VA = A * V (implicitly calculated through the matrix-vector product)
-    MatrixX<double> X;  // contains the new guesses for the eigenvectors (as a linear combination of the current subspace V)
+    MatrixX<Scalar> V;  // the subspace of guess vectors in an iterative diagonalization algorithm
+    MatrixX<Scalar> VA;  // VA = A * V (implicitly calculated through the matrix-vector product)
+    MatrixX<Scalar> X;  // contains the new guesses for the eigenvectors (as a linear combination of the current subspace V)
 
-    MatrixX<double> R;  // the residual vectors
-    MatrixX<double> Delta;  // the correction vectors (solutions to the residual equations)
+    MatrixX<Scalar> R;  // the residual vectors
+    MatrixX<Scalar> Delta;  // the correction vectors (solutions to the residual equations)
 
 
 public:
@@ -60,7 +78,7 @@ public:
     /**
      *  @param A                the matrix whose eigenvalue problem should be solved
      */
-    EigenproblemEnvironment(const SquareMatrix<double>& A) :
+    EigenproblemEnvironment(const SquareMatrix<Scalar>& A) :
         A (A)
     {}
 
@@ -68,12 +86,12 @@ public:
      *  @param matrix_vector_product            a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
      *  @param diagonal                         the diagonal of the matrix whose eigenvalue problem should be solved
      */
-    EigenproblemEnvironment(const VectorFunction<double>& matrix_vector_product_function, const VectorX<double>& diagonal, const MatrixX<double>& V) :
+    EigenproblemEnvironment(const VectorFunction<Scalar>& matrix_vector_product_function, const VectorX<Scalar>& diagonal, const MatrixX<Scalar>& V) :
         dimension (diagonal.size()),
         matrix_vector_product_function (matrix_vector_product_function),
         diagonal (diagonal),
         V (V),
-        VA (MatrixX<double>::Zero(V.rows(), 0))  // the initial environment should have no columns in VA
+        VA (MatrixX<Scalar>::Zero(V.rows(), 0))  // the initial environment should have no columns in VA
     {}
 
 
@@ -86,7 +104,7 @@ public:
      * 
      *  @return an environment that can be used to solve the dense eigenvalue problem for the given square matrix
      */
-    static EigenproblemEnvironment Dense(const SquareMatrix<double>& A) {
+    static EigenproblemEnvironment Dense(const SquareMatrix<Scalar>& A) {
         return EigenproblemEnvironment(A);
     }
 
@@ -97,7 +115,7 @@ public:
      * 
      *  @return an environment that can be used to solve the eigenvalue problem for the matrix that is represented by the given matrix-vector product
      */
-    static EigenproblemEnvironment Iterative(const VectorFunction<double>& matrix_vector_product_function, const VectorX<double>& diagonal, const MatrixX<double>& V) {
+    static EigenproblemEnvironment Iterative(const VectorFunction<Scalar>& matrix_vector_product_function, const VectorX<Scalar>& diagonal, const MatrixX<Scalar>& V) {
         return EigenproblemEnvironment(matrix_vector_product_function, diagonal, V);
     }
 
@@ -106,12 +124,32 @@ public:
      *  @param A                                the matrix whose eigenvalue problem should be solved
      *  @param V                                a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
      * 
-     *  @return an environment that can be used to solve the eigenvalue problem for the matrix that is represented by the given matrix-vector product
+     *  @return an environment that can be used to solve the eigenvalue problem for the matrix that is represented by the given matrix-vector product, which also provides the matrix elements
+     */
+    static EigenproblemEnvironment Iterative(const SquareMatrix<Scalar>& A, const MatrixX<Scalar>& V) {
+
+        // The matrix-vector product and the matrix elements share one copy of the matrix
+        const auto A_ptr = std::make_shared<const SquareMatrix<Scalar>>(A);
+        const auto matrix_vector_product_function = [A_ptr](const VectorX<Scalar>& x) { return (*A_ptr) * x; };
+
+        auto environment = EigenproblemEnvironment<Scalar>::Iterative(matrix_vector_product_function, A.diagonal(), V);
+        environment.matrix_element_function = [A_ptr](const size_t i, const size_t j) { return (*A_ptr)(i,j); };
+        return environment;
+    }
+
+
+    /**
+     *  @param matrix_vector_product            a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
+     *  @param diagonal                         the diagonal of the matrix whose eigenvalue problem should be solved
+     *  @param checkpoint_filename              the name of a checkpoint file that was written during a previous (unfinished) iterative diagonalization of the same matrix
+     * 
+     *  @return an environment that continues the iterative diagonalization from the state in the given checkpoint file
      */
-    static EigenproblemEnvironment Iterative(const SquareMatrix<double>& A, const MatrixX<double>& V) {
+    static EigenproblemEnvironment Iterative(const VectorFunction<Scalar>& matrix_vector_product_function, const VectorX<Scalar>& diagonal, const std::string& checkpoint_filename) {
 
-        const auto matrix_vector_product_function = [A](const VectorX<double>& x) { return A * x; };
-        return EigenproblemEnvironment::Iterative(matrix_vector_product_function, A.diagonal(), V);  
+        auto environment = EigenproblemEnvironment<Scalar>::Iterative(matrix_vector_product_function, diagonal, MatrixX<Scalar>::Zero(diagonal.size(), 0));
+        environment.readCheckpoint(checkpoint_filename);
+        return environment;
     }
 
 
@@ -127,7 +165,7 @@ public:
     std::vector<Eigenpair> eigenpairs(const size_t number_of_requested_eigenpairs = 1) const {
 
         if (number_of_requested_eigenpairs > eigenvectors.cols()) {
-            throw std::invalid_argument("EigenproblemEnvironment::eigenpairs(const size_t): You cannot retrieve that many eigenpairs.");
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::eigenpairs(const size_t): You cannot retrieve that many eigenpairs.");
         }
 
         std::vector<Eigenpair> eigenpairs {};
@@ -137,11 +175,109 @@ public:
             const auto& eigenvalue = this->eigenvalues(i);
             const auto& eigenvector = this->eigenvectors.col(i);
 
-            eigenpairs.emplace_back(eigenvalue, eigenvector);
+            eigenpairs.emplace_back(static_cast<double>(eigenvalue), eigenvector.template cast<double>());
         }
 
         return eigenpairs;
     }
+
+
+    /**
+     *  Restore the state of an iterative diagonalization, i.e. the subspace V, its matrix-vector products VA, the current guesses for the eigenvectors X and the corresponding eigenvalues Lambda, from a checkpoint file.
+     * 
+     *  @param filename                     the name of the checkpoint file
+     */
+    void readCheckpoint(const std::string& filename) {
+
+        std::ifstream input_file_stream (filename, std::ios::binary);
+        if (!input_file_stream.good()) {
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::readCheckpoint(const std::string&): Could not open the given checkpoint file.");
+        }
+
+        char magic[8];
+        std::uint64_t scalar_size;
+        std::uint64_t dimension;
+        input_file_stream.read(magic, sizeof(magic));
+        input_file_stream.read(reinterpret_cast<char*>(&scalar_size), sizeof(scalar_size));
+        input_file_stream.read(reinterpret_cast<char*>(&dimension), sizeof(dimension));
+        if (!input_file_stream.good() || (std::memcmp(magic, "GQCPEIGC", sizeof(magic)) != 0)) {
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::readCheckpoint(const std::string&): The given file is not a checkpoint file.");
+        }
+        if (scalar_size != sizeof(Scalar)) {
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::readCheckpoint(const std::string&): The checkpoint was written for a different scalar type.");
+        }
+        if (dimension != this->dimension) {
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::readCheckpoint(const std::string&): The dimension of the checkpoint does not match the dimension of this eigenvalue problem.");
+        }
+
+        const auto read_matrix = [&input_file_stream, dimension] (MatrixX<Scalar>& M) {
+            std::uint64_t cols;
+            input_file_stream.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+            M.resize(dimension, cols);
+            input_file_stream.read(reinterpret_cast<char*>(M.data()), M.size() * sizeof(Scalar));
+        };
+        read_matrix(this->V);
+        read_matrix(this->VA);
+        read_matrix(this->X);
+
+        std::uint64_t number_of_eigenvalues;
+        input_file_stream.read(reinterpret_cast<char*>(&number_of_eigenvalues), sizeof(number_of_eigenvalues));
+        this->Lambda.resize(number_of_eigenvalues);
+        input_file_stream.read(reinterpret_cast<char*>(this->Lambda.data()), this->Lambda.size() * sizeof(Scalar));
+
+        if (!input_file_stream.good()) {
+            throw std::invalid_argument("EigenproblemEnvironment<Scalar>::readCheckpoint(const std::string&): The given checkpoint file is incomplete.");
+        }
+
+        // Since the residual vectors aren't stored, the next convergence check always proceeds with a new iteration
+        this->R.resize(this->dimension, 0);
+    }
+
+
+    /**
+     *  Write the state of an iterative diagonalization, i.e. the subspace V, its matrix-vector products VA, the current guesses for the eigenvectors X and the corresponding eigenvalues Lambda, to a binary checkpoint file.
+     * 
+     *  @param filename                     the name of the checkpoint file
+     * 
+     *  @note The checkpoint is first written to a temporary file, which then replaces the given file. An interruption while writing therefore never leaves behind a corrupt checkpoint.
+     */
+    void writeCheckpoint(const std::string& filename) const {
+
+        const std::string temporary_filename = filename + ".tmp";
+        {
+            std::ofstream output_file_stream (temporary_filename, std::ios::binary);
+            if (!output_file_stream.good()) {
+                throw std::runtime_error("EigenproblemEnvironment<Scalar>::writeCheckpoint(const std::string&): Could not open the checkpoint file for writing.");
+            }
+
+            const std::uint64_t scalar_size = sizeof(Scalar);
+            const std::uint64_t dimension = this->dimension;
+            output_file_stream.write("GQCPEIGC", 8);
+            output_file_stream.write(reinterpret_cast<const char*>(&scalar_size), sizeof(scalar_size));
+            output_file_stream.write(reinterpret_cast<const char*>(&dimension), sizeof(dimension));
+
+            const auto write_matrix = [&output_file_stream] (const MatrixX<Scalar>& M) {
+                const std::uint64_t cols = M.cols();
+                output_file_stream.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+                output_file_stream.write(reinterpret_cast<const char*>(M.data()), M.size() * sizeof(Scalar));
+            };
+            write_matrix(this->V);
+            write_matrix(this->VA);
+            write_matrix(this->X);
+
+            const std::uint64_t number_of_eigenvalues = this->Lambda.size();
+            output_file_stream.write(reinterpret_cast<const char*>(&number_of_eigenvalues), sizeof(number_of_eigenvalues));
+            output_file_stream.write(reinterpret_cast<const char*>(this->Lambda.data()), this->Lambda.size() * sizeof(Scalar));
+
+            if (!output_file_stream.good()) {
+                throw std::runtime_error("EigenproblemEnvironment<Scalar>::writeCheckpoint(const std::string&): Could not write the checkpoint.");
+            }
+        }
+
+        if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+            throw std::runtime_error("EigenproblemEnvironment<Scalar>::writeCheckpoint(const std::string&): Could not replace the checkpoint file.");
+        }
+    }
 };
 
 
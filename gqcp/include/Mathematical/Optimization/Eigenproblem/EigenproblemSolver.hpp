@@ -27,15 +27,18 @@ namespace EigenproblemSolver {
 
 
 /**
+ *  @tparam Scalar              the scalar type in which the diagonalization is carried out
+ * 
  *  @return an algorithm that can diagonalize a dense matrix
  */
-Algorithm<EigenproblemEnvironment> Dense() {
+template <typename Scalar = double>
+Algorithm<EigenproblemEnvironment<Scalar>> Dense() {
 
     // Our dense eigenproblem solver is just a wrapper around Eigen's routines.
-    StepCollection<EigenproblemEnvironment> steps {};
-    steps.add(DenseDiagonalization());
+    StepCollection<EigenproblemEnvironment<Scalar>> steps {};
+    steps.add(DenseDiagonalization<Scalar>());
 
-    return Algorithm<EigenproblemEnvironment>(steps);
+    return Algorithm<EigenproblemEnvironment<Scalar>>(steps);
 }
 
 // We should note that we cannot add the analogous Davidson solver here, because that would cause a cyclic dependence since one of the Davidson steps requires a dense diagonalization.
@@ -0,0 +1,104 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/LinearEquation/LinearEquationEnvironment.hpp"
+
+#include <cmath>
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that preconditions the current residuals with the diagonal of the matrix A and updates the search directions of the (preconditioned) conjugate gradient algorithm, for every column of the right-hand side simultaneously.
+ * 
+ *  @tparam _Scalar             the scalar type of the elements of the vectors and matrices
+ */
+template <typename _Scalar>
+class ConjugateGradientDirectionUpdate :
+    public Step<LinearEquationEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+
+
+private:
+    double threshold;  // the threshold below which a diagonal element is not used for preconditioning
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param threshold            the threshold below which a diagonal element is not used for preconditioning
+     */
+    ConjugateGradientDirectionUpdate(const double threshold = 1.0e-12) :
+        threshold (threshold)
+    {}
+
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate the preconditioned residuals z = M^{-1} r and the new search directions p = z + beta p, in which beta = (r z)_new / (r z)_old. In the first iteration, the search directions are the preconditioned residuals.
+     * 
+     *  @param environment              the environment that this step can read from and write to
+     */
+    void execute(LinearEquationEnvironment<Scalar>& environment) override {
+
+        const auto& R = environment.R;
+        const auto& diagonal = environment.diagonal;
+
+        // Precondition the residuals with the diagonal of A, if it is available
+        environment.Z = R;
+        if (diagonal.size() == R.rows()) {
+            for (size_t i = 0; i < static_cast<size_t>(R.rows()); i++) {
+                if (std::abs(diagonal(i)) > this->threshold) {
+                    environment.Z.row(i) /= diagonal(i);
+                }
+            }
+        }
+
+        const VectorX<Scalar> rz_new = R.cwiseProduct(environment.Z).colwise().sum().transpose();
+
+
+        // Update the search directions
+        if (environment.P.cols() != R.cols()) {  // the first iteration
+            environment.P = environment.Z;
+        } else {
+            for (size_t k = 0; k < static_cast<size_t>(R.cols()); k++) {
+                const Scalar beta = (environment.rz(k) != Scalar{0}) ? rz_new(k) / environment.rz(k) : Scalar{0};
+                environment.P.col(k) = environment.Z.col(k) + beta * environment.P.col(k);
+            }
+        }
+
+        environment.rz = rz_new;
+    }
+};
+
+
+}  // namespace GQCP
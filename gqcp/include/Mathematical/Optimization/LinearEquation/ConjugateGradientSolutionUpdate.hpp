@@ -0,0 +1,70 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/LinearEquation/LinearEquationEnvironment.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  A step that moves the solutions of the (preconditioned) conjugate gradient algorithm along the current search directions, for every column of the right-hand side simultaneously.
+ * 
+ *  @tparam _Scalar             the scalar type of the elements of the vectors and matrices
+ */
+template <typename _Scalar>
+class ConjugateGradientSolutionUpdate :
+    public Step<LinearEquationEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+
+
+public:
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate the step sizes alpha = (r z) / (p A p), and update the solutions x += alpha p and the residuals r -= alpha A p.
+     * 
+     *  @param environment              the environment that this step can read from and write to
+     * 
+     *  @note The products of A with the search directions of all columns are requested at once, so that they can be calculated as a block.
+     */
+    void execute(LinearEquationEnvironment<Scalar>& environment) override {
+
+        const auto& P = environment.P;
+        const MatrixX<Scalar> AP = environment.matrix_product_function(P);
+
+        for (size_t k = 0; k < static_cast<size_t>(P.cols()); k++) {
+            const Scalar pAp = P.col(k).dot(AP.col(k));
+            const Scalar alpha = (pAp != Scalar{0}) ? environment.rz(k) / pAp : Scalar{0};
+
+            environment.x.col(k) += alpha * P.col(k);
+            environment.R.col(k) -= alpha * AP.col(k);
+        }
+    }
+};
+
+
+}  // namespace GQCP
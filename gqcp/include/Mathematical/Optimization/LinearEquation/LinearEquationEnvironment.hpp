@@ -21,6 +21,8 @@
 #include "Mathematical/Optimization/OptimizationEnvironment.hpp"
 #include "Mathematical/Representation/Matrix.hpp"
 
+#include <functional>
+
 
 namespace GQCP {
 
@@ -34,6 +36,7 @@ template <typename _Scalar>
 class LinearEquationEnvironment {
 public:
     using Scalar = _Scalar;
+    using MatrixProductFunction = std::function<MatrixX<Scalar> (const MatrixX<Scalar>&)>;  // a function that returns the product of the matrix A with every column of the given matrix
 
 
 public:
@@ -42,6 +45,14 @@ public:
 
     MatrixX<Scalar> x;  // the matrix/vector of solutions
 
+    MatrixProductFunction matrix_product_function;  // the matrix-free representation of A, which is used by iterative solvers
+    VectorX<Scalar> diagonal;  // the diagonal of A, which is used as a preconditioner by iterative solvers
+
+    MatrixX<Scalar> R;  // the residuals b - A x
+    MatrixX<Scalar> Z;  // the preconditioned residuals
+    MatrixX<Scalar> P;  // the search directions
+    VectorX<Scalar> rz;  // the inner products of every residual with its preconditioned residual
+
 
 public:
 
@@ -57,6 +68,38 @@ public:
         A (A),
         b (b)
     {}
+
+    /**
+     *  @param matrix_product_function      a function that returns the product of the matrix A with every column of the given matrix
+     *  @param diagonal                     the diagonal of the matrix A
+     *  @param b                            the matrix/vector that corresponds to the right-hand side of the linear system of equations
+     * 
+     *  @note The initial guess for the solutions is zero, so the initial residuals are the right-hand sides themselves.
+     */
+    LinearEquationEnvironment(const MatrixProductFunction& matrix_product_function, const VectorX<Scalar>& diagonal, const MatrixX<Scalar>& b) :
+        b (b),
+        x (MatrixX<Scalar>::Zero(b.rows(), b.cols())),
+        matrix_product_function (matrix_product_function),
+        diagonal (diagonal),
+        R (b)
+    {}
+
+
+
+    /*
+     *  NAMED CONSTRUCTORS
+     */
+
+    /**
+     *  @param matrix_product_function      a function that returns the product of the matrix A with every column of the given matrix
+     *  @param diagonal                     the diagonal of the matrix A
+     *  @param b                            the matrix/vector that corresponds to the right-hand side of the linear system of equations
+     * 
+     *  @return an environment that can be used to solve the linear system of equations for the matrix that is represented by the given matrix product, without ever constructing it
+     */
+    static LinearEquationEnvironment<Scalar> Iterative(const MatrixProductFunction& matrix_product_function, const VectorX<Scalar>& diagonal, const MatrixX<Scalar>& b) {
+        return LinearEquationEnvironment<Scalar>(matrix_product_function, diagonal, b);
+    }
 };
 
 
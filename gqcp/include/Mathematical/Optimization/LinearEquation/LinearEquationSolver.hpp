@@ -19,7 +19,11 @@
 
 
 #include "Mathematical/Algorithm/Algorithm.hpp"
+#include "Mathematical/Algorithm/IterativeAlgorithm.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/ResidualVectorConvergence.hpp"
 #include "Mathematical/Optimization/LinearEquation/ColPivHouseholderQRSolution.hpp"
+#include "Mathematical/Optimization/LinearEquation/ConjugateGradientDirectionUpdate.hpp"
+#include "Mathematical/Optimization/LinearEquation/ConjugateGradientSolutionUpdate.hpp"
 #include "Mathematical/Optimization/LinearEquation/HouseholderQRSolution.hpp"
 #include "Mathematical/Optimization/LinearEquation/LinearEquationEnvironment.hpp"
 
@@ -68,6 +72,26 @@ public:
 
         return Algorithm<LinearEquationEnvironment<Scalar>>(householder_steps);
     }
+
+
+    /**
+     *  @param threshold                            the threshold on the norm of every residual vector that is used to check for convergence
+     *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+     * 
+     *  @return a linear equations solver that uses the conjugate gradient algorithm, preconditioned with the diagonal of the matrix
+     * 
+     *  @note This solver should be used with an iterative environment (see LinearEquationEnvironment::Iterative()) for a symmetric positive definite matrix. All columns of the right-hand side are solved for simultaneously.
+     */
+    static IterativeAlgorithm<LinearEquationEnvironment<Scalar>> ConjugateGradient(const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128) {
+
+        StepCollection<LinearEquationEnvironment<Scalar>> conjugate_gradient_steps {};
+        conjugate_gradient_steps.add(ConjugateGradientDirectionUpdate<Scalar>());
+        conjugate_gradient_steps.add(ConjugateGradientSolutionUpdate<Scalar>());
+
+        const ResidualVectorConvergence<LinearEquationEnvironment<Scalar>> convergence_criterion (threshold);
+
+        return IterativeAlgorithm<LinearEquationEnvironment<Scalar>>(conjugate_gradient_steps, convergence_criterion, maximum_number_of_iterations);
+    }
 };
 
 
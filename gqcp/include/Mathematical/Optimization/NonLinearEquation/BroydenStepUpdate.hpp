@@ -0,0 +1,104 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/NonLinearEquation/NonLinearEquationEnvironment.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
+
+#include <Eigen/Dense>
+
+#include <type_traits>
+
+
+namespace GQCP {
+namespace NonLinearEquation {
+
+
+/**
+ *  An iteration step that produces updated variables according to a quasi-Newton step with Broyden's ('good') update of the inverse Jacobian.
+ * 
+ *  The environment's Jacobian is only evaluated (and inverted) once, at the first iterate. In the following iterations, the inverse Jacobian is updated with the Sherman-Morrison formula, so that every iteration costs only one evaluation of the vector function and O(n^2) operations.
+ * 
+ *  @tparam _Scalar             the scalar type that is used to represent the variables of the system of equations
+ *  @tparam _Environment        the type of the calculation environment
+ */
+template <typename _Scalar, typename _Environment>
+class BroydenStepUpdate :
+    public Step<_Environment> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = _Environment;
+    static_assert(std::is_same<Scalar, typename Environment::Scalar>::value, "The scalar type must match that of the environment");
+    static_assert(std::is_base_of<NonLinearEquationEnvironment<Scalar>, Environment>::value, "The environment type must derive from NonLinearEquationEnvironment.");
+
+
+private:
+    SquareMatrix<Scalar> J_inverse;  // the current approximation to the inverse Jacobian
+    VectorX<Scalar> f_previous;  // the value of the vector function at the previous iterate
+
+
+public:
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate a new iteration of the variables and add them to the environment.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        const auto& x = environment.variables.back();
+        const VectorX<Scalar> f_vector = environment.f(x);
+
+
+        if (environment.variables.size() == 1) {  // this is the start of a new solve: (re-)initialize the inverse Jacobian
+            using MatrixType = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+            const MatrixType J_matrix = environment.J(x);
+            this->J_inverse = SquareMatrix<Scalar>(Eigen::ColPivHouseholderQR<MatrixType>(J_matrix).inverse());
+        }
+
+        else {  // update the inverse Jacobian using the previous step
+            const auto& x_previous = *(environment.variables.end() - 2);
+
+            const VectorX<Scalar> dx = x - x_previous;
+            const VectorX<Scalar> df = f_vector - this->f_previous;
+
+            const VectorX<Scalar> J_inverse_df = this->J_inverse * df;
+            const double denominator = dx.dot(J_inverse_df);
+
+            if (std::abs(denominator) > 1.0e-14) {  // otherwise, skip the update to avoid a breakdown
+                const VectorX<Scalar> dx_J_inverse = this->J_inverse.transpose() * dx;
+                this->J_inverse += (dx - J_inverse_df) * dx_J_inverse.transpose() / denominator;
+            }
+        }
+
+
+        this->f_previous = f_vector;
+        environment.variables.push_back(x - this->J_inverse * f_vector);
+    }
+};
+
+
+}  // namespace NonLinearEquation
+}  // namespace GQCP
@@ -0,0 +1,165 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "Mathematical/Optimization/NonLinearEquation/NonLinearEquationEnvironment.hpp"
+#include "Mathematical/Representation/Matrix.hpp"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+namespace GQCP {
+namespace NonLinearEquation {
+
+
+/**
+ *  An iteration step that produces updated variables according to a Jacobian-free Newton-Krylov step: the Newton equations [J dx = - f] are solved approximately with GMRES, in which the action of the Jacobian on a vector is approximated by a finite difference of the vector function.
+ * 
+ *  Since the Jacobian is never constructed, the environment's Jacobian function is not used by this step.
+ * 
+ *  @tparam _Scalar             the scalar type that is used to represent the variables of the system of equations
+ *  @tparam _Environment        the type of the calculation environment
+ */
+template <typename _Scalar, typename _Environment>
+class NewtonKrylovStepUpdate :
+    public Step<_Environment> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = _Environment;
+    static_assert(std::is_same<Scalar, typename Environment::Scalar>::value, "The scalar type must match that of the environment");
+    static_assert(std::is_base_of<NonLinearEquationEnvironment<Scalar>, Environment>::value, "The environment type must derive from NonLinearEquationEnvironment.");
+
+
+private:
+    double krylov_threshold;  // the threshold on the norm of the Newton equations' residual, relative to the norm of the vector function, that determines when the GMRES iterations may stop
+    size_t maximum_krylov_dimension;  // the maximum dimension of the Krylov subspace that GMRES may build
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param krylov_threshold                 the threshold on the norm of the Newton equations' residual, relative to the norm of the vector function, that determines when the GMRES iterations may stop
+     *  @param maximum_krylov_dimension         the maximum dimension of the Krylov subspace that GMRES may build
+     */
+    NewtonKrylovStepUpdate(const double krylov_threshold = 1.0e-04, const size_t maximum_krylov_dimension = 64) :
+        krylov_threshold (krylov_threshold),
+        maximum_krylov_dimension (maximum_krylov_dimension)
+    {}
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Calculate a new iteration of the variables and add them to the environment.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        const auto& x = environment.variables.back();
+        const auto& f = environment.f;
+
+        const VectorX<Scalar> f_vector = f(x);
+        const double f_norm = f_vector.norm();
+        if (f_norm < std::numeric_limits<double>::min()) {  // x is already an exact solution
+            environment.variables.push_back(x);
+            return;
+        }
+
+
+        // The action of the Jacobian on a (normalized) vector v is approximated by a forward difference of f along v.
+        const double epsilon = std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + x.norm());
+        const auto J_product = [&f, &x, &f_vector, epsilon] (const VectorX<Scalar>& v) {
+            return VectorX<Scalar>((f(x + epsilon * v) - f_vector) / epsilon);
+        };
+
+
+        // Solve [J dx = -f] with GMRES, starting from dx = 0, so that the initial residual is -f.
+        const size_t dim = x.size();
+        const size_t m_max = std::min(this->maximum_krylov_dimension, dim);
+
+        MatrixX<Scalar> V = MatrixX<Scalar>::Zero(dim, m_max + 1);  // the orthonormal Krylov basis vectors, as columns
+        MatrixX<Scalar> H = MatrixX<Scalar>::Zero(m_max + 1, m_max);  // the upper Hessenberg matrix from the Arnoldi process
+        VectorX<Scalar> cs = VectorX<Scalar>::Zero(m_max);  // the cosines of the Givens rotations
+        VectorX<Scalar> sn = VectorX<Scalar>::Zero(m_max);  // the sines of the Givens rotations
+        VectorX<Scalar> beta = VectorX<Scalar>::Zero(m_max + 1);  // the rotated right-hand side of the least-squares problem
+
+        V.col(0) = -f_vector / f_norm;
+        beta(0) = f_norm;
+
+        size_t m = 0;  // the current dimension of the Krylov subspace
+        while (m < m_max) {
+
+            // Arnoldi: expand the Krylov subspace with a modified Gram-Schmidt orthonormalization.
+            VectorX<Scalar> w = J_product(V.col(m));
+            for (size_t i = 0; i <= m; i++) {
+                H(i,m) = V.col(i).dot(w);
+                w -= H(i,m) * V.col(i);
+            }
+            H(m+1,m) = w.norm();
+            if (H(m+1,m) > std::numeric_limits<double>::min()) {
+                V.col(m+1) = w / H(m+1,m);
+            }
+
+            // Apply the previous Givens rotations to the new column, and construct a new one that eliminates H(m+1,m).
+            for (size_t i = 0; i < m; i++) {
+                const Scalar temp = cs(i) * H(i,m) + sn(i) * H(i+1,m);
+                H(i+1,m) = -sn(i) * H(i,m) + cs(i) * H(i+1,m);
+                H(i,m) = temp;
+            }
+
+            const double r = std::sqrt(std::pow(H(m,m), 2) + std::pow(H(m+1,m), 2));
+            cs(m) = H(m,m) / r;
+            sn(m) = H(m+1,m) / r;
+            H(m,m) = r;
+            H(m+1,m) = 0.0;
+
+            beta(m+1) = -sn(m) * beta(m);
+            beta(m) = cs(m) * beta(m);
+
+            m++;
+
+            // The absolute value of the last element of the rotated right-hand side is the norm of the current residual.
+            if ((std::abs(beta(m)) <= this->krylov_threshold * f_norm) || (V.col(m).isZero())) {
+                break;
+            }
+        }
+
+
+        // Solve the upper triangular least-squares problem and construct the Newton step in the Krylov subspace.
+        const VectorX<Scalar> y = H.topLeftCorner(m, m).template triangularView<Eigen::Upper>().solve(beta.head(m));
+        const VectorX<Scalar> dx = V.leftCols(m) * y;
+
+        environment.variables.push_back(x + dx);
+    }
+};
+
+
+}  // namespace NonLinearEquation
+}  // namespace GQCP
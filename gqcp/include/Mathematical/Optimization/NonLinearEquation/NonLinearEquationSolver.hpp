@@ -21,6 +21,8 @@
 #include "Mathematical/Algorithm/IterativeAlgorithm.hpp"
 #include "Mathematical/Optimization/ConsecutiveIteratesNormConvergence.hpp"
 #include "Mathematical/Optimization/OptimizationEnvironment.hpp"
+#include "Mathematical/Optimization/NonLinearEquation/BroydenStepUpdate.hpp"
+#include "Mathematical/Optimization/NonLinearEquation/NewtonKrylovStepUpdate.hpp"
 #include "Mathematical/Optimization/NonLinearEquation/NewtonStepUpdate.hpp"
 #include "Mathematical/Optimization/NonLinearEquation/NonLinearEquationEnvironment.hpp"
 
@@ -66,6 +68,46 @@ public:
 
         return IterativeAlgorithm<NonLinearEquationEnvironment<Scalar>>(newton_cycle, convergence_criterion, maximum_number_of_iterations);
     }
+
+
+    /**
+     *  @param threshold                            the threshold that is used in comparing the iterates
+     *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+     *  @param krylov_threshold                     the threshold on the norm of the Newton equations' residual, relative to the norm of the vector function, that determines when the inner GMRES iterations may stop
+     *  @param maximum_krylov_dimension             the maximum dimension of the Krylov subspace that the inner GMRES iterations may build
+     * 
+     *  @return a Jacobian-free Newton-Krylov non-linear system of equations solver that uses the norm of the difference of two consecutive iterations of variables as a convergence criterion. The environment's Jacobian is never evaluated.
+     */
+    static IterativeAlgorithm<NonLinearEquationEnvironment<Scalar>> NewtonKrylov(const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128, const double krylov_threshold = 1.0e-04, const size_t maximum_krylov_dimension = 64) {
+
+        // Create the iteration cycle that effectively 'defines' a Newton-Krylov system of equations solver
+        StepCollection<NonLinearEquationEnvironment<Scalar>> newton_krylov_cycle {};
+        newton_krylov_cycle.add(GQCP::NonLinearEquation::NewtonKrylovStepUpdate<Scalar, NonLinearEquationEnvironment<Scalar>>(krylov_threshold, maximum_krylov_dimension));
+
+        // Create a convergence criterion on the norm of subsequent iterations of variables
+        const ConsecutiveIteratesNormConvergence<VectorX<Scalar>, NonLinearEquationEnvironment<Scalar>> convergence_criterion (threshold);
+
+        return IterativeAlgorithm<NonLinearEquationEnvironment<Scalar>>(newton_krylov_cycle, convergence_criterion, maximum_number_of_iterations);
+    }
+
+
+    /**
+     *  @param threshold                            the threshold that is used in comparing the iterates
+     *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+     * 
+     *  @return a quasi-Newton non-linear system of equations solver that uses Broyden's update of the inverse Jacobian, and the norm of the difference of two consecutive iterations of variables as a convergence criterion. The environment's Jacobian is only evaluated at the initial guess.
+     */
+    static IterativeAlgorithm<NonLinearEquationEnvironment<Scalar>> Broyden(const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128) {
+
+        // Create the iteration cycle that effectively 'defines' a Broyden system of equations solver
+        StepCollection<NonLinearEquationEnvironment<Scalar>> broyden_cycle {};
+        broyden_cycle.add(GQCP::NonLinearEquation::BroydenStepUpdate<Scalar, NonLinearEquationEnvironment<Scalar>>());
+
+        // Create a convergence criterion on the norm of subsequent iterations of variables
+        const ConsecutiveIteratesNormConvergence<VectorX<Scalar>, NonLinearEquationEnvironment<Scalar>> convergence_criterion (threshold);
+
+        return IterativeAlgorithm<NonLinearEquationEnvironment<Scalar>>(broyden_cycle, convergence_criterion, maximum_number_of_iterations);
+    }
 };
 
 
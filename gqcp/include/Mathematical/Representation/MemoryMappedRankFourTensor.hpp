@@ -0,0 +1,196 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
+#include "Mathematical/Representation/SquareRankFourTensor.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
+
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A real, square rank-four tensor g(p,q,r,s) with the symmetries of two-electron integrals in chemist's notation, whose elements are stored in a memory-mapped file rather than in RAM, so that its size is limited by the available disk space instead of the available memory.
+ * 
+ *  The elements are stored as a pair-packed 'supermatrix' M(PQ,RS) in row-major order, in which the compound indices PQ (p>=q) and RS (r>=s) are given by pairIndex(). Since this packing uses the symmetries g(p,q,r,s) = g(q,p,r,s) = g(p,q,s,r), only the elements with p>=q and r>=s are stored, which reduces the storage by about a factor of four. The full row of pairs RS for a pair PQ is contiguous in the file, so that algorithms that stream over the rows only touch every page once.
+ * 
+ *  Two-electron integrals that don't fit in memory can be written straight into the file by IntegralCalculator::calculateLibintIntegrals(const CoulombRepulsionOperator&, const ScalarBasis<GTOShell>&, const std::string&), and an RHF SCF calculation can use them through RHFSCFEnvironment::WithCoreGuess().
+ * 
+ *  @note The mapped file starts with a header of one page, which contains the dimension of the tensor, so that a stored tensor can be opened again later on.
+ */
+class MemoryMappedRankFourTensor {
+private:
+    size_t K;  // the dimension of every axis of the tensor
+    MemoryMappedFile file;  // the memory-mapped file that contains the elements
+
+
+private:
+    // PRIVATE CONSTRUCTORS
+
+    /**
+     *  @param K            the dimension of every axis of the tensor
+     *  @param file         the memory-mapped file that contains the elements
+     */
+    MemoryMappedRankFourTensor(const size_t K, MemoryMappedFile&& file);
+
+
+public:
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  Create a new memory-mapped rank-four tensor whose elements are all zero.
+     * 
+     *  @param filename         the name of the file that should contain the elements
+     *  @param K                the dimension of every axis of the tensor
+     */
+    static MemoryMappedRankFourTensor Create(const std::string& filename, const size_t K);
+
+    /**
+     *  Create a new memory-mapped rank-four tensor from a tensor in memory.
+     * 
+     *  @param filename         the name of the file that should contain the elements
+     *  @param g                the tensor whose elements should be stored
+     */
+    static MemoryMappedRankFourTensor FromTensor(const std::string& filename, const SquareRankFourTensor<double>& g);
+
+    /**
+     *  Open a memory-mapped rank-four tensor that was previously stored.
+     * 
+     *  @param filename         the name of the file that contains the elements
+     *  @param is_read_only     if the elements may not be changed
+     */
+    static MemoryMappedRankFourTensor Open(const std::string& filename, const bool is_read_only = true);
+
+
+    // OPERATORS
+
+    /**
+     *  @return a read-only reference to the element g(p,q,r,s)
+     */
+    const double& operator()(const size_t p, const size_t q, const size_t r, const size_t s) const { return this->elements()[this->numberOfPairs() * pairIndex(p, q) + pairIndex(r, s)]; }
+
+    /**
+     *  @return a writable reference to the element g(p,q,r,s), which is shared by all elements that are related to it through the symmetries of the tensor
+     */
+    double& operator()(const size_t p, const size_t q, const size_t r, const size_t s);
+
+
+    // STATIC PUBLIC METHODS
+
+    /**
+     *  @param p            the first index
+     *  @param q            the second index
+     * 
+     *  @return the compound index of the pair (p,q), which is equal to the compound index of the pair (q,p)
+     */
+    static size_t pairIndex(const size_t p, const size_t q) { return (p >= q) ? (p * (p + 1) / 2 + q) : (q * (q + 1) / 2 + p); }
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+     */
+    SquareMatrix<double> calculateCoulombMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+     */
+    SquareMatrix<double> calculateExchangeMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @param d                a rank-four tensor, e.g. a 2-DM
+     * 
+     *  @return the full contraction sum_{p,q,r,s} g(p,q,r,s) d(p,q,r,s)
+     */
+    double contract(const SquareRankFourTensor<double>& d) const;
+
+    /**
+     *  @return the dimension of every axis of this tensor
+     */
+    size_t dimension() const { return this->K; }
+
+    /**
+     *  @return the name of the file that contains the elements
+     */
+    const std::string& filename() const { return this->file.filename(); }
+
+    /**
+     *  Write the changes to the elements back to the file.
+     */
+    void flush() { this->file.flush(); }
+
+    /**
+     *  @return if the elements may be changed
+     */
+    bool isReadOnly() const { return !this->file.isWritable(); }
+
+    /**
+     *  @return the number of compound indices PQ, i.e. the number of rows (and columns) of the stored supermatrix
+     */
+    size_t numberOfPairs() const { return this->K * (this->K + 1) / 2; }
+
+    /**
+     *  @param PQ               a compound index
+     * 
+     *  @return a pointer to the contiguous row of the elements M(PQ,RS)
+     */
+    const double* pairRow(const size_t PQ) const { return this->elements() + this->numberOfPairs() * PQ; }
+
+    /**
+     *  @return this tensor as a (full) tensor in memory
+     */
+    SquareRankFourTensor<double> toTensor() const;
+
+    /**
+     *  Transform this tensor to another basis, without ever keeping the full tensor in memory.
+     * 
+     *  @param filename                         the name of the file that should contain the transformed elements
+     *  @param C                                the coefficient matrix, whose columns are the expansion coefficients of the new basis functions in terms of the current ones; it may have fewer columns than rows (e.g. for an active space)
+     *  @param maximum_tile_size_in_MB          the maximum size of the in-memory buffer that is used during the second half of the transformation
+     * 
+     *  @return the transformed tensor g'(i,j,k,l) = sum_{p,q,r,s} C(p,i) C(q,j) C(r,k) C(s,l) g(p,q,r,s)
+     */
+    MemoryMappedRankFourTensor transformed(const std::string& filename, const MatrixX<double>& C, const size_t maximum_tile_size_in_MB = 256) const;
+
+
+private:
+    // PRIVATE METHODS
+
+    /**
+     *  @return a pointer to the first stored element
+     */
+    double* elements();
+
+    /**
+     *  @return a pointer to the first stored element
+     */
+    const double* elements() const;
+};
+
+
+}  // namespace GQCP
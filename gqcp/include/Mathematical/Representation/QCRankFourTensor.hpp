@@ -21,6 +21,7 @@
 #include "Basis/TransformationMatrix.hpp"
 #include "Mathematical/Representation/SquareRankFourTensor.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 
@@ -69,44 +70,63 @@ public:
      *  In-place transform this quantum chemical rank-4 tensor according to a given basis transformation.
      *
      *  @param T    the transformation matrix between the old and the new orbital basis
+     * 
+     *  @note The transformed elements are written into the existing storage, so that views on the data of this tensor (like the numpy arrays that gqcpy hands out) remain valid.
      */
     void basisTransformInPlace(const TransformationMatrix<Scalar>& T) {
+        const Self transformed = this->transformed(T);
+        std::copy(transformed.data(), transformed.data() + transformed.size(), this->data());
+    }
 
-        // Since we're only getting T as a matrix, we should convert it to an appropriate tensor to perform contractions.
-        Eigen::TensorMap<Eigen::Tensor<const Scalar, 2>> T_tensor (T.data(), T.rows(), T.cols());  // since T is const, we need const in the template (https://stackoverflow.com/questions/45283468/eigen-const-tensormap)
 
+    /**
+     *  @param C    the coefficient matrix, whose columns are the expansion coefficients of the new orbitals in terms of the current ones; it may have fewer columns than rows (e.g. to only transform to an active space)
+     *
+     *  @return this quantum chemical rank-4 tensor expressed in the new orbitals, i.e. g'(P Q R S) = sum_{p q r s} C^*(p P) C(q Q) C^*(r R) C(s S) g(p q r s)
+     *
+     *  @note The transformation is done one index at a time, which scales as O(K^5) instead of the O(K^8) of a naive transformation. Every quarter-transformation is a (batch of) matrix-matrix product(s) on a reshaped view of the column-major tensor data, so that the heavy lifting is done by the BLAS library that Eigen is linked against.
+     */
+    Self transformed(const MatrixX<Scalar>& C) const {
 
-        // We will have to do four single contractions, so we'll have to specify the contraction indices.
-        // Eigen3 does not document its tensor contraction clearly, so see the accepted answer on stackoverflow (https://stackoverflow.com/a/47558349/7930415):
-        //      Eigen3 does not accept a way to specify the output axes: instead, it retains the order from left to right of the axes that survive the contraction.
-        //      This means that, in order to get the right ordering of the axes, we will have to swap axes
+        const auto K = this->dimension();
+        if (static_cast<size_t>(C.rows()) != K) {
+            throw std::invalid_argument("QCRankFourTensor::transformed(const MatrixX<Scalar>&): The number of rows of the given coefficient matrix should match the dimension of this tensor.");
+        }
+        const size_t K_new = C.cols();
+
+        using EigenMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+        using MatrixMap = Eigen::Map<EigenMatrix>;
+        using ConstMatrixMap = Eigen::Map<const EigenMatrix>;
 
-        // g(T U V W)  T^*(V R) -> a(T U R W) but we get a(T U W R)
-        Eigen::array<Eigen::IndexPair<int>, 1> contraction_pair1 = {Eigen::IndexPair<int>(2, 0)};
-        Eigen::array<int, 4> shuffle_1 {0, 1, 3, 2};
+        const EigenMatrix C_conjugate = C.conjugate();
 
-        // a(T U R W)  T(W S) -> b(T U R S) and we get b(T U R S), so no shuffle is needed
-        Eigen::array<Eigen::IndexPair<int>, 1> contraction_pair2 = {Eigen::IndexPair<int>(3, 0)};
 
-        // T(U Q)  b(T U R S) -> c(T Q R S) but we get c(Q T R S)
-        Eigen::array<Eigen::IndexPair<int>, 1> contraction_pair3 = {Eigen::IndexPair<int>(0, 1)};
-        Eigen::array<int, 4> shuffle_3 {1, 0, 2, 3};
+        // The tensor's elements g(p q r s) are stored in column-major order, so the tensor can be viewed as a K x K^3 matrix [p, (q r s)]
+        // 1. a(P q r s) = sum_p C^*(p P) g(p q r s)
+        EigenMatrix a (K_new, K * K * K);
+        a.noalias() = C.adjoint() * ConstMatrixMap(this->data(), K, K * K * K);
 
-        // T^*(T P)  c(T Q R S) -> g'(P Q R S) and we get g_SO(P Q R S), so no shuffle is needed
-        Eigen::array<Eigen::IndexPair<int>, 1> contraction_pair4 = {Eigen::IndexPair<int>(0, 0)};
+        // 2. b(P Q r s) = sum_q a(P q r s) C(q Q), which is a matrix-matrix product for every contiguous block (r s)
+        EigenMatrix b (K_new * K_new, K * K);
+        #pragma omp parallel for schedule(static)
+        for (size_t rs = 0; rs < K * K; rs++) {
+            MatrixMap(b.col(rs).data(), K_new, K_new).noalias() = ConstMatrixMap(a.data() + K_new * K * rs, K_new, K) * C;
+        }
+        a.resize(0, 0);  // release the memory of this intermediate
+
+        // 3. c(P Q R s) = sum_r b(P Q r s) C^*(r R), which is a matrix-matrix product for every contiguous block (s)
+        EigenMatrix c (K_new * K_new * K_new, K);
+        #pragma omp parallel for schedule(static)
+        for (size_t s = 0; s < K; s++) {
+            MatrixMap(c.col(s).data(), K_new * K_new, K_new).noalias() = ConstMatrixMap(b.data() + K_new * K_new * K * s, K_new * K_new, K) * C_conjugate;
+        }
+        b.resize(0, 0);
 
+        // 4. g'(P Q R S) = sum_s c(P Q R s) C(s S), viewing c as a K_new^3 x K matrix
+        Self g_transformed (K_new);
+        MatrixMap(g_transformed.data(), K_new * K_new * K_new, K_new).noalias() = c * C;
 
-        // Calculate the contractions. We write this as one chain of contractions to
-        //      1) avoid storing intermediate contractions;
-        //      2) let Eigen figure out some optimizations.
-        Self g_transformed = T_tensor.conjugate().contract(
-                T_tensor.contract(
-                    this->contract(T_tensor.conjugate(), contraction_pair1).shuffle(shuffle_1)  // the 'inner' contraction, the first one
-                    .contract(T_tensor, contraction_pair2),
-                contraction_pair3).shuffle(shuffle_3),
-            contraction_pair4
-        );
-        (*this) = g_transformed;
+        return g_transformed;
     }
 
 
@@ -24,6 +24,7 @@
 
 #include <boost/numeric/conversion/converter.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 
@@ -341,6 +342,77 @@ public:
     }
 
 
+    /**
+     *  @return the permanent of the given square matrix using Glynn's formula, in which the sign vectors are traversed in Gray code order
+     *
+     *  @note Since successive sign vectors only differ in one sign, the column sums can be updated in O(n), which leads to an overall scaling of O(2^n n) instead of the O(2^n n^2) of the Ryser algorithm. For larger dimensions, the range of Gray codes is split into chunks that are evaluated in parallel.
+     *
+     *  Note that this algorithm does not work for dimensions larger than 64, since the Gray codes are represented by a size_t.
+     */
+    double permanent_glynn() const {
+
+        const size_t n = this->get_dim();
+        if (n == 0) {
+            return 1.0;
+        }
+
+        if (n > 64) {
+            throw std::invalid_argument("SquareMatrix::permanent_glynn(): This algorithm does not work for dimensions larger than 64.");
+        }
+
+
+        // The first sign is always fixed to +1, so we have to go over 2^(n-1) sign vectors. The sign of row i (i>0) is encoded in bit (i-1) of the Gray code: a set bit corresponds to a sign of -1
+        const size_t number_of_sign_vectors = static_cast<size_t>(1) << (n - 1);
+        const size_t number_of_chunks = (n < 12) ? 1 : std::min<size_t>(number_of_sign_vectors, 256);
+        const size_t chunk_size = (number_of_sign_vectors + number_of_chunks - 1) / number_of_chunks;
+
+        double value = 0.0;  // value of the permanent (up to the prefactor 1/2^(n-1))
+        #pragma omp parallel for reduction(+:value) schedule(static) if(number_of_chunks > 1)
+        for (size_t chunk = 0; chunk < number_of_chunks; chunk++) {
+
+            const size_t start = chunk * chunk_size;
+            const size_t end = std::min(start + chunk_size, number_of_sign_vectors);
+            if (start >= end) {
+                continue;
+            }
+
+
+            // Initialize the column sums for the first sign vector in this chunk
+            size_t gray_code_value = gray_code(start);
+            VectorX<double> column_sums = this->row(0).transpose();
+            for (size_t i = 1; i < n; i++) {
+                if ((gray_code_value >> (i-1)) & 1) {
+                    column_sums -= this->row(i).transpose();
+                } else {
+                    column_sums += this->row(i).transpose();
+                }
+            }
+            double sign = (__builtin_popcountll(gray_code_value) % 2 == 0) ? 1.0 : -1.0;  // the product of all the signs
+            double partial_value = sign * column_sums.prod();
+
+
+            // Successive Gray codes differ in exactly one bit, which is given by the number of trailing zeros of S
+            for (size_t S = start + 1; S < end; S++) {
+                const size_t k = __builtin_ctzll(S);
+                gray_code_value ^= static_cast<size_t>(1) << k;
+
+                if ((gray_code_value >> k) & 1) {  // the sign of row k+1 has flipped from +1 to -1
+                    column_sums -= 2 * this->row(k+1).transpose();
+                } else {
+                    column_sums += 2 * this->row(k+1).transpose();
+                }
+
+                sign = -sign;
+                partial_value += sign * column_sums.prod();
+            }
+
+            value += partial_value;
+        }
+
+        return value / static_cast<double>(number_of_sign_vectors);
+    }
+
+
     /**
      *  @return a non-pivoted LU decomposition in an array, with L at position 0 and U on position 1 of the array.
      *   Warning: pivoting is required to ensure that the decomposition is stable. Eigen3 provides partial and full pivot modules
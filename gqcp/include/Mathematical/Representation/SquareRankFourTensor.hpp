@@ -22,6 +22,7 @@
 #include "Mathematical/Representation/Tensor.hpp"
 
 #include <iostream>
+#include <utility>
 
 
 namespace GQCP {
@@ -79,6 +80,22 @@ public:
     }
 
 
+    /**
+     *  A constructor that takes over the storage of a rank-4 GQCP::Tensor and checks if the given tensor is square
+     *
+     *  @param tensor       the tensor that should be square, which is left empty
+     */
+    SquareRankFourTensor(Base&& tensor) :
+        Base(std::move(tensor))
+    {
+        // Check if the given tensor is square
+        auto dims = this->dimensions();
+        if ((dims[0] != dims[1]) || (dims[1] != dims[2]) || (dims[2] != dims[3]) ) {
+            throw std::invalid_argument("SquareRankFourTensor(Base&&): The given tensor should have equal dimensions in every rank.");
+        }
+    }
+
+
     /**
      *  Constructor from Eigen::Tensor expressions
      *
@@ -0,0 +1,173 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
+#include "Mathematical/Representation/SquareRankFourTensor.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A real, square rank-four tensor g(p,q,r,s) with the 8-fold permutational symmetry of two-electron integrals over real orbitals in chemist's notation, i.e.
+ *      g(p,q,r,s) = g(q,p,r,s) = g(p,q,s,r) = g(q,p,s,r) = g(r,s,p,q) = g(s,r,p,q) = g(r,s,q,p) = g(s,r,q,p),
+ *  of which only the symmetry-unique elements are stored, which takes about K^4/8 elements instead of K^4.
+ * 
+ *  The unique elements are those with p>=q, r>=s and PQ>=RS, in which PQ and RS are the compound pair indices that are given by pairIndex(). They are stored as the lower triangle of the pair 'supermatrix' M(PQ,RS) in row-major order, so that all elements g(p,q,r,s) with RS<=PQ are contiguous for a given pair (p,q).
+ */
+class SymmetryPackedRankFourTensor {
+private:
+    size_t K;  // the dimension of every axis of the tensor
+    std::vector<double> elements;  // the symmetry-unique elements
+
+
+public:
+    // CONSTRUCTORS
+
+    /**
+     *  Construct a symmetry-packed rank-four tensor whose elements are all zero.
+     * 
+     *  @param K            the dimension of every axis of the tensor
+     */
+    SymmetryPackedRankFourTensor(const size_t K);
+
+
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  @param g            a tensor that has the 8-fold permutational symmetry of two-electron integrals over real orbitals
+     * 
+     *  @return the symmetry-packed representation of the given tensor
+     */
+    static SymmetryPackedRankFourTensor FromTensor(const SquareRankFourTensor<double>& g);
+
+    /**
+     *  Read the two-electron integrals from a FCIDUMP file, storing every value only once.
+     * 
+     *  @param fcidump_file         the name of the FCIDUMP file
+     * 
+     *  @return the symmetry-packed two-electron integrals in the FCIDUMP file
+     * 
+     *  @note The one-electron integrals, orbital energies and internuclear repulsion energy in the file are skipped.
+     */
+    static SymmetryPackedRankFourTensor ReadFCIDUMP(const std::string& fcidump_file);
+
+
+    // OPERATORS
+
+    /**
+     *  @return a read-only reference to the element g(p,q,r,s)
+     */
+    const double& operator()(const size_t p, const size_t q, const size_t r, const size_t s) const { return this->elements[compoundIndex(p, q, r, s)]; }
+
+    /**
+     *  @return a writable reference to the element g(p,q,r,s), which is shared by all elements that are related to it through the symmetries of the tensor
+     */
+    double& operator()(const size_t p, const size_t q, const size_t r, const size_t s) { return this->elements[compoundIndex(p, q, r, s)]; }
+
+
+    // STATIC PUBLIC METHODS
+
+    /**
+     *  @param p            the first index
+     *  @param q            the second index
+     * 
+     *  @return the compound index of the pair (p,q), which is equal to the compound index of the pair (q,p)
+     */
+    static size_t pairIndex(const size_t p, const size_t q) { return (p >= q) ? (p * (p + 1) / 2 + q) : (q * (q + 1) / 2 + p); }
+
+    /**
+     *  @return the position of the element g(p,q,r,s) in the packed storage
+     */
+    static size_t compoundIndex(const size_t p, const size_t q, const size_t r, const size_t s) { return pairIndex(pairIndex(p, q), pairIndex(r, s)); }
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+     */
+    SquareMatrix<double> calculateCoulombMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+     */
+    SquareMatrix<double> calculateExchangeMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @return the Coulomb integrals J(p,q) = g(p,p,q,q), which are needed to evaluate diagonal matrix elements of the Hamiltonian
+     */
+    SquareMatrix<double> coulombIntegrals() const;
+
+    /**
+     *  @return a pointer to the symmetry-unique elements
+     */
+    const double* data() const { return this->elements.data(); }
+
+    /**
+     *  @return a writable pointer to the symmetry-unique elements
+     */
+    double* data() { return this->elements.data(); }
+
+    /**
+     *  @return the dimension of every axis of this tensor
+     */
+    size_t dimension() const { return this->K; }
+
+    /**
+     *  @return the exchange integrals K(p,q) = g(p,q,q,p), which are needed to evaluate diagonal matrix elements of the Hamiltonian
+     */
+    SquareMatrix<double> exchangeIntegrals() const;
+
+    /**
+     *  @return the number of compound pair indices PQ
+     */
+    size_t numberOfPairs() const { return this->K * (this->K + 1) / 2; }
+
+    /**
+     *  @return the number of stored (i.e. symmetry-unique) elements
+     */
+    size_t size() const { return this->elements.size(); }
+
+    /**
+     *  @return this tensor as a (full) rank-four tensor
+     */
+    SquareRankFourTensor<double> toTensor() const;
+
+    /**
+     *  @param C                the coefficient matrix, whose columns are the expansion coefficients of the new basis functions in terms of the current ones; it may have fewer columns than rows (e.g. for an active space)
+     * 
+     *  @return the transformed tensor g'(i,j,k,l) = sum_{p,q,r,s} C(p,i) C(q,j) C(r,k) C(s,l) g(p,q,r,s)
+     * 
+     *  @note The intermediate half-transformed supermatrix H(PQ,KL) is kept in memory, which requires about twice the memory of this tensor when the basis isn't truncated.
+     */
+    SymmetryPackedRankFourTensor transformed(const MatrixX<double>& C) const;
+};
+
+
+}  // namespace GQCP
@@ -73,6 +73,15 @@ public:
     using BaseFrozenCoreONVBasis::evaluateOperatorDiagonal;
 
 
+    // PUBLIC METHODS
+    /**
+     *  @param address          the address (i.e. the ordening number) of a spin-resolved ONV in this ONV basis
+     *
+     *  @return the spin-resolved ONV with the corresponding address, in which the frozen orbitals are occupied
+     */
+    SpinResolvedONV makeONV(const size_t address) const;
+
+
     // UNRESTRICTED
     /**
      *  Evaluate the Hamiltonian in a dense matrix
@@ -18,6 +18,8 @@
 #pragma once
 
 
+#include "Mathematical/Representation/SquareMatrix.hpp"
+#include "Mathematical/Representation/SquareRankFourTensor.hpp"
 #include "ONVBasis/SpinUnresolvedONV.hpp"
 
 
@@ -61,6 +63,15 @@ public:
      *  @return the ONV that descripes the occupations of the beta spinors
      */
     const SpinUnresolvedONV& betaONV() const { return this->onv_beta; }
+
+    /**
+     *  @param h                the one-electron integrals, expressed in an orthonormal orbital basis
+     *  @param g                the two-electron integrals (in chemist's notation), expressed in the same orthonormal orbital basis
+     *  @param other            another spin-resolved ONV
+     *
+     *  @return the matrix element <this|H|other> of the spin-restricted Hamiltonian with the given integrals, calculated with the Slater-Condon rules
+     */
+    double calculateMatrixElement(const SquareMatrix<double>& h, const SquareRankFourTensor<double>& g, const SpinResolvedONV& other) const;
 };
 
 
@@ -19,6 +19,7 @@
 
 
 #include "ONVBasis/BaseONVBasis.hpp"
+#include "ONVBasis/SpinResolvedONV.hpp"
 #include "ONVBasis/SpinUnresolvedONVBasis.hpp"
 #include "Operator/SecondQuantized/USQHamiltonian.hpp"
 
@@ -78,6 +79,13 @@ public:
      */
     size_t dimension() const;
 
+    /**
+     *  @param address          the address (i.e. the ordening number) of a spin-resolved ONV in this ONV basis
+     *
+     *  @return the spin-resolved ONV with the corresponding address
+     */
+    SpinResolvedONV makeONV(const size_t address) const;
+
 
     /**
      *  Auxiliary method in order to calculate "theta(pq)",
@@ -0,0 +1,119 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/SpinorBasis/RSpinorBasis.hpp"
+#include "Molecule/Molecule.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  The effective Hamiltonian in an active space of orbitals, in which a number of core orbitals are kept doubly occupied.
+ * 
+ *  The orbitals are ordered as core orbitals [0, N_core) followed by active orbitals [N_core, N_core + N_active). The effective Hamiltonian consists of
+ *      - the core energy E_core = sum_i 2 h(i,i) + sum_{i,j} (2 g(i,i,j,j) - g(i,j,j,i)), in which i and j run over the core orbitals;
+ *      - the one-electron integrals of the inactive Fock operator h'(t,u) = h(t,u) + sum_i (2 g(t,u,i,i) - g(t,i,i,u)), in which t and u run over the active orbitals;
+ *      - the two-electron integrals g(t,u,v,w) over the active orbitals.
+ */
+class ActiveSpaceSQHamiltonian {
+private:
+    size_t N_core;  // the number of (doubly occupied) core orbitals
+    double core_energy;  // the energy of the doubly occupied core orbitals
+    SQHamiltonian<double> active_sq_hamiltonian;  // the effective Hamiltonian expressed in the active orbitals
+
+
+public:
+    // CONSTRUCTORS
+
+    /**
+     *  @param N_core                       the number of (doubly occupied) core orbitals
+     *  @param core_energy                  the energy of the doubly occupied core orbitals
+     *  @param active_sq_hamiltonian        the effective Hamiltonian expressed in the active orbitals
+     */
+    ActiveSpaceSQHamiltonian(const size_t N_core, const double core_energy, const SQHamiltonian<double>& active_sq_hamiltonian);
+
+
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  Construct the active-space Hamiltonian from a Hamiltonian that is expressed in all orbitals.
+     * 
+     *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+     *  @param N_core               the number of (doubly occupied) core orbitals
+     *  @param N_active             the number of active orbitals
+     */
+    static ActiveSpaceSQHamiltonian FromHamiltonian(const SQHamiltonian<double>& sq_hamiltonian, const size_t N_core, const size_t N_active);
+
+    /**
+     *  Construct the molecular active-space Hamiltonian directly from the integrals over the underlying scalar basis, so that the two-electron integrals are only ever transformed to the active orbitals.
+     * 
+     *  @param spinor_basis         the spinor basis, whose coefficient matrix contains the (orthonormal) core and active orbitals
+     *  @param molecule             the molecule
+     *  @param N_core               the number of (doubly occupied) core orbitals
+     *  @param N_active             the number of active orbitals
+     * 
+     *  @note Like SQHamiltonian::Molecular, the internuclear repulsion energy is not included in the core energy.
+     */
+    static ActiveSpaceSQHamiltonian Molecular(const RSpinorBasis<double, GTOShell>& spinor_basis, const Molecule& molecule, const size_t N_core, const size_t N_active);
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @return the effective Hamiltonian expressed in the active orbitals
+     */
+    const SQHamiltonian<double>& activeHamiltonian() const { return this->active_sq_hamiltonian; }
+
+    /**
+     *  @return the energy of the doubly occupied core orbitals
+     */
+    double coreEnergy() const { return this->core_energy; }
+
+    /**
+     *  @return the number of active orbitals
+     */
+    size_t numberOfActiveOrbitals() const { return this->active_sq_hamiltonian.dimension(); }
+
+    /**
+     *  @return the number of (doubly occupied) core orbitals
+     */
+    size_t numberOfCoreOrbitals() const { return this->N_core; }
+
+
+private:
+    // PRIVATE STATIC METHODS
+
+    /**
+     *  @param h                    the one-electron integrals in a scalar basis
+     *  @param g                    the two-electron integrals in the same scalar basis
+     *  @param C                    the coefficient matrix, whose columns are the expansion coefficients of the orthonormal orbitals in terms of the scalar basis
+     *  @param N_core               the number of (doubly occupied) core orbitals
+     *  @param N_active             the number of active orbitals
+     * 
+     *  @return the active-space Hamiltonian, for which the two-electron integrals are only transformed to the active orbitals
+     */
+    static ActiveSpaceSQHamiltonian FromScalarBasisIntegrals(const SquareMatrix<double>& h, const QCRankFourTensor<double>& g, const MatrixX<double>& C, const size_t N_core, const size_t N_active);
+};
+
+
+}  // namespace GQCP
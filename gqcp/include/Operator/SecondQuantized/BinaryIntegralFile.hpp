@@ -0,0 +1,116 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Representation/SquareMatrix.hpp"
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
+
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A compact binary file that contains the one- and two-electron integrals of a real Hamiltonian, which is memory-mapped when it is read.
+ * 
+ *  The file consists of
+ *      - a header of 64 bytes that identifies the format and contains the number of orbitals K;
+ *      - the K(K+1)/2 one-electron integrals h(p,q) with p>=q, in the order of SymmetryPackedRankFourTensor::pairIndex(p,q);
+ *      - the symmetry-unique two-electron integrals, in the storage order of SymmetryPackedRankFourTensor.
+ */
+class BinaryIntegralFile {
+private:
+    size_t K;  // the number of orbitals
+    MemoryMappedFile file;  // the memory-mapped file
+
+
+private:
+    // PRIVATE CONSTRUCTORS
+
+    /**
+     *  @param K            the number of orbitals
+     *  @param file         the memory-mapped file
+     */
+    BinaryIntegralFile(const size_t K, MemoryMappedFile&& file);
+
+
+public:
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  Open (i.e. memory-map) a binary integral file for reading.
+     * 
+     *  @param filename         the name of the binary integral file
+     */
+    static BinaryIntegralFile Open(const std::string& filename);
+
+
+    // STATIC PUBLIC METHODS
+
+    /**
+     *  Write the given integrals to a binary integral file.
+     * 
+     *  @param filename         the name of the binary integral file
+     *  @param h                the (symmetric) one-electron integrals
+     *  @param g                the symmetry-packed two-electron integrals
+     */
+    static void Write(const std::string& filename, const SquareMatrix<double>& h, const SymmetryPackedRankFourTensor& g);
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @return the number of orbitals
+     */
+    size_t dimension() const { return this->K; }
+
+    /**
+     *  @return the one-electron integrals
+     */
+    SquareMatrix<double> oneElectronIntegrals() const;
+
+    /**
+     *  @return the two-electron integral g(p,q,r,s), which is read directly from the mapped file
+     */
+    double twoElectronIntegral(const size_t p, const size_t q, const size_t r, const size_t s) const { return this->twoElectronData()[SymmetryPackedRankFourTensor::compoundIndex(p, q, r, s)]; }
+
+    /**
+     *  @return the symmetry-packed two-electron integrals
+     */
+    SymmetryPackedRankFourTensor twoElectronIntegrals() const;
+
+
+private:
+    // PRIVATE METHODS
+
+    /**
+     *  @return a pointer to the packed one-electron integrals in the mapped file
+     */
+    const double* oneElectronData() const;
+
+    /**
+     *  @return a pointer to the packed two-electron integrals in the mapped file
+     */
+    const double* twoElectronData() const;
+};
+
+
+}  // namespace GQCP
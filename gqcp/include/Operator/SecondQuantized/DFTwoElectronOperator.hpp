@@ -0,0 +1,215 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ScalarBasis.hpp"
+#include "Basis/SpinorBasis/RSpinorBasis.hpp"
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/QCRankFourTensor.hpp"
+#include "Mathematical/Representation/SquareMatrix.hpp"
+#include "Molecule/Molecule.hpp"
+#include "Operator/SecondQuantized/SQTwoElectronOperator.hpp"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  Density-fitted (resolution-of-the-identity) two-electron integrals over real orbitals in chemist's notation, which are approximated by
+ *      g(p,q,r,s) = sum_P B^P(p,q) B^P(r,s),
+ *  in which P runs over the functions of an auxiliary basis and the fitted factors are B^P(p,q) = sum_Q (p q|Q) [J^{-1/2}](Q,P), with J(P,Q) = (P|Q) the Coulomb metric.
+ * 
+ *  Only the K*K*N_aux factors are stored instead of the K^4 two-electron integrals, and quantities like the Coulomb and exchange matrices or a basis transformation can be calculated from them in O(K^3 N_aux) operations.
+ * 
+ *  The same factorized form is obtained from a pivoted incomplete Cholesky decomposition of the two-electron integral supermatrix M(pq,rs) = g(p,q,r,s), in which case the factors are the Cholesky vectors L^J(p,q) and no auxiliary basis is needed (see Cholesky()).
+ */
+class DFTwoElectronOperator {
+private:
+    size_t K;  // the dimension of the orbital basis
+    MatrixX<double> B;  // the fitted factors as a (K*K)xN_aux matrix, whose column P contains the KxK matrix B^P in column-major order
+
+
+public:
+    // CONSTRUCTORS
+
+    /**
+     *  @param B            the fitted factors as a (K*K)xN_aux matrix, whose column P contains the KxK matrix B^P in column-major order
+     *  @param K            the dimension of the orbital basis
+     */
+    DFTwoElectronOperator(const MatrixX<double>& B, const size_t K);
+
+
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  Fit the two-electron integrals over a scalar basis in an auxiliary basis, using libint to calculate the two- and three-center integrals.
+     * 
+     *  @param scalar_basis                 the scalar basis in which the two-electron integrals should be expressed
+     *  @param auxiliary_scalar_basis       the auxiliary scalar basis
+     *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+     */
+    static DFTwoElectronOperator Calculate(const ScalarBasis<GTOShell>& scalar_basis, const ScalarBasis<GTOShell>& auxiliary_scalar_basis, const double threshold = 1.0e-10);
+
+    /**
+     *  Decompose the two-electron integrals over a scalar basis by a pivoted incomplete Cholesky decomposition, using libint to calculate only the diagonal and the columns of the selected pivots.
+     * 
+     *  @param scalar_basis                 the scalar basis in which the two-electron integrals should be expressed
+     *  @param tolerance                    the tolerance on the largest remaining diagonal element g(p,q,p,q) - sum_J L^J(p,q)^2, which bounds the error of every approximate integral
+     * 
+     *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+     * 
+     *  @note The columns are calculated per pair of shells: once a pivot is selected, the integrals (p q|r s) for all basis functions r and s in the shell pair of the pivot are calculated and used as candidates for the following Cholesky vectors.
+     */
+    static DFTwoElectronOperator Cholesky(const ScalarBasis<GTOShell>& scalar_basis, const double tolerance = 1.0e-06);
+
+    /**
+     *  Decompose the given two-electron integrals by a pivoted incomplete Cholesky decomposition.
+     * 
+     *  @param g                            the two-electron integrals
+     *  @param tolerance                    the tolerance on the largest remaining diagonal element g(p,q,p,q) - sum_J L^J(p,q)^2, which bounds the error of every approximate integral
+     * 
+     *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+     */
+    static DFTwoElectronOperator Cholesky(const QCRankFourTensor<double>& g, const double tolerance = 1.0e-06);
+
+    /**
+     *  @param three_center_integrals       the three-center integrals as a (K*K)xN_aux matrix, whose column P contains the KxK matrix (p q|P) in column-major order
+     *  @param metric                       the Coulomb metric J(P,Q) = (P|Q)
+     *  @param K                            the dimension of the orbital basis
+     *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+     * 
+     *  @return the fitted two-electron integrals, using the symmetric fit B = (pq|P) J^{-1/2}
+     * 
+     *  @note The inverse square root of the metric is constructed from its eigendecomposition, in which eigenvectors with eigenvalues below the threshold are discarded, so that a (nearly) linearly dependent auxiliary basis is handled gracefully.
+     */
+    static DFTwoElectronOperator FromThreeCenterIntegrals(const MatrixX<double>& three_center_integrals, const SquareMatrix<double>& metric, const size_t K, const double threshold = 1.0e-10);
+
+    /**
+     *  Fit the molecular two-electron integrals, i.e. the integrals over the orbitals of the given spinor basis.
+     * 
+     *  @param spinor_basis                 the spinor basis, whose coefficient matrix contains the orbitals
+     *  @param molecule                     the molecule on whose nuclei the auxiliary basis functions should be centered
+     *  @param auxiliary_basisset_name      the name of the auxiliary basisset, e.g. "def2-universal-jkfit"
+     *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+     */
+    static DFTwoElectronOperator Molecular(const RSpinorBasis<double, GTOShell>& spinor_basis, const Molecule& molecule, const std::string& auxiliary_basisset_name, const double threshold = 1.0e-10);
+
+
+    // OPERATORS
+
+    /**
+     *  @return the (approximate) two-electron integral g(p,q,r,s)
+     */
+    double operator()(const size_t p, const size_t q, const size_t r, const size_t s) const;
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+     */
+    SquareMatrix<double> calculateCoulombMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @param D                a (density) matrix
+     * 
+     *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+     */
+    SquareMatrix<double> calculateExchangeMatrix(const SquareMatrix<double>& D) const;
+
+    /**
+     *  @return the dimension of the orbital basis
+     */
+    size_t dimension() const { return this->K; }
+
+    /**
+     *  @param P                the index of an auxiliary basis function
+     * 
+     *  @return the KxK matrix B^P
+     */
+    SquareMatrix<double> factorMatrix(const size_t P) const;
+
+    /**
+     *  @return the fitted factors as a (K*K)xN_aux matrix, whose column P contains the KxK matrix B^P in column-major order
+     */
+    const MatrixX<double>& factors() const { return this->B; }
+
+    /**
+     *  @return the number of auxiliary basis functions
+     */
+    size_t numberOfAuxiliaryBasisFunctions() const { return this->B.cols(); }
+
+    /**
+     *  @return the full K^4 tensor of the (approximate) two-electron integrals
+     */
+    QCRankFourTensor<double> toTensor() const;
+
+    /**
+     *  @return the (approximate) two-electron integrals, reconstructed as a second-quantized two-electron operator
+     * 
+     *  @note The reconstruction needs O(K^4) memory, so it should only be done on demand, e.g. for a small active space after transformed().
+     */
+    ScalarSQTwoElectronOperator<double> toSQTwoElectronOperator() const { return ScalarSQTwoElectronOperator<double>{this->toTensor()}; }
+
+    /**
+     *  @param C    the coefficient matrix, whose columns are the expansion coefficients of the new orbitals in terms of the current ones; it may have fewer columns than rows (e.g. to only transform to an active space)
+     *
+     *  @return the density-fitted two-electron integrals expressed in the new orbitals, i.e. with the factors B'^P = C^T B^P C
+     * 
+     *  @note Transforming the factors scales as O(K^3 N_aux) instead of the O(K^5) of the transformation of the full tensor.
+     */
+    DFTwoElectronOperator transformed(const MatrixX<double>& C) const;
+
+    /**
+     *  @param C1   the coefficient matrix for the first index of every factor
+     *  @param C2   the coefficient matrix for the second index of every factor
+     * 
+     *  @return the factors B'^P = C1^T B^P C2 as a (n1*n2)xN_aux matrix, in which n1 and n2 are the numbers of columns of C1 and C2, e.g. the factors (i a|P) over occupied and virtual orbitals
+     */
+    MatrixX<double> transformedFactors(const MatrixX<double>& C1, const MatrixX<double>& C2) const;
+
+
+private:
+    // PRIVATE STATIC METHODS
+
+    /**
+     *  Perform a pivoted incomplete Cholesky decomposition of the two-electron integral supermatrix M(pq,rs) = g(p,q,r,s), in which pq = p + K*q is the compound index of a pair.
+     * 
+     *  @param K                            the dimension of the orbital basis
+     *  @param diagonal                     the diagonal M(pq,pq) of the supermatrix
+     *  @param calculate_columns            a function that, for a given pivot, returns a batch of compound indices that includes the pivot, together with the columns of the supermatrix that correspond to them
+     *  @param tolerance                    the tolerance on the largest remaining diagonal element
+     * 
+     *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+     * 
+     *  @note Within a batch of columns, only the candidates whose remaining diagonal element is larger than both the tolerance and a fraction of the largest remaining diagonal element are used, which keeps the decomposition numerically stable.
+     */
+    static DFTwoElectronOperator PivotedCholesky(const size_t K, const VectorX<double>& diagonal, const std::function<std::pair<std::vector<size_t>, MatrixX<double>>(const size_t)>& calculate_columns, const double tolerance);
+};
+
+
+}  // namespace GQCP
@@ -25,14 +25,19 @@
 #include "Molecule/Molecule.hpp"
 #include "Operator/FirstQuantized/NuclearRepulsionOperator.hpp"
 #include "Operator/FirstQuantized/OverlapOperator.hpp"
+#include "Operator/SecondQuantized/BinaryIntegralFile.hpp"
 #include "Operator/SecondQuantized/ModelHamiltonian/HubbardHamiltonian.hpp"
 #include "Operator/SecondQuantized/SQOneElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQTwoElectronOperator.hpp"
 #include "Processing/RDM/OneRDM.hpp"
 #include "Processing/RDM/TwoRDM.hpp"
+#include "Utilities/FCIDUMPParser.hpp"
 #include "Utilities/miscellaneous.hpp"
 #include "Utilities/type_traits.hpp"
 
+#include <cstdio>
+#include <fstream>
+
 
 namespace GQCP {
 
@@ -206,61 +211,31 @@ public:
     template<typename Z = Scalar>
     static enable_if_t<std::is_same<Z, double>::value, SQHamiltonian<double>> ReadFCIDUMP(const std::string& fcidump_file) {
 
-        std::ifstream input_file_stream = validateAndOpen(fcidump_file, "FCIDUMP");
-
-
-        // Do the actual parsing
-
-        //  Get the number of orbitals to check if it's a valid FCIDUMP file
-        std::string start_line;  // first line contains orbitals and electron count
-        std::getline(input_file_stream, start_line);
-        std::stringstream linestream (start_line);
-
-        size_t K = 0;
-        char iter;
-
-        while (linestream >> iter) {
-            if (iter == '=') {
-                linestream >> K;  // right here we have the number of orbitals
-                break;  // we can finish reading the linestream after we found K
-            }
-        }
-
-        if (K == 0) {
-            throw std::invalid_argument("SQHamiltonian::ReadFCIDUMP(std::string): The .FCIDUMP-file is invalid: could not read a number of orbitals.");
-        }
-
+        const FCIDUMPParser parser (fcidump_file);
+        const auto K = parser.numberOfOrbitals();
 
         QCMatrix<double> h_core = QCMatrix<double>::Zero(K, K);
         QCRankFourTensor<double> g (K);
         g.setZero();
 
-        //  Skip 3 lines
-        for (size_t counter = 0; counter < 3; counter++) {
-            std::getline(input_file_stream, start_line);
-        }
-
-
-        //  Start reading in the one- and two-electron integrals
-        double x;
-        size_t i, j, a, b;
 
-        std::string line;
-        while (std::getline(input_file_stream, line)) {
-            std::istringstream iss (line);
+        // Based on what the values of the indices are, we can read one-electron integrals, two-electron integrals and the internuclear repulsion energy
+        //  See also (http://hande.readthedocs.io/en/latest/manual/integrals.html)
+        //  I think the documentation is a bit unclear for the two-electron integrals, but we can rest assured that FCIDUMP files give the two-electron integrals in CHEMIST's notation.
+        parser.forEachRecord([&h_core, &g, K] (const FCIDUMPRecord& record) {
+            const auto x = record.value;
 
-            // Based on what the values of the indices are, we can read one-electron integrals, two-electron integrals and the internuclear repulsion energy
-            //  See also (http://hande.readthedocs.io/en/latest/manual/integrals.html)
-            //  I think the documentation is a bit unclear for the two-electron integrals, but we can rest assured that FCIDUMP files give the two-electron integrals in CHEMIST's notation.
-            iss >> x >> i >> a >> j >> b;
+            if ((record.i > K) || (record.a > K) || (record.j > K) || (record.b > K)) {
+                throw std::invalid_argument("SQHamiltonian::ReadFCIDUMP(std::string): The .FCIDUMP-file contains an orbital index that exceeds the number of orbitals.");
+            }
 
-            //  Single-particle eigenvalues (skipped)
-            if ((a == 0) && (j == 0) && (b == 0)) {}
+            //  Single-particle eigenvalues and the internuclear repulsion energy (skipped)
+            if ((record.a == 0) && (record.j == 0) && (record.b == 0)) {}
 
             //  One-electron integrals (h_core)
-            else if ((j == 0) && (b == 0)) {
-                size_t p = i - 1;
-                size_t q = a - 1;
+            else if ((record.j == 0) && (record.b == 0)) {
+                size_t p = record.i - 1;
+                size_t q = record.a - 1;
                 h_core(p,q) = x;
 
                 // Apply the permutational symmetry for real orbitals
@@ -268,11 +243,11 @@ public:
             }
 
             //  Two-electron integrals are given in CHEMIST'S NOTATION, so just copy them over
-            else if ((i > 0) && (a > 0) && (j > 0) && (b > 0)) {
-                size_t p = i - 1;
-                size_t q = a - 1;
-                size_t r = j - 1;
-                size_t s = b - 1;
+            else if ((record.i > 0) && (record.a > 0) && (record.j > 0) && (record.b > 0)) {
+                size_t p = record.i - 1;
+                size_t q = record.a - 1;
+                size_t r = record.j - 1;
+                size_t s = record.b - 1;
                 g(p,q,r,s) = x;
 
                 // Apply the permutational symmetries for real orbitals
@@ -285,8 +260,26 @@ public:
                 g(r,s,q,p) = x;
                 g(s,r,q,p) = x;
             }
-        }  // while loop
+        });
+
 
+        return SQHamiltonian{ScalarSQOneElectronOperator<Scalar>{h_core}, ScalarSQTwoElectronOperator<Scalar>{g}};
+    }
+
+
+    /**
+     *  @param filename         the name of a binary integral file (see BinaryIntegralFile)
+     *
+     *  @return the Hamiltonian corresponding to the contents of the binary integral file
+     *
+     *  Note that this named constructor is only available for real matrix representations
+     */
+    template<typename Z = Scalar>
+    static enable_if_t<std::is_same<Z, double>::value, SQHamiltonian<double>> ReadBinaryIntegrals(const std::string& filename) {
+
+        const auto integral_file = BinaryIntegralFile::Open(filename);
+        const QCMatrix<double> h_core = integral_file.oneElectronIntegrals();
+        const QCRankFourTensor<double> g = integral_file.twoElectronIntegrals().toTensor();
 
         return SQHamiltonian{ScalarSQOneElectronOperator<Scalar>{h_core}, ScalarSQTwoElectronOperator<Scalar>{g}};
     }
@@ -505,6 +498,81 @@ public:
      *  @return the contributions to the two-electron part of the Hamiltonian
      */
     const std::vector<ScalarSQTwoElectronOperator<Scalar>>& twoElectronContributions() const { return this->two_ops; }
+
+
+    /**
+     *  Write the integrals of this Hamiltonian to a compact binary integral file (see BinaryIntegralFile), which only contains the symmetry-unique integrals.
+     *
+     *  @param filename         the name of the binary integral file
+     *
+     *  Note that this method is only available for real matrix representations
+     */
+    template<typename Z = Scalar>
+    enable_if_t<std::is_same<Z, double>::value> writeBinaryIntegrals(const std::string& filename) const {
+        BinaryIntegralFile::Write(filename, this->core().parameters(), SymmetryPackedRankFourTensor::FromTensor(this->twoElectron().parameters()));
+    }
+
+
+    /**
+     *  Write the integrals of this Hamiltonian to an FCIDUMP file, which only contains the symmetry-unique non-zero integrals.
+     *
+     *  @param fcidump_file     the name of the FCIDUMP file
+     *  @param N                the number of electrons
+     *
+     *  Note that this method is only available for real matrix representations
+     */
+    template<typename Z = Scalar>
+    enable_if_t<std::is_same<Z, double>::value> writeFCIDUMP(const std::string& fcidump_file, const size_t N) const {
+
+        std::ofstream output_file_stream (fcidump_file);
+        if (!output_file_stream.good()) {
+            throw std::runtime_error("SQHamiltonian::writeFCIDUMP(const std::string&, const size_t): Could not open the given file for writing.");
+        }
+
+        const auto K = this->dimension();
+        const auto& h = this->core().parameters();
+        const auto& g = this->twoElectron().parameters();
+
+
+        // Write the header, in which all orbitals are considered to belong to the totally symmetric irreducible representation
+        output_file_stream << " &FCI NORB=" << K << ",NELEC=" << N << ",MS2=0,\n  ORBSYM=";
+        for (size_t p = 0; p < K; p++) {
+            output_file_stream << "1,";
+        }
+        output_file_stream << "\n  ISYM=1,\n /\n";
+
+
+        // Write the symmetry-unique integrals (p>=q, r>=s, pq>=rs), followed by the one-electron integrals (p>=q) and a zero core energy
+        char line[64];
+        const auto write_record = [&output_file_stream, &line] (const double value, const size_t i, const size_t a, const size_t j, const size_t b) {
+            const auto length = std::snprintf(line, sizeof(line), "%24.16E %4zu %4zu %4zu %4zu\n", value, i, a, j, b);
+            output_file_stream.write(line, length);
+        };
+
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                for (size_t r = 0; r <= p; r++) {
+                    for (size_t s = 0; s <= r; s++) {
+                        if (((r == p) && (s > q)) || (g(p,q,r,s) == 0.0)) {
+                            continue;
+                        }
+                        write_record(g(p,q,r,s), p+1, q+1, r+1, s+1);
+                    }
+                }
+            }
+        }
+
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                if (h(p,q) != 0.0) {
+                    write_record(h(p,q), p+1, q+1, 0, 0);
+                }
+            }
+        }
+
+        write_record(0.0, 0, 0, 0, 0);
+    }
+
 };
 
 
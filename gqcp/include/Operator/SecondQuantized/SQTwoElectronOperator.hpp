@@ -27,6 +27,7 @@
 #include "Utilities/miscellaneous.hpp"
 
 #include <array>
+#include <utility>
 
 
 namespace GQCP {
@@ -59,7 +60,15 @@ public:
      *  @param gs            all the matrix representations (hence the 's') of the parameters (integrals) of the different components of this second-quantized operator
      */
     SQTwoElectronOperator(const std::array<QCRankFourTensor<Scalar>, Components>& gs) : 
-        gs (gs)
+        SQTwoElectronOperator(std::array<QCRankFourTensor<Scalar>, Components>(gs))
+    {}
+
+
+    /**
+     *  @param gs            all the matrix representations (hence the 's') of the parameters (integrals) of the different components of this second-quantized operator, whose storage is taken over
+     */
+    SQTwoElectronOperator(std::array<QCRankFourTensor<Scalar>, Components>&& gs) : 
+        gs (std::move(gs))
     {
         // Check if the given matrix representations have the same dimensions
         const auto dimension_of_first = this->gs[0].dimension();
@@ -68,7 +77,7 @@ public:
 
             const auto dimension_of_ith = this->gs[i].dimension();
             if (dimension_of_first != dimension_of_ith) {
-                throw std::invalid_argument("SQTwoElectronOperator(const std::array<QCMatrix<Scalar>, Components>&): The given matrix representations do not have the same dimensions.");
+                throw std::invalid_argument("SQTwoElectronOperator(std::array<QCMatrix<Scalar>, Components>&&): The given matrix representations do not have the same dimensions.");
             }
         }
     }
@@ -87,6 +96,17 @@ public:
     {}
 
 
+    /**
+     *  A constructor for ScalarSQTwoElectronOperators that takes over the storage of the given integrals, rather than copying them.
+     * 
+     *  @param g            the matrix representation of the integrals of this scalar second-quantized operator
+     */
+    template <size_t Z = Components>
+    SQTwoElectronOperator(QCRankFourTensor<Scalar>&& g, typename std::enable_if<Z == 1>::type* = 0) :
+        SQTwoElectronOperator(std::array<QCRankFourTensor<Scalar>, 1>{std::move(g)})
+    {}
+
+
     /**
      *  Construct a two-electron operator with zero parameters
      * 
@@ -18,6 +18,7 @@
 #pragma once
 
 
+#include "Basis/Integrals/IntegralCalculator.hpp"
 #include "Basis/SpinorBasis/SpinComponent.hpp"
 #include "Basis/SpinorBasis/USpinorBasis.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
@@ -107,6 +108,10 @@ public:
     template <typename Z = Scalar>
     static enable_if_t<std::is_same<Z, double>::value, USQHamiltonian<double>> Molecular(const USpinorBasis<Z, GTOShell>& spinor_basis, const Molecule& molecule) {
 
+        // The AOIntegralCache only shares integrals that are still alive, so hold on to the alpha AO Coulomb integrals while both components are quantized. If the beta scalar basis is the same, its integrals aren't calculated a second time.
+        const auto& scalar_basis_alpha = spinor_basis.spinorBasis(SpinComponent::ALPHA).scalarBasis();
+        const auto g_ao_alpha = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), scalar_basis_alpha, scalar_basis_alpha);
+
         const SQHamiltonian<Scalar> sq_hamiltonian_alpha = SQHamiltonian<double>::Molecular(spinor_basis.spinorBasis(SpinComponent::ALPHA), molecule);
         const SQHamiltonian<Scalar> sq_hamiltonian_beta = SQHamiltonian<double>::Molecular(spinor_basis.spinorBasis(SpinComponent::BETA), molecule);
 
@@ -0,0 +1,86 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/SpinorBasis/RSpinorBasis.hpp"
+#include "Molecule/Molecule.hpp"
+#include "Processing/Cube/CubicGrid.hpp"
+#include "Processing/RDM/OneRDM.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that writes Gaussian cube files
+ * 
+ *  The values on the grid are calculated and written slab by slab, so that the values on the full grid never have to be kept in memory.
+ */
+class CubeFile {
+public:
+    using SlabFunction = std::function<MatrixX<double> (const MatrixX<double>&)>;  // calculates the values of one or more fields at the points of a slab, given as rows of a (N x 3)-matrix, and returns them as a (N x number of fields)-matrix
+
+
+public:
+
+    /*
+     *  PUBLIC STATIC METHODS
+     */
+
+    /**
+     *  Write a cube file for the given fields
+     * 
+     *  @param filename                 the name of the cube file
+     *  @param molecule                 the molecule whose nuclei are written in the header
+     *  @param grid                     the grid on which the fields are written
+     *  @param slab_function            the function that calculates the values of the fields at the points of a slab
+     *  @param comment                  a description that is written in the header
+     *  @param orbital_indices          the (zero-based) indices of the orbitals that are written, if the fields are orbitals; leave empty if a single scalar field (like a density) is written
+     */
+    static void Write(const std::string& filename, const Molecule& molecule, const CubicGrid& grid, const SlabFunction& slab_function, const std::string& comment, const std::vector<size_t>& orbital_indices = {});
+
+    /**
+     *  Write a cube file for the electron density
+     * 
+     *  @param filename                 the name of the cube file
+     *  @param molecule                 the molecule whose nuclei are written in the header
+     *  @param spinor_basis             the spinor basis in which the 1-DM is expressed
+     *  @param D                        the (spin-summed) 1-DM
+     *  @param grid                     the grid on which the density is written
+     */
+    static void WriteDensity(const std::string& filename, const Molecule& molecule, const RSpinorBasis<double, GTOShell>& spinor_basis, const OneRDM<double>& D, const CubicGrid& grid);
+
+    /**
+     *  Write a cube file for a number of orbitals
+     * 
+     *  @param filename                 the name of the cube file
+     *  @param molecule                 the molecule whose nuclei are written in the header
+     *  @param spinor_basis             the spinor basis whose orbitals should be written
+     *  @param orbital_indices          the (zero-based) indices of the orbitals that should be written
+     *  @param grid                     the grid on which the orbitals are written
+     */
+    static void WriteOrbitals(const std::string& filename, const Molecule& molecule, const RSpinorBasis<double, GTOShell>& spinor_basis, const std::vector<size_t>& orbital_indices, const CubicGrid& grid);
+};
+
+
+}  // namespace GQCP
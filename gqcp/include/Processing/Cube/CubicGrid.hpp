@@ -0,0 +1,126 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Molecule/Molecule.hpp"
+
+#include <array>
+
+
+namespace GQCP {
+
+
+/**
+ *  A regular, axis-aligned grid of points in real space, as used in Gaussian cube files
+ * 
+ *  The points are ordered with the x-index running slowest and the z-index running fastest. A 'slab' is the set of points that share the same x-index.
+ */
+class CubicGrid {
+private:
+    Vector<double, 3> origin;  // the position of the first point of the grid, in bohr
+    std::array<size_t, 3> numbers_of_steps;  // the number of points along the x-, y- and z-axis
+    std::array<double, 3> step_sizes;  // the distance between two consecutive points along the x-, y- and z-axis, in bohr
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param origin                   the position of the first point of the grid, in bohr
+     *  @param numbers_of_steps         the number of points along the x-, y- and z-axis
+     *  @param step_sizes               the distance between two consecutive points along the x-, y- and z-axis, in bohr
+     */
+    CubicGrid(const Vector<double, 3>& origin, const std::array<size_t, 3>& numbers_of_steps, const std::array<double, 3>& step_sizes);
+
+
+    /*
+     *  NAMED CONSTRUCTORS
+     */
+
+    /**
+     *  @param center                   the center of the grid, in bohr
+     *  @param number_of_steps          the number of points along every axis
+     *  @param step_size                the distance between two consecutive points along every axis, in bohr
+     * 
+     *  @return a cubic grid that is centered around the given point
+     */
+    static CubicGrid Centered(const Vector<double, 3>& center, const size_t number_of_steps, const double step_size);
+
+    /**
+     *  @param molecule                 the molecule that should be enclosed
+     *  @param step_size                the distance between two consecutive points along every axis, in bohr
+     *  @param padding                  the distance between the outermost nuclei and the boundaries of the grid, in bohr
+     * 
+     *  @return a grid whose boxed volume encloses all the nuclei of the given molecule
+     */
+    static CubicGrid Enclosing(const Molecule& molecule, const double step_size, const double padding = 4.0);
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @return the number of points along the x-, y- and z-axis
+     */
+    const std::array<size_t, 3>& numbersOfSteps() const { return this->numbers_of_steps; }
+
+    /**
+     *  @return the total number of points in the grid
+     */
+    size_t numberOfPoints() const { return this->numbers_of_steps[0] * this->numbers_of_steps[1] * this->numbers_of_steps[2]; }
+
+    /**
+     *  @return the number of points in one slab
+     */
+    size_t numberOfPointsPerSlab() const { return this->numbers_of_steps[1] * this->numbers_of_steps[2]; }
+
+    /**
+     *  @return the position of the first point of the grid, in bohr
+     */
+    const Vector<double, 3>& originPosition() const { return this->origin; }
+
+    /**
+     *  @param i            the index along the x-axis
+     *  @param j            the index along the y-axis
+     *  @param k            the index along the z-axis
+     * 
+     *  @return the position of the grid point with the given indices
+     */
+    Vector<double, 3> position(const size_t i, const size_t j, const size_t k) const;
+
+    /**
+     *  @param i            the index along the x-axis
+     * 
+     *  @return the positions of the points in the slab with the given x-index, as rows of a (number of points per slab x 3)-matrix, with the z-index running fastest
+     */
+    MatrixX<double> slab(const size_t i) const;
+
+    /**
+     *  @return the distance between two consecutive points along the x-, y- and z-axis, in bohr
+     */
+    const std::array<double, 3>& stepSizes() const { return this->step_sizes; }
+};
+
+
+}  // namespace GQCP
@@ -56,6 +56,40 @@ public:
      *  @return the parameter response force (F_p) as an (Nx3)-matrix, i.e. the first-order parameter partial derivative of the perturbation derivative of the RHF energy function
      */
     Matrix<double, Dynamic, 3> calculateParameterResponseForce(const VectorSQOneElectronOperator<double> dipole_op) const override;
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @param sq_hamiltonian           the Hamiltonian parameters expressed in an orthonormal orbital basis
+     * 
+     *  @return the diagonal of the RHF orbital Hessian, in the same (column-major virtual-occupied) order as the parameter response force
+     */
+    VectorX<double> calculateOrbitalHessianDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const;
+
+    /**
+     *  @param sq_hamiltonian           the Hamiltonian parameters expressed in an orthonormal orbital basis
+     *  @param X                        the vectors (as columns) that the RHF orbital Hessian should act on, in the same (column-major virtual-occupied) order as the parameter response force
+     * 
+     *  @return the products of the RHF orbital Hessian with the given vectors
+     * 
+     *  @note The orbital Hessian is never constructed: every vector is turned into a virtual-occupied density-like matrix, which is contracted with the two-electron integrals like in a Fock matrix build.
+     */
+    MatrixX<double> calculateOrbitalHessianProducts(const SQHamiltonian<double>& sq_hamiltonian, const MatrixX<double>& X) const;
+
+    /**
+     *  Solve the linear response equations for the wave function response with a preconditioned conjugate gradient algorithm, for the three components of the dipole operator simultaneously.
+     * 
+     *  @param sq_hamiltonian                       the Hamiltonian parameters expressed in an orthonormal orbital basis
+     *  @param dipole_op                            the dipole integrals expressed in an orthonormal orbital basis
+     *  @param threshold                            the threshold on the norm of the residual of every component
+     *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+     * 
+     *  @return the wave function response as an (Nx3)-matrix
+     * 
+     *  @note Only vectors of the dimension of the response force are stored, instead of the full RHF orbital Hessian (see calculateOrbitalHessianProducts()).
+     */
+    Matrix<double, Dynamic, 3> calculateWaveFunctionResponseIterative(const SQHamiltonian<double>& sq_hamiltonian, const VectorSQOneElectronOperator<double> dipole_op, const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128) const;
 };
 
 
@@ -0,0 +1,138 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Basis/ScalarBasis/GTOShell.hpp"
+#include "Basis/ScalarBasis/ShellSet.hpp"
+#include "Basis/TransformationMatrix.hpp"
+#include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/QCMatrix.hpp"
+#include "Molecule/Molecule.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  The results of a potential energy scan at one of its geometries
+ */
+struct PotentialEnergyScanPoint {
+    double nuclear_repulsion_energy;  // the internuclear repulsion energy
+    double rhf_energy;  // the total (i.e. including the internuclear repulsion) RHF energy
+    double fci_energy;  // the total FCI energy, which is only set if FCI was requested
+
+    TransformationMatrix<double> C;  // the RHF coefficient matrix, expressed in the scalar basis at this geometry
+    VectorX<double> fci_coefficients;  // the FCI ground state coefficients with respect to the RHF orbitals, which are only set if FCI was requested
+};
+
+
+/**
+ *  The integrals over the scalar basis at one of the geometries of a potential energy scan
+ */
+struct PotentialEnergyScanIntegrals {
+    QCMatrix<double> S;  // the overlap matrix of the scalar basis
+    SQHamiltonian<double> sq_hamiltonian;  // the molecular Hamiltonian, expressed in the scalar basis
+};
+
+
+/**
+ *  A driver that calculates the RHF (and optionally the FCI) energies of a molecule at a series of geometries, e.g. along a dissociation curve
+ * 
+ *  The basis set is only read once: its shells are placed on the nuclei of the first geometry and are then moved along with the nuclei for all the other geometries. The geometries are divided into contiguous chunks that are handled concurrently, one chunk per thread. Within a chunk, every thread reuses its own overlap, kinetic and Coulomb integral engines, and seeds the RHF and FCI calculations at a geometry with the converged solutions at the previous one.
+ */
+class PotentialEnergyScan {
+public:
+    using IntegralFunction = std::function<PotentialEnergyScanIntegrals (const Molecule&)>;  // calculates the integrals over the scalar basis at a geometry
+
+
+private:
+    std::string basisset_name;  // the name of the basisset that is placed on every geometry
+    bool calculate_fci;  // if an FCI calculation in the RHF orbitals should be done at every geometry
+    size_t number_of_chunks;  // the maximum number of chunks of geometries that are handled concurrently, 0 meaning one for every available thread
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param basisset_name            the name of the basisset that is placed on every geometry
+     *  @param calculate_fci            if an FCI calculation in the RHF orbitals should be done at every geometry
+     *  @param number_of_chunks         the maximum number of chunks of geometries that are handled concurrently, 0 meaning one for every available thread. Only the first geometry of every chunk is calculated from scratch.
+     */
+    PotentialEnergyScan(const std::string& basisset_name, const bool calculate_fci = false, const size_t number_of_chunks = 0);
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @param molecules            the geometries of the scan, which should all contain the same nuclei in the same order and the same (even) number of electrons
+     * 
+     *  @return the results at every geometry, in the order of the given geometries
+     */
+    std::vector<PotentialEnergyScanPoint> calculate(const std::vector<Molecule>& molecules) const;
+
+    /**
+     *  @param molecules                        the geometries of the scan, which should all contain the same nuclei in the same order and the same (even) number of electrons
+     *  @param integral_function_factory        creates the function that calculates the integrals at a geometry. It is called once for every chunk, on the thread that handles that chunk, so that every created function may hold its own non-thread-safe state (like integral engines).
+     * 
+     *  @return the results at every geometry, in the order of the given geometries
+     * 
+     *  @note The basisset name of this scan is not used: the basis is determined by the given integrals.
+     */
+    std::vector<PotentialEnergyScanPoint> calculate(const std::vector<Molecule>& molecules, const std::function<IntegralFunction ()>& integral_function_factory) const;
+
+    /**
+     *  @return if an FCI calculation in the RHF orbitals is done at every geometry
+     */
+    bool calculatesFCI() const { return this->calculate_fci; }
+
+    /**
+     *  @return the maximum number of chunks of geometries that are handled concurrently, 0 meaning one for every available thread
+     */
+    size_t numberOfChunks() const { return this->number_of_chunks; }
+
+
+    /*
+     *  PUBLIC STATIC METHODS
+     */
+
+    /**
+     *  Move the shells along with the nuclei that they are centered on.
+     * 
+     *  @param shell_set            the shells that are centered on the nuclei of the reference molecule
+     *  @param reference            the molecule whose nuclei the shells are centered on
+     *  @param molecule             the molecule whose nuclei the shells should be moved to, which should contain the same nuclei as the reference in the same order
+     * 
+     *  @return the shells centered on the corresponding nuclei of the given molecule
+     */
+    static ShellSet<GTOShell> moveShells(const ShellSet<GTOShell>& shell_set, const Molecule& reference, const Molecule& molecule);
+};
+
+
+}  // namespace GQCP
@@ -24,12 +24,16 @@
 #include "ONVBasis/SpinResolvedONVBasis.hpp"
 #include "ONVBasis/SpinResolvedSelectedONVBasis.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/CI/CISigmaVector.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/DOCI.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/FCI.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/FrozenCoreFCI.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/SelectedCI.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/Hubbard.hpp"
 
+#include <memory>
+#include <string>
+
 
 namespace GQCP {
 namespace CIEnvironment {
@@ -42,11 +46,11 @@ namespace CIEnvironment {
  *  @return an environment suitable for solving Hubbard-related eigenvalue problems
  */
 template <typename Scalar>
-EigenproblemEnvironment Dense(const HubbardHamiltonian<Scalar>& hubbard_hamiltonian, const SpinResolvedONVBasis& onv_basis) {
+EigenproblemEnvironment<double> Dense(const HubbardHamiltonian<Scalar>& hubbard_hamiltonian, const SpinResolvedONVBasis& onv_basis) {
 
     const Hubbard hubbard_builder (onv_basis);  // the 'HamiltonianBuilder'
     const auto H = hubbard_builder.constructHamiltonian(hubbard_hamiltonian);
-    return EigenproblemEnvironment::Dense(H);
+    return EigenproblemEnvironment<double>::Dense(H);
 }
 
 
@@ -57,11 +61,11 @@ EigenproblemEnvironment Dense(const HubbardHamiltonian<Scalar>& hubbard_hamilton
  *  @return an environment suitable for solving DOCI eigenvalue problems
  */
 template <typename Scalar>
-EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SeniorityZeroONVBasis& onv_basis) {
+EigenproblemEnvironment<double> Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SeniorityZeroONVBasis& onv_basis) {
 
     const DOCI doci_builder (onv_basis);  // the 'HamiltonianBuilder'
     const auto H = doci_builder.constructHamiltonian(sq_hamiltonian);
-    return EigenproblemEnvironment::Dense(H);
+    return EigenproblemEnvironment<double>::Dense(H);
 }
 
 
@@ -72,11 +76,11 @@ EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const
  *  @return an environment suitable for solving frozen core FCI eigenvalue problems
  */
 template <typename Scalar>
-EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedFrozenONVBasis& onv_basis) {
+EigenproblemEnvironment<double> Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedFrozenONVBasis& onv_basis) {
 
     const FrozenCoreFCI frozen_core_fci_builder (onv_basis);  // the 'HamiltonianBuilder'
     const auto H = frozen_core_fci_builder.constructHamiltonian(sq_hamiltonian);
-    return EigenproblemEnvironment::Dense(H);
+    return EigenproblemEnvironment<double>::Dense(H);
 }
 
 
@@ -87,11 +91,11 @@ EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const
  *  @return an environment suitable for solving spin-resolved selected CI eigenvalue problems
  */
 template <typename Scalar>
-EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedSelectedONVBasis& onv_basis) {
+EigenproblemEnvironment<double> Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedSelectedONVBasis& onv_basis) {
 
     const SelectedCI selected_ci_builder (onv_basis);  // the 'HamiltonianBuilder'
     const auto H = selected_ci_builder.constructHamiltonian(sq_hamiltonian);
-    return EigenproblemEnvironment::Dense(H);
+    return EigenproblemEnvironment<double>::Dense(H);
 }
 
 
@@ -102,11 +106,11 @@ EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const
  *  @return an environment suitable for solving spin-resolved FCI eigenvalue problems
  */
 template <typename Scalar>
-EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedONVBasis& onv_basis) {
+EigenproblemEnvironment<double> Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedONVBasis& onv_basis) {
 
     const FCI fci_builder (onv_basis);  // the 'HamiltonianBuilder'
     const auto H = fci_builder.constructHamiltonian(sq_hamiltonian);
-    return EigenproblemEnvironment::Dense(H);
+    return EigenproblemEnvironment<double>::Dense(H);
 }
 
 
@@ -115,17 +119,23 @@ EigenproblemEnvironment Dense(const SQHamiltonian<Scalar>& sq_hamiltonian, const
  *  @param onv_basis                        the full, spin-resolved ONV basis
  *  @param V                                a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
  * 
- *  @return an environment suitable for solving Hubbard-related eigenvalue problems
+ *  @return an environment suitable for solving Hubbard-related eigenvalue problems, which also provides a single-precision matrix-vector product and the matrix elements
  */
 template <typename Scalar>
-EigenproblemEnvironment Iterative(const HubbardHamiltonian<Scalar>& hubbard_hamiltonian, const SpinResolvedONVBasis& onv_basis, const MatrixX<double>& V) {
+EigenproblemEnvironment<double> Iterative(const HubbardHamiltonian<Scalar>& hubbard_hamiltonian, const SpinResolvedONVBasis& onv_basis, const MatrixX<double>& V) {
 
     const Hubbard hubbard_builder (onv_basis);  // the 'HamiltonianBuilder'
 
     const auto diagonal = hubbard_builder.calculateDiagonal(hubbard_hamiltonian);
     const auto matvec_function = [diagonal, hubbard_builder, hubbard_hamiltonian] (const VectorX<double>& x) { return hubbard_builder.matrixVectorProduct(hubbard_hamiltonian, x, diagonal); };
 
-    return EigenproblemEnvironment::Iterative(matvec_function, diagonal, V);
+    const VectorX<float> single_precision_diagonal = diagonal.template cast<float>();
+    const auto single_precision_matvec_function = [single_precision_diagonal, hubbard_builder, hubbard_hamiltonian] (const VectorX<float>& x) { return hubbard_builder.matrixVectorProduct(hubbard_hamiltonian, x, single_precision_diagonal); };
+
+    auto environment = EigenproblemEnvironment<double>::Iterative(matvec_function, diagonal, V);
+    environment.single_precision_matrix_vector_product_function = single_precision_matvec_function;
+    environment.matrix_element_function = [hubbard_builder, hubbard_hamiltonian] (const size_t I, const size_t J) { return hubbard_builder.calculateMatrixElement(hubbard_hamiltonian, I, J); };
+    return environment;
 }
 
 
@@ -134,17 +144,21 @@ EigenproblemEnvironment Iterative(const HubbardHamiltonian<Scalar>& hubbard_hami
  *  @param onv_basis                    the full seniority-zero ONV basis
  *  @param V                            a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
  * 
- *  @return an environment suitable for solving DOCI eigenvalue problems
+ *  @return an environment suitable for solving DOCI eigenvalue problems, which also provides the matrix elements
  */
 template <typename Scalar>
-EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SeniorityZeroONVBasis& onv_basis, const MatrixX<double>& V) {
+EigenproblemEnvironment<double> Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SeniorityZeroONVBasis& onv_basis, const MatrixX<double>& V) {
 
     const DOCI doci_builder (onv_basis);  // the 'HamiltonianBuilder'
 
+    const auto sq_hamiltonian_ptr = std::make_shared<const SQHamiltonian<Scalar>>(sq_hamiltonian);  // shared by the matrix-vector product and the matrix elements
+
     const auto diagonal = doci_builder.calculateDiagonal(sq_hamiltonian);
-    const auto matvec_function = [diagonal, doci_builder, sq_hamiltonian] (const VectorX<double>& x) { return doci_builder.matrixVectorProduct(sq_hamiltonian, x, diagonal); };
+    const auto matvec_function = [diagonal, doci_builder, sq_hamiltonian_ptr] (const VectorX<double>& x) { return doci_builder.matrixVectorProduct(*sq_hamiltonian_ptr, x, diagonal); };
 
-    return EigenproblemEnvironment::Iterative(matvec_function, diagonal, V);
+    auto environment = EigenproblemEnvironment<double>::Iterative(matvec_function, diagonal, V);
+    environment.matrix_element_function = [doci_builder, sq_hamiltonian_ptr] (const size_t I, const size_t J) { return doci_builder.calculateMatrixElement(*sq_hamiltonian_ptr, I, J); };
+    return environment;
 }
 
 
@@ -153,17 +167,21 @@ EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, c
  *  @param onv_basis                    a frozen, spin-resolved ONV basis
  *  @param V                            a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
  * 
- *  @return an environment suitable for solving frozen core FCI eigenvalue problems
+ *  @return an environment suitable for solving frozen core FCI eigenvalue problems, which also provides the matrix elements
  */
 template <typename Scalar>
-EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedFrozenONVBasis& onv_basis, const MatrixX<double>& V) {
+EigenproblemEnvironment<double> Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedFrozenONVBasis& onv_basis, const MatrixX<double>& V) {
 
     const FrozenCoreFCI frozen_core_fci_builder (onv_basis);  // the 'HamiltonianBuilder'
 
+    const auto sq_hamiltonian_ptr = std::make_shared<const SQHamiltonian<Scalar>>(sq_hamiltonian);  // shared by the matrix-vector product and the matrix elements
+
     const auto diagonal = frozen_core_fci_builder.calculateDiagonal(sq_hamiltonian);
-    const auto matvec_function = [diagonal, frozen_core_fci_builder, sq_hamiltonian] (const VectorX<double>& x) { return frozen_core_fci_builder.matrixVectorProduct(sq_hamiltonian, x, diagonal); };
+    const auto matvec_function = [diagonal, frozen_core_fci_builder, sq_hamiltonian_ptr] (const VectorX<double>& x) { return frozen_core_fci_builder.matrixVectorProduct(*sq_hamiltonian_ptr, x, diagonal); };
 
-    return EigenproblemEnvironment::Iterative(matvec_function, diagonal, V);
+    auto environment = EigenproblemEnvironment<double>::Iterative(matvec_function, diagonal, V);
+    environment.matrix_element_function = [frozen_core_fci_builder, sq_hamiltonian_ptr] (const size_t I, const size_t J) { return frozen_core_fci_builder.calculateMatrixElement(*sq_hamiltonian_ptr, I, J); };
+    return environment;
 }
 
 
@@ -172,17 +190,21 @@ EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, c
  *  @param onv_basis                    a spin-resolved selected ONV basis
  *  @param V                            a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
  * 
- *  @return an environment suitable for solving spin-resolved selected CI eigenvalue problems
+ *  @return an environment suitable for solving spin-resolved selected CI eigenvalue problems, which also provides the matrix elements
  */
 template <typename Scalar>
-EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedSelectedONVBasis& onv_basis, const MatrixX<double>& V) {
+EigenproblemEnvironment<double> Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedSelectedONVBasis& onv_basis, const MatrixX<double>& V) {
 
     const SelectedCI selected_ci_builder (onv_basis);  // the 'HamiltonianBuilder'
 
+    const auto sq_hamiltonian_ptr = std::make_shared<const SQHamiltonian<Scalar>>(sq_hamiltonian);  // shared by the matrix-vector product and the matrix elements
+
     const auto diagonal = selected_ci_builder.calculateDiagonal(sq_hamiltonian);
-    const auto matvec_function = [diagonal, selected_ci_builder, sq_hamiltonian] (const VectorX<double>& x) { return selected_ci_builder.matrixVectorProduct(sq_hamiltonian, x, diagonal); };
+    const auto matvec_function = [diagonal, selected_ci_builder, sq_hamiltonian_ptr] (const VectorX<double>& x) { return selected_ci_builder.matrixVectorProduct(*sq_hamiltonian_ptr, x, diagonal); };
 
-    return EigenproblemEnvironment::Iterative(matvec_function, diagonal, V);
+    auto environment = EigenproblemEnvironment<double>::Iterative(matvec_function, diagonal, V);
+    environment.matrix_element_function = [selected_ci_builder, sq_hamiltonian_ptr] (const size_t I, const size_t J) { return selected_ci_builder.calculateMatrixElement(*sq_hamiltonian_ptr, I, J); };
+    return environment;
 }
 
 
@@ -191,19 +213,62 @@ EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, c
  *  @param onv_basis                    the full, spin-resolved ONV basis
  *  @param V                            a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
  * 
- *  @return an environment suitable for solving spin-resolved FCI eigenvalue problems
+ *  @return an environment suitable for solving spin-resolved FCI eigenvalue problems, which also provides a single-precision matrix-vector product and the matrix elements
  */
 template <typename Scalar>
-EigenproblemEnvironment Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedONVBasis& onv_basis, const MatrixX<double>& V) {
+EigenproblemEnvironment<double> Iterative(const SQHamiltonian<Scalar>& sq_hamiltonian, const SpinResolvedONVBasis& onv_basis, const MatrixX<double>& V) {
 
     const FCI fci_builder (onv_basis);  // the 'HamiltonianBuilder'
+    const auto sq_hamiltonian_ptr = std::make_shared<const SQHamiltonian<Scalar>>(sq_hamiltonian);  // shared by the matrix-vector products and the matrix elements
 
     const auto diagonal = fci_builder.calculateDiagonal(sq_hamiltonian);
-    const auto matvec_function = [diagonal, fci_builder, sq_hamiltonian] (const VectorX<double>& x) { return fci_builder.matrixVectorProduct(sq_hamiltonian, x, diagonal); };
+    const auto matvec_function = [diagonal, fci_builder, sq_hamiltonian_ptr] (const VectorX<double>& x) { return fci_builder.matrixVectorProduct(*sq_hamiltonian_ptr, x, diagonal); };
 
-    return EigenproblemEnvironment::Iterative(matvec_function, diagonal, V);
+    const VectorX<float> single_precision_diagonal = diagonal.template cast<float>();
+    const auto single_precision_matvec_function = [single_precision_diagonal, fci_builder, sq_hamiltonian_ptr] (const VectorX<float>& x) { return fci_builder.matrixVectorProduct(*sq_hamiltonian_ptr, x, single_precision_diagonal); };
+
+    auto environment = EigenproblemEnvironment<double>::Iterative(matvec_function, diagonal, V);
+    environment.single_precision_matrix_vector_product_function = single_precision_matvec_function;
+    environment.matrix_element_function = [fci_builder, sq_hamiltonian_ptr] (const size_t I, const size_t J) { return fci_builder.calculateMatrixElement(*sq_hamiltonian_ptr, I, J); };
+    return environment;
 }
 
 
+
+/**
+ *  @param sigma_vector                 a prepared matrix-vector product of a CI Hamiltonian
+ *  @param V                            a matrix of initial guess vectors (each column of the matrix is an initial guess vector)
+ * 
+ *  @return an environment suitable for solving the CI eigenvalue problem that corresponds to the given matrix-vector product, which also provides the matrix elements
+ */
+template <typename Builder, typename Hamiltonian>
+EigenproblemEnvironment<double> Iterative(const CISigmaVector<Builder, Hamiltonian>& sigma_vector, const MatrixX<double>& V) {
+
+    auto environment = EigenproblemEnvironment<double>::Iterative(sigma_vector.asVectorFunction(), sigma_vector.diagonal(), V);
+    environment.matrix_element_function = sigma_vector.asMatrixElementFunction();
+    return environment;
+}
+
+
+/**
+ *  @tparam Hamiltonian                 the type of the Hamiltonian
+ *  @tparam ONVBasis                    the type of the ONV basis
+ * 
+ *  @param hamiltonian                  the Hamiltonian whose CI eigenvalue problem should be solved
+ *  @param onv_basis                    the ONV basis in which the Hamiltonian should be represented
+ *  @param checkpoint_filename          the name of a checkpoint file that was written during a previous (unfinished) Davidson diagonalization of the same CI problem
+ * 
+ *  @return an environment suitable for continuing an iterative CI diagonalization from the given checkpoint file
+ */
+template <typename Hamiltonian, typename ONVBasis>
+EigenproblemEnvironment<double> Iterative(const Hamiltonian& hamiltonian, const ONVBasis& onv_basis, const std::string& checkpoint_filename) {
+
+    auto environment = CIEnvironment::Iterative(hamiltonian, onv_basis, MatrixX<double>::Zero(onv_basis.get_dimension(), 0));
+    environment.readCheckpoint(checkpoint_filename);
+    return environment;
+}
+
+
+
 }  // namespace CIEnvironment
 }  // namespace GQCP
@@ -0,0 +1,173 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Mathematical/Representation/Matrix.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/**
+ *  A prepared matrix-vector product ('sigma vector') of a CI Hamiltonian: the Hamiltonian builder, the Hamiltonian and its diagonal are set up once, after which the action of the Hamiltonian can be evaluated repeatedly
+ * 
+ *  @tparam _Builder            the type of the Hamiltonian builder, e.g. FCI, DOCI, SelectedCI or Hubbard
+ *  @tparam _Hamiltonian        the type of the Hamiltonian that the builder accepts, e.g. SQHamiltonian<double> or HubbardHamiltonian<double>
+ * 
+ *  @note The Hamiltonian builder and the Hamiltonian are shared between copies of a sigma vector, so that copying it (e.g. into the function returned by asVectorFunction()) doesn't copy the integrals.
+ */
+template <typename _Builder, typename _Hamiltonian>
+class CISigmaVector {
+public:
+    using Builder = _Builder;
+    using Hamiltonian = _Hamiltonian;
+
+
+private:
+    std::shared_ptr<const Builder> builder;
+    std::shared_ptr<const Hamiltonian> hamiltonian;
+    VectorX<double> H_diagonal;  // the diagonal of the matrix representation of the Hamiltonian in the ONV basis
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param hamiltonian          the Hamiltonian, expressed in an orthonormal orbital basis
+     *  @param onv_basis            the ONV basis in which the Hamiltonian's action should be evaluated
+     * 
+     *  @tparam ONVBasis            the type of the ONV basis, which the Hamiltonian builder should accept
+     */
+    template <typename ONVBasis>
+    CISigmaVector(const Hamiltonian& hamiltonian, const ONVBasis& onv_basis) :
+        builder (std::make_shared<const Builder>(onv_basis)),
+        hamiltonian (std::make_shared<const Hamiltonian>(hamiltonian)),
+        H_diagonal (this->builder->calculateDiagonal(*this->hamiltonian))
+    {}
+
+
+    /*
+     *  OPERATORS
+     */
+
+    /**
+     *  @param x            the vector upon which the Hamiltonian acts
+     * 
+     *  @return the action of the Hamiltonian on the given vector
+     */
+    VectorX<double> operator()(const VectorX<double>& x) const {
+
+        if (x.size() != this->H_diagonal.size()) {
+            throw std::invalid_argument("CISigmaVector::operator()(VectorX<double>): the dimension of the given vector does not match the dimension of the ONV basis.");
+        }
+
+        return this->builder->matrixVectorProduct(*this->hamiltonian, x, this->H_diagonal);
+    }
+
+    /**
+     *  @param X            the vectors upon which the Hamiltonian acts, as columns of a matrix
+     * 
+     *  @return the action of the Hamiltonian on the given vectors, as columns of a matrix
+     */
+    MatrixX<double> operator()(const MatrixX<double>& X) const {
+
+        MatrixX<double> sigma (X.rows(), X.cols());
+        this->apply(X, sigma);
+
+        return sigma;
+    }
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  Evaluate the action of the Hamiltonian on a number of vectors and write the results in a preallocated buffer
+     * 
+     *  @param X            the vectors upon which the Hamiltonian acts, as columns of a matrix
+     *  @param sigma        the buffer in which the action of the Hamiltonian on every column of X is written, in the corresponding column
+     * 
+     *  @note The Hamiltonian builders work on owning vectors, so every column of X is copied once; this is negligible compared to the cost of the matrix-vector product itself.
+     */
+    void apply(const Eigen::Ref<const Eigen::MatrixXd>& X, Eigen::Ref<Eigen::MatrixXd> sigma) const {
+
+        if ((X.rows() != this->H_diagonal.size()) || (sigma.rows() != X.rows()) || (sigma.cols() != X.cols())) {
+            throw std::invalid_argument("CISigmaVector::apply(Eigen::Ref<const Eigen::MatrixXd>, Eigen::Ref<Eigen::MatrixXd>): the dimensions of the given vectors do not match the dimension of the ONV basis or each other.");
+        }
+
+        VectorX<double> x (X.rows());
+        for (size_t column = 0; column < static_cast<size_t>(X.cols()); column++) {
+            x = X.col(column);
+            sigma.col(column) = this->builder->matrixVectorProduct(*this->hamiltonian, x, this->H_diagonal);
+        }
+    }
+
+    /**
+     *  @return a function that returns the element H(I,J) of the matrix representation of the Hamiltonian, which can be used to set up exact blocks of the Hamiltonian in iterative eigenproblem environments (e.g. for a reference space preconditioner)
+     * 
+     *  @note The returned function shares the Hamiltonian builder and the Hamiltonian with this sigma vector.
+     */
+    std::function<double (const size_t, const size_t)> asMatrixElementFunction() const {
+
+        const auto builder = this->builder;
+        const auto hamiltonian = this->hamiltonian;
+        return [builder, hamiltonian] (const size_t I, const size_t J) { return builder->calculateMatrixElement(*hamiltonian, I, J); };
+    }
+
+    /**
+     *  @return the matrix-vector product as a function that can be used in iterative eigenproblem environments
+     * 
+     *  @note The returned function shares the Hamiltonian builder and the Hamiltonian with this sigma vector, so it stays valid after this sigma vector goes out of scope; only the diagonal is copied.
+     */
+    VectorFunction<double> asVectorFunction() const {
+
+        const auto builder = this->builder;
+        const auto hamiltonian = this->hamiltonian;
+        const auto H_diagonal = std::make_shared<const VectorX<double>>(this->H_diagonal);
+        return [builder, hamiltonian, H_diagonal] (const VectorX<double>& x) {
+
+            if (x.size() != H_diagonal->size()) {
+                throw std::invalid_argument("CISigmaVector::asVectorFunction(): the dimension of the given vector does not match the dimension of the ONV basis.");
+            }
+
+            return builder->matrixVectorProduct(*hamiltonian, x, *H_diagonal);
+        };
+    }
+
+    /**
+     *  @return the diagonal of the matrix representation of the Hamiltonian in the ONV basis
+     */
+    const VectorX<double>& diagonal() const { return this->H_diagonal; }
+
+    /**
+     *  @return the dimension of the ONV basis
+     */
+    size_t dimension() const { return this->H_diagonal.size(); }
+};
+
+
+}  // namespace GQCP
@@ -73,6 +73,41 @@ public:
      *  @return the diagonal of the matrix representation of the Hamiltonian
      */
     VectorX<double> calculateDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const override;
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+     *  @param x                            the vector upon which the FCI Hamiltonian acts
+     *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+     *
+     *  @return the action of the FCI Hamiltonian on the coefficient vector, in which the contractions with the coefficient vector are performed in single precision
+     */
+    VectorX<float> matrixVectorProduct(const SQHamiltonian<double>& sq_hamiltonian, const VectorX<float>& x, const VectorX<float>& diagonal) const;
+
+    /**
+     *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+     *  @param I                            the address of the first ONV
+     *  @param J                            the address of the second ONV
+     *
+     *  @return the element H(I,J) of the matrix representation of the FCI Hamiltonian, calculated with the Slater-Condon rules
+     */
+    double calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const;
+
+
+private:
+    // PRIVATE METHODS
+    /**
+     *  @tparam Scalar                      the scalar type of the coefficient vector
+     *
+     *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+     *  @param x                            the vector upon which the FCI Hamiltonian acts
+     *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+     *
+     *  @return the action of the FCI Hamiltonian on the coefficient vector
+     */
+    template <typename Scalar>
+    VectorX<Scalar> calculateMatrixVectorProduct(const SQHamiltonian<double>& sq_hamiltonian, const VectorX<Scalar>& x, const VectorX<Scalar>& diagonal) const;
 };
 
 
@@ -43,6 +43,17 @@ public:
 
     // OVERRIDDEN GETTERS
     const BaseONVBasis* get_fock_space() const override { return &onv_basis; }
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+     *  @param I                            the address of the first ONV
+     *  @param J                            the address of the second ONV
+     *
+     *  @return the element H(I,J) of the matrix representation of the frozen core FCI Hamiltonian, calculated with the Slater-Condon rules
+     */
+    double calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const;
 };
 
 
@@ -65,12 +65,45 @@ public:
      */
     VectorX<double> matrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<double>& x, const VectorX<double>& diagonal) const;
 
+    /**
+     *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+     *  @param x                                the vector upon which the Hubbard Hamiltonian acts
+     *  @param diagonal                         the diagonal of the Hubbard Hamiltonian matrix
+     *
+     *  @return the action of the Hubbard model Hamiltonian on the coefficient vector, in which the contractions with the coefficient vector are performed in single precision
+     */
+    VectorX<float> matrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<float>& x, const VectorX<float>& diagonal) const;
+
     /**
      *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
      *
      *  @return the diagonal of the matrix representation of the Hubbard model Hamiltonian
      */
     VectorX<double> calculateDiagonal(const HubbardHamiltonian<double>& hubbard_hamiltonian) const;
+
+    /**
+     *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+     *  @param I                                the address of the first ONV
+     *  @param J                                the address of the second ONV
+     *
+     *  @return the element H(I,J) of the matrix representation of the Hubbard model Hamiltonian, calculated with the Slater-Condon rules
+     */
+    double calculateMatrixElement(const HubbardHamiltonian<double>& hubbard_hamiltonian, const size_t I, const size_t J) const;
+
+
+private:
+    // PRIVATE METHODS
+    /**
+     *  @tparam Scalar                          the scalar type of the coefficient vector
+     *
+     *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+     *  @param x                                the vector upon which the Hubbard Hamiltonian acts
+     *  @param diagonal                         the diagonal of the Hubbard Hamiltonian matrix
+     *
+     *  @return the action of the Hubbard model Hamiltonian on the coefficient vector
+     */
+    template <typename Scalar>
+    VectorX<Scalar> calculateMatrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<Scalar>& x, const VectorX<Scalar>& diagonal) const;
 };
 
 
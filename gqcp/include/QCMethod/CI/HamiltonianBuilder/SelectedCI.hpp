@@ -95,6 +95,17 @@ public:
      *  @return the diagonal of the matrix representation of the SelectedCI Hamiltonian
      */
     VectorX<double> calculateDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const override;
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+     *  @param I                            the address of the first ONV
+     *  @param J                            the address of the second ONV
+     *
+     *  @return the element H(I,J) of the matrix representation of the SelectedCI Hamiltonian, calculated with the Slater-Condon rules
+     */
+    double calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const;
 };
 
 
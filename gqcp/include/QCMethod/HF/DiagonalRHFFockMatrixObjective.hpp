@@ -21,6 +21,9 @@
 #include "QCMethod/QCObjective.hpp"
 #include "QCModel/HF/RHF.hpp"
 
+#include <functional>
+#include <memory>
+
 
 namespace GQCP {
 
@@ -41,7 +44,7 @@ public:
 
 private:
     double precision;  // the precision with which the diagonality of the Fock matrix should be checked
-    SQHamiltonian<Scalar> sq_hamiltonian;  // the Hamiltonian expressed in a scalar basis
+    std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)> fock_matrix_function;  // calculates the Fock matrix (expressed in the scalar basis) from a density matrix
 
 
 public:
@@ -51,14 +54,29 @@ public:
      */
 
     /**
-     *  @param sq_hamiltonian       the Hamiltonian expressed in a scalar basis
+     *  @param fock_matrix_function     a function that calculates the Fock matrix (expressed in a scalar basis) from a density matrix, e.g. the one of an RHFSCFEnvironment that uses density-fitted or memory-mapped two-electron integrals
+     *  @param precision                the precision with which the diagonality of the Fock matrix should be checked
      */
-    DiagonalRHFFockMatrixObjective(const SQHamiltonian<Scalar>& sq_hamiltonian, const double precision=1.0e-08) :
+    DiagonalRHFFockMatrixObjective(const std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)>& fock_matrix_function, const double precision=1.0e-08) :
         precision (precision),
-        sq_hamiltonian (sq_hamiltonian)
+        fock_matrix_function (fock_matrix_function)
     {}
 
 
+    /**
+     *  @param sq_hamiltonian       the Hamiltonian expressed in a scalar basis
+     *  @param precision            the precision with which the diagonality of the Fock matrix should be checked
+     */
+    DiagonalRHFFockMatrixObjective(const SQHamiltonian<Scalar>& sq_hamiltonian, const double precision=1.0e-08) :
+        precision (precision)
+    {
+        const auto sq_hamiltonian_ptr = std::make_shared<const SQHamiltonian<Scalar>>(sq_hamiltonian);  // copies of this objective share the Hamiltonian
+        this->fock_matrix_function = [sq_hamiltonian_ptr] (const OneRDM<Scalar>& D) {
+            return QCMatrix<Scalar>{QCModel::RHF<Scalar>::calculateScalarBasisFockMatrix(D, *sq_hamiltonian_ptr).parameters()};
+        };
+    }
+
+
     /*
      *  PUBLIC METHODS
      */
@@ -76,7 +94,7 @@ public:
         const auto D = QCModel::RHF<Scalar>::calculateScalarBasis1RDM(C, 2*N_P);
 
         // Calculate the Fock matrix in the orthonormal spinor and check if it is diagonal
-        auto F_orthonormal = QCModel::RHF<Scalar>::calculateScalarBasisFockMatrix(D, this->sq_hamiltonian);  // the converged Fock matrix (expressed in the scalar orbital basis)
+        ScalarSQOneElectronOperator<Scalar> F_orthonormal {this->fock_matrix_function(D)};  // the converged Fock matrix (expressed in the scalar orbital basis)
         F_orthonormal.transform(C);  // now in the orthonormal spinor basis
         return F_orthonormal.parameters().isDiagonal(this->precision);
     }
@@ -55,7 +55,7 @@ public:
 
         const auto& D = environment.density_matrices.back();  // the most recent density matrix
         const ScalarSQOneElectronOperator<Scalar> F {environment.fock_matrices.back()};  // the most recent Fock matrix
-        const auto& H_core = environment.sq_hamiltonian.core();  // the core Hamiltonian matrix
+        const ScalarSQOneElectronOperator<Scalar> H_core {environment.H_core};  // the core Hamiltonian matrix
 
         const auto E_electronic = QCModel::RHF<double>::calculateElectronicEnergy(D, H_core, F);
         environment.electronic_energies.push_back(E_electronic);
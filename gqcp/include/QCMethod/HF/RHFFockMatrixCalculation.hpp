@@ -29,6 +29,8 @@ namespace GQCP {
 /**
  *  An iteration step that calculates the current Fock matrix (expressed in the scalar/AO basis) from the current density matrix.
  * 
+ *  If the environment provides a Fock matrix function, it is used instead of the (dense) Hamiltonian of the environment.
+ * 
  *  @tparam _Scalar              the scalar type used to represent the expansion coefficient/elements of the transformation matrix
  */
 template <typename _Scalar>
@@ -53,8 +55,13 @@ public:
      */
     void execute(Environment& environment) override {
         const auto& D = environment.density_matrices.back();  // the most recent density matrix
-        const auto F = QCModel::RHF<double>::calculateScalarBasisFockMatrix(D, environment.sq_hamiltonian);
-        environment.fock_matrices.push_back(F.parameters());
+
+        if (environment.fock_matrix_function) {  // the two-electron integrals aren't stored in the Hamiltonian
+            environment.fock_matrices.push_back(environment.fock_matrix_function(D));
+        } else {
+            const auto F = QCModel::RHF<double>::calculateScalarBasisFockMatrix(D, environment.sq_hamiltonian);
+            environment.fock_matrices.push_back(F.parameters());
+        }
     }
 };
 
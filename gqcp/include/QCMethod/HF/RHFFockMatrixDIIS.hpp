@@ -95,8 +95,9 @@ public:
         const std::vector<VectorX<Scalar>> error_vectors (environment.error_vectors.end() - n, environment.error_vectors.end());  // the n-th last error vectors
         const std::vector<QCMatrix<Scalar>> fock_matrices (environment.fock_matrices.end() - n, environment.fock_matrices.end());  // the n-th last Fock matrices
 
-        // Calculate the accelerated Fock matrix and do a diagonalization step on it
-        const auto F_accelerated = this->diis.accelerate(fock_matrices, error_vectors);
+        // Calculate the accelerated Fock matrix and do a diagonalization step on it. The error vectors are identified by their index in the sequence of all error vectors, so that DIIS can re-use the inner products between the ones it has already seen.
+        const auto first_index = environment.number_of_discarded_error_vectors + environment.error_vectors.size() - n;
+        const auto F_accelerated = this->diis.accelerate(fock_matrices, error_vectors, first_index);
 
         environment.fock_matrices.push_back(F_accelerated);  // the diagonalization step can only read from the environment
         RHFFockMatrixDiagonalization<Scalar>().execute(environment);
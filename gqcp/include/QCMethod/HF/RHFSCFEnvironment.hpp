@@ -22,10 +22,13 @@
 #include "Mathematical/Representation/QCMatrix.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 #include "Processing/RDM/OneRDM.hpp"
+#include "QCModel/HF/RHF.hpp"
 
 #include <Eigen/Dense>
 
 #include <deque>
+#include <functional>
+#include <memory>
 
 
 namespace GQCP {
@@ -57,8 +60,12 @@ public:
     std::deque<OneRDM<Scalar>> density_matrices;  // expressed in the scalar (AO) basis
     std::deque<QCMatrix<Scalar>> fock_matrices;  // expressed in the scalar (AO) basis
     std::deque<VectorX<Scalar>> error_vectors;  // expressed in the scalar (AO) basis, used when doing DIIS calculations: the real error matrices should be converted to column-major error vectors for the DIIS algorithm to be used correctly
+    size_t number_of_discarded_error_vectors = 0;  // the number of error vectors that were removed from the front of their history, so that every error vector can be identified by its index in the sequence of all error vectors
 
-    SQHamiltonian<Scalar> sq_hamiltonian;  // the Hamiltonian expressed in the scalar (AO) basis
+    SQHamiltonian<Scalar> sq_hamiltonian;  // the Hamiltonian expressed in the scalar (AO) basis, which is left empty if the Fock matrix is calculated by the fock_matrix_function
+    QCMatrix<Scalar> H_core;  // the core Hamiltonian matrix, expressed in the scalar (AO) basis
+
+    std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)> fock_matrix_function;  // if set, calculates the Fock matrix (expressed in the scalar (AO) basis) from a density matrix, so that the two-electron integrals don't have to be stored as a dense tensor in the sq_hamiltonian (e.g. density-fitted or memory-mapped integrals)
 
 
 public:
@@ -79,6 +86,7 @@ public:
         N (N),
         S (S),
         sq_hamiltonian (sq_hamiltonian),
+        H_core (sq_hamiltonian.core().parameters()),
         coefficient_matrices(1, C_initial)
     {
         if (this->N % 2 != 0) {  // if the total number of electrons is odd
@@ -87,6 +95,28 @@ public:
     }
 
 
+    /**
+     *  A constructor that initializes the environment with an initial guess for the coefficient matrix, in which the Fock matrix is calculated by the given function instead of from a dense Hamiltonian
+     * 
+     *  @param N                        the total number of electrons
+     *  @param H_core                   the core Hamiltonian matrix, expressed in the scalar (AO) basis
+     *  @param fock_matrix_function     a function that calculates the Fock matrix (expressed in the scalar (AO) basis) from a density matrix
+     *  @param S                        the overlap matrix (of the scalar (AO) basis)
+     *  @param C_initial                the initial coefficient matrix
+     */
+    RHFSCFEnvironment(const size_t N, const QCMatrix<Scalar>& H_core, const std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)>& fock_matrix_function, const QCMatrix<Scalar>& S, const TransformationMatrix<Scalar>& C_initial) :
+        N (N),
+        S (S),
+        H_core (H_core),
+        fock_matrix_function (fock_matrix_function),
+        coefficient_matrices(1, C_initial)
+    {
+        if (this->N % 2 != 0) {  // if the total number of electrons is odd
+            throw std::invalid_argument("RHFSCFEnvironment::RHFSCFEnvironment(const size_t, const QCMatrix<Scalar>&, const std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)>&, const QCMatrix<Scalar>&, const TransformationMatrix<Scalar>&): You have given an odd number of electrons.");
+        }
+    }
+
+
     /*
      *  NAMED CONSTRUCTORS
      */
@@ -108,6 +138,90 @@ public:
 
         return RHFSCFEnvironment<Scalar>(N, sq_hamiltonian, S, C_initial);
     }
+
+
+    /**
+     *  Initialize an RHF SCF environment with an initial coefficient matrix that is obtained by diagonalizing the core Hamiltonian matrix, in which the Fock matrix is calculated by the given function.
+     * 
+     *  @param N                        the total number of electrons
+     *  @param H_core                   the core Hamiltonian matrix, expressed in the scalar (AO) basis
+     *  @param fock_matrix_function     a function that calculates the Fock matrix (expressed in the scalar (AO) basis) from a density matrix
+     *  @param S                        the overlap matrix (of the scalar (AO) basis)
+     */
+    static RHFSCFEnvironment<Scalar> WithCoreGuess(const size_t N, const QCMatrix<Scalar>& H_core, const std::function<QCMatrix<Scalar> (const OneRDM<Scalar>&)>& fock_matrix_function, const QCMatrix<Scalar>& S) {
+
+        using MatrixType = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+        Eigen::GeneralizedSelfAdjointEigenSolver<MatrixType> generalized_eigensolver (H_core, S);
+        const TransformationMatrix<Scalar> C_initial = generalized_eigensolver.eigenvectors();
+
+        return RHFSCFEnvironment<Scalar>(N, H_core, fock_matrix_function, S, C_initial);
+    }
+
+
+    /**
+     *  Initialize an RHF SCF environment with an initial coefficient matrix that is obtained by diagonalizing the core Hamiltonian matrix, in which the Fock matrix is calculated from two-electron integrals that aren't stored as a dense tensor.
+     * 
+     *  @tparam TwoElectronIntegrals    the type of the two-electron integrals, i.e. DFTwoElectronOperator, MemoryMappedRankFourTensor or SymmetryPackedRankFourTensor
+     * 
+     *  @param N                        the total number of electrons
+     *  @param H_core                   the core Hamiltonian matrix, expressed in the scalar (AO) basis
+     *  @param g                        the two-electron integrals, expressed in the scalar (AO) basis, which are shared with the environment instead of being copied
+     *  @param S                        the overlap matrix (of the scalar (AO) basis)
+     */
+    template <typename TwoElectronIntegrals>
+    static RHFSCFEnvironment<Scalar> WithCoreGuess(const size_t N, const QCMatrix<Scalar>& H_core, const std::shared_ptr<TwoElectronIntegrals>& g, const QCMatrix<Scalar>& S) {
+
+        const auto fock_matrix_function = [H_core, g] (const OneRDM<Scalar>& D) {
+            return QCMatrix<Scalar>{QCModel::RHF<Scalar>::calculateScalarBasisFockMatrix(D, H_core, *g).parameters()};
+        };
+
+        return RHFSCFEnvironment<Scalar>::WithCoreGuess(N, H_core, fock_matrix_function, S);
+    }
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  Limit the history of the iterates in this environment by removing the oldest entries, such that every history contains at most the given number of entries.
+     * 
+     *  @param history_size         the maximum number of entries that are kept for every type of iterate
+     */
+    void truncateHistory(const size_t history_size) {
+
+        truncate(this->electronic_energies, history_size);
+        truncate(this->orbital_energies, history_size);
+        truncate(this->coefficient_matrices, history_size);
+        truncate(this->density_matrices, history_size);
+        truncate(this->fock_matrices, history_size);
+
+        if (this->error_vectors.size() > history_size) {
+            this->number_of_discarded_error_vectors += this->error_vectors.size() - history_size;
+        }
+        truncate(this->error_vectors, history_size);
+    }
+
+
+private:
+
+    /*
+     *  PRIVATE METHODS
+     */
+
+    /**
+     *  Remove the oldest entries of the given history, such that it contains at most the given number of entries.
+     * 
+     *  @param history              the history of an iterate
+     *  @param history_size         the maximum number of entries that should be kept
+     */
+    template <typename T>
+    static void truncate(std::deque<T>& history, const size_t history_size) {
+
+        while (history.size() > history_size) {
+            history.pop_front();
+        }
+    }
 };
 
 
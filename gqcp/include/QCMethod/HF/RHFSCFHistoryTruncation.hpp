@@ -0,0 +1,80 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once 
+
+
+#include "Mathematical/Algorithm/Step.hpp"
+#include "QCMethod/HF/RHFSCFEnvironment.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  An iteration step that limits the history of the iterates in the environment, so that only the most recent iterates are kept in memory.
+ * 
+ *  @tparam _Scalar              the scalar type used to represent the expansion coefficient/elements of the transformation matrix
+ */
+template <typename _Scalar>
+class RHFSCFHistoryTruncation :
+    public Step<RHFSCFEnvironment<_Scalar>> {
+
+public:
+    using Scalar = _Scalar;
+    using Environment = RHFSCFEnvironment<Scalar>;
+
+
+private:
+    size_t history_size;  // the maximum number of entries that are kept for every type of iterate
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param history_size         the maximum number of entries that are kept for every type of iterate
+     */
+    RHFSCFHistoryTruncation(const size_t history_size) :
+        history_size (history_size)
+    {
+        if (history_size < 2) {
+            throw std::invalid_argument("RHFSCFHistoryTruncation::RHFSCFHistoryTruncation(const size_t): The convergence criterion needs at least two consecutive iterates.");
+        }
+    }
+
+
+    /*
+     *  OVERRIDDEN PUBLIC METHODS
+     */
+
+    /**
+     *  Remove the oldest iterates from the environment.
+     * 
+     *  @param environment              the environment that acts as a sort of calculation space
+     */
+    void execute(Environment& environment) override {
+
+        environment.truncateHistory(this->history_size);
+    }
+};
+
+
+}  // namespace GQCP
@@ -28,6 +28,9 @@
 #include "QCMethod/HF/RHFFockMatrixDiagonalization.hpp"
 #include "QCMethod/HF/RHFFockMatrixDIIS.hpp"
 #include "QCMethod/HF/RHFSCFEnvironment.hpp"
+#include "QCMethod/HF/RHFSCFHistoryTruncation.hpp"
+
+#include <algorithm>
 
 
 namespace GQCP {
@@ -101,10 +104,11 @@ public:
     /**
      *  @param threshold                            the threshold that is used in comparing the density matrices
      *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+     *  @param truncate_history                     if only the most recent iterates that DIIS can still use should be kept in the environment, instead of the whole history
      * 
      *  @return a DIIS RHF SCF solver that uses the norm of the difference of two consecutive density matrices as a convergence criterion
      */
-    static IterativeAlgorithm<RHFSCFEnvironment<Scalar>> DIIS(const size_t minimum_subspace_dimension = 6, const size_t maximum_subspace_dimension = 6, const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128) {
+    static IterativeAlgorithm<RHFSCFEnvironment<Scalar>> DIIS(const size_t minimum_subspace_dimension = 6, const size_t maximum_subspace_dimension = 6, const double threshold = 1.0e-08, const size_t maximum_number_of_iterations = 128, const bool truncate_history = false) {
 
         // Create the iteration cycle that effectively 'defines' a DIIS RHF SCF solver
         StepCollection<RHFSCFEnvironment<Scalar>> diis_rhf_scf_cycle {};
@@ -114,6 +118,10 @@ public:
                           .add(RHFFockMatrixDIIS<Scalar>(minimum_subspace_dimension, maximum_subspace_dimension))  // this also calculates the next coefficient matrix
                           .add(RHFElectronicEnergyCalculation<Scalar>());
 
+        if (truncate_history) {
+            diis_rhf_scf_cycle.add(RHFSCFHistoryTruncation<Scalar>(std::max({minimum_subspace_dimension, maximum_subspace_dimension, static_cast<size_t>(2)})));  // DIIS only needs the most recent iterates, so we don't have to keep the whole history in memory
+        }
+
         // Create a convergence criterion on the norm of subsequent density matrices
         const std::function<std::deque<OneRDM<Scalar>>(const RHFSCFEnvironment<Scalar>&)> density_matrix_extractor = [] (const RHFSCFEnvironment<Scalar>& environment) { return environment.density_matrices; };
         const ConsecutiveIteratesNormConvergence<OneRDM<Scalar>, RHFSCFEnvironment<Scalar>> convergence_criterion (threshold, density_matrix_extractor);
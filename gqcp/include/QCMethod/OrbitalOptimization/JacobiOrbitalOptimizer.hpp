@@ -21,6 +21,8 @@
 #include "Basis/SpinorBasis/JacobiRotationParameters.hpp"
 #include "QCMethod/OrbitalOptimization/BaseOrbitalOptimizer.hpp"
 
+#include <vector>
+
 
 namespace GQCP {
 
@@ -35,6 +37,10 @@ protected:
     using pair_type = std::pair<JacobiRotationParameters, double>;
     pair_type optimal_jacobi_with_scalar;  // holds the optimal Jacobi parameters and the corresponding value for the scalar function trying to optimize
 
+    std::vector<pair_type> jacobi_candidates;  // the cached optimal Jacobi parameters and corresponding scalar function changes for every orbital pair p>q, stored at the index p*(p-1)/2 + q
+    bool are_candidates_cached = false;  // if the cached Jacobi candidates correspond to an earlier iteration
+    size_t candidates_iteration = 0;  // the iteration number at which the Jacobi candidates were last updated
+
 
 public:
     // CONSTRUCTORS
@@ -84,6 +90,14 @@ public:
     virtual double calculateScalarFunctionChange(const SQHamiltonian<double>& sq_hamiltonian, const JacobiRotationParameters& jacobi_rot_par) const = 0;
 
 
+    // PUBLIC VIRTUAL METHODS
+
+    /**
+     *  @return if the Jacobi coefficients for the orbital pair (p,q) only depend on the orbitals p and q themselves. If so, a Jacobi rotation of (p,q) only changes the Jacobi candidates of orbital pairs that involve p or q, so that the other cached candidates can be re-used in the next iteration
+     */
+    virtual bool areJacobiCoefficientsLocal() const { return false; }
+
+
     // PUBLIC OVERRIDDEN METHODS
 
     /**
@@ -108,10 +122,21 @@ public:
 
     // PUBLIC METHODS
 
+    /**
+     *  @param sq_hamiltonian           the Hamiltonian
+     *  @param p                        the index of spatial orbital 1
+     *  @param q                        the index of spatial orbital 2
+     * 
+     *  @return the optimal Jacobi rotation parameters for the orbital pair (p,q) and the corresponding change in the scalar function
+     */
+    pair_type calculateJacobiCandidate(const SQHamiltonian<double>& sq_hamiltonian, const size_t p, const size_t q);
+
     /**
      *  @param sq_hamiltonian           the Hamiltonian
      * 
      *  @return the optimal Jacobi rotation and the corresponding value for the scalar function that can be obtained when the Jacobi rotation would have taken place
+     * 
+     *  @note If the Jacobi coefficients are local (see areJacobiCoefficientsLocal()) and exactly one (optimal) Jacobi rotation has been performed since the previous call, only the candidates of the orbital pairs that involve the rotated orbitals are recalculated
      */
     std::pair<JacobiRotationParameters, double> calculateOptimalJacobiParameters(const SQHamiltonian<double>& sq_hamiltonian);
 
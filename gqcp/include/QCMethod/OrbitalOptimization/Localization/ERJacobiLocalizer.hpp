@@ -39,6 +39,11 @@ public:
 
     // PUBLIC OVERRIDDEN METHODS
 
+    /**
+     *  @return if the Jacobi coefficients for the orbital pair (i,j) only depend on the orbitals i and j themselves, which is the case for the Edmiston-Ruedenberg localization index
+     */
+    bool areJacobiCoefficientsLocal() const override { return true; }
+
     /**
      *  Prepare this object (i.e. the context for the orbital optimization algorithm) to be able to check for convergence
      */
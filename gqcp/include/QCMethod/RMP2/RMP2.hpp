@@ -19,6 +19,7 @@
 
 
 #include "Molecule/Molecule.hpp"
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 #include "QCModel/HF/RHF.hpp"
 
@@ -35,5 +36,17 @@ namespace GQCP {
  */
 double calculateRMP2EnergyCorrection(const SQHamiltonian<double>& sq_hamiltonian, const Molecule& molecule, const QCModel::RHF<double>& rhf_parameters);
 
+/**
+ *  @param g                        the density-fitted or Cholesky-decomposed two-electron integrals, expressed in the scalar basis in which the RHF orbitals are expanded
+ *  @param molecule                 the molecule for which the energy correction should be calculated
+ *  @param rhf_parameters           the converged solution to the RHF SCF equations
+ *  @param batch_size               the number of occupied orbitals i for which the integrals (i a|j b) are formed at once
+ *
+ *  @return the RMP2 energy correction
+ * 
+ *  @note Only the factors (a i|P) are transformed to the RHF orbitals. For every batch of occupied orbitals i, the integrals (i a|j b) with j <= i are then formed by one matrix-matrix product, so that at most batch_size*N_occ*N_virt^2 of them are kept in memory.
+ */
+double calculateRMP2EnergyCorrection(const DFTwoElectronOperator& g, const Molecule& molecule, const QCModel::RHF<double>& rhf_parameters, const size_t batch_size = 16);
+
 
 }  // namespace GQCP
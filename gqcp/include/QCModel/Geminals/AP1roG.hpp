@@ -22,6 +22,7 @@
 #include "Mathematical/Representation/BlockRankFourTensor.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 #include "QCModel/Geminals/AP1roGGeminalCoefficients.hpp"
+#include "QCModel/Geminals/GeminalPairIntegrals.hpp"
 
 
 namespace GQCP {
@@ -69,9 +70,19 @@ public:
      *  @param a                        the superscript for the coordinate function
      *
      *  @return the PSE coordinate function with given indices (i,a) at the given geminal coefficients
+     * 
+     *  @note This element-wise evaluation accesses the full two-electron integrals: to evaluate all the coordinate functions, use calculatePSECoordinateFunctions()
      */
     static double calculatePSECoordinateFunction(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G, const size_t i, const size_t a);
 
+    /**
+     *  @param pair_integrals           the pair integrals of the Hamiltonian expressed in an orthonormal basis
+     *  @param G                        the AP1roG geminal coefficients
+     *
+     *  @return the PSEs, evaluated at the given geminal coefficients
+     */
+    static BlockMatrix<double> calculatePSECoordinateFunctions(const GeminalPairIntegrals& pair_integrals, const AP1roGGeminalCoefficients& G);
+
     /**
      *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
      *  @param G                        the AP1roG geminal coefficients
@@ -97,9 +108,19 @@ public:
      *  @param b                    the superscript for the geminal coefficient
      *
      *  @return the Jacobian element with compound indices (i,a) and (j,b) at the given geminal coefficients
+     * 
+     *  @note This element-wise evaluation accesses the full two-electron integrals: to evaluate the full Jacobian, use calculatePSEJacobian()
      */
     static double calculatePSEJacobianElement(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G, const size_t i, const size_t a, const size_t j, const size_t b);
 
+    /**
+     *  @param pair_integrals       the pair integrals of the Hamiltonian expressed in an orthonormal basis
+     *  @param G                    the AP1roG geminal coefficients
+     *
+     *  @return the Jacobian J_{ia,jb} of the PSEs, i.e. df_i^a/dG_j^b, evaluated at the given geminal coefficients
+     */
+    static BlockRankFourTensor<double> calculatePSEJacobian(const GeminalPairIntegrals& pair_integrals, const AP1roGGeminalCoefficients& G);
+
     /**
      *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
      *  @param G                    the AP1roG geminal coefficients
@@ -114,6 +114,22 @@ public:
      *  @return the overlap of the APIG wave function with the given ONV, i.e. the projection of the APIG wave function onto that ONV
      */
     double overlap(const SpinUnresolvedONV& onv) const override;
+
+    /**
+     *  @param onv_basis       the seniority-zero spin-resolved ONV basis whose ONVs should be projected on
+     *
+     *  @return the overlaps of the APIG wave function with all the ONVs of the given ONV basis, in the order of their addresses
+     *
+     *  @note The overlaps are calculated as permanents using Glynn's formula, but the column sums that are needed for each sign vector are shared among all ONVs, and the partial products of the column sums are shared between ONVs that share their highest occupied orbitals. The ONVs are evaluated in parallel.
+     */
+    VectorX<double> overlaps(const SeniorityZeroONVBasis& onv_basis) const;
+
+    /**
+     *  @param onv_basis       the seniority-zero spin-resolved ONV basis the wave function should live in
+     *
+     *  @return the wave function expansion corresponding to the geminal coefficients
+     */
+    LinearExpansion<SeniorityZeroONVBasis> toLinearExpansion(const SeniorityZeroONVBasis& onv_basis) const override;
 };
 
 
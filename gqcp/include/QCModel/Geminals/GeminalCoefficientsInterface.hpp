@@ -44,7 +44,7 @@ public:
      *
      *  @return the wave function expansion corresponding to the geminal coefficients
      */
-    LinearExpansion<SeniorityZeroONVBasis> toLinearExpansion(const SeniorityZeroONVBasis& onv_basis) const;
+    virtual LinearExpansion<SeniorityZeroONVBasis> toLinearExpansion(const SeniorityZeroONVBasis& onv_basis) const;
 };
 
 
@@ -0,0 +1,83 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  The 'pair' integrals of a Hamiltonian that appear in the equations for geminal wave function models: for the two-electron integrals, these are the (K x K)-matrices g_ppqq, g_pqqp and g_pqpq.
+ * 
+ *  Extracting these once avoids repeatedly accessing scattered elements of the full rank-four tensor, and it allows the geminal equations to be formulated in terms of matrix products.
+ */
+class GeminalPairIntegrals {
+private:
+    VectorX<double> h_diagonal;  // the diagonal of the core Hamiltonian, h_pp
+    SquareMatrix<double> J;  // the Coulomb-type integrals g_ppqq
+    SquareMatrix<double> K;  // the exchange-type integrals g_pqqp
+    SquareMatrix<double> X;  // the pair excitation integrals g_pqpq
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+     */
+    GeminalPairIntegrals(const SQHamiltonian<double>& sq_hamiltonian);
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @return the diagonal of the core Hamiltonian, h_pp
+     */
+    const VectorX<double>& coreDiagonal() const { return this->h_diagonal; }
+
+    /**
+     *  @return the Coulomb-type integrals g_ppqq
+     */
+    const SquareMatrix<double>& coulomb() const { return this->J; }
+
+    /**
+     *  @return the number of orbitals these pair integrals are expressed in
+     */
+    size_t dimension() const { return this->h_diagonal.size(); }
+
+    /**
+     *  @return the exchange-type integrals g_pqqp
+     */
+    const SquareMatrix<double>& exchange() const { return this->K; }
+
+    /**
+     *  @return the pair excitation integrals g_pqpq
+     */
+    const SquareMatrix<double>& pairExcitation() const { return this->X; }
+};
+
+
+}  // namespace GQCP
@@ -20,8 +20,11 @@
 
 #include "Basis/TransformationMatrix.hpp"
 #include "Mathematical/Representation/BlockRankFourTensor.hpp"
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
 #include "Mathematical/Representation/SquareMatrix.hpp"
 #include "Mathematical/Representation/QCMatrix.hpp"
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 #include "Operator/SecondQuantized/SQOneElectronOperator.hpp"
 #include "Processing/RDM/OneRDM.hpp"
@@ -173,6 +176,51 @@ public:
     }
 
 
+    /**
+     *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the two-electron integrals, which are stored out-of-core
+     *
+     *  @param D                    the RHF density matrix in a scalar basis
+     *  @param H_core               the core Hamiltonian expressed in the same scalar basis
+     *  @param g                    the memory-mapped two-electron integrals expressed in the same scalar basis
+     *
+     *  @return the RHF Fock matrix expressed in the scalar basis
+     */
+    static ScalarSQOneElectronOperator<double> calculateScalarBasisFockMatrix(const OneRDM<double>& D, const SquareMatrix<double>& H_core, const MemoryMappedRankFourTensor& g) {
+
+        return ScalarSQOneElectronOperator<double>{H_core + g.calculateCoulombMatrix(D) - 0.5 * g.calculateExchangeMatrix(D)};
+    }
+
+
+    /**
+     *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the symmetry-packed two-electron integrals
+     *
+     *  @param D                    the RHF density matrix in a scalar basis
+     *  @param H_core               the core Hamiltonian expressed in the same scalar basis
+     *  @param g                    the symmetry-packed two-electron integrals expressed in the same scalar basis
+     *
+     *  @return the RHF Fock matrix expressed in the scalar basis
+     */
+    static ScalarSQOneElectronOperator<double> calculateScalarBasisFockMatrix(const OneRDM<double>& D, const SquareMatrix<double>& H_core, const SymmetryPackedRankFourTensor& g) {
+
+        return ScalarSQOneElectronOperator<double>{H_core + g.calculateCoulombMatrix(D) - 0.5 * g.calculateExchangeMatrix(D)};
+    }
+
+
+    /**
+     *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the density-fitted two-electron integrals
+     *
+     *  @param D                    the RHF density matrix in a scalar basis
+     *  @param H_core               the core Hamiltonian expressed in the same scalar basis
+     *  @param g                    the density-fitted two-electron integrals expressed in the same scalar basis
+     *
+     *  @return the RHF Fock matrix expressed in the scalar basis
+     */
+    static ScalarSQOneElectronOperator<double> calculateScalarBasisFockMatrix(const OneRDM<double>& D, const SquareMatrix<double>& H_core, const DFTwoElectronOperator& g) {
+
+        return ScalarSQOneElectronOperator<double>{H_core + g.calculateCoulombMatrix(D) - 0.5 * g.calculateExchangeMatrix(D)};
+    }
+
+
     /**
      *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
      *  @param N_P                  the number of electron pairs
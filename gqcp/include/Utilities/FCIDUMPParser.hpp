@@ -0,0 +1,175 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  One line in the body of an FCIDUMP file: an integral value, followed by four (1-based) orbital indices.
+ * 
+ *  Based on which indices are zero, the record represents (http://hande.readthedocs.io/en/latest/manual/integrals.html)
+ *      - a two-electron integral (i a|j b) in chemist's notation, if all indices are non-zero;
+ *      - a one-electron integral h(i,a), if j and b are zero;
+ *      - an orbital energy, if a, j and b are zero;
+ *      - the core energy, if all indices are zero.
+ */
+struct FCIDUMPRecord {
+    double value;
+    size_t i;
+    size_t a;
+    size_t j;
+    size_t b;
+};
+
+
+/**
+ *  A parser for FCIDUMP files that reads the file in chunks of bounded size, and parses every chunk with multiple threads.
+ */
+class FCIDUMPParser {
+private:
+    std::string filename;  // the name of the FCIDUMP file
+    size_t K;  // the number of orbitals (NORB)
+    size_t N;  // the number of electrons (NELEC), or 0 if it wasn't given
+    std::streamoff body_offset;  // the position in the file at which the records start
+    size_t chunk_size;  // the number of bytes that are read (and parsed) at once
+
+
+public:
+    // CONSTRUCTORS
+
+    /**
+     *  Read the header of an FCIDUMP file.
+     * 
+     *  @param fcidump_file             the name of the FCIDUMP file
+     *  @param chunk_size               the number of bytes that are read (and parsed) at once
+     */
+    FCIDUMPParser(const std::string& fcidump_file, const size_t chunk_size = 64 * 1024 * 1024);
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  Call the given function for every record in the body of the FCIDUMP file.
+     * 
+     *  @tparam Function            the type of a function that accepts a const FCIDUMPRecord&
+     * 
+     *  @param function             the function that should be called for every record
+     * 
+     *  @note Every chunk is parsed by multiple threads into separate record buffers, but the function is called from a single thread, in the order in which the records appear in the file. The function can therefore freely write to shared memory, and if a file contains a value more than once, the last one wins.
+     */
+    template <typename Function>
+    void forEachRecord(const Function& function) const {
+
+        std::ifstream file (this->filename, std::ios::binary);
+        file.seekg(this->body_offset);
+
+        std::string chunk;
+        std::string remainder;  // the incomplete last line of the previous chunk
+        while (this->readChunk(file, chunk, remainder)) {
+            const auto boundaries = FCIDUMPParser::splitAtLines(chunk);
+            std::vector<std::vector<FCIDUMPRecord>> records (boundaries.size() - 1);  // the parsed records, for every part of the chunk
+
+            std::exception_ptr exception = nullptr;  // exceptions can't leave an OpenMP region, so we rethrow the first one afterwards
+
+            #pragma omp parallel for schedule(dynamic)
+            for (size_t part = 0; part < boundaries.size() - 1; part++) {
+                try {
+                    const char* cursor = chunk.data() + boundaries[part];
+                    const char* end = chunk.data() + boundaries[part + 1];
+
+                    FCIDUMPRecord record;
+                    while (FCIDUMPParser::parseRecord(cursor, end, record)) {
+                        records[part].push_back(record);
+                    }
+                } catch (...) {
+                    #pragma omp critical
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                }
+            }
+
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+
+            for (const auto& part_records : records) {
+                for (const auto& record : part_records) {
+                    function(record);
+                }
+            }
+        }
+    }
+
+    /**
+     *  @return the number of electrons (NELEC) in the header, or 0 if it wasn't given
+     */
+    size_t numberOfElectrons() const { return this->N; }
+
+    /**
+     *  @return the number of orbitals (NORB) in the header
+     */
+    size_t numberOfOrbitals() const { return this->K; }
+
+
+private:
+    // PRIVATE METHODS
+
+    /**
+     *  Read the next chunk of complete lines from the file.
+     * 
+     *  @param file                 the file stream
+     *  @param chunk                the chunk, on output
+     *  @param remainder            the incomplete line at the end of the previous chunk, which is updated for the next chunk
+     * 
+     *  @return if a (non-empty) chunk was read
+     */
+    bool readChunk(std::ifstream& file, std::string& chunk, std::string& remainder) const;
+
+
+    // PRIVATE STATIC METHODS
+
+    /**
+     *  Parse the record at the given position.
+     * 
+     *  @param cursor               the position at which parsing starts, which is moved to the start of the next line
+     *  @param end                  the end of the part of the chunk that should be parsed
+     *  @param record               the parsed record, on output
+     * 
+     *  @return if a record was found before the end
+     */
+    static bool parseRecord(const char*& cursor, const char* end, FCIDUMPRecord& record);
+
+    /**
+     *  @param chunk                a chunk of complete lines
+     * 
+     *  @return the offsets that split the chunk into parts of (approximately) equal size, which all start at the beginning of a line
+     */
+    static std::vector<size_t> splitAtLines(const std::string& chunk);
+};
+
+
+}  // namespace GQCP
@@ -0,0 +1,133 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A file that is mapped into memory, so that its contents can be accessed as if they were in RAM, while the operating system pages them in and out of the file.
+ * 
+ *  The mapping is released (and changes are written back to the file) upon destruction. Since a mapping can't be shared, this class can only be moved, not copied.
+ */
+class MemoryMappedFile {
+private:
+    std::string path;  // the path to the mapped file
+    int file_descriptor;  // the POSIX file descriptor of the opened file
+    void* address;  // the start of the mapping
+    size_t number_of_bytes;  // the size of the mapping
+    bool is_writable;  // if the mapping allows writing
+
+
+private:
+    // PRIVATE CONSTRUCTORS
+
+    /**
+     *  @param path                 the path to the file that should be mapped
+     *  @param file_descriptor      the POSIX file descriptor of the opened file
+     *  @param number_of_bytes      the size of the file
+     *  @param is_writable          if the mapping should allow writing
+     */
+    MemoryMappedFile(const std::string& path, const int file_descriptor, const size_t number_of_bytes, const bool is_writable);
+
+
+public:
+    // CONSTRUCTORS
+
+    MemoryMappedFile(const MemoryMappedFile& other) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other);
+
+
+    // DESTRUCTOR
+    ~MemoryMappedFile();
+
+
+    // NAMED CONSTRUCTORS
+
+    /**
+     *  Create a new file (or overwrite an existing one) with the given size, filled with zeros, and map it into memory for reading and writing.
+     * 
+     *  @param path                 the path to the file that should be created
+     *  @param number_of_bytes      the size of the file
+     */
+    static MemoryMappedFile Create(const std::string& path, const size_t number_of_bytes);
+
+    /**
+     *  Map an existing file into memory.
+     * 
+     *  @param path                 the path to the file that should be mapped
+     *  @param is_writable          if the mapping should allow writing
+     */
+    static MemoryMappedFile Open(const std::string& path, const bool is_writable = false);
+
+
+    // OPERATORS
+
+    MemoryMappedFile& operator=(const MemoryMappedFile& other) = delete;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other);
+
+
+    // PUBLIC METHODS
+
+    /**
+     *  @return a pointer to the start of the mapping
+     */
+    char* data() { return static_cast<char*>(this->address); }
+
+    /**
+     *  @return a pointer to the start of the mapping
+     */
+    const char* data() const { return static_cast<const char*>(this->address); }
+
+    /**
+     *  @return the path to the mapped file
+     */
+    const std::string& filename() const { return this->path; }
+
+    /**
+     *  Write the changes in the mapping back to the file.
+     */
+    void flush();
+
+    /**
+     *  @return if the mapping allows writing
+     */
+    bool isWritable() const { return this->is_writable; }
+
+    /**
+     *  @return the size of the mapping, in bytes
+     */
+    size_t size() const { return this->number_of_bytes; }
+
+
+private:
+    // PRIVATE METHODS
+
+    /**
+     *  Release the mapping and close the file.
+     */
+    void release();
+};
+
+
+}  // namespace GQCP
@@ -26,9 +26,13 @@
 #include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
 #include "Basis/Integrals/Interfaces/LibintOneElectronIntegralBuffer.hpp"
 #include "Basis/Integrals/Interfaces/LibintOneElectronIntegralEngine.hpp"
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
+#include "Basis/Integrals/Interfaces/LibintThreeCenterIntegralEngine.hpp"
+#include "Basis/Integrals/Interfaces/LibintTwoCenterIntegralEngine.hpp"
 #include "Basis/Integrals/Interfaces/LibintTwoElectronIntegralBuffer.hpp"
 #include "Basis/Integrals/Interfaces/LibintTwoElectronIntegralEngine.hpp"
 
+#include "Basis/Integrals/AOIntegralCache.hpp"
 #include "Basis/Integrals/BaseOneElectronIntegralBuffer.hpp"
 #include "Basis/Integrals/BaseOneElectronIntegralEngine.hpp"
 #include "Basis/Integrals/BaseTwoElectronIntegralBuffer.hpp"
@@ -39,6 +43,8 @@
 #include "Basis/ScalarBasis/CartesianExponents.hpp"
 #include "Basis/ScalarBasis/CartesianGTO.hpp"
 #include "Basis/ScalarBasis/GTOBasisSet.hpp"
+#include "Basis/ScalarBasis/GTOBasisSetCache.hpp"
+#include "Basis/ScalarBasis/GTOGridEvaluator.hpp"
 #include "Basis/ScalarBasis/GTOShell.hpp"
 #include "Basis/ScalarBasis/ShellSet.hpp"
 #include "Basis/ScalarBasis/ScalarBasis.hpp"
@@ -92,10 +98,12 @@
 #include "Mathematical/Representation/BlockMatrix.hpp"
 #include "Mathematical/Representation/BlockRankFourTensor.hpp"
 #include "Mathematical/Representation/Matrix.hpp"
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
 #include "Mathematical/Representation/QCMatrix.hpp"
 #include "Mathematical/Representation/QCRankFourTensor.hpp"
 #include "Mathematical/Representation/SquareMatrix.hpp"
 #include "Mathematical/Representation/SquareRankFourTensor.hpp"
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
 #include "Mathematical/Representation/Tensor.hpp"
 
 #include "Mathematical/CartesianDirection.hpp"
@@ -138,11 +146,17 @@
 #include "Operator/SecondQuantized/ModelHamiltonian/HoppingMatrix.hpp"
 #include "Operator/SecondQuantized/ModelHamiltonian/HubbardHamiltonian.hpp"
 
+#include "Operator/SecondQuantized/ActiveSpaceSQHamiltonian.hpp"
+#include "Operator/SecondQuantized/BinaryIntegralFile.hpp"
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 #include "Operator/SecondQuantized/SQOneElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQTwoElectronOperator.hpp"
 #include "Operator/SecondQuantized/USQHamiltonian.hpp"
 
+#include "Processing/Cube/CubeFile.hpp"
+#include "Processing/Cube/CubicGrid.hpp"
+
 #include "Processing/Properties/BaseElectricalResponseSolver.hpp"
 #include "Processing/Properties/expectation_values.hpp"
 #include "Processing/Properties/properties.hpp"
@@ -164,6 +178,7 @@
 #include "Processing/RDM/TwoRDM.hpp"
 
 #include "QCMethod/Applications/AtomicDecompositionParameters.hpp"
+#include "QCMethod/Applications/PotentialEnergyScan.hpp"
 
 #include "QCMethod/CI/HamiltonianBuilder/DOCI.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/FCI.hpp"
@@ -174,6 +189,7 @@
 #include "QCMethod/CI/HamiltonianBuilder/Hubbard.hpp"
 #include "QCMethod/CI/HamiltonianBuilder/SelectedCI.hpp"
 
+#include "QCMethod/CI/CISigmaVector.hpp"
 // #include "QCMethod/CI/DOCINewtonOrbitalOptimizer.hpp"
 
 #include "QCMethod/Geminals/AP1roGJacobiOrbitalOptimizer.hpp"
@@ -189,6 +205,7 @@
 #include "QCMethod/HF/RHFFockMatrixDiagonalization.hpp"
 #include "QCMethod/HF/RHFFockMatrixDIIS.hpp"
 #include "QCMethod/HF/RHFSCFEnvironment.hpp"
+#include "QCMethod/HF/RHFSCFHistoryTruncation.hpp"
 #include "QCMethod/HF/RHFSCFSolver.hpp"
 
 #include "QCMethod/OrbitalOptimization/Localization/ERJacobiLocalizer.hpp"
@@ -214,8 +231,10 @@
 #include "QCModel/HF/RHF.hpp"
 
 #include "Utilities/CRTP.hpp"
+#include "Utilities/FCIDUMPParser.hpp"
 #include "Utilities/linalg.hpp"
 #include "Utilities/memory.hpp"
+#include "Utilities/MemoryMappedFile.hpp"
 #include "Utilities/miscellaneous.hpp"
 #include "Utilities/type_traits.hpp"
 #include "Utilities/typedefs.hpp"
@@ -0,0 +1,289 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Basis/Integrals/AOIntegralCache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+
+namespace GQCP {
+
+
+/*
+ *  PRIVATE METHODS - SINGLETON
+ */
+
+/**
+ *  Private constructor as required by the singleton class design
+ */
+AOIntegralCache::AOIntegralCache() :
+    capacity (1)
+{}
+
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  @param lhs          the left-hand side shell set
+ *  @param rhs          the right-hand side shell set
+ *
+ *  @return if the two shell sets contain the same shells, such that they produce the same integrals
+ */
+bool AOIntegralCache::areEqual(const ShellSet<GTOShell>& lhs, const ShellSet<GTOShell>& rhs) {
+
+    const auto& lhs_shells = lhs.asVector();
+    const auto& rhs_shells = rhs.asVector();
+
+    if (lhs_shells.size() != rhs_shells.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < lhs_shells.size(); i++) {
+        const auto& lhs_shell = lhs_shells[i];
+        const auto& rhs_shell = rhs_shells[i];
+
+        // GTOShell::operator== doesn't check the number of primitives or the normalization conventions, which also determine the integrals
+        if ((lhs_shell.get_gaussian_exponents().size() != rhs_shell.get_gaussian_exponents().size()) ||
+            (lhs_shell.get_contraction_coefficients().size() != rhs_shell.get_contraction_coefficients().size()) ||
+            (lhs_shell.are_embedded_normalization_factors_of_primitives() != rhs_shell.are_embedded_normalization_factors_of_primitives()) ||
+            (lhs_shell.is_normalized() != rhs_shell.is_normalized()) ||
+            !(lhs_shell == rhs_shell)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Replace the calculation of the entry with the given identifier by a weak reference to its result, if the entry is still in the cache.
+ * 
+ *  @param id               the identifier of the entry
+ *  @param integrals        the calculated integrals
+ */
+void AOIntegralCache::finish(const size_t id, const std::shared_ptr<const Tensor<double, 4>>& integrals) {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+
+    const auto it = std::find_if(this->entries.begin(), this->entries.end(), [id] (const Entry& entry) { return entry.id == id; });
+    if (it != this->entries.end()) {
+        it->integrals = integrals;
+        it->calculation = std::shared_future<std::shared_ptr<const Tensor<double, 4>>>();  // the shared state of the calculation holds a strong reference to the integrals
+    }
+}
+
+
+/**
+ *  Remove the entry with the given identifier, if it is still in the cache.
+ * 
+ *  @param id               the identifier of the entry
+ */
+void AOIntegralCache::remove(const size_t id) {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+
+    const auto it = std::find_if(this->entries.begin(), this->entries.end(), [id] (const Entry& entry) { return entry.id == id; });
+    if (it != this->entries.end()) {
+        this->entries.erase(it);
+    }
+}
+
+
+
+/*
+ *  PUBLIC METHODS - SINGLETON
+ */
+
+/**
+ *  @return the static singleton instance
+ */
+AOIntegralCache& AOIntegralCache::get() {  // need to return by reference since we deleted the relevant constructor
+    static AOIntegralCache singleton_instance;  // instantiated on first use and guaranteed to be destroyed
+    return singleton_instance;
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @return the maximum number of integral sets that are kept in the cache
+ */
+size_t AOIntegralCache::maximumNumberOfEntries() const {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    return this->capacity;
+}
+
+
+/**
+ *  @param capacity         the maximum number of integral sets that should be kept in the cache. A capacity of zero disables the cache.
+ */
+void AOIntegralCache::setMaximumNumberOfEntries(const size_t capacity) {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    this->capacity = capacity;
+
+    // Remove the least recently used entries that don't fit anymore
+    if (this->entries.size() > this->capacity) {
+        this->entries.erase(this->entries.begin(), this->entries.end() - this->capacity);
+    }
+}
+
+
+/**
+ *  Remove all the integral sets from the cache.
+ */
+void AOIntegralCache::clear() {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    this->entries.clear();
+}
+
+
+/**
+ *  Look up the integrals over the given operator and shell sets, and only calculate them if they aren't in the cache yet.
+ * 
+ *  @param operator_key             a key that identifies the operator and its parameters
+ *  @param left_shell_set           the shells that appear on the left of the operator
+ *  @param right_shell_set          the shells that appear on the right of the operator
+ *  @param calculate                a function that calculates the integrals, which is only called on a cache miss
+ * 
+ *  @return the (shared) integrals over the given operator and shell sets
+ * 
+ *  @note If the same integrals are being calculated by another thread, this call waits for that calculation to finish. If the calculation throws, the exception is propagated to all the waiting callers and nothing is cached.
+ * 
+ *  @note The integrals are only found in the cache while another caller still holds them.
+ */
+std::shared_ptr<const Tensor<double, 4>> AOIntegralCache::findOrCalculate(const std::string& operator_key, const ShellSet<GTOShell>& left_shell_set, const ShellSet<GTOShell>& right_shell_set, const std::function<Tensor<double, 4>()>& calculate) {
+
+    std::promise<std::shared_ptr<const Tensor<double, 4>>> promise;
+    std::shared_future<std::shared_ptr<const Tensor<double, 4>>> ongoing_calculation;  // a calculation of the requested integrals by another request
+    size_t id = 0;
+    bool is_cached = false;  // if the result of this calculation will be stored in the cache
+
+    {
+        std::lock_guard<std::mutex> lock (this->mutex);
+
+        for (auto it = this->entries.begin(); it != this->entries.end(); it++) {
+            if ((it->operator_key == operator_key) && AOIntegralCache::areEqual(it->left_shell_set, left_shell_set) && AOIntegralCache::areEqual(it->right_shell_set, right_shell_set)) {
+
+                // Entries whose integrals have been freed by all their users are of no use anymore
+                auto integrals = it->integrals.lock();
+                if (!it->calculation.valid() && !integrals) {
+                    this->entries.erase(it);
+                    break;
+                }
+
+                // Mark the entry as the most recently used one
+                Entry entry = *it;
+                this->entries.erase(it);
+                this->entries.push_back(entry);
+
+                if (integrals) {
+                    return integrals;
+                }
+                ongoing_calculation = entry.calculation;
+                break;
+            }
+        }
+
+
+        // On a cache miss, reserve an entry for the integrals if there is room for them, so that concurrent requests for the same integrals wait for this calculation
+        if (!ongoing_calculation.valid() && (this->capacity > 0)) {
+            if (this->entries.size() == this->capacity) {
+                this->entries.erase(this->entries.begin());  // remove the least recently used entry
+            }
+
+            id = this->next_id++;
+            this->entries.push_back(Entry {operator_key, left_shell_set, right_shell_set, id, promise.get_future().share(), std::weak_ptr<const Tensor<double, 4>>()});
+            is_cached = true;
+        }
+    }
+
+    // Wait for the ongoing calculation outside of the lock
+    if (ongoing_calculation.valid()) {
+        return ongoing_calculation.get();
+    }
+
+
+    // Calculate the integrals without holding the lock, so that other requests aren't blocked by this calculation. The tensor itself isn't const, so that release() may move from it.
+    try {
+        const std::shared_ptr<const Tensor<double, 4>> integrals = std::make_shared<Tensor<double, 4>>(calculate());
+        promise.set_value(integrals);
+        if (is_cached) {
+            this->finish(id, integrals);
+        }
+        return integrals;
+
+    } catch (...) {
+        promise.set_exception(std::current_exception());  // let the waiting requests fail as well
+        if (is_cached) {
+            this->remove(id);
+        }
+        throw;
+    }
+}
+
+
+/**
+ *  @return the number of integral sets that are currently in the cache
+ */
+size_t AOIntegralCache::numberOfEntries() const {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    return this->entries.size();
+}
+
+
+/**
+ *  Give up the shared ownership of integrals that were returned by findOrCalculate(), in exchange for an owning tensor.
+ * 
+ *  @param integrals        the shared integrals, which are reset by this call
+ * 
+ *  @return the integrals: they are moved out if the given pointer was their only owner, and are copied otherwise
+ */
+Tensor<double, 4> AOIntegralCache::release(std::shared_ptr<const Tensor<double, 4>>& integrals) {
+
+    // The cache only hands out new owners while holding its lock, so the number of owners can't grow while we hold it.
+    std::lock_guard<std::mutex> lock (this->mutex);
+
+    Tensor<double, 4> released;
+    if (integrals.use_count() == 1) {
+        released = std::move(const_cast<Tensor<double, 4>&>(*integrals));  // the tensor was created non-const by findOrCalculate()
+    } else {
+        released = *integrals;
+    }
+    integrals.reset();
+
+    return released;
+}
+
+
+}  // namespace GQCP
@@ -171,6 +171,24 @@ libint2::BasisSet LibintInterfacer::interface(const ShellSet<GTOShell>& shellset
 }
 
 
+/**
+ *  @param shellset     the GQCP ShellSet that should be interfaced
+ *
+ *  @return the libint2::Shells (whose renorm()alization has been undone) that correspond to the shells in the given GQCP ShellSet, in the same order
+ */
+std::vector<libint2::Shell> LibintInterfacer::interfaceShells(const ShellSet<GTOShell>& shellset) const {
+
+    std::vector<libint2::Shell> libint_shells;
+    libint_shells.reserve(shellset.numberOfShells());
+
+    for (const auto& shell : shellset.asVector()) {
+        libint_shells.push_back(this->interface(shell));
+    }
+
+    return libint_shells;
+}
+
+
 /*
  *  PUBLIC METHODS - INTERFACING (LIBINT TO GQCP)
  */
@@ -0,0 +1,85 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param shell_set            the shells that should be interfaced to libint2 shells
+ */
+LibintPreparedShells::LibintPreparedShells(const ShellSet<GTOShell>& shell_set) :
+    shells (shell_set.asVector()),
+    libint_shells (LibintInterfacer::get().interfaceShells(shell_set))
+{}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param shell_set            the set of shells that contains the requested shell
+ *  @param shell_index          the index of the requested shell inside the shell set
+ * 
+ *  @return the prepared libint2 shell that corresponds to the requested shell, or nullptr if the requested shell isn't identical to the prepared shell at the same index
+ */
+const libint2::Shell* LibintPreparedShells::find(const ShellSet<GTOShell>& shell_set, const size_t shell_index) const {
+
+    if ((shell_index >= this->shells.size()) || !LibintPreparedShells::areIdentical(this->shells[shell_index], shell_set.asVector()[shell_index])) {
+        return nullptr;
+    }
+
+    return &this->libint_shells[shell_index];
+}
+
+
+
+/*
+ *  PUBLIC STATIC METHODS
+ */
+
+/**
+ *  @param lhs                  the left-hand side shell
+ *  @param rhs                  the right-hand side shell
+ * 
+ *  @return if the two shells are exactly equal, i.e. if they produce exactly the same integrals
+ * 
+ *  @note Contrary to GTOShell::operator==, no tolerance is used and the normalization conventions are also compared.
+ */
+bool LibintPreparedShells::areIdentical(const GTOShell& lhs, const GTOShell& rhs) {
+
+    return (lhs.get_l() == rhs.get_l()) &&
+           (lhs.is_pure() == rhs.is_pure()) &&
+           (lhs.are_embedded_normalization_factors_of_primitives() == rhs.are_embedded_normalization_factors_of_primitives()) &&
+           (lhs.is_normalized() == rhs.is_normalized()) &&
+           (lhs.get_nucleus().position() == rhs.get_nucleus().position()) &&
+           (lhs.get_gaussian_exponents() == rhs.get_gaussian_exponents()) &&
+           (lhs.get_contraction_coefficients() == rhs.get_contraction_coefficients());
+}
+
+
+}  // namespace GQCP
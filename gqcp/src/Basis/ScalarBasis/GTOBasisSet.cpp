@@ -17,7 +17,7 @@
 // 
 #include "Basis/ScalarBasis/GTOBasisSet.hpp"
 
-#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/ScalarBasis/GTOBasisSetCache.hpp"
 
 
 namespace GQCP {
@@ -47,12 +47,17 @@ GTOBasisSet::GTOBasisSet(const std::string& basisset_name) :
  */
 ShellSet<GTOShell> GTOBasisSet::generate(const NuclearFramework& nuclear_framework) const {
 
-    // TODO no longer use libint2 to read this
+    // The basisset file is only parsed once for every element, so placing the shells is an in-memory operation
+    auto& cache = GTOBasisSetCache::get();
 
-    const auto& nuclei = nuclear_framework.nucleiAsVector();
-    libint2::BasisSet libint_basis (basisset_name, LibintInterfacer::get().interface(nuclei));
+    std::vector<GTOShell> shells;
+    for (const auto& nucleus : nuclear_framework.nucleiAsVector()) {
+        for (const auto& shell : cache.shells(this->basisset_name, nucleus.charge())) {
+            shells.emplace_back(shell.get_l(), nucleus, shell.get_gaussian_exponents(), shell.get_contraction_coefficients(), shell.is_pure(), shell.are_embedded_normalization_factors_of_primitives(), shell.is_normalized());
+        }
+    }
 
-    return LibintInterfacer::get().interface(libint_basis, nuclei);
+    return ShellSet<GTOShell>(shells);
 }
 
 
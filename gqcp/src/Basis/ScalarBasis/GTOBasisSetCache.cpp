@@ -0,0 +1,135 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Basis/ScalarBasis/GTOBasisSetCache.hpp"
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+
+namespace GQCP {
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  @param basisset_name        the name of the basisset
+ *
+ *  @return the name under which the basisset is cached. Since basisset names are case-insensitive, this is the lowercase name.
+ */
+std::string GTOBasisSetCache::key(const std::string& basisset_name) {
+
+    std::string key = basisset_name;
+    std::transform(key.begin(), key.end(), key.begin(), [ ] (const unsigned char c) { return std::tolower(c); });
+
+    return key;
+}
+
+
+/**
+ *  Parse the basisset file for one element.
+ * 
+ *  @param basisset_name        the name of the basisset
+ *  @param Z                    the atomic number of the element
+ *
+ *  @return the shells of the basisset for the given element, centered on a nucleus at the origin
+ */
+std::vector<GTOShell> GTOBasisSetCache::parse(const std::string& basisset_name, const size_t Z) {
+
+    // TODO no longer use libint2 to read this
+
+    const std::vector<Nucleus> nuclei {Nucleus(Z, 0.0, 0.0, 0.0)};
+    libint2::BasisSet libint_basis (basisset_name, LibintInterfacer::get().interface(nuclei));
+
+    return LibintInterfacer::get().interface(libint_basis, nuclei);
+}
+
+
+
+/*
+ *  PUBLIC METHODS - SINGLETON
+ */
+
+/**
+ *  @return the static singleton instance
+ */
+GTOBasisSetCache& GTOBasisSetCache::get() {  // need to return by reference since we deleted the relevant constructor
+    static GTOBasisSetCache singleton_instance;  // instantiated on first use and guaranteed to be destroyed
+    return singleton_instance;
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  Remove all the parsed basisset definitions from the cache.
+ */
+void GTOBasisSetCache::clear() {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    this->element_shells.clear();
+}
+
+
+/**
+ *  @return the number of (basisset, element) pairs whose shells are currently in the cache
+ */
+size_t GTOBasisSetCache::numberOfEntries() const {
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    return this->element_shells.size();
+}
+
+
+/**
+ *  Look up the shells of the given basisset for the given element, and only parse the basisset file if they aren't in the cache yet.
+ * 
+ *  @param basisset_name        the name of the basisset
+ *  @param Z                    the atomic number of the element
+ * 
+ *  @return the shells of the basisset for the given element, centered on a nucleus at the origin
+ */
+std::vector<GTOShell> GTOBasisSetCache::shells(const std::string& basisset_name, const size_t Z) {
+
+    const auto entry_key = std::make_pair(GTOBasisSetCache::key(basisset_name), Z);
+
+    {
+        std::lock_guard<std::mutex> lock (this->mutex);
+
+        const auto it = this->element_shells.find(entry_key);
+        if (it != this->element_shells.end()) {
+            return it->second;
+        }
+    }
+
+
+    // On a cache miss, parse the basisset file without holding the lock, so that other threads can keep on using the cache in the meantime. If another thread has stored the same shells in the meantime, its entry is kept.
+    auto shells = GTOBasisSetCache::parse(basisset_name, Z);
+
+    std::lock_guard<std::mutex> lock (this->mutex);
+    return this->element_shells.emplace(entry_key, std::move(shells)).first->second;
+}
+
+
+}  // namespace GQCP
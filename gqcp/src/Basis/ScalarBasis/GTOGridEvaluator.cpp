@@ -0,0 +1,354 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Basis/ScalarBasis/GTOGridEvaluator.hpp"
+
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/special_functions/binomial.hpp>
+#include <boost/math/special_functions/factorials.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace GQCP {
+
+
+namespace {
+
+
+/**
+ *  @param i        an integer
+ * 
+ *  @return (-1)^i
+ */
+int parity(const int i) {
+    return (i % 2 == 0) ? 1 : -1;
+}
+
+
+/**
+ *  @param n        a non-negative integer
+ * 
+ *  @return n!
+ */
+double factorial(const int n) {
+    return boost::math::factorial<double>(static_cast<unsigned>(n));
+}
+
+
+/**
+ *  @param n        an integer that is at least -1
+ * 
+ *  @return n!!, with (-1)!! = 1
+ */
+double doubleFactorial(const int n) {
+    return (n <= 0) ? 1.0 : boost::math::double_factorial<double>(static_cast<unsigned>(n));
+}
+
+
+/**
+ *  @param n        a non-negative integer
+ *  @param k        a non-negative integer, not larger than n
+ * 
+ *  @return the binomial coefficient (n k)
+ */
+double binomial(const int n, const int k) {
+    return boost::math::binomial_coefficient<double>(static_cast<unsigned>(n), static_cast<unsigned>(k));
+}
+
+
+/**
+ *  Calculate the coefficient of a Cartesian component in the expansion of a real solid harmonic, following the convention of libint2 (Schlegel and Frisch, Int. J. Quantum Chem. 54, 83 (1995))
+ * 
+ *  @param l            the angular momentum
+ *  @param m            the magnetic quantum number of the solid harmonic
+ *  @param lx           the exponent of x in the Cartesian component
+ *  @param ly           the exponent of y in the Cartesian component
+ *  @param lz           the exponent of z in the Cartesian component
+ * 
+ *  @return the coefficient of the Cartesian component x^lx y^ly z^lz (normalized as an axis-aligned component) in the normalized solid harmonic with quantum numbers (l, m)
+ */
+double calculateSolidHarmonicCoefficient(const int l, const int m, const int lx, const int ly, const int lz) {
+
+    const int abs_m = std::abs(m);
+    if ((lx + ly - abs_m) % 2 != 0) {
+        return 0.0;
+    }
+
+    const int j = (lx + ly - abs_m) / 2;
+    if (j < 0) {
+        return 0.0;
+    }
+
+    // Cosine-like components (m >= 0) contain even powers of y, sine-like components (m < 0) contain odd powers of y
+    const int comp = (m >= 0) ? 1 : -1;
+    const int i = abs_m - lx;
+    if (comp != parity(std::abs(i))) {
+        return 0.0;
+    }
+
+    double prefactor = std::sqrt((factorial(2*lx) * factorial(2*ly) * factorial(2*lz) / factorial(2*l)) * (factorial(l - abs_m) / factorial(l)) / factorial(l + abs_m) / (factorial(lx) * factorial(ly) * factorial(lz)));
+    prefactor /= std::pow(2.0, l);
+    prefactor *= (m < 0) ? parity((i - 1) / 2) : parity(i / 2);
+
+    double sum = 0.0;
+    for (int k = j; k <= (l - abs_m) / 2; k++) {
+        double term = binomial(l, k) * binomial(k, j) * parity(k) * factorial(2 * (l - k)) / factorial(l - abs_m - 2*k);
+
+        double inner_sum = 0.0;
+        for (int n = std::max((lx - abs_m) / 2, 0); n <= std::min(j, lx / 2); n++) {
+            if (lx - 2*n <= abs_m) {
+                inner_sum += binomial(j, n) * binomial(abs_m, lx - 2*n) * parity(n);
+            }
+        }
+        sum += term * inner_sum;
+    }
+
+    // Account for the normalization of the Cartesian component with respect to the axis-aligned one
+    sum *= std::sqrt(doubleFactorial(2*l - 1) / (doubleFactorial(2*lx - 1) * doubleFactorial(2*ly - 1) * doubleFactorial(2*lz - 1)));
+
+    return (m == 0) ? prefactor * sum : boost::math::constants::root_two<double>() * prefactor * sum;
+}
+
+
+}  // namespace
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param scalar_basis         the scalar basis whose basis functions should be evaluated
+ *  @param threshold            the value below which the basis functions of a shell are considered to be zero, determining the cutoff radius of every shell
+ *  @param block_size           the number of points that are evaluated at once
+ */
+GTOGridEvaluator::GTOGridEvaluator(const ScalarBasis<GTOShell>& scalar_basis, const double threshold, const size_t block_size) :
+    K (scalar_basis.numberOfBasisFunctions()),
+    block_size (block_size)
+{
+    if (threshold <= 0.0) {
+        throw std::invalid_argument("GTOGridEvaluator::GTOGridEvaluator(ScalarBasis<GTOShell>, double, size_t): the threshold must be positive.");
+    }
+
+    if (block_size == 0) {
+        throw std::invalid_argument("GTOGridEvaluator::GTOGridEvaluator(ScalarBasis<GTOShell>, double, size_t): the block size must be positive.");
+    }
+
+
+    size_t offset = 0;
+    for (const auto& shell : scalar_basis.shellSet().asVector()) {
+        ShellData data;
+        data.l = shell.get_l();
+        data.offset = offset;
+        data.number_of_basis_functions = shell.numberOfBasisFunctions();
+        data.center = shell.get_nucleus().position();
+        data.exponents = shell.get_gaussian_exponents();
+        data.coefficients = shell.get_contraction_coefficients();
+
+        // Make sure the contraction coefficients refer to normalized (axis-aligned) primitives
+        if (!shell.are_embedded_normalization_factors_of_primitives()) {
+            for (size_t p = 0; p < data.coefficients.size(); p++) {
+                data.coefficients[p] *= CartesianGTO::calculateNormalizationFactor(data.exponents[p], CartesianExponents(data.l, 0, 0));
+            }
+        }
+
+
+        // Set up the Cartesian-to-spherical transformation for pure shells
+        const int l = static_cast<int>(data.l);
+        const size_t number_of_cartesians = (data.l + 1) * (data.l + 2) / 2;
+        double angular_bound = 1.0;  // an upper bound to the angular part of the basis functions, relative to r^l
+        if (shell.is_pure()) {
+            data.T = MatrixX<double>::Zero(number_of_cartesians, 2*data.l + 1);
+
+            size_t cartesian_index = 0;
+            for (int i = 0; i <= l; i++) {
+                for (int j = 0; j <= i; j++) {
+                    for (int m = -l; m <= l; m++) {
+                        data.T(cartesian_index, m + l) = calculateSolidHarmonicCoefficient(l, m, l - i, i - j, j);
+                    }
+                    cartesian_index++;
+                }
+            }
+
+            angular_bound = data.T.cwiseAbs().colwise().sum().maxCoeff();
+        }
+
+
+        // Determine the cutoff radius from |phi(r)| <= sum_p |c_p| * r^l * exp(-alpha_min r^2), which we solve iteratively for the radius at which the bound equals the threshold
+        double coefficient_bound = 0.0;
+        for (const auto& c : data.coefficients) {
+            coefficient_bound += std::abs(c);
+        }
+        const double alpha_min = *std::min_element(data.exponents.begin(), data.exponents.end());
+        const double log_ratio = std::log(angular_bound * coefficient_bound / threshold);
+
+        double r2 = 0.0;
+        for (size_t iteration = 0; iteration < 32; iteration++) {
+            r2 = std::max(0.0, (log_ratio + 0.5 * data.l * std::log(std::max(r2, 1.0))) / alpha_min);  // max(r^2, 1) keeps r^l as an upper bound inside the unit sphere
+        }
+        data.cutoff_radius_squared = r2;
+
+        offset += data.number_of_basis_functions;
+        this->shells.push_back(data);
+    }
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param points               the points at which the basis functions should be evaluated, as rows of a (N x 3)-matrix
+ * 
+ *  @return the values of the basis functions at the given points, as a (N x K)-matrix
+ */
+MatrixX<double> GTOGridEvaluator::evaluate(const MatrixX<double>& points) const {
+
+    if (points.cols() != 3) {
+        throw std::invalid_argument("GTOGridEvaluator::evaluate(MatrixX<double>): the points should be given as rows of a (N x 3)-matrix.");
+    }
+
+    const size_t N = points.rows();
+    MatrixX<double> values = MatrixX<double>::Zero(N, this->K);
+
+    // Every block writes to its own rows, so the blocks can be evaluated in parallel
+    const auto number_of_blocks = static_cast<long>((N + this->block_size - 1) / this->block_size);
+    #pragma omp parallel for schedule(dynamic)
+    for (long b = 0; b < number_of_blocks; b++) {
+        const size_t start = b * this->block_size;
+        const size_t size = std::min(this->block_size, N - start);
+        this->evaluateBlock(points, start, size, values);
+    }
+
+    return values;
+}
+
+
+/**
+ *  @param points               the points at which the density should be evaluated, as rows of a (N x 3)-matrix
+ *  @param D                    the density matrix expressed in the scalar basis
+ * 
+ *  @return the values of the electron density at the given points
+ */
+VectorX<double> GTOGridEvaluator::evaluateDensity(const MatrixX<double>& points, const SquareMatrix<double>& D) const {
+
+    if (D.dimension() != this->K) {
+        throw std::invalid_argument("GTOGridEvaluator::evaluateDensity(MatrixX<double>, SquareMatrix<double>): the dimension of the density matrix does not match the number of basis functions.");
+    }
+
+    // rho(r) = sum_{mu nu} phi_mu(r) D_{mu nu} phi_nu(r), which is the row-wise dot product of (Phi D) and Phi
+    const MatrixX<double> phi = this->evaluate(points);
+    const MatrixX<double> phi_D = phi * D;
+
+    return phi_D.cwiseProduct(phi).rowwise().sum();
+}
+
+
+/**
+ *  @param points               the points at which the orbitals should be evaluated, as rows of a (N x 3)-matrix
+ *  @param C                    the coefficient matrix of the orbitals, i.e. the orbitals are the columns of C, expanded in the scalar basis
+ * 
+ *  @return the values of the orbitals at the given points, as a (N x number of orbitals)-matrix
+ */
+MatrixX<double> GTOGridEvaluator::evaluateOrbitals(const MatrixX<double>& points, const MatrixX<double>& C) const {
+
+    if (C.rows() != this->K) {
+        throw std::invalid_argument("GTOGridEvaluator::evaluateOrbitals(MatrixX<double>, MatrixX<double>): the number of rows of the coefficient matrix does not match the number of basis functions.");
+    }
+
+    return this->evaluate(points) * C;
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Evaluate all basis functions at a contiguous block of points and write the results in the corresponding rows of the given matrix
+ * 
+ *  @param points               the points at which the basis functions should be evaluated, as rows of a (N x 3)-matrix
+ *  @param start                the index of the first point of the block
+ *  @param size                 the number of points in the block
+ *  @param values               the (N x K)-matrix in which the values are stored
+ */
+void GTOGridEvaluator::evaluateBlock(const MatrixX<double>& points, const size_t start, const size_t size, MatrixX<double>& values) const {
+
+    std::vector<Eigen::ArrayXd> x_powers, y_powers, z_powers;
+
+    for (const auto& shell : this->shells) {
+
+        const Eigen::ArrayXd x = points.col(0).segment(start, size).array() - shell.center(0);
+        const Eigen::ArrayXd y = points.col(1).segment(start, size).array() - shell.center(1);
+        const Eigen::ArrayXd z = points.col(2).segment(start, size).array() - shell.center(2);
+        const Eigen::ArrayXd r2 = x.square() + y.square() + z.square();
+
+        // Shell-wise screening: the values have been initialized to zero
+        if (r2.minCoeff() > shell.cutoff_radius_squared) {
+            continue;
+        }
+
+
+        // The contracted radial part, shared by all basis functions in the shell
+        Eigen::ArrayXd radial = Eigen::ArrayXd::Zero(size);
+        for (size_t p = 0; p < shell.exponents.size(); p++) {
+            radial += shell.coefficients[p] * (-shell.exponents[p] * r2).exp();
+        }
+
+
+        // Build the powers of x, y and z through repeated multiplication
+        const size_t l = shell.l;
+        x_powers.resize(l + 1);
+        y_powers.resize(l + 1);
+        z_powers.resize(l + 1);
+        x_powers[0] = radial;  // absorb the radial part in the powers of x
+        y_powers[0] = Eigen::ArrayXd::Ones(size);
+        z_powers[0] = Eigen::ArrayXd::Ones(size);
+        for (size_t n = 1; n <= l; n++) {
+            x_powers[n] = x_powers[n-1] * x;
+            y_powers[n] = y_powers[n-1] * y;
+            z_powers[n] = z_powers[n-1] * z;
+        }
+
+
+        // Evaluate the Cartesian components in the standard order, and transform them to spherical ones if necessary
+        const size_t number_of_cartesians = (l + 1) * (l + 2) / 2;
+        MatrixX<double> cartesian_values (size, number_of_cartesians);
+        size_t cartesian_index = 0;
+        for (size_t i = 0; i <= l; i++) {
+            for (size_t j = 0; j <= i; j++) {
+                cartesian_values.col(cartesian_index) = (x_powers[l - i] * y_powers[i - j] * z_powers[j]).matrix();
+                cartesian_index++;
+            }
+        }
+
+        if (shell.T.size() > 0) {  // pure shell
+            values.block(start, shell.offset, size, shell.number_of_basis_functions) = cartesian_values * shell.T;
+        } else {
+            values.block(start, shell.offset, size, shell.number_of_basis_functions) = cartesian_values;
+        }
+    }
+}
+
+
+}  // namespace GQCP
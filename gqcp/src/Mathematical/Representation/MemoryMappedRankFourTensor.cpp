@@ -0,0 +1,460 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+namespace {
+
+
+constexpr char magic_string[8] = {'G', 'Q', 'C', 'P', 'R', 'N', 'K', '4'};  // identifies files that contain a memory-mapped rank-four tensor
+constexpr std::uint64_t format_version = 1;
+constexpr size_t header_size = 4096;  // one page, so that the elements are page-aligned
+
+
+/**
+ *  The header at the start of every file that contains a memory-mapped rank-four tensor.
+ */
+struct Header {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t dimension;
+};
+
+
+/**
+ *  @param packed           the pair-packed elements of a symmetric matrix
+ *  @param K                the dimension of the symmetric matrix
+ * 
+ *  @return the symmetric matrix
+ */
+SquareMatrix<double> unpackSymmetric(const double* packed, const size_t K) {
+
+    SquareMatrix<double> X (K);
+    size_t pair_index = 0;
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            X(p,q) = packed[pair_index];
+            X(q,p) = packed[pair_index];
+            pair_index++;
+        }
+    }
+
+    return X;
+}
+
+
+/**
+ *  @param X                a symmetric matrix
+ *  @param packed           the pair-packed elements of the symmetric matrix, on output
+ */
+void packSymmetric(const MatrixX<double>& X, double* packed) {
+
+    size_t pair_index = 0;
+    for (size_t p = 0; p < static_cast<size_t>(X.rows()); p++) {
+        for (size_t q = 0; q <= p; q++) {
+            packed[pair_index] = X(p,q);
+            pair_index++;
+        }
+    }
+}
+
+
+}  // namespace
+
+
+
+/*
+ *  PRIVATE CONSTRUCTORS
+ */
+
+/**
+ *  @param K            the dimension of every axis of the tensor
+ *  @param file         the memory-mapped file that contains the elements
+ */
+MemoryMappedRankFourTensor::MemoryMappedRankFourTensor(const size_t K, MemoryMappedFile&& file) :
+    K (K),
+    file (std::move(file))
+{}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  Create a new memory-mapped rank-four tensor whose elements are all zero.
+ * 
+ *  @param filename         the name of the file that should contain the elements
+ *  @param K                the dimension of every axis of the tensor
+ */
+MemoryMappedRankFourTensor MemoryMappedRankFourTensor::Create(const std::string& filename, const size_t K) {
+
+    if (K == 0) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::Create(const std::string&, const size_t): The dimension of the tensor should be positive.");
+    }
+
+    const size_t number_of_pairs = K * (K + 1) / 2;
+    auto file = MemoryMappedFile::Create(filename, header_size + number_of_pairs * number_of_pairs * sizeof(double));  // a new file is zero-filled
+
+    Header header;
+    std::memcpy(header.magic, magic_string, sizeof(magic_string));
+    header.version = format_version;
+    header.dimension = K;
+    std::memcpy(file.data(), &header, sizeof(Header));
+
+    return MemoryMappedRankFourTensor(K, std::move(file));
+}
+
+
+/**
+ *  Create a new memory-mapped rank-four tensor from a tensor in memory.
+ * 
+ *  @param filename         the name of the file that should contain the elements
+ *  @param g                the tensor whose elements should be stored
+ */
+MemoryMappedRankFourTensor MemoryMappedRankFourTensor::FromTensor(const std::string& filename, const SquareRankFourTensor<double>& g) {
+
+    const auto K = g.get_dim();
+    auto result = MemoryMappedRankFourTensor::Create(filename, K);
+
+    const auto number_of_pairs = result.numberOfPairs();
+    double* elements = result.elements();
+
+    size_t PQ = 0;
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+
+            size_t RS = 0;
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    elements[number_of_pairs * PQ + RS] = g(p,q,r,s);
+                    RS++;
+                }
+            }
+
+            PQ++;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ *  Open a memory-mapped rank-four tensor that was previously stored.
+ * 
+ *  @param filename         the name of the file that contains the elements
+ *  @param is_read_only     if the elements may not be changed
+ */
+MemoryMappedRankFourTensor MemoryMappedRankFourTensor::Open(const std::string& filename, const bool is_read_only) {
+
+    auto file = MemoryMappedFile::Open(filename, !is_read_only);
+
+    if (file.size() < header_size) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::Open(const std::string&, const bool): The given file is too small to contain a memory-mapped rank-four tensor.");
+    }
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if ((std::memcmp(header.magic, magic_string, sizeof(magic_string)) != 0) || (header.version != format_version)) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::Open(const std::string&, const bool): The given file does not contain a memory-mapped rank-four tensor.");
+    }
+
+    const size_t K = header.dimension;
+    const size_t number_of_pairs = K * (K + 1) / 2;
+    if (file.size() != header_size + number_of_pairs * number_of_pairs * sizeof(double)) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::Open(const std::string&, const bool): The size of the given file does not match the dimension in its header.");
+    }
+
+    return MemoryMappedRankFourTensor(K, std::move(file));
+}
+
+
+
+/*
+ *  OPERATORS
+ */
+
+/**
+ *  @return a writable reference to the element g(p,q,r,s), which is shared by all elements that are related to it through the symmetries of the tensor
+ */
+double& MemoryMappedRankFourTensor::operator()(const size_t p, const size_t q, const size_t r, const size_t s) {
+
+    if (this->isReadOnly()) {
+        throw std::logic_error("MemoryMappedRankFourTensor::operator()(const size_t, const size_t, const size_t, const size_t): This tensor was opened as read-only.");
+    }
+
+    return this->elements()[this->numberOfPairs() * pairIndex(p, q) + pairIndex(r, s)];
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+ */
+SquareMatrix<double> MemoryMappedRankFourTensor::calculateCoulombMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+    const auto number_of_pairs = this->numberOfPairs();
+
+    // Since g(p,q,r,s) = g(p,q,s,r), the contraction with D can be done over the packed pairs RS if we fold D
+    VectorX<double> D_folded (number_of_pairs);
+    size_t RS = 0;
+    for (size_t r = 0; r < K; r++) {
+        for (size_t s = 0; s <= r; s++) {
+            D_folded(RS) = (r == s) ? D(r,r) : D(s,r) + D(r,s);
+            RS++;
+        }
+    }
+
+    VectorX<double> J_packed (number_of_pairs);
+    #pragma omp parallel for schedule(static)
+    for (size_t PQ = 0; PQ < number_of_pairs; PQ++) {
+        J_packed(PQ) = Eigen::Map<const Eigen::VectorXd>(this->pairRow(PQ), number_of_pairs).dot(D_folded);
+    }
+
+    return unpackSymmetric(J_packed.data(), K);
+}
+
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+ */
+SquareMatrix<double> MemoryMappedRankFourTensor::calculateExchangeMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+    SquareMatrix<double> K_matrix = SquareMatrix<double>::Zero(K, K);
+
+    #pragma omp parallel
+    {
+        // Every thread accumulates its own contributions, so that no synchronization is needed during the streaming over the rows
+        SquareMatrix<double> K_thread = SquareMatrix<double>::Zero(K, K);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                const double* row = this->pairRow(pairIndex(p, q));
+
+                size_t RS = 0;
+                for (size_t r = 0; r < K; r++) {
+                    for (size_t s = 0; s <= r; s++) {
+                        const double value = row[RS];
+                        RS++;
+
+                        // Every stored element represents the elements (p,q,r,s), (q,p,r,s), (p,q,s,r) and (q,p,s,r), which have to be counted once if they coincide
+                        K_thread(p,s) += value * D(q,r);
+                        if (p != q) {
+                            K_thread(q,s) += value * D(p,r);
+                        }
+                        if (r != s) {
+                            K_thread(p,r) += value * D(q,s);
+                        }
+                        if ((p != q) && (r != s)) {
+                            K_thread(q,r) += value * D(p,s);
+                        }
+                    }
+                }
+            }
+        }
+
+        #pragma omp critical
+        K_matrix += K_thread;
+    }
+
+    return K_matrix;
+}
+
+
+/**
+ *  @param d                a rank-four tensor, e.g. a 2-DM
+ * 
+ *  @return the full contraction sum_{p,q,r,s} g(p,q,r,s) d(p,q,r,s)
+ */
+double MemoryMappedRankFourTensor::contract(const SquareRankFourTensor<double>& d) const {
+
+    const auto K = this->K;
+    if (d.get_dim() != K) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::contract(const SquareRankFourTensor<double>&): The dimensions of the given tensor are incompatible with this tensor.");
+    }
+
+    double value = 0.0;
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:value)
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            const double* row = this->pairRow(pairIndex(p, q));
+
+            size_t RS = 0;
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s <= r; s++) {
+
+                    // Fold the elements of d that are related to each other through the symmetries of g
+                    double d_folded = d(p,q,r,s);
+                    if (p != q) {
+                        d_folded += d(q,p,r,s);
+                    }
+                    if (r != s) {
+                        d_folded += d(p,q,s,r);
+                    }
+                    if ((p != q) && (r != s)) {
+                        d_folded += d(q,p,s,r);
+                    }
+
+                    value += row[RS] * d_folded;
+                    RS++;
+                }
+            }
+        }
+    }
+
+    return value;
+}
+
+
+/**
+ *  @return this tensor as a (full) tensor in memory
+ */
+SquareRankFourTensor<double> MemoryMappedRankFourTensor::toTensor() const {
+
+    const auto K = this->K;
+    SquareRankFourTensor<double> g (K);
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    g(p,q,r,s) = (*this)(p,q,r,s);
+                }
+            }
+        }
+    }
+
+    return g;
+}
+
+
+/**
+ *  Transform this tensor to another basis, without ever keeping the full tensor in memory.
+ * 
+ *  @param filename                         the name of the file that should contain the transformed elements
+ *  @param C                                the coefficient matrix, whose columns are the expansion coefficients of the new basis functions in terms of the current ones; it may have fewer columns than rows (e.g. for an active space)
+ *  @param maximum_tile_size_in_MB          the maximum size of the in-memory buffer that is used during the second half of the transformation
+ * 
+ *  @return the transformed tensor g'(i,j,k,l) = sum_{p,q,r,s} C(p,i) C(q,j) C(r,k) C(s,l) g(p,q,r,s)
+ */
+MemoryMappedRankFourTensor MemoryMappedRankFourTensor::transformed(const std::string& filename, const MatrixX<double>& C, const size_t maximum_tile_size_in_MB) const {
+
+    const auto K = this->K;
+    if (static_cast<size_t>(C.rows()) != K) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::transformed(const std::string&, const MatrixX<double>&, const size_t): The number of rows of the given coefficient matrix should match the dimension of this tensor.");
+    }
+    if (filename == this->filename()) {
+        throw std::invalid_argument("MemoryMappedRankFourTensor::transformed(const std::string&, const MatrixX<double>&, const size_t): The transformed tensor can't be stored in the file of this tensor.");
+    }
+
+    const size_t K_new = C.cols();
+    const size_t number_of_pairs = this->numberOfPairs();
+    const size_t number_of_new_pairs = K_new * (K_new + 1) / 2;
+
+
+    // Transform the last two indices: every row PQ of the half-transformed supermatrix H(PQ,KL) only depends on the row PQ of the original one
+    // The half-transformed elements are stored in a scratch file that is removed from the file system right away: the mapping stays valid until it is released
+    const std::string half_transformed_filename = filename + ".half";
+    auto half_transformed_file = MemoryMappedFile::Create(half_transformed_filename, number_of_pairs * number_of_new_pairs * sizeof(double));
+    std::remove(half_transformed_filename.c_str());
+    double* half_transformed = reinterpret_cast<double*>(half_transformed_file.data());
+
+    #pragma omp parallel for schedule(static)
+    for (size_t PQ = 0; PQ < number_of_pairs; PQ++) {
+        const auto X = unpackSymmetric(this->pairRow(PQ), K);
+        const MatrixX<double> Y = C.transpose() * X * C;
+        packSymmetric(Y, half_transformed + number_of_new_pairs * PQ);
+    }
+
+
+    // Transform the first two indices: every column KL of the half-transformed supermatrix yields a column of the transformed supermatrix
+    // Since the columns are strided in the scratch file, we gather tiles of consecutive columns by streaming over the rows. Because the transformed supermatrix is symmetric (for real tensors), every column KL is written as the contiguous row KL.
+    auto result = MemoryMappedRankFourTensor::Create(filename, K_new);
+    double* result_elements = result.elements();
+
+    const size_t maximum_tile_size = std::max<size_t>(maximum_tile_size_in_MB * 1024 * 1024 / (number_of_pairs * sizeof(double)), 1);
+    const size_t tile_size = std::min(maximum_tile_size, number_of_new_pairs);
+    MatrixX<double> tile (number_of_pairs, tile_size);
+
+    for (size_t tile_start = 0; tile_start < number_of_new_pairs; tile_start += tile_size) {
+        const size_t number_of_columns = std::min(tile_size, number_of_new_pairs - tile_start);
+
+        for (size_t PQ = 0; PQ < number_of_pairs; PQ++) {
+            const double* row = half_transformed + number_of_new_pairs * PQ + tile_start;
+            for (size_t column = 0; column < number_of_columns; column++) {
+                tile(PQ, column) = row[column];
+            }
+        }
+
+        #pragma omp parallel for schedule(static)
+        for (size_t column = 0; column < number_of_columns; column++) {
+            const auto Z = unpackSymmetric(tile.col(column).data(), K);
+            const MatrixX<double> W = C.transpose() * Z * C;
+            packSymmetric(W, result_elements + number_of_new_pairs * (tile_start + column));
+        }
+    }
+
+    return result;
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  @return a pointer to the first stored element
+ */
+double* MemoryMappedRankFourTensor::elements() {
+    return reinterpret_cast<double*>(this->file.data() + header_size);
+}
+
+
+/**
+ *  @return a pointer to the first stored element
+ */
+const double* MemoryMappedRankFourTensor::elements() const {
+    return reinterpret_cast<const double*>(this->file.data() + header_size);
+}
+
+
+}  // namespace GQCP
@@ -0,0 +1,362 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
+
+#include "Utilities/FCIDUMPParser.hpp"
+
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  Construct a symmetry-packed rank-four tensor whose elements are all zero.
+ * 
+ *  @param K            the dimension of every axis of the tensor
+ */
+SymmetryPackedRankFourTensor::SymmetryPackedRankFourTensor(const size_t K) :
+    K (K),
+    elements ((K * (K + 1) / 2) * (K * (K + 1) / 2 + 1) / 2, 0.0)
+{}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  @param g            a tensor that has the 8-fold permutational symmetry of two-electron integrals over real orbitals
+ * 
+ *  @return the symmetry-packed representation of the given tensor
+ */
+SymmetryPackedRankFourTensor SymmetryPackedRankFourTensor::FromTensor(const SquareRankFourTensor<double>& g) {
+
+    const auto K = g.get_dim();
+    SymmetryPackedRankFourTensor result (K);
+
+    size_t index = 0;
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+
+            // The elements of the row PQ are contiguous up to RS=PQ
+            const auto PQ = pairIndex(p, q);
+            for (size_t r = 0; r <= p; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    if (pairIndex(r, s) > PQ) {
+                        break;
+                    }
+
+                    result.elements[index] = g(p,q,r,s);
+                    index++;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ *  Read the two-electron integrals from a FCIDUMP file, storing every value only once.
+ * 
+ *  @param fcidump_file         the name of the FCIDUMP file
+ * 
+ *  @return the symmetry-packed two-electron integrals in the FCIDUMP file
+ * 
+ *  @note The one-electron integrals, orbital energies and internuclear repulsion energy in the file are skipped.
+ */
+SymmetryPackedRankFourTensor SymmetryPackedRankFourTensor::ReadFCIDUMP(const std::string& fcidump_file) {
+
+    const FCIDUMPParser parser (fcidump_file);
+    const auto K = parser.numberOfOrbitals();
+
+    // Every two-electron integral is only written once, since all its symmetry-related elements share the same storage
+    SymmetryPackedRankFourTensor g (K);
+    parser.forEachRecord([&g, K] (const FCIDUMPRecord& record) {
+        if ((record.i > 0) && (record.a > 0) && (record.j > 0) && (record.b > 0)) {
+            if ((record.i > K) || (record.a > K) || (record.j > K) || (record.b > K)) {
+                throw std::invalid_argument("SymmetryPackedRankFourTensor::ReadFCIDUMP(const std::string&): The .FCIDUMP-file contains an orbital index that exceeds the number of orbitals.");
+            }
+
+            g(record.i - 1, record.a - 1, record.j - 1, record.b - 1) = record.value;
+        }
+    });
+
+    return g;
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+ */
+SquareMatrix<double> SymmetryPackedRankFourTensor::calculateCoulombMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+    const auto number_of_pairs = this->numberOfPairs();
+
+    // Since g(p,q,r,s) = g(p,q,s,r), the contraction with D can be done over the pairs RS if we fold D
+    VectorX<double> D_folded (number_of_pairs);
+    for (size_t r = 0; r < K; r++) {
+        for (size_t s = 0; s <= r; s++) {
+            D_folded(pairIndex(r, s)) = (r == s) ? D(r,r) : D(s,r) + D(r,s);
+        }
+    }
+
+    // Every unique element M(PQ,RS) contributes to J(PQ) and, through the symmetry M(PQ,RS) = M(RS,PQ), to J(RS)
+    VectorX<double> J_packed = VectorX<double>::Zero(number_of_pairs);
+
+    #pragma omp parallel
+    {
+        VectorX<double> J_thread = VectorX<double>::Zero(number_of_pairs);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t PQ = 0; PQ < number_of_pairs; PQ++) {
+            const double* row = this->elements.data() + PQ * (PQ + 1) / 2;
+
+            for (size_t RS = 0; RS < PQ; RS++) {
+                J_thread(PQ) += row[RS] * D_folded(RS);
+                J_thread(RS) += row[RS] * D_folded(PQ);
+            }
+            J_thread(PQ) += row[PQ] * D_folded(PQ);
+        }
+
+        #pragma omp critical
+        J_packed += J_thread;
+    }
+
+
+    SquareMatrix<double> J (K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            J(p,q) = J_packed(pairIndex(p, q));
+            J(q,p) = J(p,q);
+        }
+    }
+
+    return J;
+}
+
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+ */
+SquareMatrix<double> SymmetryPackedRankFourTensor::calculateExchangeMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+    SquareMatrix<double> K_matrix = SquareMatrix<double>::Zero(K, K);
+
+    #pragma omp parallel
+    {
+        SquareMatrix<double> K_thread = SquareMatrix<double>::Zero(K, K);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                const auto PQ = pairIndex(p, q);
+                const double* row = this->elements.data() + PQ * (PQ + 1) / 2;
+
+                for (size_t r = 0; r <= p; r++) {
+                    for (size_t s = 0; s <= r; s++) {
+                        const auto RS = pairIndex(r, s);
+                        if (RS > PQ) {
+                            break;
+                        }
+                        const double value = row[RS];
+
+                        // Every unique element represents up to eight elements, which all have to be counted exactly once
+                        K_thread(p,s) += value * D(q,r);
+                        if (p != q) {
+                            K_thread(q,s) += value * D(p,r);
+                        }
+                        if (r != s) {
+                            K_thread(p,r) += value * D(q,s);
+                        }
+                        if ((p != q) && (r != s)) {
+                            K_thread(q,r) += value * D(p,s);
+                        }
+
+                        if (PQ != RS) {  // the elements g(r,s,p,q), g(s,r,p,q), g(r,s,q,p) and g(s,r,q,p)
+                            K_thread(r,q) += value * D(s,p);
+                            if (r != s) {
+                                K_thread(s,q) += value * D(r,p);
+                            }
+                            if (p != q) {
+                                K_thread(r,p) += value * D(s,q);
+                            }
+                            if ((r != s) && (p != q)) {
+                                K_thread(s,p) += value * D(r,q);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        #pragma omp critical
+        K_matrix += K_thread;
+    }
+
+    return K_matrix;
+}
+
+
+/**
+ *  @return the Coulomb integrals J(p,q) = g(p,p,q,q), which are needed to evaluate diagonal matrix elements of the Hamiltonian
+ */
+SquareMatrix<double> SymmetryPackedRankFourTensor::coulombIntegrals() const {
+
+    const auto K = this->K;
+    SquareMatrix<double> J (K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            J(p,q) = (*this)(p,p,q,q);
+        }
+    }
+
+    return J;
+}
+
+
+/**
+ *  @return the exchange integrals K(p,q) = g(p,q,q,p), which are needed to evaluate diagonal matrix elements of the Hamiltonian
+ */
+SquareMatrix<double> SymmetryPackedRankFourTensor::exchangeIntegrals() const {
+
+    const auto K = this->K;
+    SquareMatrix<double> K_matrix (K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            K_matrix(p,q) = (*this)(p,q,q,p);
+        }
+    }
+
+    return K_matrix;
+}
+
+
+/**
+ *  @return this tensor as a (full) rank-four tensor
+ */
+SquareRankFourTensor<double> SymmetryPackedRankFourTensor::toTensor() const {
+
+    const auto K = this->K;
+    SquareRankFourTensor<double> g (K);
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    g(p,q,r,s) = (*this)(p,q,r,s);
+                }
+            }
+        }
+    }
+
+    return g;
+}
+
+
+/**
+ *  @param C                the coefficient matrix, whose columns are the expansion coefficients of the new basis functions in terms of the current ones; it may have fewer columns than rows (e.g. for an active space)
+ * 
+ *  @return the transformed tensor g'(i,j,k,l) = sum_{p,q,r,s} C(p,i) C(q,j) C(r,k) C(s,l) g(p,q,r,s)
+ * 
+ *  @note The intermediate half-transformed supermatrix H(PQ,KL) is kept in memory, which requires about twice the memory of this tensor when the basis isn't truncated.
+ */
+SymmetryPackedRankFourTensor SymmetryPackedRankFourTensor::transformed(const MatrixX<double>& C) const {
+
+    const auto K = this->K;
+    if (static_cast<size_t>(C.rows()) != K) {
+        throw std::invalid_argument("SymmetryPackedRankFourTensor::transformed(const MatrixX<double>&): The number of rows of the given coefficient matrix should match the dimension of this tensor.");
+    }
+
+    const size_t K_new = C.cols();
+    const auto number_of_pairs = this->numberOfPairs();
+    const size_t number_of_new_pairs = K_new * (K_new + 1) / 2;
+
+
+    // Transform the last two indices, for every pair (p,q): H(PQ,KL) = sum_{r,s} C(r,k) g(p,q,r,s) C(s,l)
+    MatrixX<double> H (number_of_pairs, number_of_new_pairs);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t p = 0; p < K; p++) {
+        SquareMatrix<double> X (K);
+        for (size_t q = 0; q <= p; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    X(r,s) = (*this)(p,q,r,s);
+                    X(s,r) = X(r,s);
+                }
+            }
+
+            const MatrixX<double> Y = C.transpose() * X * C;
+            const auto PQ = pairIndex(p, q);
+            for (size_t k = 0; k < K_new; k++) {
+                for (size_t l = 0; l <= k; l++) {
+                    H(PQ, pairIndex(k, l)) = Y(k,l);
+                }
+            }
+        }
+    }
+
+
+    // Transform the first two indices, for every pair (k,l): g'(i,j,k,l) = sum_{p,q} C(p,i) H(PQ,KL) C(q,j), of which we only need the unique elements with IJ>=KL
+    SymmetryPackedRankFourTensor result (K_new);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t KL = 0; KL < number_of_new_pairs; KL++) {
+        SquareMatrix<double> Z (K);
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                Z(p,q) = H(pairIndex(p, q), KL);
+                Z(q,p) = Z(p,q);
+            }
+        }
+
+        const MatrixX<double> W = C.transpose() * Z * C;
+        for (size_t i = 0; i < K_new; i++) {
+            for (size_t j = 0; j <= i; j++) {
+                const auto IJ = pairIndex(i, j);
+                if (IJ >= KL) {
+                    result.elements[pairIndex(IJ, KL)] = W(i,j);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+}  // namespace GQCP
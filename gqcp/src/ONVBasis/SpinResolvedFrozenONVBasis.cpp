@@ -50,6 +50,29 @@ SpinResolvedFrozenONVBasis::SpinResolvedFrozenONVBasis(const SpinResolvedONVBasi
 
 
 
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param address          the address (i.e. the ordening number) of a spin-resolved ONV in this ONV basis
+ *
+ *  @return the spin-resolved ONV with the corresponding address, in which the frozen orbitals are occupied
+ */
+SpinResolvedONV SpinResolvedFrozenONVBasis::makeONV(const size_t address) const {
+
+    const auto active_onv = this->active_onv_basis.makeONV(address);
+
+    // The frozen orbitals are the first X orbitals, i.e. the rightmost bits of the unsigned representations
+    const size_t frozen_representation = (1UL << this->X) - 1;
+    const SpinUnresolvedONV onv_alpha (this->get_K(), this->get_N_alpha(), (active_onv.alphaONV().get_unsigned_representation() << this->X) | frozen_representation);
+    const SpinUnresolvedONV onv_beta (this->get_K(), this->get_N_beta(), (active_onv.betaONV().get_unsigned_representation() << this->X) | frozen_representation);
+
+    return SpinResolvedONV(onv_alpha, onv_beta);
+}
+
+
+
 /*
  *  UNRESTRICTED
  */
@@ -0,0 +1,148 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "ONVBasis/SpinResolvedONV.hpp"
+
+
+namespace GQCP {
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param h                the one-electron integrals, expressed in an orthonormal orbital basis
+ *  @param g                the two-electron integrals (in chemist's notation), expressed in the same orthonormal orbital basis
+ *  @param other            another spin-resolved ONV
+ *
+ *  @return the matrix element <this|H|other> of the spin-restricted Hamiltonian with the given integrals, calculated with the Slater-Condon rules
+ */
+double SpinResolvedONV::calculateMatrixElement(const SquareMatrix<double>& h, const SquareRankFourTensor<double>& g, const SpinResolvedONV& other) const {
+
+    const auto& alpha_I = this->onv_alpha;
+    const auto& beta_I = this->onv_beta;
+    const auto& alpha_J = other.onv_alpha;
+    const auto& beta_J = other.onv_beta;
+
+    const auto number_of_alpha_excitations = alpha_I.countNumberOfDifferences(alpha_J) / 2;
+    const auto number_of_beta_excitations = beta_I.countNumberOfDifferences(beta_J) / 2;
+    if (number_of_alpha_excitations + number_of_beta_excitations > 2) {
+        return 0.0;
+    }
+
+    // The orbitals that are occupied in both ONVs
+    const auto alpha_occupations = alpha_I.findMatchingOccupations(alpha_J);
+    const auto beta_occupations = beta_I.findMatchingOccupations(beta_J);
+
+
+    // The sign of the operator string a^dagger_p a_q, or a^dagger_p a^dagger_r a_s a_q, that excites onv_J to onv_I
+    const auto calculate_sign = [] (const SpinUnresolvedONV& onv_J, const std::vector<size_t>& annihilation_indices, const std::vector<size_t>& creation_indices) {
+        auto onv = onv_J;
+        int sign = 1;
+        onv.annihilateAll(annihilation_indices, sign);
+        onv.createAll(creation_indices, sign);
+        return sign;
+    };
+
+
+    // 0 excitations: the diagonal element
+    if ((number_of_alpha_excitations == 0) && (number_of_beta_excitations == 0)) {
+        double value = 0.0;
+        for (const auto& p : alpha_occupations) {
+            value += h(p,p);
+            for (const auto& q : alpha_occupations) {
+                value += 0.5 * (g(p,p,q,q) - g(p,q,q,p));
+            }
+            for (const auto& q : beta_occupations) {
+                value += g(p,p,q,q);
+            }
+        }
+
+        for (const auto& p : beta_occupations) {
+            value += h(p,p);
+            for (const auto& q : beta_occupations) {
+                value += 0.5 * (g(p,p,q,q) - g(p,q,q,p));
+            }
+        }
+
+        return value;
+    }
+
+
+    // 1 excitation in one of the spin components
+    const auto single_excitation_element = [&h, &g, &calculate_sign] (const SpinUnresolvedONV& onv_I, const SpinUnresolvedONV& onv_J, const std::vector<size_t>& same_spin_occupations, const std::vector<size_t>& other_spin_occupations) {
+
+        const auto p = onv_I.findDifferentOccupations(onv_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+        const auto q = onv_J.findDifferentOccupations(onv_I)[0];
+
+        double value = h(p,q);
+        for (const auto& r : same_spin_occupations) {
+            value += g(p,q,r,r) - g(p,r,r,q);
+        }
+        for (const auto& r : other_spin_occupations) {
+            value += g(p,q,r,r);
+        }
+
+        return calculate_sign(onv_J, {q}, {p}) * value;
+    };
+
+    if ((number_of_alpha_excitations == 1) && (number_of_beta_excitations == 0)) {
+        return single_excitation_element(alpha_I, alpha_J, alpha_occupations, beta_occupations);
+    }
+
+    if ((number_of_alpha_excitations == 0) && (number_of_beta_excitations == 1)) {
+        return single_excitation_element(beta_I, beta_J, beta_occupations, alpha_occupations);
+    }
+
+
+    // 1 excitation in both spin components
+    if ((number_of_alpha_excitations == 1) && (number_of_beta_excitations == 1)) {
+        const auto p = alpha_I.findDifferentOccupations(alpha_J)[0];
+        const auto q = alpha_J.findDifferentOccupations(alpha_I)[0];
+        const auto r = beta_I.findDifferentOccupations(beta_J)[0];
+        const auto s = beta_J.findDifferentOccupations(beta_I)[0];
+
+        return calculate_sign(alpha_J, {q}, {p}) * calculate_sign(beta_J, {s}, {r}) * g(p,q,r,s);
+    }
+
+
+    // 2 excitations in one of the spin components
+    const auto double_excitation_element = [&g, &calculate_sign] (const SpinUnresolvedONV& onv_I, const SpinUnresolvedONV& onv_J) {
+
+        const auto created_indices = onv_I.findDifferentOccupations(onv_J);  // we're sure that there are 2 elements in the std::vector<size_t>
+        const auto annihilated_indices = onv_J.findDifferentOccupations(onv_I);
+
+        const auto p = created_indices[0];
+        const auto r = created_indices[1];
+        const auto q = annihilated_indices[0];
+        const auto s = annihilated_indices[1];
+
+        // a^dagger_p a^dagger_r a_s a_q: first annihilate q, then s, then create r, then p
+        return calculate_sign(onv_J, {q, s}, {r, p}) * (g(p,q,r,s) - g(p,s,r,q));
+    };
+
+    if (number_of_alpha_excitations == 2) {
+        return double_excitation_element(alpha_I, alpha_J);
+    } else {
+        return double_excitation_element(beta_I, beta_J);
+    }
+}
+
+
+
+}  // namespace GQCP
@@ -83,6 +83,18 @@ size_t SpinResolvedONVBasis::dimension() const {
 }
 
 
+/**
+ *  @param address          the address (i.e. the ordening number) of a spin-resolved ONV in this ONV basis
+ *
+ *  @return the spin-resolved ONV with the corresponding address
+ */
+SpinResolvedONV SpinResolvedONVBasis::makeONV(const size_t address) const {
+
+    const auto dim_beta = this->fock_space_beta.get_dimension();  // the address is I_alpha * dim_beta + I_beta
+    return SpinResolvedONV(this->fock_space_alpha.makeONV(address / dim_beta), this->fock_space_beta.makeONV(address % dim_beta));
+}
+
+
 /**
  *  Auxiliary method in order to calculate "theta(pq)",
  *  it returns a partition of a two-electron operator as one-electron operator
@@ -0,0 +1,139 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Operator/SecondQuantized/ActiveSpaceSQHamiltonian.hpp"
+
+#include "Basis/Integrals/IntegralCalculator.hpp"
+#include "Operator/FirstQuantized/Operator.hpp"
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param N_core                       the number of (doubly occupied) core orbitals
+ *  @param core_energy                  the energy of the doubly occupied core orbitals
+ *  @param active_sq_hamiltonian        the effective Hamiltonian expressed in the active orbitals
+ */
+ActiveSpaceSQHamiltonian::ActiveSpaceSQHamiltonian(const size_t N_core, const double core_energy, const SQHamiltonian<double>& active_sq_hamiltonian) :
+    N_core (N_core),
+    core_energy (core_energy),
+    active_sq_hamiltonian (active_sq_hamiltonian)
+{}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  Construct the active-space Hamiltonian from a Hamiltonian that is expressed in all orbitals.
+ * 
+ *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+ *  @param N_core               the number of (doubly occupied) core orbitals
+ *  @param N_active             the number of active orbitals
+ */
+ActiveSpaceSQHamiltonian ActiveSpaceSQHamiltonian::FromHamiltonian(const SQHamiltonian<double>& sq_hamiltonian, const size_t N_core, const size_t N_active) {
+
+    // The orbitals are the basis functions themselves, so the coefficient matrix is a unit matrix
+    const auto K = sq_hamiltonian.dimension();
+    return ActiveSpaceSQHamiltonian::FromScalarBasisIntegrals(sq_hamiltonian.core().parameters(), sq_hamiltonian.twoElectron().parameters(), MatrixX<double>::Identity(K, K), N_core, N_active);
+}
+
+
+/**
+ *  Construct the molecular active-space Hamiltonian directly from the integrals over the underlying scalar basis, so that the two-electron integrals are only ever transformed to the active orbitals.
+ * 
+ *  @param spinor_basis         the spinor basis, whose coefficient matrix contains the (orthonormal) core and active orbitals
+ *  @param molecule             the molecule
+ *  @param N_core               the number of (doubly occupied) core orbitals
+ *  @param N_active             the number of active orbitals
+ * 
+ *  @note Like SQHamiltonian::Molecular, the internuclear repulsion energy is not included in the core energy.
+ */
+ActiveSpaceSQHamiltonian ActiveSpaceSQHamiltonian::Molecular(const RSpinorBasis<double, GTOShell>& spinor_basis, const Molecule& molecule, const size_t N_core, const size_t N_active) {
+
+    // Calculate the integrals over the scalar basis directly, since quantizing in the spinor basis would transform them to all the orbitals
+    const auto& scalar_basis = spinor_basis.scalarBasis();
+
+    const auto T = IntegralCalculator::calculateLibintIntegrals(Operator::Kinetic(), scalar_basis);
+    const auto V = IntegralCalculator::calculateLibintIntegrals(Operator::NuclearAttraction(molecule), scalar_basis);
+    const SquareMatrix<double> H = T + V;
+    const auto g = IntegralCalculator::calculateLibintIntegrals(Operator::Coulomb(), scalar_basis);
+
+    return ActiveSpaceSQHamiltonian::FromScalarBasisIntegrals(H, g, spinor_basis.coefficientMatrix(), N_core, N_active);
+}
+
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  @param h                    the one-electron integrals in a scalar basis
+ *  @param g                    the two-electron integrals in the same scalar basis
+ *  @param C                    the coefficient matrix, whose columns are the expansion coefficients of the orthonormal orbitals in terms of the scalar basis
+ *  @param N_core               the number of (doubly occupied) core orbitals
+ *  @param N_active             the number of active orbitals
+ * 
+ *  @return the active-space Hamiltonian, for which the two-electron integrals are only transformed to the active orbitals
+ */
+ActiveSpaceSQHamiltonian ActiveSpaceSQHamiltonian::FromScalarBasisIntegrals(const SquareMatrix<double>& h, const QCRankFourTensor<double>& g, const MatrixX<double>& C, const size_t N_core, const size_t N_active) {
+
+    const auto K = g.dimension();
+    if (N_active == 0) {
+        throw std::invalid_argument("ActiveSpaceSQHamiltonian::FromScalarBasisIntegrals(const SquareMatrix<double>&, const QCRankFourTensor<double>&, const MatrixX<double>&, const size_t, const size_t): The number of active orbitals should be positive.");
+    }
+    if (N_core + N_active > static_cast<size_t>(C.cols())) {
+        throw std::invalid_argument("ActiveSpaceSQHamiltonian::FromScalarBasisIntegrals(const SquareMatrix<double>&, const QCRankFourTensor<double>&, const MatrixX<double>&, const size_t, const size_t): The number of core and active orbitals exceeds the number of orbitals.");
+    }
+
+
+    // The core orbitals only enter through the density matrix D = 2 C_core C_core^T of the doubly occupied core, which we use to set up the inactive Fock matrix F = h + J(D) - 1/2 K(D) in the scalar basis
+    const MatrixX<double> C_core = C.leftCols(N_core);
+    const MatrixX<double> C_active = C.middleCols(N_core, N_active);
+    const SquareMatrix<double> D = 2 * C_core * C_core.transpose();
+
+    Eigen::TensorMap<Eigen::Tensor<const double, 2>> D_tensor (D.data(), K, K);
+    Eigen::array<Eigen::IndexPair<int>, 2> direct_contraction_pair = {Eigen::IndexPair<int>(3, 0), Eigen::IndexPair<int>(2, 1)};  // (mu nu|rho lambda) D(lambda rho)
+    Eigen::array<Eigen::IndexPair<int>, 2> exchange_contraction_pair = {Eigen::IndexPair<int>(1, 0), Eigen::IndexPair<int>(2, 1)};  // (mu lambda|rho nu) D(lambda rho)
+
+    Tensor<double, 2> direct_contraction = g.contract(D_tensor, direct_contraction_pair);
+    Tensor<double, 2> exchange_contraction = g.contract(D_tensor, exchange_contraction_pair);
+    Eigen::Map<Eigen::MatrixXd> J (direct_contraction.data(), K, K);
+    Eigen::Map<Eigen::MatrixXd> K_matrix (exchange_contraction.data(), K, K);
+
+    const SquareMatrix<double> F = h + J - 0.5 * K_matrix;
+
+
+    // E_core = 1/2 tr(D (h + F)), and the active-space integrals are found by transforming with the active orbitals only
+    const double core_energy = 0.5 * (D * (h + F)).trace();
+
+    const QCMatrix<double> h_active = C_active.transpose() * F * C_active;
+    const auto g_active = g.transformed(C_active);
+
+    return ActiveSpaceSQHamiltonian(N_core, core_energy, SQHamiltonian<double>(ScalarSQOneElectronOperator<double>{h_active}, ScalarSQTwoElectronOperator<double>{g_active}));
+}
+
+
+}  // namespace GQCP
@@ -0,0 +1,213 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Operator/SecondQuantized/BinaryIntegralFile.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+namespace {
+
+
+constexpr char magic_string[8] = {'G', 'Q', 'C', 'P', 'I', 'N', 'T', 'S'};  // identifies binary integral files
+constexpr std::uint64_t format_version = 1;
+constexpr size_t header_size = 64;  // a multiple of the size of a double, so that the integrals are aligned
+
+
+/**
+ *  The header at the start of every binary integral file.
+ */
+struct Header {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t dimension;
+    char reserved[header_size - 24];
+};
+
+
+/**
+ *  @param K            the number of orbitals
+ * 
+ *  @return the number of bytes of a binary integral file for the given number of orbitals
+ */
+size_t fileSize(const size_t K) {
+
+    const size_t number_of_pairs = K * (K + 1) / 2;
+    return header_size + (number_of_pairs + number_of_pairs * (number_of_pairs + 1) / 2) * sizeof(double);
+}
+
+
+}  // namespace
+
+
+
+/*
+ *  PRIVATE CONSTRUCTORS
+ */
+
+/**
+ *  @param K            the number of orbitals
+ *  @param file         the memory-mapped file
+ */
+BinaryIntegralFile::BinaryIntegralFile(const size_t K, MemoryMappedFile&& file) :
+    K (K),
+    file (std::move(file))
+{}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  Open (i.e. memory-map) a binary integral file for reading.
+ * 
+ *  @param filename         the name of the binary integral file
+ */
+BinaryIntegralFile BinaryIntegralFile::Open(const std::string& filename) {
+
+    auto file = MemoryMappedFile::Open(filename);
+
+    Header header;
+    if (file.size() < header_size) {
+        throw std::invalid_argument("BinaryIntegralFile::Open(const std::string&): The given file is too small to be a binary integral file.");
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+
+    if ((std::memcmp(header.magic, magic_string, sizeof(magic_string)) != 0) || (header.version != format_version)) {
+        throw std::invalid_argument("BinaryIntegralFile::Open(const std::string&): The given file is not a binary integral file.");
+    }
+    if (file.size() != fileSize(header.dimension)) {
+        throw std::invalid_argument("BinaryIntegralFile::Open(const std::string&): The size of the given file does not match the number of orbitals in its header.");
+    }
+
+    return BinaryIntegralFile(header.dimension, std::move(file));
+}
+
+
+
+/*
+ *  STATIC PUBLIC METHODS
+ */
+
+/**
+ *  Write the given integrals to a binary integral file.
+ * 
+ *  @param filename         the name of the binary integral file
+ *  @param h                the (symmetric) one-electron integrals
+ *  @param g                the symmetry-packed two-electron integrals
+ */
+void BinaryIntegralFile::Write(const std::string& filename, const SquareMatrix<double>& h, const SymmetryPackedRankFourTensor& g) {
+
+    const auto K = g.dimension();
+    if (h.dimension() != K) {
+        throw std::invalid_argument("BinaryIntegralFile::Write(const std::string&, const SquareMatrix<double>&, const SymmetryPackedRankFourTensor&): The dimensions of the one- and two-electron integrals are incompatible.");
+    }
+
+    std::ofstream output_file_stream (filename, std::ios::binary);
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("BinaryIntegralFile::Write(const std::string&, const SquareMatrix<double>&, const SymmetryPackedRankFourTensor&): Could not open the given file for writing.");
+    }
+
+    Header header {};
+    std::memcpy(header.magic, magic_string, sizeof(magic_string));
+    header.version = format_version;
+    header.dimension = K;
+    output_file_stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    std::vector<double> h_packed;
+    h_packed.reserve(K * (K + 1) / 2);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            h_packed.push_back(h(p,q));
+        }
+    }
+    output_file_stream.write(reinterpret_cast<const char*>(h_packed.data()), h_packed.size() * sizeof(double));
+    output_file_stream.write(reinterpret_cast<const char*>(g.data()), g.size() * sizeof(double));
+
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("BinaryIntegralFile::Write(const std::string&, const SquareMatrix<double>&, const SymmetryPackedRankFourTensor&): Could not write the integrals to the given file.");
+    }
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @return the one-electron integrals
+ */
+SquareMatrix<double> BinaryIntegralFile::oneElectronIntegrals() const {
+
+    const auto K = this->K;
+    const double* h_packed = this->oneElectronData();
+
+    SquareMatrix<double> h (K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            h(p,q) = h_packed[SymmetryPackedRankFourTensor::pairIndex(p, q)];
+            h(q,p) = h(p,q);
+        }
+    }
+
+    return h;
+}
+
+
+/**
+ *  @return the symmetry-packed two-electron integrals
+ */
+SymmetryPackedRankFourTensor BinaryIntegralFile::twoElectronIntegrals() const {
+
+    SymmetryPackedRankFourTensor g (this->K);
+    std::memcpy(g.data(), this->twoElectronData(), g.size() * sizeof(double));  // the storage orders are identical
+
+    return g;
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  @return a pointer to the packed one-electron integrals in the mapped file
+ */
+const double* BinaryIntegralFile::oneElectronData() const {
+    return reinterpret_cast<const double*>(this->file.data() + header_size);
+}
+
+
+/**
+ *  @return a pointer to the packed two-electron integrals in the mapped file
+ */
+const double* BinaryIntegralFile::twoElectronData() const {
+    return this->oneElectronData() + this->K * (this->K + 1) / 2;
+}
+
+
+}  // namespace GQCP
@@ -0,0 +1,471 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
+
+#include "Basis/Integrals/IntegralCalculator.hpp"
+#include "Basis/Integrals/IntegralEngine.hpp"
+#include "Operator/FirstQuantized/Operator.hpp"
+
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param B            the fitted factors as a (K*K)xN_aux matrix, whose column P contains the KxK matrix B^P in column-major order
+ *  @param K            the dimension of the orbital basis
+ */
+DFTwoElectronOperator::DFTwoElectronOperator(const MatrixX<double>& B, const size_t K) :
+    K (K),
+    B (B)
+{
+    if (static_cast<size_t>(B.rows()) != K * K) {
+        throw std::invalid_argument("DFTwoElectronOperator::DFTwoElectronOperator(const MatrixX<double>&, const size_t): The number of rows of the given factors should be K*K.");
+    }
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  Fit the two-electron integrals over a scalar basis in an auxiliary basis, using libint to calculate the two- and three-center integrals.
+ * 
+ *  @param scalar_basis                 the scalar basis in which the two-electron integrals should be expressed
+ *  @param auxiliary_scalar_basis       the auxiliary scalar basis
+ *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+ */
+DFTwoElectronOperator DFTwoElectronOperator::Calculate(const ScalarBasis<GTOShell>& scalar_basis, const ScalarBasis<GTOShell>& auxiliary_scalar_basis, const double threshold) {
+
+    const auto metric = IntegralCalculator::calculateLibintTwoCenterIntegrals(Operator::Coulomb(), auxiliary_scalar_basis);
+    const auto three_center_integrals = IntegralCalculator::calculateLibintThreeCenterIntegrals(Operator::Coulomb(), auxiliary_scalar_basis, scalar_basis);
+
+    return DFTwoElectronOperator::FromThreeCenterIntegrals(three_center_integrals, metric, scalar_basis.numberOfBasisFunctions(), threshold);
+}
+
+
+/**
+ *  Decompose the two-electron integrals over a scalar basis by a pivoted incomplete Cholesky decomposition, using libint to calculate only the diagonal and the columns of the selected pivots.
+ * 
+ *  @param scalar_basis                 the scalar basis in which the two-electron integrals should be expressed
+ *  @param tolerance                    the tolerance on the largest remaining diagonal element g(p,q,p,q) - sum_J L^J(p,q)^2, which bounds the error of every approximate integral
+ * 
+ *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+ * 
+ *  @note The columns are calculated per pair of shells: once a pivot is selected, the integrals (p q|r s) for all basis functions r and s in the shell pair of the pivot are calculated and used as candidates for the following Cholesky vectors.
+ */
+DFTwoElectronOperator DFTwoElectronOperator::Cholesky(const ScalarBasis<GTOShell>& scalar_basis, const double tolerance) {
+
+    const auto shell_set = scalar_basis.shellSet();
+    const auto& shells = shell_set.asVector();
+    const auto K = shell_set.numberOfBasisFunctions();
+    const auto nsh = shell_set.numberOfShells();
+
+    auto engine = IntegralEngine::Libint(Operator::Coulomb(), shell_set.maximumNumberOfPrimitives(), shell_set.maximumAngularMomentum());
+    engine.prepare(shell_set, shell_set);
+
+    // Find the shell that every basis function belongs to, so that the shell pair of a pivot can be found
+    std::vector<size_t> shell_indices (K);
+    for (size_t shell_index = 0; shell_index < nsh; shell_index++) {
+        const auto bf_index = shell_set.basisFunctionIndex(shell_index);
+        for (size_t f = 0; f < shells[shell_index].numberOfBasisFunctions(); f++) {
+            shell_indices[bf_index + f] = shell_index;
+        }
+    }
+
+
+    // The diagonal (p q|p q) only needs the shell quartets (M N|M N)
+    VectorX<double> diagonal = VectorX<double>::Zero(K * K);
+    for (size_t shell_index1 = 0; shell_index1 < nsh; shell_index1++) {
+        const auto bf1_index = shell_set.basisFunctionIndex(shell_index1);
+
+        for (size_t shell_index2 = 0; shell_index2 <= shell_index1; shell_index2++) {
+            const auto bf2_index = shell_set.basisFunctionIndex(shell_index2);
+
+            const auto buffer = engine.calculateOverShellIndices(shell_set, shell_index1, shell_index2, shell_set, shell_index1, shell_index2);
+            if (buffer->areIntegralsAllZero()) {
+                continue;
+            }
+
+            for (size_t f1 = 0; f1 < buffer->numberOfBasisFunctionsInShell1(); f1++) {
+                for (size_t f2 = 0; f2 < buffer->numberOfBasisFunctionsInShell2(); f2++) {
+                    const auto value = buffer->value(0, f1, f2, f1, f2);
+                    diagonal((bf1_index + f1) + K * (bf2_index + f2)) = value;
+                    diagonal((bf2_index + f2) + K * (bf1_index + f1)) = value;
+                }
+            }
+        }
+    }
+
+
+    // For a pivot (r,s), calculate the columns (p q|r' s') for all r' and s' in the shell pair (R,S) of the pivot
+    const auto calculate_columns = [&] (const size_t pivot) {
+
+        const auto shell_index3 = shell_indices[pivot % K];
+        const auto shell_index4 = shell_indices[pivot / K];
+        const auto bf3_index = shell_set.basisFunctionIndex(shell_index3);
+        const auto bf4_index = shell_set.basisFunctionIndex(shell_index4);
+        const auto nbf3 = shells[shell_index3].numberOfBasisFunctions();
+        const auto nbf4 = shells[shell_index4].numberOfBasisFunctions();
+
+        std::vector<size_t> indices;
+        for (size_t f4 = 0; f4 < nbf4; f4++) {
+            for (size_t f3 = 0; f3 < nbf3; f3++) {
+                indices.push_back((bf3_index + f3) + K * (bf4_index + f4));
+            }
+        }
+
+        MatrixX<double> columns = MatrixX<double>::Zero(K * K, nbf3 * nbf4);
+        for (size_t shell_index1 = 0; shell_index1 < nsh; shell_index1++) {
+            const auto bf1_index = shell_set.basisFunctionIndex(shell_index1);
+
+            for (size_t shell_index2 = 0; shell_index2 <= shell_index1; shell_index2++) {  // (p q|r s) = (q p|r s)
+                const auto bf2_index = shell_set.basisFunctionIndex(shell_index2);
+
+                const auto buffer = engine.calculateOverShellIndices(shell_set, shell_index1, shell_index2, shell_set, shell_index3, shell_index4);
+                if (buffer->areIntegralsAllZero()) {
+                    continue;
+                }
+
+                for (size_t f1 = 0; f1 < buffer->numberOfBasisFunctionsInShell1(); f1++) {
+                    for (size_t f2 = 0; f2 < buffer->numberOfBasisFunctionsInShell2(); f2++) {
+                        for (size_t f3 = 0; f3 < nbf3; f3++) {
+                            for (size_t f4 = 0; f4 < nbf4; f4++) {
+                                const auto value = buffer->value(0, f1, f2, f3, f4);
+                                columns((bf1_index + f1) + K * (bf2_index + f2), f3 + nbf3 * f4) = value;
+                                columns((bf2_index + f2) + K * (bf1_index + f1), f3 + nbf3 * f4) = value;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return std::make_pair(indices, columns);
+    };
+
+    return DFTwoElectronOperator::PivotedCholesky(K, diagonal, calculate_columns, tolerance);
+}
+
+
+/**
+ *  Decompose the given two-electron integrals by a pivoted incomplete Cholesky decomposition.
+ * 
+ *  @param g                            the two-electron integrals
+ *  @param tolerance                    the tolerance on the largest remaining diagonal element g(p,q,p,q) - sum_J L^J(p,q)^2, which bounds the error of every approximate integral
+ * 
+ *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+ */
+DFTwoElectronOperator DFTwoElectronOperator::Cholesky(const QCRankFourTensor<double>& g, const double tolerance) {
+
+    // In column-major order, the tensor g(p,q,r,s) is the (K*K)x(K*K) supermatrix M(pq,rs)
+    const auto K = g.dimension();
+    const Eigen::Map<const Eigen::MatrixXd> M (g.data(), K * K, K * K);
+
+    const auto calculate_columns = [&M] (const size_t pivot) {
+        return std::make_pair(std::vector<size_t> {pivot}, MatrixX<double>(M.col(pivot)));
+    };
+
+    return DFTwoElectronOperator::PivotedCholesky(K, M.diagonal(), calculate_columns, tolerance);
+}
+
+
+/**
+ *  @param three_center_integrals       the three-center integrals as a (K*K)xN_aux matrix, whose column P contains the KxK matrix (p q|P) in column-major order
+ *  @param metric                       the Coulomb metric J(P,Q) = (P|Q)
+ *  @param K                            the dimension of the orbital basis
+ *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+ * 
+ *  @return the fitted two-electron integrals, using the symmetric fit B = (pq|P) J^{-1/2}
+ * 
+ *  @note The inverse square root of the metric is constructed from its eigendecomposition, in which eigenvectors with eigenvalues below the threshold are discarded, so that a (nearly) linearly dependent auxiliary basis is handled gracefully.
+ */
+DFTwoElectronOperator DFTwoElectronOperator::FromThreeCenterIntegrals(const MatrixX<double>& three_center_integrals, const SquareMatrix<double>& metric, const size_t K, const double threshold) {
+
+    if (three_center_integrals.cols() != metric.cols()) {
+        throw std::invalid_argument("DFTwoElectronOperator::FromThreeCenterIntegrals(const MatrixX<double>&, const SquareMatrix<double>&, const size_t, const double): The number of columns of the three-center integrals should match the dimension of the metric.");
+    }
+
+    // Construct J^{-1/2} from the eigenvectors of J that have a non-negligible eigenvalue
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (metric);
+    const auto& eigenvalues = eigensolver.eigenvalues();
+    const auto& eigenvectors = eigensolver.eigenvectors();
+
+    const size_t N_aux = metric.cols();
+    Eigen::MatrixXd J_inverse_sqrt = Eigen::MatrixXd::Zero(N_aux, N_aux);
+    for (size_t P = 0; P < N_aux; P++) {
+        if (eigenvalues(P) > threshold) {
+            J_inverse_sqrt += eigenvectors.col(P) * eigenvectors.col(P).transpose() / std::sqrt(eigenvalues(P));
+        }
+    }
+
+    MatrixX<double> B (three_center_integrals.rows(), N_aux);
+    B.noalias() = three_center_integrals * J_inverse_sqrt;
+    return DFTwoElectronOperator(B, K);
+}
+
+
+/**
+ *  Fit the molecular two-electron integrals, i.e. the integrals over the orbitals of the given spinor basis.
+ * 
+ *  @param spinor_basis                 the spinor basis, whose coefficient matrix contains the orbitals
+ *  @param molecule                     the molecule on whose nuclei the auxiliary basis functions should be centered
+ *  @param auxiliary_basisset_name      the name of the auxiliary basisset, e.g. "def2-universal-jkfit"
+ *  @param threshold                    the threshold below which eigenvalues of the Coulomb metric are considered to be zero
+ */
+DFTwoElectronOperator DFTwoElectronOperator::Molecular(const RSpinorBasis<double, GTOShell>& spinor_basis, const Molecule& molecule, const std::string& auxiliary_basisset_name, const double threshold) {
+
+    const ScalarBasis<GTOShell> auxiliary_scalar_basis (molecule, auxiliary_basisset_name);
+    return DFTwoElectronOperator::Calculate(spinor_basis.scalarBasis(), auxiliary_scalar_basis, threshold).transformed(spinor_basis.coefficientMatrix());
+}
+
+
+
+/*
+ *  OPERATORS
+ */
+
+/**
+ *  @return the (approximate) two-electron integral g(p,q,r,s)
+ */
+double DFTwoElectronOperator::operator()(const size_t p, const size_t q, const size_t r, const size_t s) const {
+
+    return this->B.row(p + this->K * q).dot(this->B.row(r + this->K * s));
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the Coulomb matrix J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r)
+ */
+SquareMatrix<double> DFTwoElectronOperator::calculateCoulombMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+
+    // gamma(P) = sum_{r,s} B^P(r,s) D(s,r), after which J(p,q) = sum_P B^P(p,q) gamma(P)
+    const Eigen::MatrixXd D_transpose = D.transpose();
+    const Eigen::VectorXd gamma = this->B.transpose() * Eigen::Map<const Eigen::VectorXd>(D_transpose.data(), K * K);
+    const Eigen::VectorXd J_vectorized = this->B * gamma;
+
+    return SquareMatrix<double>(Eigen::Map<const Eigen::MatrixXd>(J_vectorized.data(), K, K));
+}
+
+
+/**
+ *  @param D                a (density) matrix
+ * 
+ *  @return the exchange matrix K(p,s) = sum_{q,r} g(p,q,r,s) D(q,r)
+ */
+SquareMatrix<double> DFTwoElectronOperator::calculateExchangeMatrix(const SquareMatrix<double>& D) const {
+
+    const auto K = this->K;
+    const size_t N_aux = this->B.cols();
+    SquareMatrix<double> K_matrix = SquareMatrix<double>::Zero(K, K);
+
+    // K = sum_P B^P D B^P
+    #pragma omp parallel
+    {
+        Eigen::MatrixXd K_thread = Eigen::MatrixXd::Zero(K, K);
+        Eigen::MatrixXd BD (K, K);
+
+        #pragma omp for schedule(static)
+        for (size_t P = 0; P < N_aux; P++) {
+            const Eigen::Map<const Eigen::MatrixXd> B_P (this->B.col(P).data(), K, K);
+            BD.noalias() = B_P * D;
+            K_thread.noalias() += BD * B_P;
+        }
+
+        #pragma omp critical
+        K_matrix += K_thread;
+    }
+
+    return K_matrix;
+}
+
+
+/**
+ *  @param P                the index of an auxiliary basis function
+ * 
+ *  @return the KxK matrix B^P
+ */
+SquareMatrix<double> DFTwoElectronOperator::factorMatrix(const size_t P) const {
+
+    return SquareMatrix<double>(Eigen::Map<const Eigen::MatrixXd>(this->B.col(P).data(), this->K, this->K));
+}
+
+
+/**
+ *  @return the full K^4 tensor of the (approximate) two-electron integrals
+ */
+QCRankFourTensor<double> DFTwoElectronOperator::toTensor() const {
+
+    // In column-major order, the tensor g(p,q,r,s) is the (K*K)x(K*K) matrix M(pq,rs) = sum_P B(pq,P) B(rs,P)
+    const auto K = this->K;
+    QCRankFourTensor<double> g (K);
+    Eigen::Map<Eigen::MatrixXd>(g.data(), K * K, K * K).noalias() = this->B * this->B.transpose();
+
+    return g;
+}
+
+
+/**
+ *  @param C    the coefficient matrix, whose columns are the expansion coefficients of the new orbitals in terms of the current ones; it may have fewer columns than rows (e.g. to only transform to an active space)
+ *
+ *  @return the density-fitted two-electron integrals expressed in the new orbitals, i.e. with the factors B'^P = C^T B^P C
+ * 
+ *  @note Transforming the factors scales as O(K^3 N_aux) instead of the O(K^5) of the transformation of the full tensor.
+ */
+DFTwoElectronOperator DFTwoElectronOperator::transformed(const MatrixX<double>& C) const {
+
+    return DFTwoElectronOperator(this->transformedFactors(C, C), C.cols());
+}
+
+
+/**
+ *  @param C1   the coefficient matrix for the first index of every factor
+ *  @param C2   the coefficient matrix for the second index of every factor
+ * 
+ *  @return the factors B'^P = C1^T B^P C2 as a (n1*n2)xN_aux matrix, in which n1 and n2 are the numbers of columns of C1 and C2, e.g. the factors (i a|P) over occupied and virtual orbitals
+ */
+MatrixX<double> DFTwoElectronOperator::transformedFactors(const MatrixX<double>& C1, const MatrixX<double>& C2) const {
+
+    const auto K = this->K;
+    if ((static_cast<size_t>(C1.rows()) != K) || (static_cast<size_t>(C2.rows()) != K)) {
+        throw std::invalid_argument("DFTwoElectronOperator::transformedFactors(const MatrixX<double>&, const MatrixX<double>&): The number of rows of the given coefficient matrices should match the dimension of the orbital basis.");
+    }
+
+    const size_t n1 = C1.cols();
+    const size_t n2 = C2.cols();
+    const size_t N_aux = this->B.cols();
+
+    MatrixX<double> B_transformed (n1 * n2, N_aux);
+    #pragma omp parallel
+    {
+        Eigen::MatrixXd BC (K, n2);
+
+        #pragma omp for schedule(static)
+        for (size_t P = 0; P < N_aux; P++) {
+            BC.noalias() = Eigen::Map<const Eigen::MatrixXd>(this->B.col(P).data(), K, K) * C2;
+            Eigen::Map<Eigen::MatrixXd>(B_transformed.col(P).data(), n1, n2).noalias() = C1.transpose() * BC;
+        }
+    }
+
+    return B_transformed;
+}
+
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  Perform a pivoted incomplete Cholesky decomposition of the two-electron integral supermatrix M(pq,rs) = g(p,q,r,s), in which pq = p + K*q is the compound index of a pair.
+ * 
+ *  @param K                            the dimension of the orbital basis
+ *  @param diagonal                     the diagonal M(pq,pq) of the supermatrix
+ *  @param calculate_columns            a function that, for a given pivot, returns a batch of compound indices that includes the pivot, together with the columns of the supermatrix that correspond to them
+ *  @param tolerance                    the tolerance on the largest remaining diagonal element
+ * 
+ *  @return the Cholesky vectors L^J(p,q) as the factors of the two-electron integrals
+ * 
+ *  @note Within a batch of columns, only the candidates whose remaining diagonal element is larger than both the tolerance and a fraction of the largest remaining diagonal element are used, which keeps the decomposition numerically stable.
+ */
+DFTwoElectronOperator DFTwoElectronOperator::PivotedCholesky(const size_t K, const VectorX<double>& diagonal, const std::function<std::pair<std::vector<size_t>, MatrixX<double>>(const size_t)>& calculate_columns, const double tolerance) {
+
+    if (static_cast<size_t>(diagonal.size()) != K * K) {
+        throw std::invalid_argument("DFTwoElectronOperator::PivotedCholesky(const size_t, const VectorX<double>&, const std::function<...>&, const double): The given diagonal should have K*K elements.");
+    }
+
+    const double screening_factor = 1.0e-02;  // the fraction of the largest remaining diagonal element that a candidate in a batch should exceed
+
+    Eigen::VectorXd d = diagonal;  // the remaining diagonal
+    Eigen::MatrixXd L (K * K, std::max<size_t>(K, 1));  // the Cholesky vectors, whose number of columns is grown when needed
+    size_t number_of_vectors = 0;
+
+    while (true) {
+        Eigen::Index pivot;
+        const double d_max = d.maxCoeff(&pivot);
+        if ((d_max <= tolerance) || (number_of_vectors == K * K)) {
+            break;
+        }
+
+        // Calculate the columns of the batch and subtract the contributions of the previous Cholesky vectors
+        auto batch = calculate_columns(static_cast<size_t>(pivot));
+        const auto& indices = batch.first;
+        auto& columns = batch.second;
+
+        Eigen::MatrixXd L_batch (number_of_vectors, indices.size());
+        for (size_t c = 0; c < indices.size(); c++) {
+            L_batch.col(c) = L.row(indices[c]).head(number_of_vectors).transpose();
+        }
+        columns.noalias() -= L.leftCols(number_of_vectors) * L_batch;
+
+
+        // Turn the qualifying candidates into new Cholesky vectors, in the order of decreasing remaining diagonal elements
+        std::vector<size_t> order (indices.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&d, &indices] (const size_t a, const size_t b) { return d(indices[a]) > d(indices[b]); });
+
+        const double d_min = std::max(tolerance, screening_factor * d_max);
+        for (size_t i = 0; i < order.size(); i++) {
+            const auto c = order[i];
+            const auto index = indices[c];
+            if ((d(index) <= d_min) || (number_of_vectors == K * K)) {
+                continue;
+            }
+
+            if (number_of_vectors == static_cast<size_t>(L.cols())) {
+                L.conservativeResize(Eigen::NoChange, std::min(2 * L.cols(), static_cast<Eigen::Index>(K * K)));
+            }
+            L.col(number_of_vectors) = columns.col(c) / std::sqrt(d(index));
+
+            // Update the remaining candidates of this batch and the remaining diagonal
+            for (size_t j = i + 1; j < order.size(); j++) {
+                const auto other = order[j];
+                columns.col(other) -= L(indices[other], number_of_vectors) * L.col(number_of_vectors);
+            }
+            d -= L.col(number_of_vectors).cwiseAbs2();
+            d(index) = 0.0;
+            number_of_vectors++;
+        }
+    }
+
+    return DFTwoElectronOperator(L.leftCols(number_of_vectors), K);
+}
+
+
+}  // namespace GQCP
@@ -0,0 +1,189 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Processing/Cube/CubeFile.hpp"
+
+#include "Basis/ScalarBasis/GTOGridEvaluator.hpp"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+
+
+namespace GQCP {
+
+
+/*
+ *  PUBLIC STATIC METHODS
+ */
+
+/**
+ *  Write a cube file for the given fields
+ * 
+ *  @param filename                 the name of the cube file
+ *  @param molecule                 the molecule whose nuclei are written in the header
+ *  @param grid                     the grid on which the fields are written
+ *  @param slab_function            the function that calculates the values of the fields at the points of a slab
+ *  @param comment                  a description that is written in the header
+ *  @param orbital_indices          the (zero-based) indices of the orbitals that are written, if the fields are orbitals; leave empty if a single scalar field (like a density) is written
+ */
+void CubeFile::Write(const std::string& filename, const Molecule& molecule, const CubicGrid& grid, const SlabFunction& slab_function, const std::string& comment, const std::vector<size_t>& orbital_indices) {
+
+    std::ofstream output_file_stream (filename);
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("CubeFile::Write(std::string, Molecule, CubicGrid, SlabFunction, std::string, std::vector<size_t>): Could not open the given file for writing.");
+    }
+
+    const auto& nuclei = molecule.nuclearFramework().nucleiAsVector();
+    const auto& origin = grid.originPosition();
+    const auto& numbers_of_steps = grid.numbersOfSteps();
+    const auto& step_sizes = grid.stepSizes();
+    const size_t number_of_fields = orbital_indices.empty() ? 1 : orbital_indices.size();
+    char buffer[128];
+
+
+    // The header: two comment lines, the origin and the axes of the grid, and the nuclei. For orbitals, the number of atoms is negative and is followed by a line with the orbital indices.
+    output_file_stream << "GQCP cube file\n" << comment << '\n';
+
+    const long number_of_atoms = orbital_indices.empty() ? static_cast<long>(nuclei.size()) : -static_cast<long>(nuclei.size());
+    std::snprintf(buffer, sizeof(buffer), "%5ld%12.6f%12.6f%12.6f\n", number_of_atoms, origin(0), origin(1), origin(2));
+    output_file_stream << buffer;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        std::array<double, 3> step {0.0, 0.0, 0.0};
+        step[axis] = step_sizes[axis];
+        std::snprintf(buffer, sizeof(buffer), "%5zu%12.6f%12.6f%12.6f\n", numbers_of_steps[axis], step[0], step[1], step[2]);
+        output_file_stream << buffer;
+    }
+
+    for (const auto& nucleus : nuclei) {
+        const auto& position = nucleus.position();
+        std::snprintf(buffer, sizeof(buffer), "%5zu%12.6f%12.6f%12.6f%12.6f\n", nucleus.charge(), static_cast<double>(nucleus.charge()), position(0), position(1), position(2));
+        output_file_stream << buffer;
+    }
+
+    if (!orbital_indices.empty()) {
+        std::snprintf(buffer, sizeof(buffer), "%5zu", orbital_indices.size());
+        output_file_stream << buffer;
+        for (const auto& index : orbital_indices) {
+            std::snprintf(buffer, sizeof(buffer), "%5zu", index + 1);  // cube files use one-based orbital indices
+            output_file_stream << buffer;
+        }
+        output_file_stream << '\n';
+    }
+
+
+    // The values are written slab by slab: for every point, all fields are written, with six values per line and a line break after every row of points along the z-axis
+    const size_t n_y = numbers_of_steps[1];
+    const size_t n_z = numbers_of_steps[2];
+    std::string slab_text;
+    for (size_t i = 0; i < numbers_of_steps[0]; i++) {
+        const auto values = slab_function(grid.slab(i));
+        if ((static_cast<size_t>(values.rows()) != n_y * n_z) || (static_cast<size_t>(values.cols()) != number_of_fields)) {
+            throw std::invalid_argument("CubeFile::Write(std::string, Molecule, CubicGrid, SlabFunction, std::string, std::vector<size_t>): The dimensions of the values returned by the slab function do not match the grid or the number of fields.");
+        }
+
+        slab_text.clear();
+        for (size_t j = 0; j < n_y; j++) {
+            size_t count = 0;
+            for (size_t k = 0; k < n_z; k++) {
+                for (size_t field = 0; field < number_of_fields; field++) {
+                    std::snprintf(buffer, sizeof(buffer), " %12.5E", values(j * n_z + k, field));
+                    slab_text += buffer;
+
+                    count++;
+                    if (count % 6 == 0) {
+                        slab_text += '\n';
+                    }
+                }
+            }
+            if (count % 6 != 0) {
+                slab_text += '\n';
+            }
+        }
+        output_file_stream << slab_text;
+    }
+
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("CubeFile::Write(std::string, Molecule, CubicGrid, SlabFunction, std::string, std::vector<size_t>): Could not write the values to the given file.");
+    }
+}
+
+
+/**
+ *  Write a cube file for the electron density
+ * 
+ *  @param filename                 the name of the cube file
+ *  @param molecule                 the molecule whose nuclei are written in the header
+ *  @param spinor_basis             the spinor basis in which the 1-DM is expressed
+ *  @param D                        the (spin-summed) 1-DM
+ *  @param grid                     the grid on which the density is written
+ */
+void CubeFile::WriteDensity(const std::string& filename, const Molecule& molecule, const RSpinorBasis<double, GTOShell>& spinor_basis, const OneRDM<double>& D, const CubicGrid& grid) {
+
+    const auto& C = spinor_basis.coefficientMatrix();
+    if (D.dimension() != C.cols()) {
+        throw std::invalid_argument("CubeFile::WriteDensity(std::string, Molecule, RSpinorBasis<double, GTOShell>, OneRDM<double>, CubicGrid): The dimension of the 1-DM does not match the number of orbitals.");
+    }
+
+    // Express the 1-DM in the scalar basis, so that every slab only requires the basis function values
+    const SquareMatrix<double> D_AO = C * D * C.transpose();
+    const GTOGridEvaluator evaluator (spinor_basis.scalarBasis());
+
+    const auto slab_function = [&evaluator, &D_AO] (const MatrixX<double>& points) {
+        return MatrixX<double>(evaluator.evaluateDensity(points, D_AO));
+    };
+
+    CubeFile::Write(filename, molecule, grid, slab_function, "Electron density");
+}
+
+
+/**
+ *  Write a cube file for a number of orbitals
+ * 
+ *  @param filename                 the name of the cube file
+ *  @param molecule                 the molecule whose nuclei are written in the header
+ *  @param spinor_basis             the spinor basis whose orbitals should be written
+ *  @param orbital_indices          the (zero-based) indices of the orbitals that should be written
+ *  @param grid                     the grid on which the orbitals are written
+ */
+void CubeFile::WriteOrbitals(const std::string& filename, const Molecule& molecule, const RSpinorBasis<double, GTOShell>& spinor_basis, const std::vector<size_t>& orbital_indices, const CubicGrid& grid) {
+
+    const auto& C = spinor_basis.coefficientMatrix();
+    if (orbital_indices.empty()) {
+        throw std::invalid_argument("CubeFile::WriteOrbitals(std::string, Molecule, RSpinorBasis<double, GTOShell>, std::vector<size_t>, CubicGrid): At least one orbital should be given.");
+    }
+
+    // Gather the coefficients of the requested orbitals
+    MatrixX<double> C_selected (C.rows(), orbital_indices.size());
+    for (size_t n = 0; n < orbital_indices.size(); n++) {
+        if (orbital_indices[n] >= static_cast<size_t>(C.cols())) {
+            throw std::invalid_argument("CubeFile::WriteOrbitals(std::string, Molecule, RSpinorBasis<double, GTOShell>, std::vector<size_t>, CubicGrid): One of the orbital indices is out of bounds.");
+        }
+        C_selected.col(n) = C.col(orbital_indices[n]);
+    }
+
+    const GTOGridEvaluator evaluator (spinor_basis.scalarBasis());
+    const auto slab_function = [&evaluator, &C_selected] (const MatrixX<double>& points) {
+        return evaluator.evaluateOrbitals(points, C_selected);
+    };
+
+    CubeFile::Write(filename, molecule, grid, slab_function, "Molecular orbitals", orbital_indices);
+}
+
+
+}  // namespace GQCP
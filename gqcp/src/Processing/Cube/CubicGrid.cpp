@@ -0,0 +1,157 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Processing/Cube/CubicGrid.hpp"
+
+#include <cmath>
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param origin                   the position of the first point of the grid, in bohr
+ *  @param numbers_of_steps         the number of points along the x-, y- and z-axis
+ *  @param step_sizes               the distance between two consecutive points along the x-, y- and z-axis, in bohr
+ */
+CubicGrid::CubicGrid(const Vector<double, 3>& origin, const std::array<size_t, 3>& numbers_of_steps, const std::array<double, 3>& step_sizes) :
+    origin (origin),
+    numbers_of_steps (numbers_of_steps),
+    step_sizes (step_sizes)
+{
+    for (size_t axis = 0; axis < 3; axis++) {
+        if (numbers_of_steps[axis] == 0) {
+            throw std::invalid_argument("CubicGrid::CubicGrid(Vector<double, 3>, std::array<size_t, 3>, std::array<double, 3>): the grid should have at least one point along every axis.");
+        }
+
+        if (step_sizes[axis] <= 0.0) {
+            throw std::invalid_argument("CubicGrid::CubicGrid(Vector<double, 3>, std::array<size_t, 3>, std::array<double, 3>): the step sizes should be positive.");
+        }
+    }
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  @param center                   the center of the grid, in bohr
+ *  @param number_of_steps          the number of points along every axis
+ *  @param step_size                the distance between two consecutive points along every axis, in bohr
+ * 
+ *  @return a cubic grid that is centered around the given point
+ */
+CubicGrid CubicGrid::Centered(const Vector<double, 3>& center, const size_t number_of_steps, const double step_size) {
+
+    const double half_length = 0.5 * (static_cast<double>(number_of_steps) - 1.0) * step_size;
+    const Vector<double, 3> origin = center.array() - half_length;
+
+    return CubicGrid(origin, {number_of_steps, number_of_steps, number_of_steps}, {step_size, step_size, step_size});
+}
+
+
+/**
+ *  @param molecule                 the molecule that should be enclosed
+ *  @param step_size                the distance between two consecutive points along every axis, in bohr
+ *  @param padding                  the distance between the outermost nuclei and the boundaries of the grid, in bohr
+ * 
+ *  @return a grid whose boxed volume encloses all the nuclei of the given molecule
+ */
+CubicGrid CubicGrid::Enclosing(const Molecule& molecule, const double step_size, const double padding) {
+
+    if (step_size <= 0.0) {
+        throw std::invalid_argument("CubicGrid::Enclosing(Molecule, double, double): the step size should be positive.");
+    }
+
+    const auto& nuclei = molecule.nuclearFramework().nucleiAsVector();
+    if (nuclei.empty()) {
+        throw std::invalid_argument("CubicGrid::Enclosing(Molecule, double, double): the molecule should contain at least one nucleus.");
+    }
+
+    Vector<double, 3> minimum = nuclei[0].position();
+    Vector<double, 3> maximum = nuclei[0].position();
+    for (const auto& nucleus : nuclei) {
+        minimum = minimum.cwiseMin(nucleus.position());
+        maximum = maximum.cwiseMax(nucleus.position());
+    }
+
+    const Vector<double, 3> origin = minimum.array() - padding;
+    std::array<size_t, 3> numbers_of_steps;
+    for (size_t axis = 0; axis < 3; axis++) {
+        const double length = maximum(axis) - minimum(axis) + 2 * padding;
+        numbers_of_steps[axis] = static_cast<size_t>(std::ceil(length / step_size)) + 1;
+    }
+
+    return CubicGrid(origin, numbers_of_steps, {step_size, step_size, step_size});
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param i            the index along the x-axis
+ *  @param j            the index along the y-axis
+ *  @param k            the index along the z-axis
+ * 
+ *  @return the position of the grid point with the given indices
+ */
+Vector<double, 3> CubicGrid::position(const size_t i, const size_t j, const size_t k) const {
+
+    Vector<double, 3> r = this->origin;
+    r(0) += i * this->step_sizes[0];
+    r(1) += j * this->step_sizes[1];
+    r(2) += k * this->step_sizes[2];
+
+    return r;
+}
+
+
+/**
+ *  @param i            the index along the x-axis
+ * 
+ *  @return the positions of the points in the slab with the given x-index, as rows of a (number of points per slab x 3)-matrix, with the z-index running fastest
+ */
+MatrixX<double> CubicGrid::slab(const size_t i) const {
+
+    if (i >= this->numbers_of_steps[0]) {
+        throw std::invalid_argument("CubicGrid::slab(size_t): the given index is out of bounds.");
+    }
+
+    const size_t n_y = this->numbers_of_steps[1];
+    const size_t n_z = this->numbers_of_steps[2];
+
+    MatrixX<double> points (n_y * n_z, 3);
+    for (size_t j = 0; j < n_y; j++) {
+        for (size_t k = 0; k < n_z; k++) {
+            points.row(j * n_z + k) = this->position(i, j, k).transpose();
+        }
+    }
+
+    return points;
+}
+
+
+}  // namespace GQCP
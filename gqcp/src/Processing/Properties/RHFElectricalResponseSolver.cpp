@@ -17,14 +17,95 @@
 // 
 #include "Processing/Properties/RHFElectricalResponseSolver.hpp"
 
+#include "Mathematical/Optimization/LinearEquation/LinearEquationEnvironment.hpp"
+#include "Mathematical/Optimization/LinearEquation/LinearEquationSolver.hpp"
 #include "Mathematical/Representation/BlockMatrix.hpp"
 #include "QCMethod/HF/RHF.hpp"
 #include "QCModel/HF/RHF.hpp"
 
+#include <stdexcept>
+
 
 namespace GQCP {
 
 
+namespace {
+
+
+/**
+ *  @param g                        the two-electron integrals expressed in an orthonormal orbital basis
+ *  @param F                        the inactive Fock matrix expressed in the same orbital basis
+ *  @param N_P                      the number of electron pairs
+ *  @param X                        the vectors (as columns) that the RHF orbital Hessian should act on, in column-major virtual-occupied order
+ * 
+ *  @return the products of the RHF orbital Hessian with the given vectors
+ * 
+ *  @note For every vector x, the RHF orbital Hessian product is
+ *      (H x)(a,i) = 4 [(F_vv X)(a,i) - (X F_oo)(a,i) + 4 J(a,i) - K[D](a,i) - K[D^T](a,i)],
+ *  in which X is the vector as a virtual-occupied matrix, D is the KxK matrix that contains X in its virtual-occupied block, J(p,q) = sum_{r,s} g(p,q,r,s) D(s,r) and K[D](p,s) = sum_{q,r} g(p,q,r,s) D(q,r).
+ */
+MatrixX<double> applyOrbitalHessian(const QCRankFourTensor<double>& g, const SquareMatrix<double>& F, const size_t N_P, const MatrixX<double>& X) {
+
+    const size_t K = g.dimension();
+    const size_t N_V = K - N_P;  // the number of virtual orbitals
+    const size_t n = X.cols();
+
+    using ConstMatrixMap = Eigen::Map<const Eigen::MatrixXd>;
+
+
+    // Collect vec(D^T) and vec(D) of every vector, so that all contractions with the two-electron integrals can be done as matrix-matrix products
+    Eigen::MatrixXd D_transpose_vectors = Eigen::MatrixXd::Zero(K * K, n);
+    Eigen::MatrixXd D_vectors = Eigen::MatrixXd::Zero(K * K, 2 * n);  // vec(D) followed by vec(D^T)
+    for (size_t k = 0; k < n; k++) {
+        const ConstMatrixMap X_k (X.col(k).data(), N_V, N_P);
+
+        Eigen::MatrixXd D = Eigen::MatrixXd::Zero(K, K);
+        D.block(N_P, 0, N_V, N_P) = X_k;
+        const Eigen::MatrixXd D_transpose = D.transpose();
+
+        D_transpose_vectors.col(k) = ConstMatrixMap(D_transpose.data(), K * K, 1);
+        D_vectors.col(k) = ConstMatrixMap(D.data(), K * K, 1);
+        D_vectors.col(n + k) = D_transpose_vectors.col(k);
+    }
+
+
+    // In column-major order, g(p,q,r,s) is the (K*K)x(K*K) matrix M(pq,rs), so that vec(J) = M vec(D^T)
+    const Eigen::MatrixXd J_vectors = ConstMatrixMap(g.data(), K * K, K * K) * D_transpose_vectors;
+
+    // For every s, g(p,q,r,s) is the Kx(K*K) matrix G_s(p,qr), so that K[D](p,s) = (G_s vec(D))(p)
+    Eigen::MatrixXd K_vectors (K * K, 2 * n);  // vec(K[D]) followed by vec(K[D^T])
+    #pragma omp parallel for schedule(static)
+    for (size_t s = 0; s < K; s++) {
+        const Eigen::MatrixXd K_s = ConstMatrixMap(g.data() + K * K * K * s, K, K * K) * D_vectors;  // the column s of every exchange matrix
+        for (size_t k = 0; k < 2 * n; k++) {
+            K_vectors.col(k).segment(K * s, K) = K_s.col(k);
+        }
+    }
+
+
+    // Assemble the products from the virtual-occupied blocks
+    const auto F_vv = F.block(N_P, N_P, N_V, N_V);
+    const auto F_oo = F.block(0, 0, N_P, N_P);
+
+    MatrixX<double> HX (N_V * N_P, n);
+    for (size_t k = 0; k < n; k++) {
+        const ConstMatrixMap X_k (X.col(k).data(), N_V, N_P);
+        const ConstMatrixMap J (J_vectors.col(k).data(), K, K);
+        const ConstMatrixMap K_D (K_vectors.col(k).data(), K, K);
+        const ConstMatrixMap K_D_transpose (K_vectors.col(n + k).data(), K, K);
+
+        Eigen::Map<Eigen::MatrixXd> HX_k (HX.col(k).data(), N_V, N_P);
+        HX_k = 4 * (F_vv * X_k - X_k * F_oo + 4 * J.block(N_P, 0, N_V, N_P) - K_D.block(N_P, 0, N_V, N_P) - K_D_transpose.block(N_P, 0, N_V, N_P));
+    }
+
+    return HX;
+}
+
+
+}  // namespace
+
+
+
 /*
  *  CONSTRUCTORS
  */
@@ -86,4 +167,85 @@ Matrix<double, Dynamic, 3> RHFElectricalResponseSolver::calculateParameterRespon
 }
 
 
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param sq_hamiltonian           the Hamiltonian parameters expressed in an orthonormal orbital basis
+ * 
+ *  @return the diagonal of the RHF orbital Hessian, in the same (column-major virtual-occupied) order as the parameter response force
+ */
+VectorX<double> RHFElectricalResponseSolver::calculateOrbitalHessianDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const {
+
+    const auto K = sq_hamiltonian.dimension();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto F = sq_hamiltonian.calculateInactiveFockian(this->N_P).parameters();
+
+    BlockMatrix<double> diagonal (this->N_P, K, 0, this->N_P);  // zero-initialize an object suitable for the representation of virtual-occupied (a,i) quantities
+    for (size_t i = 0; i < this->N_P; i++) {
+        for (size_t a = this->N_P; a < K; a++) {
+            diagonal(a,i) = 4 * (F(a,a) - F(i,i) + 3 * g(a,i,a,i) - g(a,a,i,i));  // the RHF orbital Hessian element (ai,ai)
+        }
+    }
+
+    return diagonal.asVector();
+}
+
+
+/**
+ *  @param sq_hamiltonian           the Hamiltonian parameters expressed in an orthonormal orbital basis
+ *  @param X                        the vectors (as columns) that the RHF orbital Hessian should act on, in the same (column-major virtual-occupied) order as the parameter response force
+ * 
+ *  @return the products of the RHF orbital Hessian with the given vectors
+ * 
+ *  @note The orbital Hessian is never constructed: every vector is turned into a virtual-occupied density-like matrix, which is contracted with the two-electron integrals like in a Fock matrix build.
+ */
+MatrixX<double> RHFElectricalResponseSolver::calculateOrbitalHessianProducts(const SQHamiltonian<double>& sq_hamiltonian, const MatrixX<double>& X) const {
+
+    const auto K = sq_hamiltonian.dimension();
+    if (static_cast<size_t>(X.rows()) != this->N_P * (K - this->N_P)) {
+        throw std::invalid_argument("RHFElectricalResponseSolver::calculateOrbitalHessianProducts(const SQHamiltonian<double>&, const MatrixX<double>&): The number of rows of the given vectors should be the number of non-redundant orbital rotation generators.");
+    }
+
+    const auto F = sq_hamiltonian.calculateInactiveFockian(this->N_P).parameters();
+    return applyOrbitalHessian(sq_hamiltonian.twoElectron().parameters(), F, this->N_P, X);
+}
+
+
+/**
+ *  Solve the linear response equations for the wave function response with a preconditioned conjugate gradient algorithm, for the three components of the dipole operator simultaneously.
+ * 
+ *  @param sq_hamiltonian                       the Hamiltonian parameters expressed in an orthonormal orbital basis
+ *  @param dipole_op                            the dipole integrals expressed in an orthonormal orbital basis
+ *  @param threshold                            the threshold on the norm of the residual of every component
+ *  @param maximum_number_of_iterations         the maximum number of iterations the algorithm may perform
+ * 
+ *  @return the wave function response as an (Nx3)-matrix
+ * 
+ *  @note Only vectors of the dimension of the response force are stored, instead of the full RHF orbital Hessian (see calculateOrbitalHessianProducts()).
+ */
+Matrix<double, Dynamic, 3> RHFElectricalResponseSolver::calculateWaveFunctionResponseIterative(const SQHamiltonian<double>& sq_hamiltonian, const VectorSQOneElectronOperator<double> dipole_op, const double threshold, const size_t maximum_number_of_iterations) const {
+
+    const auto N_P = this->N_P;
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const SquareMatrix<double> F = sq_hamiltonian.calculateInactiveFockian(N_P).parameters();  // only calculate the inactive Fock matrix once
+
+    const auto matrix_product_function = [&g, &F, N_P] (const MatrixX<double>& X) {
+        return applyOrbitalHessian(g, F, N_P, X);
+    };
+    const auto F_p = this->calculateParameterResponseForce(dipole_op);  // has 3 columns
+
+
+    // Solve k_p x = -F_p, in which k_p is the RHF orbital Hessian
+    auto environment = LinearEquationEnvironment<double>::Iterative(matrix_product_function, this->calculateOrbitalHessianDiagonal(sq_hamiltonian), -F_p);
+    auto solver = LinearEquationSolver<double>::ConjugateGradient(threshold, maximum_number_of_iterations);
+    solver.perform(environment);
+
+    const Matrix<double, Dynamic, 3> x = environment.x;
+    return x;
+}
+
 }  // namespace GQCP
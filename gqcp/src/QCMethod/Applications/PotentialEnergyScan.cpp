@@ -0,0 +1,320 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "QCMethod/Applications/PotentialEnergyScan.hpp"
+
+#include "Basis/Integrals/IntegralCalculator.hpp"
+#include "Basis/Integrals/IntegralEngine.hpp"
+#include "Basis/ScalarBasis/GTOBasisSet.hpp"
+#include "Mathematical/Optimization/Eigenproblem/Davidson/DavidsonSolver.hpp"
+#include "ONVBasis/SpinResolvedONVBasis.hpp"
+#include "Operator/FirstQuantized/Operator.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/CI/CI.hpp"
+#include "QCMethod/CI/CIEnvironment.hpp"
+#include "QCMethod/CI/CISigmaVector.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/FCI.hpp"
+#include "QCMethod/HF/DiagonalRHFFockMatrixObjective.hpp"
+#include "QCMethod/HF/RHF.hpp"
+#include "QCMethod/HF/RHFSCFSolver.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+
+namespace GQCP {
+namespace {
+
+
+/**
+ *  @param C_previous           the converged RHF coefficient matrix at the previous geometry
+ *  @param S                    the overlap matrix of the scalar basis at the current geometry
+ * 
+ *  @return the previous orbitals, symmetrically orthonormalized with respect to the current overlap metric, so that they can serve as an initial guess at the current geometry
+ */
+TransformationMatrix<double> orthonormalizedGuess(const TransformationMatrix<double>& C_previous, const QCMatrix<double>& S) {
+
+    const MatrixX<double> C_S_C = C_previous.transpose() * S * C_previous;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (C_S_C);
+
+    return TransformationMatrix<double>(C_previous * eigensolver.operatorInverseSqrt());
+}
+
+
+/**
+ *  Flip the signs of the orbitals that have a negative overlap with the corresponding orbitals at the previous geometry, so that the FCI coefficients at the previous geometry remain a good initial guess.
+ * 
+ *  @param C                    the RHF coefficient matrix at the current geometry
+ *  @param C_previous           the RHF coefficient matrix at the previous geometry
+ *  @param S                    the overlap matrix of the scalar basis at the current geometry
+ */
+void alignPhases(TransformationMatrix<double>& C, const TransformationMatrix<double>& C_previous, const QCMatrix<double>& S) {
+
+    const VectorX<double> overlaps = (C_previous.transpose() * S * C).diagonal();
+    for (size_t p = 0; p < C.cols(); p++) {
+        if (overlaps(p) < 0.0) {
+            C.col(p) *= -1.0;
+        }
+    }
+}
+
+
+/**
+ *  @param molecules            the geometries of a scan
+ * 
+ *  @return the number of electrons, which is the same for every geometry and is even, so that RHF and FCI can be applied
+ */
+size_t checkNumberOfElectrons(const std::vector<Molecule>& molecules) {
+
+    const auto N = molecules.front().numberOfElectrons();
+    for (const auto& molecule : molecules) {
+        if (molecule.numberOfElectrons() != N) {
+            throw std::invalid_argument("PotentialEnergyScan::calculate(const std::vector<Molecule>&): All geometries should have the same number of electrons.");
+        }
+    }
+    if (N % 2 != 0) {
+        throw std::invalid_argument("PotentialEnergyScan::calculate(const std::vector<Molecule>&): The number of electrons should be even, since the scan is based on RHF.");
+    }
+
+    return N;
+}
+
+
+}  // namespace
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param basisset_name            the name of the basisset that is placed on every geometry
+ *  @param calculate_fci            if an FCI calculation in the RHF orbitals should be done at every geometry
+ *  @param number_of_chunks         the maximum number of chunks of geometries that are handled concurrently, 0 meaning one for every available thread. Only the first geometry of every chunk is calculated from scratch.
+ */
+PotentialEnergyScan::PotentialEnergyScan(const std::string& basisset_name, const bool calculate_fci, const size_t number_of_chunks) :
+    basisset_name (basisset_name),
+    calculate_fci (calculate_fci),
+    number_of_chunks (number_of_chunks)
+{}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param molecules            the geometries of the scan, which should all contain the same nuclei in the same order and the same (even) number of electrons
+ * 
+ *  @return the results at every geometry, in the order of the given geometries
+ */
+std::vector<PotentialEnergyScanPoint> PotentialEnergyScan::calculate(const std::vector<Molecule>& molecules) const {
+
+    if (molecules.empty()) {
+        return {};
+    }
+    checkNumberOfElectrons(molecules);  // before the basisset is read
+
+
+    // Read the basisset only once, and move its shells along with the nuclei for all the other geometries.
+    const auto& reference = molecules.front();
+    const auto reference_shell_set = GTOBasisSet(this->basisset_name).generate(reference);
+    const auto max_nprim = reference_shell_set.maximumNumberOfPrimitives();
+    const auto max_l = reference_shell_set.maximumAngularMomentum();
+
+    const auto integral_function_factory = [&reference_shell_set, &reference, max_nprim, max_l] () -> IntegralFunction {
+
+        // Libint engines are not thread-safe, so every chunk constructs its own, which it reuses for all its geometries.
+        const auto overlap_engine = std::make_shared<decltype(IntegralEngine::Libint(Operator::Overlap(), max_nprim, max_l))>(IntegralEngine::Libint(Operator::Overlap(), max_nprim, max_l));
+        const auto kinetic_engine = std::make_shared<decltype(IntegralEngine::Libint(Operator::Kinetic(), max_nprim, max_l))>(IntegralEngine::Libint(Operator::Kinetic(), max_nprim, max_l));
+        const auto coulomb_engine = std::make_shared<decltype(IntegralEngine::Libint(Operator::Coulomb(), max_nprim, max_l))>(IntegralEngine::Libint(Operator::Coulomb(), max_nprim, max_l));
+
+        return [&reference_shell_set, &reference, max_nprim, max_l, overlap_engine, kinetic_engine, coulomb_engine] (const Molecule& molecule) {
+
+            const auto shell_set = PotentialEnergyScan::moveShells(reference_shell_set, reference, molecule);
+
+            const QCMatrix<double> S {IntegralCalculator::calculate(*overlap_engine, shell_set, shell_set)[0]};
+            const QCMatrix<double> T {IntegralCalculator::calculate(*kinetic_engine, shell_set, shell_set)[0]};
+
+            auto nuclear_attraction_engine = IntegralEngine::Libint(Operator::NuclearAttraction(molecule), max_nprim, max_l);  // the point charges change with every geometry
+            const QCMatrix<double> V {IntegralCalculator::calculate(nuclear_attraction_engine, shell_set, shell_set)[0]};
+
+            const QCRankFourTensor<double> g {IntegralCalculator::calculate(*coulomb_engine, shell_set, shell_set)[0]};
+
+            return PotentialEnergyScanIntegrals {S, SQHamiltonian<double>{ScalarSQOneElectronOperator<double>{T + V}, ScalarSQTwoElectronOperator<double>{g}}};
+        };
+    };
+
+    return this->calculate(molecules, integral_function_factory);
+}
+
+
+/**
+ *  @param molecules                        the geometries of the scan, which should all contain the same nuclei in the same order and the same (even) number of electrons
+ *  @param integral_function_factory        creates the function that calculates the integrals at a geometry. It is called once for every chunk, on the thread that handles that chunk, so that every created function may hold its own non-thread-safe state (like integral engines).
+ * 
+ *  @return the results at every geometry, in the order of the given geometries
+ * 
+ *  @note The basisset name of this scan is not used: the basis is determined by the given integrals.
+ */
+std::vector<PotentialEnergyScanPoint> PotentialEnergyScan::calculate(const std::vector<Molecule>& molecules, const std::function<IntegralFunction ()>& integral_function_factory) const {
+
+    if (molecules.empty()) {
+        return {};
+    }
+    const auto N = checkNumberOfElectrons(molecules);
+
+
+    const auto number_of_geometries = molecules.size();
+    const size_t number_of_threads = (this->number_of_chunks == 0) ? static_cast<size_t>(omp_get_max_threads()) : this->number_of_chunks;
+    const auto number_of_chunks = std::max<size_t>(1, std::min(number_of_threads, number_of_geometries));
+    const auto chunk_size = (number_of_geometries + number_of_chunks - 1) / number_of_chunks;
+
+    std::vector<PotentialEnergyScanPoint> points (number_of_geometries);
+    std::exception_ptr exception = nullptr;  // exceptions can't leave an OpenMP region, so we rethrow the first one afterwards
+
+
+    // Every chunk of consecutive geometries is handled by one thread, so that every geometry inside a chunk can be seeded with the solution at the previous one.
+    #pragma omp parallel for schedule(dynamic) num_threads(number_of_chunks)
+    for (size_t chunk = 0; chunk < number_of_chunks; chunk++) {
+        try {
+            const auto begin = chunk * chunk_size;
+            const auto end = std::min(begin + chunk_size, number_of_geometries);
+
+            const auto integral_function = integral_function_factory();  // reused for all the geometries in this chunk
+
+            for (size_t i = begin; i < end; i++) {
+                const auto& molecule = molecules[i];
+                auto& point = points[i];
+
+                const auto integrals = integral_function(molecule);
+                const auto& S = integrals.S;
+                const auto& sq_hamiltonian = integrals.sq_hamiltonian;  // in the scalar (AO) basis
+
+                point.nuclear_repulsion_energy = Operator::NuclearRepulsion(molecule).value();
+
+
+                // Solve the RHF SCF equations, starting from the orbitals at the previous geometry if there are any.
+                const bool is_seeded = (i > begin);
+                auto rhf_environment = is_seeded ?
+                                       RHFSCFEnvironment<double>(N, sq_hamiltonian, S, orthonormalizedGuess(points[i - 1].C, S)) :
+                                       RHFSCFEnvironment<double>::WithCoreGuess(N, sq_hamiltonian, S);
+                auto rhf_solver = RHFSCFSolver<double>::DIIS();
+                const DiagonalRHFFockMatrixObjective<double> objective (sq_hamiltonian);
+                const auto rhf_qc_structure = QCMethod::RHF<double>().optimize(objective, rhf_solver, rhf_environment);
+
+                point.rhf_energy = rhf_qc_structure.groundStateEnergy() + point.nuclear_repulsion_energy;
+                point.C = rhf_qc_structure.groundStateParameters().coefficientMatrix();
+                if (is_seeded) {
+                    alignPhases(point.C, points[i - 1].C, S);
+                }
+
+                if (!this->calculate_fci) {
+                    point.fci_energy = std::numeric_limits<double>::quiet_NaN();
+                    continue;
+                }
+
+
+                // Solve the FCI eigenvalue problem in the RHF orbitals, starting from the FCI expansion at the previous geometry if there is one.
+                auto mo_hamiltonian = sq_hamiltonian;
+                mo_hamiltonian.transform(point.C);
+
+                const auto K = mo_hamiltonian.dimension();
+                const SpinResolvedONVBasis onv_basis (K, N / 2, N / 2);
+                const CISigmaVector<FCI, SQHamiltonian<double>> sigma_vector (mo_hamiltonian, onv_basis);
+
+                const MatrixX<double> V_initial = is_seeded ? MatrixX<double>(points[i - 1].fci_coefficients) : MatrixX<double>(onv_basis.hartreeFockExpansion());
+                auto ci_environment = CIEnvironment::Iterative(sigma_vector, V_initial);
+                auto ci_solver = EigenproblemSolver::Davidson();
+                const auto ci_qc_structure = QCMethod::CI<SpinResolvedONVBasis>(onv_basis).optimize(ci_solver, ci_environment);
+
+                point.fci_energy = ci_qc_structure.groundStateEnergy() + point.nuclear_repulsion_energy;
+                point.fci_coefficients = ci_qc_structure.groundStateParameters().coefficients();
+            }
+        } catch (...) {
+            #pragma omp critical
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    return points;
+}
+
+
+
+/*
+ *  PUBLIC STATIC METHODS
+ */
+
+/**
+ *  Move the shells along with the nuclei that they are centered on.
+ * 
+ *  @param shell_set            the shells that are centered on the nuclei of the reference molecule
+ *  @param reference            the molecule whose nuclei the shells are centered on
+ *  @param molecule             the molecule whose nuclei the shells should be moved to, which should contain the same nuclei as the reference in the same order
+ * 
+ *  @return the shells centered on the corresponding nuclei of the given molecule
+ */
+ShellSet<GTOShell> PotentialEnergyScan::moveShells(const ShellSet<GTOShell>& shell_set, const Molecule& reference, const Molecule& molecule) {
+
+    const auto& reference_nuclei = reference.nuclearFramework().nucleiAsVector();
+    const auto& nuclei = molecule.nuclearFramework().nucleiAsVector();
+
+    if (reference_nuclei.size() != nuclei.size()) {
+        throw std::invalid_argument("PotentialEnergyScan::moveShells(const ShellSet<GTOShell>&, const Molecule&, const Molecule&): The molecules should contain the same number of nuclei.");
+    }
+    for (size_t n = 0; n < nuclei.size(); n++) {
+        if (reference_nuclei[n].charge() != nuclei[n].charge()) {
+            throw std::invalid_argument("PotentialEnergyScan::moveShells(const ShellSet<GTOShell>&, const Molecule&, const Molecule&): The molecules should contain the same nuclei in the same order.");
+        }
+    }
+
+
+    const auto are_equal = Nucleus::equalityComparer();
+
+    std::vector<GTOShell> shells;
+    shells.reserve(shell_set.numberOfShells());
+    for (const auto& shell : shell_set.asVector()) {
+
+        // Find the reference nucleus that the shell is centered on, and place the shell on the corresponding nucleus of the given molecule.
+        const auto it = std::find_if(reference_nuclei.begin(), reference_nuclei.end(), [&shell, &are_equal] (const Nucleus& nucleus) { return are_equal(nucleus, shell.get_nucleus()); });
+        if (it == reference_nuclei.end()) {
+            throw std::invalid_argument("PotentialEnergyScan::moveShells(const ShellSet<GTOShell>&, const Molecule&, const Molecule&): A shell is not centered on any of the nuclei of the reference molecule.");
+        }
+        const auto& nucleus = nuclei[std::distance(reference_nuclei.begin(), it)];
+
+        shells.emplace_back(shell.get_l(), nucleus, shell.get_gaussian_exponents(), shell.get_contraction_coefficients(), shell.is_pure(), shell.are_embedded_normalization_factors_of_primitives(), shell.is_normalized());
+    }
+
+    return ShellSet<GTOShell>(shells);
+}
+
+
+}  // namespace GQCP
@@ -17,6 +17,8 @@
 // 
 #include "QCMethod/CI/HamiltonianBuilder/DOCI.hpp"
 
+#include "ONVBasis/SpinResolvedONV.hpp"
+
 
 namespace GQCP {
 
@@ -230,4 +232,26 @@ VectorX<double> DOCI::calculateDiagonal(const SQHamiltonian<double>& sq_hamilton
 }
 
 
+/**
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param I                            the address of the first ONV
+ *  @param J                            the address of the second ONV
+ *
+ *  @return the element H(I,J) of the matrix representation of the DOCI Hamiltonian, calculated with the Slater-Condon rules
+ */
+double DOCI::calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const {
+
+    const auto& h = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    // A seniority-zero ONV has the same occupations for the alpha and beta electrons
+    const auto proxy_onv_basis = this->onv_basis.proxy();
+    const auto onv_I = proxy_onv_basis.makeONV(I);
+    const auto onv_J = proxy_onv_basis.makeONV(J);
+
+    return SpinResolvedONV(onv_I, onv_I).calculateMatrixElement(h, g, SpinResolvedONV(onv_J, onv_J));
+}
+
+
+
 }  // namespace GQCP
@@ -58,9 +58,78 @@ SquareMatrix<double> FCI::constructHamiltonian(const SQHamiltonian<double>& sq_h
  */
 VectorX<double> FCI::matrixVectorProduct(const SQHamiltonian<double>& sq_hamiltonian, const VectorX<double>& x, const VectorX<double>& diagonal) const {
 
+    return this->calculateMatrixVectorProduct(sq_hamiltonian, x, diagonal);
+}
+
+
+/**
+ *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
+ *
+ *  @return the diagonal of the matrix representation of the Hamiltonian
+ */
+VectorX<double> FCI::calculateDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const {
+
+   return this->onv_basis.evaluateOperatorDiagonal(sq_hamiltonian);
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param x                            the vector upon which the FCI Hamiltonian acts
+ *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+ *
+ *  @return the action of the FCI Hamiltonian on the coefficient vector, in which the contractions with the coefficient vector are performed in single precision
+ */
+VectorX<float> FCI::matrixVectorProduct(const SQHamiltonian<double>& sq_hamiltonian, const VectorX<float>& x, const VectorX<float>& diagonal) const {
+
+    return this->calculateMatrixVectorProduct(sq_hamiltonian, x, diagonal);
+}
+
+
+
+/**
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param I                            the address of the first ONV
+ *  @param J                            the address of the second ONV
+ *
+ *  @return the element H(I,J) of the matrix representation of the FCI Hamiltonian, calculated with the Slater-Condon rules
+ */
+double FCI::calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const {
+
+    const auto& h = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    return this->onv_basis.makeONV(I).calculateMatrixElement(h, g, this->onv_basis.makeONV(J));
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  @tparam Scalar                      the scalar type of the coefficient vector
+ *
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param x                            the vector upon which the FCI Hamiltonian acts
+ *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+ *
+ *  @return the action of the FCI Hamiltonian on the coefficient vector
+ * 
+ *  @note The (sparse) intermediates are always set up in double precision, but they are cast to the given scalar type before they are contracted with the coefficient vector. For double precision, these casts don't copy anything.
+ */
+template <typename Scalar>
+VectorX<Scalar> FCI::calculateMatrixVectorProduct(const SQHamiltonian<double>& sq_hamiltonian, const VectorX<Scalar>& x, const VectorX<Scalar>& diagonal) const {
+
     auto K = sq_hamiltonian.core().get_dim();
     if (K != this->onv_basis.get_K()) {
-        throw std::invalid_argument("FCI::matrixVectorProduct(SQHamiltonian<double>, VectorX<double>, VectorX<double>): Basis functions of the ONV basis and sq_hamiltonian are incompatible.");
+        throw std::invalid_argument("FCI::matrixVectorProduct(SQHamiltonian<double>, VectorX<Scalar>, VectorX<Scalar>): Basis functions of the ONV basis and sq_hamiltonian are incompatible.");
     }
 
     SpinUnresolvedONVBasis fock_space_alpha = onv_basis.get_fock_space_alpha();
@@ -71,10 +140,10 @@ VectorX<double> FCI::matrixVectorProduct(const SQHamiltonian<double>& sq_hamilto
     auto dim_alpha = fock_space_alpha.get_dimension();
     auto dim_beta = fock_space_beta.get_dimension();
 
-    VectorX<double> matvec = diagonal.cwiseProduct(x);
+    VectorX<Scalar> matvec = diagonal.cwiseProduct(x);
 
-    Eigen::Map<Eigen::MatrixXd> matvecmap (matvec.data(), dim_beta, dim_alpha);
-    Eigen::Map<const Eigen::MatrixXd> xmap (x.data(), dim_beta, dim_alpha);
+    Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> matvecmap (matvec.data(), dim_beta, dim_alpha);
+    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> xmap (x.data(), dim_beta, dim_alpha);
 
     for (size_t p = 0; p<K; p++) {
 
@@ -82,36 +151,25 @@ VectorX<double> FCI::matrixVectorProduct(const SQHamiltonian<double>& sq_hamilto
         const auto& beta_two_electron_intermediate = fock_space_beta.evaluateOperatorDense(P, false);
 
         // sigma(pp) * X * theta(pp)
-        matvecmap += beta_two_electron_intermediate * (xmap * alpha_couplings[p*(K+K+1-p)/2]);
+        matvecmap += beta_two_electron_intermediate.template cast<Scalar>() * (xmap * alpha_couplings[p*(K+K+1-p)/2].template cast<Scalar>());
         for (size_t q = p + 1; q<K; q++) {
 
             const auto& P = this->onv_basis.oneElectronPartition(p, q, sq_hamiltonian.twoElectron());
             const auto& beta_two_electron_intermediate = fock_space_beta.evaluateOperatorDense(P, true);
 
             // (sigma(pq) + sigma(qp)) * X * theta(pq)
-            matvecmap += beta_two_electron_intermediate * (xmap * alpha_couplings[p*(K+K+1-p)/2 + q - p]);
+            matvecmap += beta_two_electron_intermediate.template cast<Scalar>() * (xmap * alpha_couplings[p*(K+K+1-p)/2 + q - p].template cast<Scalar>());
         }
     }
 
     auto beta_hamiltonian = fock_space_beta.evaluateOperatorSparse(sq_hamiltonian, false);
     auto alpha_hamiltonian = fock_space_alpha.evaluateOperatorSparse(sq_hamiltonian, false);
 
-    matvecmap += beta_hamiltonian * xmap + xmap * alpha_hamiltonian;
+    matvecmap += beta_hamiltonian.template cast<Scalar>() * xmap + xmap * alpha_hamiltonian.template cast<Scalar>();
 
     return matvec;
 }
 
 
-/**
- *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
- *
- *  @return the diagonal of the matrix representation of the Hamiltonian
- */
-VectorX<double> FCI::calculateDiagonal(const SQHamiltonian<double>& sq_hamiltonian) const {
-
-   return this->onv_basis.evaluateOperatorDiagonal(sq_hamiltonian);
-}
-
-
 
 }  // namespace GQCP
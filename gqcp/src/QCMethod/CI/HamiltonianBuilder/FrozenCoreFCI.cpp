@@ -37,4 +37,25 @@ FrozenCoreFCI::FrozenCoreFCI(const SpinResolvedFrozenONVBasis& onv_basis) :
 
 
 
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param I                            the address of the first ONV
+ *  @param J                            the address of the second ONV
+ *
+ *  @return the element H(I,J) of the matrix representation of the frozen core FCI Hamiltonian, calculated with the Slater-Condon rules
+ */
+double FrozenCoreFCI::calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const {
+
+    const auto& h = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    return this->onv_basis.makeONV(I).calculateMatrixElement(h, g, this->onv_basis.makeONV(J));
+}
+
+
+
 }  // namespace GQCP
@@ -64,31 +64,20 @@ SquareMatrix<double> Hubbard::constructHamiltonian(const HubbardHamiltonian<doub
  */
 VectorX<double> Hubbard::matrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<double>& x, const VectorX<double>& diagonal) const {
 
-    const auto K = hubbard_hamiltonian.numberOfLatticeSites();
-    if (K != this->onv_basis.get_K()) {
-        throw std::invalid_argument("Hubbard::constructHamiltonian(const HubbardHamiltonian<double>&): The number of spatial orbitals of this ONV basis and the number of lattice sites for the Hubbard Hamiltonian are incompatible.");
-    }
-
-
-    // Set up ONV bases for alpha and beta
-    const SpinUnresolvedONVBasis onv_basis_alpha = onv_basis.get_fock_space_alpha();
-    const auto dim_alpha = onv_basis_alpha.get_dimension();
-
-    const SpinUnresolvedONVBasis onv_basis_beta = onv_basis.get_fock_space_beta();
-    const auto dim_beta = onv_basis_beta.get_dimension();
-
-
-    // Calculate the Hubbard matrix-vector product, which is the sum of the alpha- and beta one-electron contributions plus the diagonal (which contains the two-electron contributions).
-    VectorX<double> matvec = diagonal.cwiseProduct(x);
+    return this->calculateMatrixVectorProduct(hubbard_hamiltonian, x, diagonal);
+}
 
-    Eigen::Map<Eigen::MatrixXd> matvecmap (matvec.data(), dim_beta, dim_alpha);
-    Eigen::Map<const Eigen::MatrixXd> xmap (x.data(), dim_beta, dim_alpha);
 
-    const auto H_alpha = onv_basis_alpha.evaluateOperatorSparse(hubbard_hamiltonian.core(), false);  // false: no diagonal contributions
-    const auto H_beta = onv_basis_beta.evaluateOperatorSparse(hubbard_hamiltonian.core(), false);  // false: no diagonal contributions
+/**
+ *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+ *  @param x                                the vector upon which the Hubbard Hamiltonian acts
+ *  @param diagonal                         the diagonal of the Hubbard Hamiltonian matrix
+ *
+ *  @return the action of the Hubbard model Hamiltonian on the coefficient vector, in which the contractions with the coefficient vector are performed in single precision
+ */
+VectorX<float> Hubbard::matrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<float>& x, const VectorX<float>& diagonal) const {
 
-    matvecmap += xmap * H_alpha + H_beta * xmap;
-    return matvec;
+    return this->calculateMatrixVectorProduct(hubbard_hamiltonian, x, diagonal);
 }
 
 
@@ -149,4 +138,100 @@ VectorX<double> Hubbard::calculateDiagonal(const HubbardHamiltonian<double>& hub
 
 
 
+/**
+ *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+ *  @param I                                the address of the first ONV
+ *  @param J                                the address of the second ONV
+ *
+ *  @return the element H(I,J) of the matrix representation of the Hubbard model Hamiltonian, calculated with the Slater-Condon rules
+ */
+double Hubbard::calculateMatrixElement(const HubbardHamiltonian<double>& hubbard_hamiltonian, const size_t I, const size_t J) const {
+
+    const auto& H = hubbard_hamiltonian.hoppingMatrix();  // the hopping terms are on the off-diagonal, the on-site repulsions on the diagonal
+
+    const auto onv_I = this->onv_basis.makeONV(I);
+    const auto onv_J = this->onv_basis.makeONV(J);
+    const auto& alpha_I = onv_I.alphaONV();
+    const auto& beta_I = onv_I.betaONV();
+    const auto& alpha_J = onv_J.alphaONV();
+    const auto& beta_J = onv_J.betaONV();
+
+    const auto alpha_differences = alpha_I.countNumberOfDifferences(alpha_J);
+    const auto beta_differences = beta_I.countNumberOfDifferences(beta_J);
+
+    // The on-site repulsion only contributes to the diagonal
+    if ((alpha_differences == 0) && (beta_differences == 0)) {
+        double value = 0.0;
+        for (const auto& p : alpha_I.findMatchingOccupations(beta_I)) {  // the doubly occupied sites
+            value += H(p,p);
+        }
+        return value;
+    }
+
+    // The hopping operator only couples ONVs that differ by a single excitation
+    const auto single_excitation_element = [&H] (const SpinUnresolvedONV& onv_I, const SpinUnresolvedONV& onv_J) {
+        const auto p = onv_I.findDifferentOccupations(onv_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+        const auto q = onv_J.findDifferentOccupations(onv_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+
+        return onv_I.operatorPhaseFactor(p) * onv_J.operatorPhaseFactor(q) * H(p,q);
+    };
+
+    if ((alpha_differences == 2) && (beta_differences == 0)) {
+        return single_excitation_element(alpha_I, alpha_J);
+    } else if ((alpha_differences == 0) && (beta_differences == 2)) {
+        return single_excitation_element(beta_I, beta_J);
+    } else {
+        return 0.0;
+    }
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  @tparam Scalar                          the scalar type of the coefficient vector
+ *
+ *  @param hubbard_hamiltonian              the Hubbard model Hamiltonian
+ *  @param x                                the vector upon which the Hubbard Hamiltonian acts
+ *  @param diagonal                         the diagonal of the Hubbard Hamiltonian matrix
+ *
+ *  @return the action of the Hubbard model Hamiltonian on the coefficient vector
+ * 
+ *  @note The sparse one-electron Hamiltonians are always set up in double precision, but they are cast to the given scalar type before they are contracted with the coefficient vector. For double precision, these casts don't copy anything.
+ */
+template <typename Scalar>
+VectorX<Scalar> Hubbard::calculateMatrixVectorProduct(const HubbardHamiltonian<double>& hubbard_hamiltonian, const VectorX<Scalar>& x, const VectorX<Scalar>& diagonal) const {
+
+    const auto K = hubbard_hamiltonian.numberOfLatticeSites();
+    if (K != this->onv_basis.get_K()) {
+        throw std::invalid_argument("Hubbard::constructHamiltonian(const HubbardHamiltonian<double>&): The number of spatial orbitals of this ONV basis and the number of lattice sites for the Hubbard Hamiltonian are incompatible.");
+    }
+
+
+    // Set up ONV bases for alpha and beta
+    const SpinUnresolvedONVBasis onv_basis_alpha = onv_basis.get_fock_space_alpha();
+    const auto dim_alpha = onv_basis_alpha.get_dimension();
+
+    const SpinUnresolvedONVBasis onv_basis_beta = onv_basis.get_fock_space_beta();
+    const auto dim_beta = onv_basis_beta.get_dimension();
+
+
+    // Calculate the Hubbard matrix-vector product, which is the sum of the alpha- and beta one-electron contributions plus the diagonal (which contains the two-electron contributions).
+    VectorX<Scalar> matvec = diagonal.cwiseProduct(x);
+
+    Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> matvecmap (matvec.data(), dim_beta, dim_alpha);
+    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> xmap (x.data(), dim_beta, dim_alpha);
+
+    const auto H_alpha = onv_basis_alpha.evaluateOperatorSparse(hubbard_hamiltonian.core(), false);  // false: no diagonal contributions
+    const auto H_beta = onv_basis_beta.evaluateOperatorSparse(hubbard_hamiltonian.core(), false);  // false: no diagonal contributions
+
+    matvecmap += xmap * H_alpha.template cast<Scalar>() + H_beta.template cast<Scalar>() * xmap;
+    return matvec;
+}
+
+
+
 }  // namespace GQCP
@@ -257,4 +257,25 @@ VectorX<double> SelectedCI::calculateDiagonal(const SQHamiltonian<double>& sq_ha
 
 
 
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
+ *  @param I                            the address of the first ONV
+ *  @param J                            the address of the second ONV
+ *
+ *  @return the element H(I,J) of the matrix representation of the SelectedCI Hamiltonian, calculated with the Slater-Condon rules
+ */
+double SelectedCI::calculateMatrixElement(const SQHamiltonian<double>& sq_hamiltonian, const size_t I, const size_t J) const {
+
+    const auto& h = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    return this->onv_basis.get_configuration(I).calculateMatrixElement(h, g, this->onv_basis.get_configuration(J));
+}
+
+
+
 }  // namespace GQCP
@@ -17,7 +17,7 @@
 // 
 #include "QCMethod/OrbitalOptimization/JacobiOrbitalOptimizer.hpp"
 
-#include <queue>
+#include <algorithm>
 
 
 namespace GQCP {
@@ -87,31 +87,74 @@ TransformationMatrix<double> JacobiOrbitalOptimizer::calculateNewRotationMatrix(
  *  PUBLIC METHODS
  */
 
+/**
+ *  @param sq_hamiltonian           the Hamiltonian
+ *  @param p                        the index of spatial orbital 1
+ *  @param q                        the index of spatial orbital 2
+ * 
+ *  @return the optimal Jacobi rotation parameters for the orbital pair (p,q) and the corresponding change in the scalar function
+ */
+JacobiOrbitalOptimizer::pair_type JacobiOrbitalOptimizer::calculateJacobiCandidate(const SQHamiltonian<double>& sq_hamiltonian, const size_t p, const size_t q) {
+
+    this->calculateJacobiCoefficients(sq_hamiltonian, p,q);  // initialize the trigoniometric polynomial coefficients
+
+    const double theta = this->calculateOptimalRotationAngle(sq_hamiltonian, p,q);
+    const JacobiRotationParameters jacobi_rot_par (p, q, theta);
+
+    const double E_change = this->calculateScalarFunctionChange(sq_hamiltonian, jacobi_rot_par);
+
+    return pair_type(jacobi_rot_par, E_change);
+}
+
+
 /**
  *  @param sq_hamiltonian           the current Hamiltonian
- *  @param dim                      the dimension of the orbital space that should be scanned. The valid orbital indices then are 0 ... dim (not included)
  * 
  *  @return the optimal Jacobi rotation parameters and the corresponding value for the scalar function that can be obtained when the Jacobi rotation would have taken place
+ * 
+ *  @note If the Jacobi coefficients are local (see areJacobiCoefficientsLocal()) and exactly one (optimal) Jacobi rotation has been performed since the previous call, only the candidates of the orbital pairs that involve the rotated orbitals are recalculated
  */
 std::pair<JacobiRotationParameters, double> JacobiOrbitalOptimizer::calculateOptimalJacobiParameters(const SQHamiltonian<double>& sq_hamiltonian) {
 
-    const auto& cmp = this->comparer();
-    std::priority_queue<pair_type, std::vector<pair_type>, decltype(cmp)> queue (cmp);
+    // The previous optimal Jacobi rotation has been performed on the Hamiltonian if the base algorithm has done exactly one iteration since the candidates were last updated
+    const bool can_update_incrementally = this->areJacobiCoefficientsLocal() && this->are_candidates_cached && (this->number_of_iterations == this->candidates_iteration + 1);
 
-    for (size_t q = 0; q < this->dim; q++) {
-        for (size_t p = q+1; p < this->dim; p++) {  // loop over p>q
-            this->calculateJacobiCoefficients(sq_hamiltonian, p,q);  // initialize the trigoniometric polynomial coefficients
+    if (can_update_incrementally) {
 
-            const double theta = this->calculateOptimalRotationAngle(sq_hamiltonian, p,q);
-            const JacobiRotationParameters jacobi_rot_par (p, q, theta);
+        // Only the orbital pairs that involve one of the rotated orbitals have changed
+        const size_t p_rotated = this->optimal_jacobi_with_scalar.first.get_p();
+        const size_t q_rotated = this->optimal_jacobi_with_scalar.first.get_q();
 
-            const double E_change = this->calculateScalarFunctionChange(sq_hamiltonian, jacobi_rot_par);
+        for (const auto& r : {p_rotated, q_rotated}) {
+            for (size_t s = 0; s < this->dim; s++) {
+                if ((s == r) || ((r == q_rotated) && (s == p_rotated))) {  // the pair (p_rotated, q_rotated) is already updated in the first pass
+                    continue;
+                }
 
-            queue.emplace(jacobi_rot_par, E_change);  // construct a pair_type
+                const size_t p = std::max(r, s);
+                const size_t q = std::min(r, s);
+                this->jacobi_candidates[p*(p-1)/2 + q] = this->calculateJacobiCandidate(sq_hamiltonian, p,q);
+            }
         }
     }
 
-    return queue.top();
+    else {
+        this->jacobi_candidates = std::vector<pair_type>(this->dim * (this->dim - 1) / 2);
+
+        for (size_t q = 0; q < this->dim; q++) {
+            for (size_t p = q+1; p < this->dim; p++) {  // loop over p>q
+                this->jacobi_candidates[p*(p-1)/2 + q] = this->calculateJacobiCandidate(sq_hamiltonian, p,q);
+            }
+        }
+    }
+
+    this->are_candidates_cached = true;
+    this->candidates_iteration = this->number_of_iterations;
+
+
+    // Find the candidate with the lowest change in the scalar function: a linear scan over the cached candidates is cheap compared to their calculation
+    const auto& cmp = this->comparer();
+    return *std::max_element(this->jacobi_candidates.begin(), this->jacobi_candidates.end(), cmp);
 }
 
 
@@ -17,10 +17,46 @@
 // 
 #include "QCMethod/RMP2/RMP2.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 
 namespace GQCP {
 
 
+namespace {
+
+
+/**
+ *  @param K_ij                     the integrals K_ij(a,b) = (i a|j b) over all virtual orbitals a and b
+ *  @param epsilon                  the RHF orbital energies
+ *  @param i                        the first occupied orbital
+ *  @param j                        the second occupied orbital
+ *  @param N_occ                    the number of occupied orbitals, i.e. the index of the first virtual orbital
+ * 
+ *  @return the RMP2 pair energy e_ij = sum_{a,b} (i a|j b) [2 (i a|j b) - (i b|j a)] / (e_i + e_j - e_a - e_b)
+ */
+double calculateRMP2PairEnergy(const Eigen::MatrixXd& K_ij, const VectorX<double>& epsilon, const size_t i, const size_t j, const size_t N_occ) {
+
+    const size_t N_virt = K_ij.rows();
+    const double epsilon_ij = epsilon(i) + epsilon(j);
+
+    double e_ij = 0.0;
+    for (size_t b = 0; b < N_virt; b++) {
+        const double epsilon_ijb = epsilon_ij - epsilon(N_occ + b);
+        for (size_t a = 0; a < N_virt; a++) {
+            e_ij += K_ij(a,b) * (2 * K_ij(a,b) - K_ij(b,a)) / (epsilon_ijb - epsilon(N_occ + a));
+        }
+    }
+
+    return e_ij;
+}
+
+
+}  // namespace
+
+
+
 /**
  *  @param sq_hamiltonian               the Hamiltonian expressed in an orthonormal basis
  *  @param molecule                     the molecule for which the energy correction should be calculated
@@ -33,31 +69,81 @@ double calculateRMP2EnergyCorrection(const SQHamiltonian<double>& sq_hamiltonian
     const size_t N = molecule.numberOfElectrons();
     const size_t K = sq_hamiltonian.dimension();
 
-    const size_t HOMO_index = QCModel::RHF<double>::HOMOIndex(N);
-    const size_t LUMO_index = QCModel::RHF<double>::LUMOIndex(K, N);
+    const size_t N_occ = QCModel::RHF<double>::HOMOIndex(N) + 1;
+    const size_t N_virt = K - N_occ;
 
     const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto& epsilon = rhf_parameters.orbitalEnergies();
 
+    // Since the pair energies e_ij and e_ji are equal, only the pairs with j <= i are calculated
     double E = 0.0;
-    //  loop over all occupied orbitals (0 <= HOMO )
-    for (size_t i = 0; i <= HOMO_index; i++) {
-        for (size_t j = 0; j <= HOMO_index; j++) {
-
-            //  loop over all virtual orbitals (LUMO < K)
-            for (size_t a = LUMO_index; a < K; a++) {
-                for (size_t b = LUMO_index; b < K; b++) {
+    #pragma omp parallel for schedule(dynamic) reduction(+:E)
+    for (size_t i = 0; i < N_occ; i++) {
+        Eigen::MatrixXd K_ij (N_virt, N_virt);
 
-                    double epsilon_a = rhf_parameters.orbitalEnergy(a);
-                    double epsilon_b = rhf_parameters.orbitalEnergy(b);
-                    double epsilon_i = rhf_parameters.orbitalEnergy(i);
-                    double epsilon_j = rhf_parameters.orbitalEnergy(j);
+        for (size_t j = 0; j <= i; j++) {
 
-                    E -= g(a,i,b,j) * (2 * g(i,a,j,b) - g(i,b,j,a)) / (epsilon_a + epsilon_b - epsilon_i - epsilon_j);
+            // Gather the integrals K_ij(a,b) = (i a|j b), in which every column b is a strided read from the contiguous slice g(., ., j, b)
+            for (size_t b = 0; b < N_virt; b++) {
+                const double* slice = g.data() + K * K * (j + K * (N_occ + b));
+                for (size_t a = 0; a < N_virt; a++) {
+                    K_ij(a,b) = slice[i + K * (N_occ + a)];
                 }
-            }  // end of summation over virtual orbitals
+            }
+
+            E += (i == j ? 1.0 : 2.0) * calculateRMP2PairEnergy(K_ij, epsilon, i, j, N_occ);
+        }
+    }
+
+    return E;
+}
+
+
+/**
+ *  @param g                        the density-fitted or Cholesky-decomposed two-electron integrals, expressed in the scalar basis in which the RHF orbitals are expanded
+ *  @param molecule                 the molecule for which the energy correction should be calculated
+ *  @param rhf_parameters           the converged solution to the RHF SCF equations
+ *  @param batch_size               the number of occupied orbitals i for which the integrals (i a|j b) are formed at once
+ *
+ *  @return the RMP2 energy correction
+ * 
+ *  @note Only the factors (a i|P) are transformed to the RHF orbitals. For every batch of occupied orbitals i, the integrals (i a|j b) with j <= i are then formed by one matrix-matrix product, so that at most batch_size*N_occ*N_virt^2 of them are kept in memory.
+ */
+double calculateRMP2EnergyCorrection(const DFTwoElectronOperator& g, const Molecule& molecule, const QCModel::RHF<double>& rhf_parameters, const size_t batch_size) {
+
+    if (batch_size == 0) {
+        throw std::invalid_argument("calculateRMP2EnergyCorrection(const DFTwoElectronOperator&, const Molecule&, const QCModel::RHF<double>&, const size_t): The batch size should be at least 1.");
+    }
+
+    const size_t N = molecule.numberOfElectrons();
+    const size_t K = g.dimension();
+
+    const size_t N_occ = QCModel::RHF<double>::HOMOIndex(N) + 1;
+    const size_t N_virt = K - N_occ;
+
+    const auto& C = rhf_parameters.coefficientMatrix();
+    const auto& epsilon = rhf_parameters.orbitalEnergies();
+
+    // The factors B(a + N_virt*i, P) = (a i|P), so that the factors that belong to one occupied orbital are contiguous rows
+    const MatrixX<double> B = g.transformedFactors(C.rightCols(N_virt), C.leftCols(N_occ));
+
+    double E = 0.0;
+    for (size_t i_start = 0; i_start < N_occ; i_start += batch_size) {
+        const size_t i_end = std::min(i_start + batch_size, N_occ);
+        const size_t batch_rows = N_virt * (i_end - i_start);
+
+        // W(a + N_virt*(i - i_start), b + N_virt*j) = (i a|j b) for all occupied orbitals i in the batch and all j < i_end
+        Eigen::MatrixXd W (batch_rows, N_virt * i_end);
+        W.noalias() = B.middleRows(N_virt * i_start, batch_rows) * B.topRows(N_virt * i_end).transpose();
 
+        #pragma omp parallel for schedule(dynamic) reduction(+:E)
+        for (size_t i = i_start; i < i_end; i++) {
+            for (size_t j = 0; j <= i; j++) {
+                const Eigen::MatrixXd K_ij = W.block(N_virt * (i - i_start), N_virt * j, N_virt, N_virt);
+                E += (i == j ? 1.0 : 2.0) * calculateRMP2PairEnergy(K_ij, epsilon, i, j, N_occ);
+            }
         }
-    }  // end of summation over occupied orbitals
+    }
 
     return E;
 }
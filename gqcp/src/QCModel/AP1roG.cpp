@@ -116,27 +116,75 @@ double QCModel::AP1roG::calculatePSECoordinateFunction(const SQHamiltonian<doubl
 
 
 /**
- *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
+ *  @param pair_integrals           the pair integrals of the Hamiltonian expressed in an orthonormal basis
  *  @param G                        the AP1roG geminal coefficients
  *
  *  @return the PSEs, evaluated at the given geminal coefficients
  */
-BlockMatrix<double> QCModel::AP1roG::calculatePSECoordinateFunctions(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G) {
+BlockMatrix<double> QCModel::AP1roG::calculatePSECoordinateFunctions(const GeminalPairIntegrals& pair_integrals, const AP1roGGeminalCoefficients& G) {
 
     // Prepare some variables.
     const auto N_P = G.numberOfElectronPairs();
     const auto K = G.numberOfSpatialOrbitals();
+    const auto V = K - N_P;  // the number of virtual orbitals
 
-    BlockMatrix<double> F (0, N_P, N_P, K);  // an occupied-virtual matrix
+    const auto& h = pair_integrals.coreDiagonal();
+    const auto& J = pair_integrals.coulomb();
+    const auto& X = pair_integrals.pairExcitation();
 
-    // Loop over all the elements of F to construct it.
-    for (size_t i = 0; i < N_P; i++) {
-        for (size_t a = N_P; a < K; a++) {
-            F(i,a) = QCModel::AP1roG::calculatePSECoordinateFunction(sq_hamiltonian, G, i, a);
+    const MatrixX<double> G_ov = G.asMatrix().topRightCorner(N_P, V);  // without the identity block
+    const MatrixX<double> X_oo = X.topLeftCorner(N_P, N_P);
+    const MatrixX<double> X_ov = X.topRightCorner(N_P, V);
+    const MatrixX<double> X_vv = X.bottomRightCorner(V, V);
+
+
+    // D_pq = 2 g_ppqq - g_pqqp, and s_p = sum_j D_pj over the occupied orbitals j
+    const MatrixX<double> D = 2 * J - pair_integrals.exchange();
+    const VectorX<double> s = D.leftCols(N_P).rowwise().sum();
+
+    // r_i = sum_b g_ibib G_ib and c_a = sum_j g_jaja G_ja
+    const MatrixX<double> XG = X_ov.cwiseProduct(G_ov);
+    const VectorX<double> r = XG.rowwise().sum();
+    const VectorX<double> c = XG.colwise().sum().transpose();
+
+
+    // The unrestricted sums over occupied and virtual indices can be written as matrix products.
+    MatrixX<double> F = G_ov * X_vv.transpose() + X_oo.transpose() * G_ov + (G_ov * X_ov.transpose()) * G_ov;
+
+    // Correct for the excluded (j == i) and (b == a) terms, and add the terms that are diagonal in (i,a).
+    for (size_t a = 0; a < V; a++) {
+        const size_t a_full = N_P + a;  // the index of the virtual orbital in the full orbital space
+
+        for (size_t i = 0; i < N_P; i++) {
+            const double G_ia = G_ov(i,a);
+            const double X_ia = X(i,a_full);
+
+            double value = X(a_full,i) * (1 - std::pow(G_ia, 2));
+            value += 2 * ((s(a_full) - D(a_full,i)) - (s(i) - D(i,i))) * G_ia;
+            value += 2 * (h(a_full) - h(i)) * G_ia;
+            value += (J(a_full,a_full) - J(i,i)) * G_ia;
+
+            value -= X(a_full,a_full) * G_ia + (r(i) - X_ia * G_ia) * G_ia;  // the (b == a) term and the G_ia-quadratic term of the sum over b
+            value -= X(i,i) * G_ia + (c(a) - X_ia * G_ia) * G_ia;  // the (j == i) term and the G_ia-quadratic term of the sum over j
+            value -= (c(a) + r(i)) * G_ia - X_ia * std::pow(G_ia, 2);  // the (b == a) and (j == i) terms of the double sum
+
+            F(i,a) += value;
         }
     }
 
-    return F;
+    return BlockMatrix<double>(0, N_P, N_P, K, F);  // an occupied-virtual matrix
+}
+
+
+/**
+ *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
+ *  @param G                        the AP1roG geminal coefficients
+ *
+ *  @return the PSEs, evaluated at the given geminal coefficients
+ */
+BlockMatrix<double> QCModel::AP1roG::calculatePSECoordinateFunctions(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G) {
+
+    return QCModel::AP1roG::calculatePSECoordinateFunctions(GeminalPairIntegrals(sq_hamiltonian), G);
 }
 
 
@@ -148,11 +196,13 @@ BlockMatrix<double> QCModel::AP1roG::calculatePSECoordinateFunctions(const SQHam
  */
 VectorFunction<double> QCModel::AP1roG::callablePSECoordinateFunctions(const SQHamiltonian<double>& sq_hamiltonian, const size_t N_P) {
 
-    VectorFunction<double> callable = [&sq_hamiltonian, N_P] (const VectorX<double>& x) {
-        const auto K = sq_hamiltonian.dimension();  // the number of spatial orbitals
+    const GeminalPairIntegrals pair_integrals (sq_hamiltonian);  // extract the pair integrals only once
+
+    VectorFunction<double> callable = [pair_integrals, N_P] (const VectorX<double>& x) {
+        const auto K = pair_integrals.dimension();  // the number of spatial orbitals
 
         const auto G = AP1roGGeminalCoefficients::FromColumnMajor(x, N_P, K);
-        return QCModel::AP1roG::calculatePSECoordinateFunctions(sq_hamiltonian, G).asVector();
+        return QCModel::AP1roG::calculatePSECoordinateFunctions(pair_integrals, G).asVector();
     };
 
     return callable;
@@ -226,37 +276,93 @@ double QCModel::AP1roG::calculatePSEJacobianElement(const SQHamiltonian<double>&
 
 
 /**
- *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+ *  @param pair_integrals       the pair integrals of the Hamiltonian expressed in an orthonormal basis
  *  @param G                    the AP1roG geminal coefficients
  *
  *  @return the Jacobian J_{ia,jb} of the PSEs, i.e. df_i^a/dG_j^b, evaluated at the given geminal coefficients
  */
-BlockRankFourTensor<double> QCModel::AP1roG::calculatePSEJacobian(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G) {
+BlockRankFourTensor<double> QCModel::AP1roG::calculatePSEJacobian(const GeminalPairIntegrals& pair_integrals, const AP1roGGeminalCoefficients& G) {
 
     // Prepare some variables.
     const auto N_P = G.numberOfElectronPairs();
     const auto K = G.numberOfSpatialOrbitals();
+    const auto V = K - N_P;  // the number of virtual orbitals
+
+    const auto& h = pair_integrals.coreDiagonal();
+    const auto& X = pair_integrals.pairExcitation();
+
+    const MatrixX<double> G_ov = G.asMatrix().topRightCorner(N_P, V);  // without the identity block
+    const MatrixX<double> X_oo = X.topLeftCorner(N_P, N_P);
+    const MatrixX<double> X_ov = X.topRightCorner(N_P, V);
+    const MatrixX<double> X_vv = X.bottomRightCorner(V, V);
+
+    // D_pq = 2 g_ppqq - g_pqqp, and s_p = sum_k D_pk over the occupied orbitals k
+    const MatrixX<double> D = 2 * pair_integrals.coulomb() - pair_integrals.exchange();
+    const VectorX<double> s = D.leftCols(N_P).rowwise().sum();
+
+    // r_i = sum_c g_icic G_ic and c_a = sum_k g_kaka G_ka
+    const MatrixX<double> XG = X_ov.cwiseProduct(G_ov);
+    const VectorX<double> r = XG.rowwise().sum();
+    const VectorX<double> c = XG.colwise().sum().transpose();
+
+    // The unrestricted sums over occupied and virtual indices can be written as matrix products.
+    const MatrixX<double> GT_X = G_ov.transpose() * X_ov;  // (a,b): sum_k G_ka g_kbkb
+    const MatrixX<double> G_XT = G_ov * X_ov.transpose();  // (i,j): sum_c G_ic g_jcjc
 
 
     BlockRankFourTensor<double> J (0, N_P, N_P, K, 
                                    0, N_P, N_P, K);  // an occupied-virtual, occupied-virtual tensor
 
-
-    // Loop over all elements of J to construct it.
+    // The Jacobian is only non-zero if (i == j) or (a == b).
     for (size_t i = 0; i < N_P; i++) {
-        for (size_t a = N_P; a < K; a++) {
-            for (size_t j = 0; j < N_P; j++) {
-                for (size_t b = N_P; b < K; b++) {
-                    J(i,a,j,b) = QCModel::AP1roG::calculatePSEJacobianElement(sq_hamiltonian, G, i, a, j, b);
-                }
+        const MatrixX<double> J_i = X_vv + GT_X - 2 * G_ov.row(i).transpose() * X_ov.row(i);  // (a,b)
+
+        for (size_t b = 0; b < V; b++) {
+            for (size_t a = 0; a < V; a++) {
+                J(i,N_P+a,i,N_P+b) += J_i(a,b);
             }
         }
     }
 
+    for (size_t a = 0; a < V; a++) {
+        const MatrixX<double> J_a = X_oo.transpose() + G_XT - 2 * G_ov.col(a) * X_ov.col(a).transpose();  // (i,j)
+
+        for (size_t j = 0; j < N_P; j++) {
+            for (size_t i = 0; i < N_P; i++) {
+                J(i,N_P+a,j,N_P+a) += J_a(i,j);
+            }
+        }
+    }
+
+    for (size_t a = 0; a < V; a++) {
+        const size_t a_full = N_P + a;  // the index of the virtual orbital in the full orbital space
+
+        for (size_t i = 0; i < N_P; i++) {
+            const double XG_ia = X(i,a_full) * G_ov(i,a);
+
+            double value = 2 * (h(a_full) - h(i)) - 2 * D(a_full,i) + 2 * (s(a_full) - s(i));  // g_ppqq is symmetric
+            value -= 2 * (c(a) - XG_ia) + 2 * (r(i) - XG_ia);
+
+            J(i,a_full,i,a_full) += value;
+        }
+    }
+
     return J;
 }
 
 
+/**
+ *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+ *  @param G                    the AP1roG geminal coefficients
+ *
+ *  @return the Jacobian J_{ia,jb} of the PSEs, i.e. df_i^a/dG_j^b, evaluated at the given geminal coefficients
+ */
+BlockRankFourTensor<double> QCModel::AP1roG::calculatePSEJacobian(const SQHamiltonian<double>& sq_hamiltonian, const AP1roGGeminalCoefficients& G) {
+
+    return QCModel::AP1roG::calculatePSEJacobian(GeminalPairIntegrals(sq_hamiltonian), G);
+}
+
+
 /**
  *  @param sq_hamiltonian           the Hamiltonian expressed in an orthonormal basis
  *  @param N_P                      the number of electron pairs
@@ -265,11 +371,13 @@ BlockRankFourTensor<double> QCModel::AP1roG::calculatePSEJacobian(const SQHamilt
  */
 MatrixFunction<double> QCModel::AP1roG::callablePSEJacobian(const SQHamiltonian<double>& sq_hamiltonian, const size_t N_P) {
 
-    MatrixFunction<double> callable = [&sq_hamiltonian, N_P] (const VectorX<double>& x) {
-        const auto K = sq_hamiltonian.dimension(); // the number of spatial orbitals
+    const GeminalPairIntegrals pair_integrals (sq_hamiltonian);  // extract the pair integrals only once
+
+    MatrixFunction<double> callable = [pair_integrals, N_P] (const VectorX<double>& x) {
+        const auto K = pair_integrals.dimension(); // the number of spatial orbitals
 
         const auto G = AP1roGGeminalCoefficients::FromColumnMajor(x, N_P, K);
-        return QCModel::AP1roG::calculatePSEJacobian(sq_hamiltonian, G).asMatrix();
+        return QCModel::AP1roG::calculatePSEJacobian(pair_integrals, G).asMatrix();
     };
 
     return callable;
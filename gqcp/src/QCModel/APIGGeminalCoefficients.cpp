@@ -21,6 +21,9 @@
 #include "Mathematical/Representation/SquareMatrix.hpp"
 #include "Utilities/miscellaneous.hpp"
 
+#include <algorithm>
+#include <vector>
+
 
 namespace GQCP {
 
@@ -152,7 +155,116 @@ double APIGGeminalCoefficients::overlap(const SpinUnresolvedONV& onv) const {
 
 
     // Calculate the permanent of Gm to obtain the coefficient
-    return Gm.permanent_ryser();
+    return Gm.permanent_glynn();
+}
+
+
+/**
+ *  @param onv_basis       the seniority-zero spin-resolved ONV basis whose ONVs should be projected on
+ *
+ *  @return the overlaps of the APIG wave function with all the ONVs of the given ONV basis, in the order of their addresses
+ */
+VectorX<double> APIGGeminalCoefficients::overlaps(const SeniorityZeroONVBasis& onv_basis) const {
+
+    if ((onv_basis.numberOfSpatialOrbitals() != this->K) || (onv_basis.numberOfElectronPairs() != this->N_P)) {
+        throw std::invalid_argument("APIGGeminalCoefficients::overlaps(const SeniorityZeroONVBasis&): The given ONV basis is not compatible with these geminal coefficients.");
+    }
+
+    const auto dim = onv_basis.dimension();
+    if (this->N_P == 0) {
+        return VectorX<double>::Ones(dim);
+    }
+
+    if (this->N_P > 64) {
+        throw std::invalid_argument("APIGGeminalCoefficients::overlaps(const SeniorityZeroONVBasis&): Glynn's formula does not work for more than 64 electron pairs.");
+    }
+
+
+    // Store the occupied orbitals of every ONV, from the highest to the lowest one, together with the number of leading occupations that are shared with the previous ONV
+    std::vector<size_t> occupations (dim * this->N_P);
+    std::vector<size_t> number_of_shared_occupations (dim, 0);
+
+    const auto onv_basis_proxy = onv_basis.proxy();
+    SpinUnresolvedONV onv = onv_basis_proxy.makeONV(0);  // start with address 0
+    for (size_t I = 0; I < dim; I++) {
+
+        for (size_t l = 0; l < this->N_P; l++) {
+            occupations[I * this->N_P + l] = onv.get_occupation_index(this->N_P - 1 - l);
+        }
+
+        if (I > 0) {
+            size_t l = 0;
+            while ((l < this->N_P) && (occupations[I * this->N_P + l] == occupations[(I-1) * this->N_P + l])) {
+                l++;
+            }
+            number_of_shared_occupations[I] = l;
+        }
+
+        if (I < dim - 1) {  // prevent the last permutation from occurring
+            onv_basis_proxy.setNextONV(onv);
+        }
+    }
+
+
+    // Every block of consecutive ONVs walks through all the sign vectors of Glynn's formula. The sign of geminal i (i>0) is encoded in bit (i-1) of the Gray code: a set bit corresponds to a sign of -1
+    const size_t number_of_sign_vectors = static_cast<size_t>(1) << (this->N_P - 1);
+    const size_t block_size = 256;
+    const size_t number_of_blocks = (dim + block_size - 1) / block_size;
+
+    VectorX<double> coefficients = VectorX<double>::Zero(dim);
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = 0; block < number_of_blocks; block++) {
+
+        const size_t first = block * block_size;
+        const size_t last = std::min(first + block_size, dim);
+
+        VectorX<double> column_sums = this->G.colwise().sum().transpose();  // all signs are +1 for the first Gray code
+        std::vector<double> partial_products (this->N_P + 1);
+        partial_products[0] = 1.0;
+
+        size_t gray_code_value = 0;
+        double sign = 1.0;  // the product of all the signs
+        for (size_t S = 0; S < number_of_sign_vectors; S++) {
+
+            // Successive Gray codes differ in exactly one bit, which is given by the number of trailing zeros of S
+            if (S > 0) {
+                const size_t k = __builtin_ctzll(S);
+                gray_code_value ^= static_cast<size_t>(1) << k;
+
+                if ((gray_code_value >> k) & 1) {  // the sign of geminal k+1 has flipped from +1 to -1
+                    column_sums -= 2 * this->G.row(k+1).transpose();
+                } else {
+                    column_sums += 2 * this->G.row(k+1).transpose();
+                }
+
+                sign = -sign;
+            }
+
+
+            // Only the partial products that are not shared with the previous ONV have to be recalculated
+            for (size_t I = first; I < last; I++) {
+                const size_t l_start = (I == first) ? 0 : number_of_shared_occupations[I];
+                for (size_t l = l_start; l < this->N_P; l++) {
+                    partial_products[l+1] = partial_products[l] * column_sums(occupations[I * this->N_P + l]);
+                }
+
+                coefficients(I) += sign * partial_products[this->N_P];
+            }
+        }
+    }
+
+    return coefficients / static_cast<double>(number_of_sign_vectors);
+}
+
+
+/**
+ *  @param onv_basis       the seniority-zero spin-resolved ONV basis the wave function should live in
+ *
+ *  @return the wave function expansion corresponding to the geminal coefficients
+ */
+LinearExpansion<SeniorityZeroONVBasis> APIGGeminalCoefficients::toLinearExpansion(const SeniorityZeroONVBasis& onv_basis) const {
+
+    return LinearExpansion<SeniorityZeroONVBasis>{onv_basis, this->overlaps(onv_basis)};
 }
 
 
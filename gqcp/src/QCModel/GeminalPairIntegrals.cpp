@@ -0,0 +1,50 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "QCModel/Geminals/GeminalPairIntegrals.hpp"
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param sq_hamiltonian       the Hamiltonian expressed in an orthonormal basis
+ */
+GeminalPairIntegrals::GeminalPairIntegrals(const SQHamiltonian<double>& sq_hamiltonian) :
+    h_diagonal (sq_hamiltonian.core().parameters().diagonal()),
+    J (SquareMatrix<double>::Zero(sq_hamiltonian.dimension(), sq_hamiltonian.dimension())),
+    K (SquareMatrix<double>::Zero(sq_hamiltonian.dimension(), sq_hamiltonian.dimension())),
+    X (SquareMatrix<double>::Zero(sq_hamiltonian.dimension(), sq_hamiltonian.dimension()))
+{
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    const auto dim = sq_hamiltonian.dimension();
+    for (size_t q = 0; q < dim; q++) {
+        for (size_t p = 0; p < dim; p++) {
+            this->J(p,q) = g(p,p,q,q);
+            this->K(p,q) = g(p,q,q,p);
+            this->X(p,q) = g(p,q,p,q);
+        }
+    }
+}
+
+
+}  // namespace GQCP
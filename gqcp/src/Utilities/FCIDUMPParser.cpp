@@ -0,0 +1,245 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Utilities/FCIDUMPParser.hpp"
+
+#include "Utilities/miscellaneous.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+namespace {
+
+
+constexpr size_t part_size = 1024 * 1024;  // the approximate number of bytes of a chunk that a thread parses at once
+
+
+/**
+ *  @param header           the (upper case) header of an FCIDUMP file
+ *  @param key              the name of a variable in the header
+ * 
+ *  @return the value of the given variable, or 0 if it isn't present
+ */
+size_t readHeaderValue(const std::string& header, const std::string& key) {
+
+    const auto key_position = header.find(key);
+    if (key_position == std::string::npos) {
+        return 0;
+    }
+
+    const auto equals_position = header.find('=', key_position + key.size());
+    if (equals_position == std::string::npos) {
+        return 0;
+    }
+
+    return std::strtoul(header.c_str() + equals_position + 1, nullptr, 10);
+}
+
+
+/**
+ *  @param cursor           the position at which parsing starts, which is moved past the parsed index
+ *  @param end              the end of the line
+ * 
+ *  @return the unsigned integer at the given position, after skipping spaces and tabs
+ */
+size_t parseIndex(const char*& cursor, const char* end) {
+
+    while ((cursor < end) && ((*cursor == ' ') || (*cursor == '\t'))) {
+        cursor++;
+    }
+
+    if ((cursor == end) || !std::isdigit(static_cast<unsigned char>(*cursor))) {
+        throw std::invalid_argument("FCIDUMPParser::parseRecord(const char*&, const char*, FCIDUMPRecord&): Found a line that doesn't contain a value followed by four orbital indices.");
+    }
+
+    size_t index = 0;
+    while ((cursor < end) && std::isdigit(static_cast<unsigned char>(*cursor))) {
+        index = 10 * index + static_cast<size_t>(*cursor - '0');
+        cursor++;
+    }
+
+    return index;
+}
+
+
+}  // namespace
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  Read the header of an FCIDUMP file.
+ * 
+ *  @param fcidump_file             the name of the FCIDUMP file
+ *  @param chunk_size               the number of bytes that are read (and parsed) at once
+ */
+FCIDUMPParser::FCIDUMPParser(const std::string& fcidump_file, const size_t chunk_size) :
+    filename (fcidump_file),
+    chunk_size (std::max<size_t>(chunk_size, 1))
+{
+    std::ifstream input_file_stream = validateAndOpen(fcidump_file, "FCIDUMP");
+
+
+    // The header is a Fortran namelist that is terminated by a line that starts with '/' or '&END'
+    std::string header;
+    std::string line;
+    bool found_end_of_header = false;
+    while (std::getline(input_file_stream, line)) {
+        std::transform(line.begin(), line.end(), line.begin(), [] (unsigned char c) { return std::toupper(c); });
+
+        const auto first_character = line.find_first_not_of(" \t\r");
+        if ((first_character != std::string::npos) && ((line[first_character] == '/') || (line.compare(first_character, 4, "&END") == 0))) {
+            found_end_of_header = true;
+            break;
+        }
+
+        header += line + ' ';
+    }
+
+    if (!found_end_of_header) {
+        throw std::invalid_argument("FCIDUMPParser::FCIDUMPParser(const std::string&, const size_t): The .FCIDUMP-file is invalid: could not find the end of the header.");
+    }
+
+    this->body_offset = input_file_stream.tellg();
+    this->K = readHeaderValue(header, "NORB");
+    this->N = readHeaderValue(header, "NELEC");
+
+    if (this->K == 0) {
+        throw std::invalid_argument("FCIDUMPParser::FCIDUMPParser(const std::string&, const size_t): The .FCIDUMP-file is invalid: could not read a number of orbitals.");
+    }
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Read the next chunk of complete lines from the file.
+ * 
+ *  @param file                 the file stream
+ *  @param chunk                the chunk, on output
+ *  @param remainder            the incomplete line at the end of the previous chunk, which is updated for the next chunk
+ * 
+ *  @return if a (non-empty) chunk was read
+ */
+bool FCIDUMPParser::readChunk(std::ifstream& file, std::string& chunk, std::string& remainder) const {
+
+    chunk.swap(remainder);
+    remainder.clear();
+
+    // Keep reading until the chunk contains at least one complete line, or until the end of the file
+    while (file) {
+        const auto previous_size = chunk.size();
+        chunk.resize(previous_size + this->chunk_size);
+        file.read(&chunk[previous_size], this->chunk_size);
+        chunk.resize(previous_size + static_cast<size_t>(file.gcount()));
+
+        if (!file) {  // we have reached the end of the file, so the last line is complete
+            break;
+        }
+
+        const auto last_newline = chunk.rfind('\n');
+        if ((last_newline != std::string::npos) && (last_newline >= previous_size)) {
+            remainder.assign(chunk, last_newline + 1, std::string::npos);
+            chunk.resize(last_newline + 1);
+            break;
+        }
+    }
+
+    return !chunk.empty();
+}
+
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  Parse the record at the given position.
+ * 
+ *  @param cursor               the position at which parsing starts, which is moved to the start of the next line
+ *  @param end                  the end of the part of the chunk that should be parsed
+ *  @param record               the parsed record, on output
+ * 
+ *  @return if a record was found before the end
+ */
+bool FCIDUMPParser::parseRecord(const char*& cursor, const char* end, FCIDUMPRecord& record) {
+
+    // Skip empty lines and leading whitespace
+    while ((cursor < end) && std::isspace(static_cast<unsigned char>(*cursor))) {
+        cursor++;
+    }
+    if (cursor == end) {
+        return false;
+    }
+
+    // Since every part of a chunk ends with a newline or with the terminating null character of the chunk, strtod can't read past the end
+    char* value_end = nullptr;
+    record.value = std::strtod(cursor, &value_end);
+    if (value_end == cursor) {
+        throw std::invalid_argument("FCIDUMPParser::parseRecord(const char*&, const char*, FCIDUMPRecord&): Found a line that doesn't start with a value.");
+    }
+    cursor = value_end;
+
+    const char* line_end = std::find(cursor, end, '\n');
+    record.i = parseIndex(cursor, line_end);
+    record.a = parseIndex(cursor, line_end);
+    record.j = parseIndex(cursor, line_end);
+    record.b = parseIndex(cursor, line_end);
+
+    cursor = line_end;
+    return true;
+}
+
+
+/**
+ *  @param chunk                a chunk of complete lines
+ * 
+ *  @return the offsets that split the chunk into parts of (approximately) equal size, which all start at the beginning of a line
+ */
+std::vector<size_t> FCIDUMPParser::splitAtLines(const std::string& chunk) {
+
+    std::vector<size_t> boundaries {0};
+    while (boundaries.back() + part_size < chunk.size()) {
+        const auto newline = chunk.find('\n', boundaries.back() + part_size);
+        if (newline == std::string::npos) {
+            break;
+        }
+        boundaries.push_back(newline + 1);
+    }
+
+    if (boundaries.back() != chunk.size()) {
+        boundaries.push_back(chunk.size());
+    }
+
+    return boundaries;
+}
+
+
+}  // namespace GQCP
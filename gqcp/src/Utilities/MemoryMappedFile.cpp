@@ -0,0 +1,213 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "Utilities/MemoryMappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/*
+ *  PRIVATE CONSTRUCTORS
+ */
+
+/**
+ *  @param path                 the path to the file that should be mapped
+ *  @param file_descriptor      the POSIX file descriptor of the opened file
+ *  @param number_of_bytes      the size of the file
+ *  @param is_writable          if the mapping should allow writing
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string& path, const int file_descriptor, const size_t number_of_bytes, const bool is_writable) :
+    path (path),
+    file_descriptor (file_descriptor),
+    address (nullptr),
+    number_of_bytes (number_of_bytes),
+    is_writable (is_writable)
+{
+    if (number_of_bytes == 0) {
+        ::close(file_descriptor);
+        throw std::invalid_argument("MemoryMappedFile::MemoryMappedFile(const std::string&, const int, const size_t, const bool): Can't map an empty file.");
+    }
+
+    const int protection = is_writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* mapped_address = ::mmap(nullptr, number_of_bytes, protection, MAP_SHARED, file_descriptor, 0);
+    if (mapped_address == MAP_FAILED) {
+        const std::string error = std::strerror(errno);
+        ::close(file_descriptor);
+        throw std::runtime_error("MemoryMappedFile::MemoryMappedFile(const std::string&, const int, const size_t, const bool): Could not map the file " + path + ": " + error);
+    }
+
+    this->address = mapped_address;
+}
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) :
+    path (std::move(other.path)),
+    file_descriptor (other.file_descriptor),
+    address (other.address),
+    number_of_bytes (other.number_of_bytes),
+    is_writable (other.is_writable)
+{
+    other.file_descriptor = -1;
+    other.address = nullptr;
+    other.number_of_bytes = 0;
+}
+
+
+
+/*
+ *  DESTRUCTOR
+ */
+
+MemoryMappedFile::~MemoryMappedFile() {
+    this->release();
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  Create a new file (or overwrite an existing one) with the given size, filled with zeros, and map it into memory for reading and writing.
+ * 
+ *  @param path                 the path to the file that should be created
+ *  @param number_of_bytes      the size of the file
+ */
+MemoryMappedFile MemoryMappedFile::Create(const std::string& path, const size_t number_of_bytes) {
+
+    const int file_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_descriptor < 0) {
+        throw std::runtime_error("MemoryMappedFile::Create(const std::string&, const size_t): Could not create the file " + path + ": " + std::strerror(errno));
+    }
+
+    // Extending a file with ftruncate fills it with zeros, without having to write them explicitly
+    if (::ftruncate(file_descriptor, static_cast<off_t>(number_of_bytes)) != 0) {
+        const std::string error = std::strerror(errno);
+        ::close(file_descriptor);
+        throw std::runtime_error("MemoryMappedFile::Create(const std::string&, const size_t): Could not resize the file " + path + ": " + error);
+    }
+
+    return MemoryMappedFile(path, file_descriptor, number_of_bytes, true);
+}
+
+
+/**
+ *  Map an existing file into memory.
+ * 
+ *  @param path                 the path to the file that should be mapped
+ *  @param is_writable          if the mapping should allow writing
+ */
+MemoryMappedFile MemoryMappedFile::Open(const std::string& path, const bool is_writable) {
+
+    const int file_descriptor = ::open(path.c_str(), is_writable ? O_RDWR : O_RDONLY);
+    if (file_descriptor < 0) {
+        throw std::runtime_error("MemoryMappedFile::Open(const std::string&, const bool): Could not open the file " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat file_status;
+    if (::fstat(file_descriptor, &file_status) != 0) {
+        const std::string error = std::strerror(errno);
+        ::close(file_descriptor);
+        throw std::runtime_error("MemoryMappedFile::Open(const std::string&, const bool): Could not determine the size of the file " + path + ": " + error);
+    }
+
+    return MemoryMappedFile(path, file_descriptor, static_cast<size_t>(file_status.st_size), is_writable);
+}
+
+
+
+/*
+ *  OPERATORS
+ */
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) {
+
+    if (this != &other) {
+        this->release();
+
+        this->path = std::move(other.path);
+        this->file_descriptor = other.file_descriptor;
+        this->address = other.address;
+        this->number_of_bytes = other.number_of_bytes;
+        this->is_writable = other.is_writable;
+
+        other.file_descriptor = -1;
+        other.address = nullptr;
+        other.number_of_bytes = 0;
+    }
+
+    return *this;
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  Write the changes in the mapping back to the file.
+ */
+void MemoryMappedFile::flush() {
+
+    if (this->is_writable && (this->address != nullptr)) {
+        if (::msync(this->address, this->number_of_bytes, MS_SYNC) != 0) {
+            throw std::runtime_error("MemoryMappedFile::flush(): Could not write the mapping back to the file " + this->path + ": " + std::strerror(errno));
+        }
+    }
+}
+
+
+
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Release the mapping and close the file.
+ */
+void MemoryMappedFile::release() {
+
+    if (this->address != nullptr) {
+        ::munmap(this->address, this->number_of_bytes);  // changes to a shared mapping are written back to the file by the operating system
+        this->address = nullptr;
+    }
+
+    if (this->file_descriptor >= 0) {
+        ::close(this->file_descriptor);
+        this->file_descriptor = -1;
+    }
+}
+
+
+}  // namespace GQCP
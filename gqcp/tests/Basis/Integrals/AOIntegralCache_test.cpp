@@ -0,0 +1,190 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "AOIntegralCache"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basis/Integrals/AOIntegralCache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+/**
+ *  Check if integrals over the same shell sets are only calculated once, and if different shell sets or operators lead to a new calculation.
+ */
+BOOST_AUTO_TEST_CASE ( findOrCalculate ) {
+
+    const GQCP::Nucleus H1 (1, 0.0, 0.0, 0.0);
+    const GQCP::Nucleus H2 (1, 0.0, 0.0, 1.4);
+
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set1 {GQCP::GTOShell(0, H1, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})};
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set2 {GQCP::GTOShell(0, H2, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})};
+
+
+    // Provide a 'calculation' that counts how many times it has been called
+    size_t number_of_calculations = 0;
+    const auto calculate = [&number_of_calculations] () {
+        number_of_calculations++;
+
+        GQCP::Tensor<double, 4> g (1, 1, 1, 1);
+        g.setConstant(static_cast<double>(number_of_calculations));
+        return g;
+    };
+
+
+    auto& cache = GQCP::AOIntegralCache::get();
+    cache.clear();
+    cache.setMaximumNumberOfEntries(2);
+
+    const auto g1 = cache.findOrCalculate("Coulomb", shell_set1, shell_set1, calculate);
+    const auto g1_again = cache.findOrCalculate("Coulomb", shell_set1, shell_set1, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 1);
+    BOOST_CHECK_EQUAL(g1.get(), g1_again.get());  // the integrals should be shared
+
+    // Check that a different shell set or operator leads to a new calculation
+    const auto g12 = cache.findOrCalculate("Coulomb", shell_set1, shell_set2, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 2);
+    BOOST_CHECK(std::abs((*g12)(0,0,0,0) - 2.0) < 1.0e-12);
+
+    cache.findOrCalculate("Other", shell_set1, shell_set1, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 3);
+
+
+    // The least recently used entry (shell_set1, shell_set1) should have been removed, since the capacity is 2
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 2);
+    cache.findOrCalculate("Coulomb", shell_set1, shell_set2, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 3);
+    cache.findOrCalculate("Coulomb", shell_set1, shell_set1, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 4);
+
+
+    // Check that a capacity of zero disables the cache
+    cache.setMaximumNumberOfEntries(0);
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 0);
+    cache.findOrCalculate("Coulomb", shell_set1, shell_set1, calculate);
+    cache.findOrCalculate("Coulomb", shell_set1, shell_set1, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 6);
+
+    cache.setMaximumNumberOfEntries(1);
+}
+
+
+/**
+ *  Check if concurrent requests for the same integrals only lead to one calculation, and if a failing calculation isn't cached.
+ */
+BOOST_AUTO_TEST_CASE ( concurrent_findOrCalculate ) {
+
+    const GQCP::Nucleus H (1, 0.0, 0.0, 0.0);
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set {GQCP::GTOShell(0, H, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})};
+
+    auto& cache = GQCP::AOIntegralCache::get();
+    cache.clear();
+    cache.setMaximumNumberOfEntries(1);
+
+
+    // Let every thread request the same integrals, which should only be calculated once
+    std::atomic<size_t> number_of_calculations {0};
+    const auto calculate = [&number_of_calculations] () {
+        number_of_calculations++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));  // give the other threads the time to request the integrals in the meantime
+
+        GQCP::Tensor<double, 4> g (1, 1, 1, 1);
+        g.setConstant(1.0);
+        return g;
+    };
+
+    const size_t number_of_requests = 8;
+    std::vector<std::shared_ptr<const GQCP::Tensor<double, 4>>> results (number_of_requests);  // keep the integrals alive, since the cache only shares integrals that are still in use
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < number_of_requests; i++) {
+        results[i] = cache.findOrCalculate("Coulomb", shell_set, shell_set, calculate);
+    }
+
+    BOOST_CHECK_EQUAL(number_of_calculations, 1);
+    for (const auto& result : results) {
+        BOOST_CHECK_EQUAL(result.get(), results[0].get());
+    }
+    results.clear();
+
+
+    // Check that a failing calculation is propagated and isn't cached
+    cache.clear();
+    const auto fail = [ ] () -> GQCP::Tensor<double, 4> { throw std::runtime_error("failure"); };
+    BOOST_CHECK_THROW(cache.findOrCalculate("Coulomb", shell_set, shell_set, fail), std::runtime_error);
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 0);
+
+    cache.findOrCalculate("Coulomb", shell_set, shell_set, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 2);
+}
+
+
+/**
+ *  Check if the cache doesn't keep the integrals alive, and if releasing integrals that aren't shared moves them out instead of copying them, so that a second request doesn't lead to another copy of the integrals.
+ */
+BOOST_AUTO_TEST_CASE ( release ) {
+
+    const GQCP::Nucleus H (1, 0.0, 0.0, 0.0);
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set {GQCP::GTOShell(0, H, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})};
+
+    auto& cache = GQCP::AOIntegralCache::get();
+    cache.clear();
+    cache.setMaximumNumberOfEntries(1);
+
+
+    // Provide a 'calculation' that remembers where it has stored the integrals
+    size_t number_of_calculations = 0;
+    const double* calculated_data = nullptr;
+    const auto calculate = [&number_of_calculations, &calculated_data] () {
+        number_of_calculations++;
+
+        GQCP::Tensor<double, 4> g (3, 3, 3, 3);
+        g.setConstant(1.0);
+        calculated_data = g.data();
+        return g;
+    };
+
+
+    // Releasing the only owner should move the integrals out, after which the cache doesn't hold any integrals anymore
+    for (size_t i = 1; i <= 2; i++) {
+        auto g = cache.findOrCalculate("Coulomb", shell_set, shell_set, calculate);
+        const std::weak_ptr<const GQCP::Tensor<double, 4>> cached_g = g;
+        const auto released_g = cache.release(g);
+
+        BOOST_CHECK_EQUAL(number_of_calculations, i);  // the integrals of the previous iteration weren't kept alive by the cache
+        BOOST_CHECK(!g);
+        BOOST_CHECK(cached_g.expired());
+        BOOST_CHECK_EQUAL(released_g.data(), calculated_data);  // no copy has been made
+        BOOST_CHECK(std::abs(released_g(2,2,2,2) - 1.0) < 1.0e-12);
+    }
+
+
+    // Releasing one of the owners of shared integrals should copy them
+    auto g1 = cache.findOrCalculate("Coulomb", shell_set, shell_set, calculate);
+    auto g2 = cache.findOrCalculate("Coulomb", shell_set, shell_set, calculate);
+    BOOST_CHECK_EQUAL(number_of_calculations, 3);
+
+    const auto released_g1 = cache.release(g1);
+    BOOST_CHECK(released_g1.data() != g2->data());
+    BOOST_CHECK(std::abs(released_g1(0,1,2,0) - (*g2)(0,1,2,0)) < 1.0e-12);
+
+    const auto released_g2 = cache.release(g2);
+    BOOST_CHECK_EQUAL(released_g2.data(), calculated_data);
+}
@@ -23,6 +23,11 @@
 #include "Basis/ScalarBasis/ScalarBasis.hpp"
 #include "Molecule/Molecule.hpp"
 #include "Operator/FirstQuantized/Operator.hpp"
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
+
+#include <Eigen/Eigenvalues>
+
+#include <cstdio>
 
 
 /**
@@ -160,3 +165,73 @@ BOOST_AUTO_TEST_CASE ( libcint_vs_libint2_dipole_origin ) {
         BOOST_CHECK(dipole_libcint[i].isApprox(dipole_libint2[i], 1.0e-08));
     }
 }
+
+
+/**
+ *  Check the two- and three-center Coulomb integrals, by checking their symmetries and by fitting the four-center integrals of H2O in an auxiliary basis.
+ */
+BOOST_AUTO_TEST_CASE ( two_and_three_center_integrals_h2o_sto3g ) {
+
+    const auto molecule = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (molecule, "STO-3G");
+    const GQCP::ScalarBasis<GQCP::GTOShell> auxiliary_scalar_basis (molecule, "def2-universal-jkfit");
+    const auto K = scalar_basis.numberOfBasisFunctions();
+    const auto N_aux = auxiliary_scalar_basis.numberOfBasisFunctions();
+
+    const auto J = GQCP::IntegralCalculator::calculateLibintTwoCenterIntegrals(GQCP::Operator::Coulomb(), auxiliary_scalar_basis);
+    const auto three_center_integrals = GQCP::IntegralCalculator::calculateLibintThreeCenterIntegrals(GQCP::Operator::Coulomb(), auxiliary_scalar_basis, scalar_basis);
+
+
+    // The Coulomb metric should be symmetric and positive definite, and the three-center integrals (mu nu|P) should be symmetric in mu and nu
+    BOOST_CHECK_EQUAL(J.rows(), N_aux);
+    BOOST_CHECK(J.isApprox(J.transpose(), 1.0e-12));
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (J);
+    BOOST_CHECK(eigensolver.eigenvalues().minCoeff() > 0.0);
+
+    BOOST_CHECK_EQUAL(three_center_integrals.rows(), K * K);
+    BOOST_CHECK_EQUAL(three_center_integrals.cols(), N_aux);
+    for (size_t P = 0; P < N_aux; P++) {
+        const Eigen::Map<const Eigen::MatrixXd> integrals_P (three_center_integrals.col(P).data(), K, K);
+        BOOST_CHECK(integrals_P.isApprox(integrals_P.transpose(), 1.0e-12));
+    }
+
+
+    // The fitted four-center integrals should be close to the reference from HORTON, and the fitted Coulomb energy of a density can't be larger than the exact one
+    const auto g_df = GQCP::DFTwoElectronOperator::FromThreeCenterIntegrals(three_center_integrals, J, K).toTensor();
+    const auto ref_g = GQCP::QCRankFourTensor<double>::FromFile("data/h2o_sto-3g_coulomb_horton.data", K);
+    BOOST_CHECK(g_df.isApprox(ref_g, 1.0e-02));
+
+    double E_J_df = 0.0;
+    double E_J = 0.0;
+    for (size_t p = 0; p < K; p++) {
+        for (size_t r = 0; r < K; r++) {
+            E_J_df += g_df(p,p,r,r);
+            E_J += ref_g(p,p,r,r);
+        }
+    }
+    BOOST_CHECK(E_J_df <= E_J + 1.0e-06);
+    BOOST_CHECK(std::abs(E_J_df - E_J) < 1.0e-02 * E_J);
+}
+
+
+/**
+ *  Check if the Coulomb integrals that libint writes straight into a memory-mapped file are equal to the reference values from HORTON.
+ */
+BOOST_AUTO_TEST_CASE ( memory_mapped_integrals_h2o_sto3g ) {
+
+    const auto molecule = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (molecule, "STO-3G");
+    const auto nbf = scalar_basis.numberOfBasisFunctions();
+
+    {
+        const auto g_mapped = GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::Coulomb(), scalar_basis, "g_libint.bin");
+        BOOST_CHECK_EQUAL(g_mapped.dimension(), nbf);
+    }
+
+    // The integrals should have been written to the file, so that they can be opened again
+    const auto g_reopened = GQCP::MemoryMappedRankFourTensor::Open("g_libint.bin");
+    const auto ref_g = GQCP::QCRankFourTensor<double>::FromFile("data/h2o_sto-3g_coulomb_horton.data", nbf);
+    BOOST_CHECK(g_reopened.toTensor().isApprox(ref_g, 1.0e-06));
+
+    std::remove("g_libint.bin");
+}
@@ -0,0 +1,67 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "LibintPreparedShells"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basis/Integrals/Interfaces/LibintPreparedShells.hpp"
+
+
+/**
+ *  Check if the prepared libint2 shells are only found for exactly the shells that were prepared.
+ */
+BOOST_AUTO_TEST_CASE ( find ) {
+
+    const GQCP::Nucleus h1 (1,  0.0, 0.0, 0.0);
+    const GQCP::Nucleus h2 (1,  0.0, 0.0, 1.4);
+    const GQCP::GTOShell shell1 (0, h1, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454}, false);
+    const GQCP::GTOShell shell2 (0, h2, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454}, false);
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set {shell1, shell2};
+
+    const GQCP::LibintPreparedShells prepared_shells (shell_set);
+
+
+    // The prepared shells should be found, also through another (but identical) shell set.
+    BOOST_CHECK(prepared_shells.find(shell_set, 0));
+    BOOST_CHECK(prepared_shells.find(shell_set, 1));
+    BOOST_CHECK_EQUAL(prepared_shells.find(shell_set, 1)->O[2], 1.4);
+
+    const GQCP::ShellSet<GQCP::GTOShell> copied_shell_set {shell1, shell2};
+    BOOST_CHECK(prepared_shells.find(copied_shell_set, 1));
+
+
+    // A shell set with the same number of shells, but with a moved nucleus or other contraction coefficients, shouldn't be found.
+    const GQCP::Nucleus h2_moved (1,  0.0, 0.0, 1.5);
+    const GQCP::GTOShell moved_shell2 (0, h2_moved, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454}, false);
+    const GQCP::ShellSet<GQCP::GTOShell> moved_shell_set {shell1, moved_shell2};
+    BOOST_CHECK(prepared_shells.find(moved_shell_set, 0));
+    BOOST_CHECK(!prepared_shells.find(moved_shell_set, 1));
+
+    const GQCP::GTOShell other_shell2 (0, h2, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463455}, false);
+    const GQCP::ShellSet<GQCP::GTOShell> other_shell_set {shell1, other_shell2};
+    BOOST_CHECK(!prepared_shells.find(other_shell_set, 1));
+
+
+    // Shells outside of the prepared shells shouldn't be found.
+    const GQCP::ShellSet<GQCP::GTOShell> larger_shell_set {shell1, shell2, shell1};
+    BOOST_CHECK(!prepared_shells.find(larger_shell_set, 2));
+
+
+    // Nothing should be found if no shells were prepared.
+    BOOST_CHECK(!GQCP::LibintPreparedShells().find(shell_set, 0));
+}
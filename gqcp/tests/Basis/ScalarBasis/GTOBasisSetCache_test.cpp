@@ -0,0 +1,123 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "GTOBasisSetCache"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basis/ScalarBasis/GTOBasisSetCache.hpp"
+
+#include "Basis/Integrals/Interfaces/LibintInterfacer.hpp"
+#include "Basis/ScalarBasis/GTOBasisSet.hpp"
+
+
+namespace {
+
+
+/**
+ *  @return if the two shell sets contain the same shells, in the same order
+ */
+bool areEqual(const GQCP::ShellSet<GQCP::GTOShell>& lhs, const GQCP::ShellSet<GQCP::GTOShell>& rhs) {
+
+    if (lhs.numberOfShells() != rhs.numberOfShells()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < lhs.numberOfShells(); i++) {
+        const auto& lhs_shell = lhs.asVector()[i];
+        const auto& rhs_shell = rhs.asVector()[i];
+
+        if ((lhs_shell.get_gaussian_exponents().size() != rhs_shell.get_gaussian_exponents().size()) || !(lhs_shell == rhs_shell)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+}  // namespace
+
+
+/**
+ *  Check if the shells that are placed from the cache are the same as the ones that libint2 generates for the whole molecule
+ */
+BOOST_AUTO_TEST_CASE ( generate ) {
+
+    auto& cache = GQCP::GTOBasisSetCache::get();
+    cache.clear();
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const auto& nuclei = water.nuclearFramework().nucleiAsVector();
+
+    for (const auto& basisset_name : {"STO-3G", "6-31G**", "cc-pVDZ"}) {
+        libint2::BasisSet libint_basis (basisset_name, GQCP::LibintInterfacer::get().interface(nuclei));
+        const GQCP::ShellSet<GQCP::GTOShell> ref_shell_set = GQCP::LibintInterfacer::get().interface(libint_basis, nuclei);
+
+        const auto shell_set = GQCP::GTOBasisSet(basisset_name).generate(water);
+        BOOST_CHECK(areEqual(shell_set, ref_shell_set));
+    }
+}
+
+
+/**
+ *  Check if every basisset is only stored once for every element, regardless of the case of its name
+ */
+BOOST_AUTO_TEST_CASE ( entries ) {
+
+    auto& cache = GQCP::GTOBasisSetCache::get();
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 0);
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const auto shell_set = GQCP::GTOBasisSet("STO-3G").generate(water);
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 2);  // H and O
+
+    const auto shell_set_again = GQCP::GTOBasisSet("sto-3g").generate(water);
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 2);
+    BOOST_CHECK(areEqual(shell_set, shell_set_again));
+
+    GQCP::GTOBasisSet("6-31G").generate(water);
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 4);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 0);
+}
+
+
+/**
+ *  Check if concurrent requests for the same shells lead to the same shell sets
+ */
+BOOST_AUTO_TEST_CASE ( concurrent_generate ) {
+
+    auto& cache = GQCP::GTOBasisSetCache::get();
+    cache.clear();
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const size_t number_of_requests = 16;
+    std::vector<GQCP::ShellSet<GQCP::GTOShell>> shell_sets (number_of_requests, GQCP::ShellSet<GQCP::GTOShell>(std::vector<GQCP::GTOShell>{}));
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < number_of_requests; i++) {
+        shell_sets[i] = GQCP::GTOBasisSet("6-31G").generate(water);
+    }
+
+    BOOST_CHECK_EQUAL(cache.numberOfEntries(), 2);
+    for (size_t i = 1; i < number_of_requests; i++) {
+        BOOST_CHECK(areEqual(shell_sets[i], shell_sets[0]));
+    }
+}
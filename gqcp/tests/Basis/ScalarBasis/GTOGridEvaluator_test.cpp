@@ -0,0 +1,187 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "GTOGridEvaluator"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basis/ScalarBasis/GTOGridEvaluator.hpp"
+
+
+namespace {
+
+
+/**
+ *  @return a set of points scattered around the origin, as rows of a (N x 3)-matrix
+ */
+GQCP::MatrixX<double> testPoints() {
+
+    GQCP::MatrixX<double> points (7, 3);
+    points << 0.0,  0.0,  0.0,
+              0.5, -0.3,  0.2,
+             -1.0,  0.7,  0.4,
+              0.1,  1.2, -0.8,
+              2.0,  0.0,  1.5,
+             -0.4, -0.6, -1.1,
+              0.3,  0.3,  0.3;
+
+    return points;
+}
+
+
+}  // namespace
+
+
+/**
+ *  Check if the constructor throws upon invalid arguments
+ */
+BOOST_AUTO_TEST_CASE ( constructor ) {
+
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (GQCP::ShellSet<GQCP::GTOShell>({GQCP::GTOShell(0, GQCP::Nucleus(), {1.0}, {1.0})}));
+
+    BOOST_CHECK_THROW(GQCP::GTOGridEvaluator(scalar_basis, 0.0), std::invalid_argument);
+    BOOST_CHECK_THROW(GQCP::GTOGridEvaluator(scalar_basis, 1.0e-12, 0), std::invalid_argument);
+
+    const GQCP::GTOGridEvaluator evaluator (scalar_basis);
+    BOOST_CHECK_THROW(evaluator.evaluate(GQCP::MatrixX<double>::Zero(4, 2)), std::invalid_argument);
+}
+
+
+/**
+ *  Check the values of Cartesian s- and p-shells with the ones of the corresponding Cartesian GTOs
+ */
+BOOST_AUTO_TEST_CASE ( cartesian_shells ) {
+
+    const GQCP::Nucleus nucleus (1, 0.1, -0.2, 0.3);
+    const std::vector<double> exponents {3.42525091, 0.62391373, 0.16885540};
+    const std::vector<double> coefficients {0.15432897, 0.53532814, 0.44463454};
+
+    const GQCP::GTOShell s_shell (0, nucleus, exponents, coefficients, false);
+    const GQCP::GTOShell p_shell (1, nucleus, exponents, coefficients, false);
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (GQCP::ShellSet<GQCP::GTOShell>({s_shell, p_shell}));
+
+    const auto points = testPoints();
+    const auto values = GQCP::GTOGridEvaluator(scalar_basis, 1.0e-12, 3).evaluate(points);  // use a block size that doesn't divide the number of points
+    BOOST_REQUIRE_EQUAL(values.rows(), 7);
+    BOOST_REQUIRE_EQUAL(values.cols(), 4);
+
+
+    // Construct the reference basis functions as linear combinations of (normalized) Cartesian GTOs
+    const std::vector<GQCP::CartesianExponents> cartesian_exponents {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (size_t mu = 0; mu < 4; mu++) {
+        for (size_t n = 0; n < 7; n++) {
+            const GQCP::Vector<double, 3> r = points.row(n).transpose();
+
+            double ref_value = 0.0;
+            for (size_t p = 0; p < exponents.size(); p++) {
+                ref_value += coefficients[p] * GQCP::CartesianGTO(exponents[p], cartesian_exponents[mu], nucleus.position())(r);
+            }
+
+            BOOST_CHECK(std::abs(values(n, mu) - ref_value) < 1.0e-12);
+        }
+    }
+}
+
+
+/**
+ *  Check the values of a spherical d-shell with the corresponding combinations of Cartesian components
+ */
+BOOST_AUTO_TEST_CASE ( spherical_d_shell ) {
+
+    const std::vector<double> exponents {1.2, 0.4};
+    const std::vector<double> coefficients {0.6, 0.5};
+
+    const GQCP::GTOShell cartesian_shell (2, GQCP::Nucleus(), exponents, coefficients, false);
+    const GQCP::GTOShell spherical_shell (2, GQCP::Nucleus(), exponents, coefficients, true);
+
+    const auto points = testPoints();
+    const auto cartesian = GQCP::GTOGridEvaluator(GQCP::ScalarBasis<GQCP::GTOShell>(GQCP::ShellSet<GQCP::GTOShell>({cartesian_shell}))).evaluate(points);  // xx, xy, xz, yy, yz, zz
+    const auto spherical = GQCP::GTOGridEvaluator(GQCP::ScalarBasis<GQCP::GTOShell>(GQCP::ShellSet<GQCP::GTOShell>({spherical_shell}))).evaluate(points);  // m = -2, ..., 2
+    BOOST_REQUIRE_EQUAL(spherical.cols(), 5);
+
+    // The Cartesian components all carry the normalization factor of the axis-aligned component
+    const double sqrt3 = std::sqrt(3.0);
+    for (size_t n = 0; n < 7; n++) {
+        BOOST_CHECK(std::abs(spherical(n, 0) - sqrt3 * cartesian(n, 1)) < 1.0e-12);  // xy
+        BOOST_CHECK(std::abs(spherical(n, 1) - sqrt3 * cartesian(n, 4)) < 1.0e-12);  // yz
+        BOOST_CHECK(std::abs(spherical(n, 2) - (cartesian(n, 5) - 0.5 * (cartesian(n, 0) + cartesian(n, 3)))) < 1.0e-12);  // 2z^2 - x^2 - y^2
+        BOOST_CHECK(std::abs(spherical(n, 3) - sqrt3 * cartesian(n, 2)) < 1.0e-12);  // xz
+        BOOST_CHECK(std::abs(spherical(n, 4) - 0.5 * sqrt3 * (cartesian(n, 0) - cartesian(n, 3))) < 1.0e-12);  // x^2 - y^2
+    }
+}
+
+
+/**
+ *  Check if the shell-wise screening only discards negligible values
+ */
+BOOST_AUTO_TEST_CASE ( screening ) {
+
+    const GQCP::GTOShell tight_shell (1, GQCP::Nucleus(1, 0.0, 0.0, 0.0), {15.0}, {1.0});
+    const GQCP::GTOShell diffuse_shell (0, GQCP::Nucleus(1, 0.0, 0.0, 1.0), {0.05}, {1.0});
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (GQCP::ShellSet<GQCP::GTOShell>({tight_shell, diffuse_shell}));
+
+    const double threshold = 1.0e-10;
+    const GQCP::GTOGridEvaluator evaluator (scalar_basis, threshold, 1);
+    const GQCP::GTOGridEvaluator reference_evaluator (scalar_basis, 1.0e-300);  // effectively no screening
+    BOOST_CHECK(evaluator.cutoffRadius(0) < evaluator.cutoffRadius(1));
+
+    // Points on a line through both centers
+    GQCP::MatrixX<double> points = GQCP::MatrixX<double>::Zero(50, 3);
+    for (size_t n = 0; n < 50; n++) {
+        points(n, 2) = -5.0 + 0.3 * n;
+        points(n, 0) = 0.1;
+    }
+
+    const auto values = evaluator.evaluate(points);
+    const auto ref_values = reference_evaluator.evaluate(points);
+    BOOST_CHECK(values.isApprox(ref_values, 1.0e-08) || (values - ref_values).cwiseAbs().maxCoeff() < threshold);
+
+    // The tight shell should have been screened away at the points that are far from its center
+    BOOST_CHECK_EQUAL(values(0, 0), 0.0);
+    BOOST_CHECK(std::abs(values(0, 3)) > 0.0);
+}
+
+
+/**
+ *  Check if the density is consistent with the values of the orbitals
+ */
+BOOST_AUTO_TEST_CASE ( orbitals_and_density ) {
+
+    const GQCP::GTOShell s_shell (0, GQCP::Nucleus(1, 0.0, 0.0, -0.7), {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454});
+    const GQCP::GTOShell s_shell2 (0, GQCP::Nucleus(1, 0.0, 0.0, 0.7), {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454});
+    const GQCP::GTOShell p_shell (1, GQCP::Nucleus(1, 0.0, 0.0, 0.7), {0.8}, {1.0});
+    const GQCP::GTOGridEvaluator evaluator (GQCP::ScalarBasis<GQCP::GTOShell>(GQCP::ShellSet<GQCP::GTOShell>({s_shell, s_shell2, p_shell})));
+    BOOST_REQUIRE_EQUAL(evaluator.numberOfBasisFunctions(), 5);
+
+    GQCP::MatrixX<double> C (5, 2);
+    C << 0.5,  0.6,
+         0.5, -0.6,
+         0.0,  0.1,
+         0.1,  0.0,
+         0.2,  0.3;
+    const GQCP::SquareMatrix<double> D = 2 * C * C.transpose();  // two doubly-occupied orbitals
+
+    const auto points = testPoints();
+    const auto orbital_values = evaluator.evaluateOrbitals(points, C);
+    const auto density = evaluator.evaluateDensity(points, D);
+
+    const GQCP::VectorX<double> ref_density = 2 * orbital_values.rowwise().squaredNorm();
+    BOOST_CHECK(density.isApprox(ref_density, 1.0e-12));
+
+    BOOST_CHECK_THROW(evaluator.evaluateOrbitals(points, GQCP::MatrixX<double>::Zero(4, 2)), std::invalid_argument);
+    BOOST_CHECK_THROW(evaluator.evaluateDensity(points, GQCP::SquareMatrix<double>::Zero(4, 4)), std::invalid_argument);
+}
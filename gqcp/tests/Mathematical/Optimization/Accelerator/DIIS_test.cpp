@@ -0,0 +1,81 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "DIIS"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mathematical/Optimization/Accelerator/DIIS.hpp"
+
+
+/**
+ *  Check if the DIIS coefficients that are calculated from an incrementally updated B matrix are equal to the ones that are calculated from scratch, when the errors form a sliding window that is identified by the index of its first error.
+ */
+BOOST_AUTO_TEST_CASE ( incremental_B_matrix ) {
+
+    const size_t maximum_subspace_dimension = 4;
+    std::vector<GQCP::VectorX<double>> all_errors;
+    for (size_t i = 0; i < 10; i++) {
+        all_errors.push_back(GQCP::VectorX<double>::Random(7));
+    }
+
+
+    GQCP::DIIS<double> incremental_diis;
+    for (size_t n = 2; n <= all_errors.size(); n++) {
+
+        // Use the most recent errors, as in an SCF procedure
+        const auto subspace_dimension = std::min(maximum_subspace_dimension, n);
+        const std::vector<GQCP::VectorX<double>> errors (all_errors.begin() + n - subspace_dimension, all_errors.begin() + n);
+
+        const auto incremental_coefficients = incremental_diis.calculateDIISCoefficients(errors, n - subspace_dimension);
+        const auto ref_coefficients = GQCP::DIIS<double>().calculateDIISCoefficients(errors);
+
+        BOOST_CHECK(incremental_coefficients.isApprox(ref_coefficients, 1.0e-12));
+    }
+
+
+    // Check that a window that moved backwards is handled correctly
+    const std::vector<GQCP::VectorX<double>> errors (all_errors.begin(), all_errors.begin() + 3);
+    BOOST_CHECK(incremental_diis.calculateDIISCoefficients(errors, 0).isApprox(GQCP::DIIS<double>().calculateDIISCoefficients(errors), 1.0e-12));
+
+    // Check that a restarted sequence of errors, whose indices overlap with the previous window, is detected
+    std::vector<GQCP::VectorX<double>> restarted_errors;
+    for (size_t i = 0; i < 3; i++) {
+        restarted_errors.push_back(GQCP::VectorX<double>::Random(7));
+    }
+    BOOST_CHECK(incremental_diis.calculateDIISCoefficients(restarted_errors, 1).isApprox(GQCP::DIIS<double>().calculateDIISCoefficients(restarted_errors), 1.0e-12));
+}
+
+
+/**
+ *  Check if a const DIIS accelerator can accelerate subjects, and if the accelerated subject is the linear combination of the subjects with the DIIS coefficients
+ */
+BOOST_AUTO_TEST_CASE ( accelerate_const ) {
+
+    std::vector<GQCP::VectorX<double>> errors;
+    std::vector<GQCP::MatrixX<double>> subjects;
+    for (size_t i = 0; i < 3; i++) {
+        errors.push_back(GQCP::VectorX<double>::Random(5));
+        subjects.push_back(GQCP::MatrixX<double>::Random(2, 2));
+    }
+
+    const GQCP::DIIS<double> diis;
+    const auto coefficients = diis.calculateDIISCoefficients(errors);
+    const GQCP::MatrixX<double> ref_subject = coefficients(0) * subjects[0] + coefficients(1) * subjects[1] + coefficients(2) * subjects[2];
+
+    BOOST_CHECK(diis.accelerate(subjects, errors).isApprox(ref_subject, 1.0e-12));
+}
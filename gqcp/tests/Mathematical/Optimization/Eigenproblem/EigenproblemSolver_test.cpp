@@ -23,6 +23,9 @@
 #include "Mathematical/Optimization/Eigenproblem/Davidson/DavidsonSolver.hpp"
 #include "Utilities/linalg.hpp"
 
+#include <cstdio>
+#include <vector>
+
 
 
 
@@ -58,7 +61,7 @@ BOOST_AUTO_TEST_CASE ( dense ) {
 
 
     // Use our dense diagonalization algorithm to find the number of requested eigenpairs
-    auto dense_environment = GQCP::EigenproblemEnvironment::Dense(B);
+    auto dense_environment = GQCP::EigenproblemEnvironment<double>::Dense(B);
     auto dense_diagonalizer = GQCP::EigenproblemSolver::Dense();
     dense_diagonalizer.perform(dense_environment);
 
@@ -98,7 +101,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_ESQC_example_solver ) {
     // Solve using the Davidson diagonalization, supplying an initial guess
     GQCP::VectorX<double> x_0 (5);
     x_0 << 1, 0, 0, 0, 0;
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, x_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson();  // the default is finding only the eigenpair with the lowest eigenvalue
     davidson_solver.perform(davidson_environment);
 
@@ -139,7 +142,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_50 ) {
     GQCP::VectorX<double> x_0 = GQCP::VectorX<double>::Zero(N);
     x_0(0) = 1;
 
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, x_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson();  // the default is finding only the eigenpair with the lowest eigenvalue
     davidson_solver.perform(davidson_environment);
 
@@ -183,7 +186,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_50_collapse ) {
     GQCP::VectorX<double> x_0 = GQCP::VectorX<double>::Zero(N);
     x_0(0) = 1;
 
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, x_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson(1, 10);  // number_of_requested_eigenpairs=1, maximum_subspace_dimension=10
     davidson_solver.perform(davidson_environment);
 
@@ -226,7 +229,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_50_number_of_requested_eigenpairs ) {
     // Solve using our Davidson diagonalization algorithm, supplying a number of initial guesses
     const GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
 
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, X_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, X_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson(3);  // number_of_requested_eigenpairs=3, 
     davidson_solver.perform(davidson_environment);
 
@@ -265,7 +268,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_1000 ) {
     // Solve using our Davidson diagonalization algorithm, supplying an initial guess
     GQCP::VectorX<double> x_0 = GQCP::VectorX<double>::Zero(N);
     x_0(0) = 1;
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, x_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson();  // the default is finding only the eigenpair with the lowest eigenvalue
     davidson_solver.perform(davidson_environment);
 
@@ -308,7 +311,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_1000_collapse ) {
     GQCP::VectorX<double> x_0 = GQCP::VectorX<double>::Zero(N);
     x_0(0) = 1;
 
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, x_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson(1, 10);  // number_of_requested_eigenpairs=1, maximum_subspace_dimension=10
     davidson_solver.perform(davidson_environment);
 
@@ -352,7 +355,7 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_1000_number_of_requested_eigenpairs ) {
     // Solve using our Davidson diagonalization algorithm, supplying a number of initial guesses
     const GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
 
-    auto davidson_environment = GQCP::EigenproblemEnvironment::Iterative(A, X_0);
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, X_0);
     auto davidson_solver = GQCP::EigenproblemSolver::Davidson(3, 10);  // number_of_requested_eigenpairs=3
     davidson_solver.perform(davidson_environment);
 
@@ -363,3 +366,223 @@ BOOST_AUTO_TEST_CASE ( Davidson_Liu_1000_number_of_requested_eigenpairs ) {
         BOOST_CHECK(std::abs(davidson_environment.eigenvectors.col(i).norm() - 1) < 1.0e-12);
     }
 }
+
+
+/**
+ *  Check if a Davidson diagonalization that was interrupted (because it ran out of iterations) can be continued from its checkpoint file, using Liu's reference test (Liu1975).
+ */
+BOOST_AUTO_TEST_CASE ( Davidson_Liu_50_checkpoint_restart ) {
+
+    // Build up the example matrix
+    const size_t N = 50;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Ones(N, N);
+    for (size_t i = 0; i < N; i++) {
+        if (i < 5) {
+            A(i, i) = 1 + 0.1 * i;
+        } else {
+            A(i, i) = 2 * (i + 1) - 1;
+        }
+    }
+
+
+    // Solve the eigenvalue problem with Eigen
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);
+    const double ref_lowest_eigenvalue = eigensolver.eigenvalues()(0);
+    const GQCP::VectorX<double> ref_lowest_eigenvector = eigensolver.eigenvectors().col(0);
+
+
+    // Let a Davidson diagonalization run out of iterations, while writing a checkpoint after every iteration. This diagonalization requires 12 iterations to converge.
+    const std::string checkpoint_filename = "Davidson_Liu_50.chk";
+
+    GQCP::VectorX<double> x_0 = GQCP::VectorX<double>::Zero(N);
+    x_0(0) = 1;
+
+    auto interrupted_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, x_0);
+    auto interrupted_solver = GQCP::EigenproblemSolver::Davidson(1, 15, 1.0e-08, 1.0e-12, 5, 1.0e-03, checkpoint_filename);  // maximum_number_of_iterations=5
+    BOOST_CHECK_THROW(interrupted_solver.perform(interrupted_environment), std::runtime_error);
+
+
+    // Check that the checkpoint restores the state of the interrupted diagonalization.
+    const auto diagonal = A.diagonal();
+    const auto matvec = [&A] (const GQCP::VectorX<double>& x) { return A * x; };
+    auto restarted_environment = GQCP::EigenproblemEnvironment<double>::Iterative(matvec, diagonal, checkpoint_filename);
+
+    BOOST_CHECK(restarted_environment.V.isApprox(interrupted_environment.V, 1.0e-12));
+    BOOST_CHECK(restarted_environment.VA.isApprox(interrupted_environment.VA, 1.0e-12));
+    BOOST_CHECK(restarted_environment.X.isApprox(interrupted_environment.X, 1.0e-12));
+    BOOST_CHECK(restarted_environment.Lambda.isApprox(interrupted_environment.Lambda, 1.0e-12));
+
+
+    // Continue the diagonalization from the checkpoint and check the results.
+    auto davidson_solver = GQCP::EigenproblemSolver::Davidson(1, 15, 1.0e-08, 1.0e-12, 10);  // maximum_number_of_iterations=10: fewer than the 12 iterations needed for a diagonalization from scratch
+    davidson_solver.perform(restarted_environment);
+
+    const double test_lowest_eigenvalue = restarted_environment.eigenvalues(0);
+    const GQCP::VectorX<double> test_lowest_eigenvector = restarted_environment.eigenvectors.col(0);
+
+    BOOST_CHECK(std::abs(test_lowest_eigenvalue - ref_lowest_eigenvalue) < 1.0e-08);
+    BOOST_CHECK(GQCP::areEqualEigenvectors(test_lowest_eigenvector, ref_lowest_eigenvector, 1.0e-08));
+
+
+    // Check that a checkpoint for a problem with a different dimension is rejected.
+    const auto small_diagonal = GQCP::VectorX<double>::Ones(N - 1);
+    BOOST_CHECK_THROW(GQCP::EigenproblemEnvironment<double>::Iterative(matvec, small_diagonal, checkpoint_filename), std::invalid_argument);
+
+    std::remove(checkpoint_filename.c_str());
+}
+
+
+/**
+ *  Check if the mixed-precision Davidson algorithm, which performs its first iterations in single precision, converges to the double-precision results for Liu's reference test (Liu1975) with large dimensions.
+ */
+BOOST_AUTO_TEST_CASE ( MixedPrecisionDavidson_Liu_1000_number_of_requested_eigenpairs ) {
+
+    const size_t number_of_requested_eigenpairs = 3;
+
+    // Build up the example matrix
+    const size_t N = 1000;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Ones(N, N);
+    for (size_t i = 0; i < N; i++) {
+        if (i < 5) {
+            A(i, i) = 1 + 0.1 * i;
+        } else {
+            A(i, i) = 2 * (i + 1) - 1;
+        }
+    }
+
+
+    // Solve the eigenvalue problem with Eigen
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);
+    const GQCP::VectorX<double> ref_lowest_eigenvalues = eigensolver.eigenvalues().head(number_of_requested_eigenpairs);
+    const GQCP::MatrixX<double> ref_lowest_eigenvectors = eigensolver.eigenvectors().topLeftCorner(N, number_of_requested_eigenpairs);
+
+
+    // Solve using the mixed-precision Davidson diagonalization algorithm, supplying a number of initial guesses
+    const GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
+
+    auto davidson_environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, X_0);
+    auto davidson_solver = GQCP::EigenproblemSolver::MixedPrecisionDavidson(3, 10);  // number_of_requested_eigenpairs=3, maximum_subspace_dimension=10
+    BOOST_CHECK_THROW(davidson_solver.perform(davidson_environment), std::invalid_argument);  // no single-precision matrix-vector product is provided
+
+    const GQCP::SquareMatrix<float> A_single = A.cast<float>();
+    davidson_environment.single_precision_matrix_vector_product_function = [&A_single] (const GQCP::VectorX<float>& x) { return A_single * x; };
+    davidson_solver.perform(davidson_environment);
+
+
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        BOOST_CHECK(std::abs(davidson_environment.eigenvalues(i) - ref_lowest_eigenvalues(i)) < 1.0e-08);
+        BOOST_CHECK(GQCP::areEqualEigenvectors(davidson_environment.eigenvectors.col(i), ref_lowest_eigenvectors.col(i), 1.0e-08));
+        BOOST_CHECK(std::abs(davidson_environment.eigenvectors.col(i).norm() - 1) < 1.0e-12);
+    }
+
+
+    // Check that a purely single-precision Davidson diagonalization finds the eigenvalues up to single precision.
+    auto single_precision_environment = GQCP::EigenproblemEnvironment<float>::Iterative(A_single, X_0.cast<float>());
+    auto single_precision_solver = GQCP::EigenproblemSolver::Davidson<float>(3, 10, 1.0e-04);  // convergence_threshold=1.0e-04
+    single_precision_solver.perform(single_precision_environment);
+
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        BOOST_CHECK_SMALL(std::abs(single_precision_environment.eigenvalues(i) - ref_lowest_eigenvalues(i)), 1.0e-04);
+    }
+}
+
+
+/**
+ *  Check if the preconditioners keep the sign of denominators that are replaced by the correction threshold.
+ */
+BOOST_AUTO_TEST_CASE ( preconditioner_denominator_sign ) {
+
+    // Set up a state in which the first denominator (1 - lambda) is a tiny negative number.
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Zero(2, 2);
+    A << 1.0, 0.0,
+         0.0, 2.0;
+
+    auto environment = GQCP::EigenproblemEnvironment<double>::Iterative(A, GQCP::MatrixX<double>::Identity(2, 1));
+    environment.Lambda = GQCP::VectorX<double>::Constant(1, 1.0 + 1.0e-14);
+    environment.X = GQCP::MatrixX<double>::Zero(2, 1);
+    environment.X(1, 0) = 1.0;
+    environment.R = GQCP::MatrixX<double>::Zero(2, 1);
+    environment.R(0, 0) = 1.0;
+
+
+    // Dividing the residual by the (negative) denominator should produce a negative correction.
+    GQCP::OlsenCorrectionVectorCalculation<double> olsen_correction (1, 1.0e-12);
+    olsen_correction.execute(environment);
+    BOOST_CHECK(environment.Delta(0, 0) < 0.0);
+
+    GQCP::ReferenceSpaceCorrectionVectorCalculation<double> reference_space_correction (1, 1, 1.0e-12);  // a reference space of only the first basis vector
+    reference_space_correction.execute(environment);
+    BOOST_CHECK(environment.Delta(0, 0) < 0.0);
+}
+
+
+/**
+ *  Check if the Davidson algorithm with Olsen's correction and with the reference space preconditioner finds the correct results for Liu's reference test (Liu1975) with large dimensions. The reference space preconditioner should need fewer iterations and fewer matrix-vector products than the diagonal preconditioner.
+ */
+BOOST_AUTO_TEST_CASE ( Davidson_Liu_1000_preconditioners ) {
+
+    const size_t number_of_requested_eigenpairs = 1;
+
+    // Build up the example matrix
+    const size_t N = 1000;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Ones(N, N);
+    for (size_t i = 0; i < N; i++) {
+        if (i < 5) {
+            A(i, i) = 1 + 0.1 * i;
+        } else {
+            A(i, i) = 2 * (i + 1) - 1;
+        }
+    }
+
+
+    // Solve the eigenvalue problem with Eigen
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);
+    const GQCP::VectorX<double> ref_lowest_eigenvalues = eigensolver.eigenvalues().head(number_of_requested_eigenpairs);
+    const GQCP::MatrixX<double> ref_lowest_eigenvectors = eigensolver.eigenvectors().topLeftCorner(N, number_of_requested_eigenpairs);
+
+
+    // Solve the eigenvalue problem with the different preconditioners. The matrix is only accessed through matrix-vector products (which are counted) and matrix elements.
+    const GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
+    size_t number_of_matvecs = 0;
+    const auto matvec = [&A, &number_of_matvecs] (const GQCP::VectorX<double>& x) { number_of_matvecs++; return A * x; };
+    const auto matrix_element = [&A] (const size_t i, const size_t j) { return A(i,j); };
+    const GQCP::VectorX<double> diagonal = A.diagonal();
+
+    auto diagonal_environment = GQCP::EigenproblemEnvironment<double>::Iterative(matvec, diagonal, X_0);
+    auto diagonal_solver = GQCP::EigenproblemSolver::Davidson(number_of_requested_eigenpairs);
+    diagonal_solver.perform(diagonal_environment);
+    const auto diagonal_number_of_matvecs = number_of_matvecs;
+
+    auto olsen_environment = GQCP::EigenproblemEnvironment<double>::Iterative(matvec, diagonal, X_0);
+    auto olsen_solver = GQCP::EigenproblemSolver::Davidson(GQCP::OlsenCorrectionVectorCalculation<double>(number_of_requested_eigenpairs), number_of_requested_eigenpairs);
+    olsen_solver.perform(olsen_environment);
+
+    // The reference space block is set up from the matrix elements, so it can't be used when only matrix-vector products are provided.
+    auto matvec_only_environment = GQCP::EigenproblemEnvironment<double>::Iterative(matvec, diagonal, X_0);
+    auto matvec_only_solver = GQCP::EigenproblemSolver::Davidson(GQCP::ReferenceSpaceCorrectionVectorCalculation<double>(number_of_requested_eigenpairs), number_of_requested_eigenpairs);
+    BOOST_CHECK_THROW(matvec_only_solver.perform(matvec_only_environment), std::invalid_argument);
+
+    std::vector<GQCP::EigenproblemEnvironment<double>> reference_space_environments;
+    for (const size_t reference_space_dimension : {20, 100}) {
+        auto reference_space_environment = GQCP::EigenproblemEnvironment<double>::Iterative(matvec, diagonal, X_0);
+        reference_space_environment.matrix_element_function = matrix_element;
+        auto reference_space_solver = GQCP::EigenproblemSolver::Davidson(GQCP::ReferenceSpaceCorrectionVectorCalculation<double>(number_of_requested_eigenpairs, reference_space_dimension), number_of_requested_eigenpairs);
+
+        number_of_matvecs = 0;
+        reference_space_solver.perform(reference_space_environment);
+
+        BOOST_CHECK(reference_space_solver.numberOfIterations() < diagonal_solver.numberOfIterations());
+        BOOST_CHECK(number_of_matvecs < diagonal_number_of_matvecs);
+        reference_space_environments.push_back(reference_space_environment);
+    }
+
+
+    for (const auto& environment : {olsen_environment, reference_space_environments[0], reference_space_environments[1]}) {
+        for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+            BOOST_CHECK(std::abs(environment.eigenvalues(i) - ref_lowest_eigenvalues(i)) < 1.0e-08);
+            BOOST_CHECK(GQCP::areEqualEigenvectors(environment.eigenvectors.col(i), ref_lowest_eigenvectors.col(i), 1.0e-08));
+        }
+    }
+
+    BOOST_CHECK(olsen_solver.numberOfIterations() <= diagonal_solver.numberOfIterations());
+}
@@ -91,3 +91,78 @@ BOOST_AUTO_TEST_CASE ( nl_syseq_example ) {
 
     BOOST_CHECK(solution.isZero(1.0e-08));  // the analytical solution of f(x) = (0,0) is x=(0,0)
 }
+
+
+/**
+ *  Implement a vector function with a non-singular Jacobian at its root x=(2,3): (x0^2 - 4, x0 x1 - 6)
+ */
+GQCP::VectorX<double> g(const GQCP::VectorX<double>& x) {
+
+    GQCP::VectorX<double> g (2);
+
+    g << x(0) * x(0) - 4,
+         x(0) * x(1) - 6;
+
+    return g;
+}
+
+
+/**
+ *  Implement the Jacobian of the previous function
+ */
+GQCP::SquareMatrix<double> J_g(const GQCP::VectorX<double>& x) {
+
+    GQCP::SquareMatrix<double> J (2);
+
+    J << 2 * x(0), 0,
+         x(1),     x(0);
+
+    return J;
+}
+
+
+/**
+ *  Check the solution of a non-linear system of equations through the Jacobian-free Newton-Krylov solver.
+ */
+BOOST_AUTO_TEST_CASE ( nl_syseq_newton_krylov ) {
+
+    GQCP::VectorX<double> x (2);
+    x << 1.5, 2.5;
+
+    GQCP::VectorX<double> ref_solution (2);
+    ref_solution << 2, 3;
+
+
+    // The Newton-Krylov solver should not need the Jacobian.
+    const GQCP::MatrixFunction<double> no_jacobian = [] (const GQCP::VectorX<double>& x) -> GQCP::MatrixX<double> {
+        throw std::logic_error("The Jacobian should not be evaluated.");
+    };
+
+    GQCP::NonLinearEquationEnvironment<double> non_linear_environment (x, g, no_jacobian);
+    auto non_linear_solver = GQCP::NonLinearEquationSolver<double>::NewtonKrylov(1.0e-10, 128, 1.0e-08);
+    non_linear_solver.perform(non_linear_environment);
+    const auto& solution = non_linear_environment.variables.back();
+
+    BOOST_CHECK(solution.isApprox(ref_solution, 1.0e-06));
+}
+
+
+/**
+ *  Check the solution of a non-linear system of equations through the Broyden solver.
+ */
+BOOST_AUTO_TEST_CASE ( nl_syseq_broyden ) {
+
+    GQCP::VectorX<double> x (2);
+    x << 1.5, 2.5;
+
+    GQCP::VectorX<double> ref_solution (2);
+    ref_solution << 2, 3;
+
+
+    GQCP::NonLinearEquationEnvironment<double> non_linear_environment (x, g, J_g);
+    auto non_linear_solver = GQCP::NonLinearEquationSolver<double>::Broyden(1.0e-10);
+    non_linear_solver.perform(non_linear_environment);
+    const auto& solution = non_linear_environment.variables.back();
+
+    BOOST_CHECK(solution.isApprox(ref_solution, 1.0e-06));
+}
@@ -0,0 +1,138 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "MemoryMappedRankFourTensor"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+
+#include <cstdio>
+
+
+/**
+ *  Check if the memory-mapped storage reproduces the elements of a tensor in memory, also after it has been reopened.
+ */
+BOOST_AUTO_TEST_CASE ( FromTensor_Open ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.get_dim();
+
+    {
+        const auto g_mapped = GQCP::MemoryMappedRankFourTensor::FromTensor("g_mapped.bin", g);
+        BOOST_CHECK(g_mapped.dimension() == K);
+        BOOST_CHECK(g_mapped.numberOfPairs() == K * (K + 1) / 2);
+        BOOST_CHECK(g_mapped.toTensor().isApprox(g, 1.0e-12));
+    }
+
+    auto g_reopened = GQCP::MemoryMappedRankFourTensor::Open("g_mapped.bin");
+    BOOST_CHECK(g_reopened.isReadOnly());
+    BOOST_CHECK(g_reopened.toTensor().isApprox(g, 1.0e-12));
+    BOOST_CHECK_THROW(g_reopened(0,0,0,0) = 1.0, std::logic_error);
+
+    std::remove("g_mapped.bin");
+}
+
+
+/**
+ *  Check if the Coulomb and exchange matrices and the full contraction match the ones that are calculated in memory.
+ */
+BOOST_AUTO_TEST_CASE ( contractions ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.get_dim();
+
+    const auto g_mapped = GQCP::MemoryMappedRankFourTensor::FromTensor("g_mapped.bin", g);
+
+    const GQCP::SquareMatrix<double> D = GQCP::SquareMatrix<double>::Random(K, K);  // not symmetric, to check that the folding is correct
+    GQCP::SquareMatrix<double> J_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    GQCP::SquareMatrix<double> K_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    J_ref(p,q) += g(p,q,r,s) * D(s,r);
+                    K_ref(p,s) += g(p,q,r,s) * D(q,r);
+                }
+            }
+        }
+    }
+    BOOST_CHECK(g_mapped.calculateCoulombMatrix(D).isApprox(J_ref, 1.0e-12));
+    BOOST_CHECK(g_mapped.calculateExchangeMatrix(D).isApprox(K_ref, 1.0e-12));
+
+    GQCP::SquareRankFourTensor<double> d (K);
+    d.setRandom();
+    double contraction_ref = 0.0;
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    contraction_ref += g(p,q,r,s) * d(p,q,r,s);
+                }
+            }
+        }
+    }
+    BOOST_CHECK(std::abs(g_mapped.contract(d) - contraction_ref) < 1.0e-10);
+
+    std::remove("g_mapped.bin");
+}
+
+
+/**
+ *  Check if the out-of-core basis transformation matches the in-memory one, also for a rectangular coefficient matrix and for tiles that are smaller than the number of columns.
+ */
+BOOST_AUTO_TEST_CASE ( transformed ) {
+
+    auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const auto g_mapped = GQCP::MemoryMappedRankFourTensor::FromTensor("g_mapped.bin", sq_hamiltonian.twoElectron().parameters());
+
+    GQCP::TransformationMatrix<double> T (K);
+    T.setRandom();
+
+    // Use a tile that only contains one column
+    const auto g_transformed = g_mapped.transformed("g_transformed.bin", T, 0);
+    sq_hamiltonian.transform(T);
+    BOOST_CHECK(g_transformed.toTensor().isApprox(sq_hamiltonian.twoElectron().parameters(), 1.0e-10));
+
+
+    // Transform to the first few functions only
+    const size_t K_active = 4;
+    const GQCP::MatrixX<double> C = T.leftCols(K_active);
+    const auto g_active = g_mapped.transformed("g_active.bin", C);
+    BOOST_CHECK(g_active.dimension() == K_active);
+
+    const auto g_full = g_mapped.transformed("g_full.bin", T);
+    for (size_t i = 0; i < K_active; i++) {
+        for (size_t j = 0; j < K_active; j++) {
+            for (size_t k = 0; k < K_active; k++) {
+                for (size_t l = 0; l < K_active; l++) {
+                    BOOST_CHECK(std::abs(g_active(i,j,k,l) - g_full(i,j,k,l)) < 1.0e-10);
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(g_mapped.transformed("g_transformed.bin", GQCP::MatrixX<double>::Identity(K + 1, K)), std::invalid_argument);
+
+    for (const auto& filename : {"g_mapped.bin", "g_transformed.bin", "g_active.bin", "g_full.bin"}) {
+        std::remove(filename);
+    }
+}
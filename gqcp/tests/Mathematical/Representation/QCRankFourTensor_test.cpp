@@ -53,6 +53,67 @@ BOOST_AUTO_TEST_CASE ( QCRankFourTensor_basisTransformInPlace_trivial ) {
 }
 
 
+/**
+ *  Check if an in-place transformation writes into the existing storage, so that views on the tensor's data remain valid
+ */
+BOOST_AUTO_TEST_CASE ( QCRankFourTensor_basisTransformInPlace_storage ) {
+
+    const size_t dim = 4;
+    GQCP::QCRankFourTensor<double> g (dim);
+    g.setRandom();
+
+    GQCP::TransformationMatrix<double> T (dim);
+    T.setRandom();
+    const auto ref_g_transformed = g.transformed(T);
+
+    const double* data = g.data();
+    g.basisTransformInPlace(T);
+
+    BOOST_CHECK(g.data() == data);
+    BOOST_CHECK(g.isApprox(ref_g_transformed, 1.0e-12));
+}
+
+
+/**
+ *  Check the quarter-by-quarter transformation against a straightforward implementation, for a coefficient matrix that only transforms to a subset of the orbitals
+ */
+BOOST_AUTO_TEST_CASE ( QCRankFourTensor_transformed_rectangular ) {
+
+    const size_t K = 5;
+    const size_t K_new = 3;
+
+    GQCP::QCRankFourTensor<double> g (K);
+    g.setRandom();
+    const GQCP::MatrixX<double> C = GQCP::MatrixX<double>::Random(K, K_new);
+
+    GQCP::QCRankFourTensor<double> g_ref (K_new);
+    g_ref.setZero();
+    for (size_t P = 0; P < K_new; P++) {
+        for (size_t Q = 0; Q < K_new; Q++) {
+            for (size_t R = 0; R < K_new; R++) {
+                for (size_t S = 0; S < K_new; S++) {
+                    for (size_t p = 0; p < K; p++) {
+                        for (size_t q = 0; q < K; q++) {
+                            for (size_t r = 0; r < K; r++) {
+                                for (size_t s = 0; s < K; s++) {
+                                    g_ref(P,Q,R,S) += C(p,P) * C(q,Q) * C(r,R) * C(s,S) * g(p,q,r,s);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const auto g_transformed = g.transformed(C);
+    BOOST_CHECK(g_transformed.dimension() == K_new);
+    BOOST_CHECK(g_transformed.isApprox(g_ref, 1.0e-12));
+
+    BOOST_CHECK_THROW(g.transformed(GQCP::MatrixX<double>::Random(K + 1, K_new)), std::invalid_argument);
+}
+
+
 /**
  *  Check the basis transformation formula using an other implementation (the old olsens code) from Ayers' Lab
  */
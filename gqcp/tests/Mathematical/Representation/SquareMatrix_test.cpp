@@ -181,6 +181,31 @@ BOOST_AUTO_TEST_CASE ( permanent_ryser ) {
 }
 
 
+BOOST_AUTO_TEST_CASE ( permanent_glynn ) {
+
+    GQCP::SquareMatrix<double> A (2);
+    A << 2, 3,
+         9, 1;
+    BOOST_CHECK(std::abs(A.permanent_glynn() - 29.0) < 1.0e-12);
+
+
+    GQCP::SquareMatrix<double> B (3);
+    B << 1,  2, -3,
+         4, -5,  6,
+         7, -8,  9;
+    BOOST_CHECK(std::abs(B.permanent_glynn() - 264.0) < 1.0e-12);
+
+
+    GQCP::SquareMatrix<double> C = GQCP::SquareMatrix<double>::Random(5, 5);
+    BOOST_CHECK(std::abs(C.permanent_ryser() - C.permanent_glynn()) < 1.0e-12);
+
+
+    // Check a dimension for which the Gray codes are evaluated in chunks
+    GQCP::SquareMatrix<double> D = GQCP::SquareMatrix<double>::Random(14, 14);
+    BOOST_CHECK(std::abs(D.permanent_ryser() - D.permanent_glynn()) < 1.0e-08 * std::abs(D.permanent_ryser()));
+}
+
+
 BOOST_AUTO_TEST_CASE ( NoPivotLUDecomposition ) {
 
     // Reference data from https://stackoverflow.com/questions/41150997/perform-lu-decomposition-without-pivoting-in-matlab
@@ -0,0 +1,137 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "SymmetryPackedRankFourTensor"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCModel/HF/RHF.hpp"
+
+
+/**
+ *  Check if the packed storage only contains the symmetry-unique elements and reproduces the full tensor.
+ */
+BOOST_AUTO_TEST_CASE ( FromTensor_toTensor ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.get_dim();  // 7
+
+    const auto g_packed = GQCP::SymmetryPackedRankFourTensor::FromTensor(g);
+    BOOST_CHECK(g_packed.size() == 406);  // 28 pairs, so 28*29/2 unique elements
+    BOOST_CHECK(g_packed.toTensor().isApprox(g, 1.0e-12));
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    BOOST_CHECK(&g_packed(p,q,r,s) == &g_packed(s,r,q,p));
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ *  Check if reading a FCIDUMP file into packed storage gives the same two-electron integrals as reading it into a full tensor.
+ */
+BOOST_AUTO_TEST_CASE ( ReadFCIDUMP ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto g_packed = GQCP::SymmetryPackedRankFourTensor::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+
+    BOOST_CHECK(g_packed.dimension() == sq_hamiltonian.dimension());
+    BOOST_CHECK(g_packed.toTensor().isApprox(sq_hamiltonian.twoElectron().parameters(), 1.0e-12));
+}
+
+
+/**
+ *  Check if the Coulomb and exchange matrices, and the resulting RHF Fock matrix, match the ones that are calculated from the full tensor.
+ */
+BOOST_AUTO_TEST_CASE ( Fock_matrix ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.get_dim();
+    const auto g_packed = GQCP::SymmetryPackedRankFourTensor::FromTensor(g);
+
+    const GQCP::SquareMatrix<double> D = GQCP::SquareMatrix<double>::Random(K, K);  // not symmetric, to check that all symmetry-related elements are taken into account
+    GQCP::SquareMatrix<double> J_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    GQCP::SquareMatrix<double> K_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    J_ref(p,q) += g(p,q,r,s) * D(s,r);
+                    K_ref(p,s) += g(p,q,r,s) * D(q,r);
+                }
+            }
+        }
+    }
+    BOOST_CHECK(g_packed.calculateCoulombMatrix(D).isApprox(J_ref, 1.0e-12));
+    BOOST_CHECK(g_packed.calculateExchangeMatrix(D).isApprox(K_ref, 1.0e-12));
+
+    const GQCP::OneRDM<double> D_rhf = GQCP::QCModel::RHF<double>::calculateOrthonormalBasis1RDM(K, 10);
+    const auto F_ref = GQCP::QCModel::RHF<double>::calculateScalarBasisFockMatrix(D_rhf, sq_hamiltonian);
+    const auto F = GQCP::QCModel::RHF<double>::calculateScalarBasisFockMatrix(D_rhf, sq_hamiltonian.core().parameters(), g_packed);
+    BOOST_CHECK(F.parameters().isApprox(F_ref.parameters(), 1.0e-12));
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            BOOST_CHECK(std::abs(g_packed.coulombIntegrals()(p,q) - g(p,p,q,q)) < 1.0e-12);
+            BOOST_CHECK(std::abs(g_packed.exchangeIntegrals()(p,q) - g(p,q,q,p)) < 1.0e-12);
+        }
+    }
+}
+
+
+/**
+ *  Check if the packed basis transformation matches the full one, also for a rectangular coefficient matrix.
+ */
+BOOST_AUTO_TEST_CASE ( transformed ) {
+
+    auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const auto g_packed = GQCP::SymmetryPackedRankFourTensor::FromTensor(sq_hamiltonian.twoElectron().parameters());
+
+    GQCP::TransformationMatrix<double> T (K);
+    T.setRandom();
+
+    const auto g_transformed = g_packed.transformed(T);
+    sq_hamiltonian.transform(T);
+    const auto& g_ref = sq_hamiltonian.twoElectron().parameters();
+    BOOST_CHECK(g_transformed.toTensor().isApprox(g_ref, 1.0e-10));
+
+
+    const size_t K_active = 3;
+    const auto g_active = g_packed.transformed(T.leftCols(K_active));
+    BOOST_CHECK(g_active.dimension() == K_active);
+    for (size_t i = 0; i < K_active; i++) {
+        for (size_t j = 0; j < K_active; j++) {
+            for (size_t k = 0; k < K_active; k++) {
+                for (size_t l = 0; l < K_active; l++) {
+                    BOOST_CHECK(std::abs(g_active(i,j,k,l) - g_ref(i,j,k,l)) < 1.0e-10);
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(g_packed.transformed(GQCP::MatrixX<double>::Identity(K + 1, K)), std::invalid_argument);
+}
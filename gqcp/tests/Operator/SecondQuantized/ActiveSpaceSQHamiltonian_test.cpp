@@ -0,0 +1,109 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "ActiveSpaceSQHamiltonian"
+
+#include <boost/test/unit_test.hpp>
+
+#include "ONVBasis/BaseFrozenCoreONVBasis.hpp"
+#include "Operator/SecondQuantized/ActiveSpaceSQHamiltonian.hpp"
+
+
+/**
+ *  Check if the active-space Hamiltonian matches the 'frozen' Hamiltonian that is used in frozen-core CI calculations, and if the core energy is correct.
+ */
+BOOST_AUTO_TEST_CASE ( FromHamiltonian_frozen_core ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");  // in an orthonormal basis
+    const auto K = sq_hamiltonian.dimension();
+    const auto& h = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    const size_t N_core = 2;
+    const auto active_space_hamiltonian = GQCP::ActiveSpaceSQHamiltonian::FromHamiltonian(sq_hamiltonian, N_core, K - N_core);
+    const auto frozen_hamiltonian = GQCP::BaseFrozenCoreONVBasis::freezeOperator(sq_hamiltonian, N_core);
+
+    BOOST_CHECK(active_space_hamiltonian.numberOfCoreOrbitals() == N_core);
+    BOOST_CHECK(active_space_hamiltonian.numberOfActiveOrbitals() == K - N_core);
+    BOOST_CHECK(active_space_hamiltonian.activeHamiltonian().core().parameters().isApprox(frozen_hamiltonian.core().parameters(), 1.0e-12));
+    BOOST_CHECK(active_space_hamiltonian.activeHamiltonian().twoElectron().parameters().isApprox(frozen_hamiltonian.twoElectron().parameters(), 1.0e-12));
+
+    double core_energy_ref = 0.0;
+    for (size_t i = 0; i < N_core; i++) {
+        core_energy_ref += 2 * h(i,i);
+        for (size_t j = 0; j < N_core; j++) {
+            core_energy_ref += 2 * g(i,i,j,j) - g(i,j,j,i);
+        }
+    }
+    BOOST_CHECK(std::abs(active_space_hamiltonian.coreEnergy() - core_energy_ref) < 1.0e-12);
+}
+
+
+/**
+ *  Check if only the integrals over the active orbitals are kept when there are also (unoccupied) orbitals after the active space, and if invalid active spaces throw.
+ */
+BOOST_AUTO_TEST_CASE ( FromHamiltonian_truncated ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");  // in an orthonormal basis
+    const auto K = sq_hamiltonian.dimension();
+
+    const size_t N_core = 1;
+    const size_t N_active = 4;
+    const auto active_space_hamiltonian = GQCP::ActiveSpaceSQHamiltonian::FromHamiltonian(sq_hamiltonian, N_core, N_active);
+    const auto frozen_hamiltonian = GQCP::BaseFrozenCoreONVBasis::freezeOperator(sq_hamiltonian, N_core);
+
+    const auto& h_active = active_space_hamiltonian.activeHamiltonian().core().parameters();
+    const auto& g_active = active_space_hamiltonian.activeHamiltonian().twoElectron().parameters();
+    const auto& h_frozen = frozen_hamiltonian.core().parameters();
+    const auto& g_frozen = frozen_hamiltonian.twoElectron().parameters();
+
+    BOOST_CHECK(h_active.isApprox(h_frozen.topLeftCorner(N_active, N_active), 1.0e-12));
+    for (size_t t = 0; t < N_active; t++) {
+        for (size_t u = 0; u < N_active; u++) {
+            for (size_t v = 0; v < N_active; v++) {
+                for (size_t w = 0; w < N_active; w++) {
+                    BOOST_CHECK(std::abs(g_active(t,u,v,w) - g_frozen(t,u,v,w)) < 1.0e-12);
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(GQCP::ActiveSpaceSQHamiltonian::FromHamiltonian(sq_hamiltonian, N_core, K), std::invalid_argument);
+    BOOST_CHECK_THROW(GQCP::ActiveSpaceSQHamiltonian::FromHamiltonian(sq_hamiltonian, N_core, 0), std::invalid_argument);
+}
+
+
+/**
+ *  Check if constructing the molecular active-space Hamiltonian directly from the scalar basis integrals gives the same result as first constructing the Hamiltonian in all orbitals.
+ */
+BOOST_AUTO_TEST_CASE ( Molecular ) {
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    GQCP::RSpinorBasis<double, GQCP::GTOShell> spinor_basis (water, "STO-3G");
+    spinor_basis.lowdinOrthonormalize();
+
+    const size_t N_core = 1;
+    const size_t N_active = 5;
+    const auto active_space_hamiltonian = GQCP::ActiveSpaceSQHamiltonian::Molecular(spinor_basis, water, N_core, N_active);
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Molecular(spinor_basis, water);
+    const auto active_space_hamiltonian_ref = GQCP::ActiveSpaceSQHamiltonian::FromHamiltonian(sq_hamiltonian, N_core, N_active);
+
+    BOOST_CHECK(std::abs(active_space_hamiltonian.coreEnergy() - active_space_hamiltonian_ref.coreEnergy()) < 1.0e-10);
+    BOOST_CHECK(active_space_hamiltonian.activeHamiltonian().core().parameters().isApprox(active_space_hamiltonian_ref.activeHamiltonian().core().parameters(), 1.0e-10));
+    BOOST_CHECK(active_space_hamiltonian.activeHamiltonian().twoElectron().parameters().isApprox(active_space_hamiltonian_ref.activeHamiltonian().twoElectron().parameters(), 1.0e-10));
+}
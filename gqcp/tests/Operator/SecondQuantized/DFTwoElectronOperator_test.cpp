@@ -0,0 +1,163 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "DFTwoElectronOperator"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCModel/HF/RHF.hpp"
+
+
+namespace {
+
+/**
+ *  @param g        a two-electron integral tensor
+ * 
+ *  @return the density-fitted two-electron integrals in the 'complete' auxiliary basis that consists of all orbital products, for which the fit is exact
+ */
+GQCP::DFTwoElectronOperator completeFit(const GQCP::QCRankFourTensor<double>& g) {
+
+    const auto K = g.dimension();
+
+    // In this auxiliary basis, both the three-center integrals and the metric are given by the supermatrix M(pq,rs) = g(p,q,r,s), which is singular because M(pq,rs) = M(qp,rs)
+    const GQCP::MatrixX<double> M = Eigen::Map<const Eigen::MatrixXd>(g.data(), K * K, K * K);
+    return GQCP::DFTwoElectronOperator::FromThreeCenterIntegrals(M, GQCP::SquareMatrix<double>(M), K);
+}
+
+}  // namespace
+
+
+/**
+ *  Check if the fitted factors reproduce the two-electron integrals when the auxiliary basis is complete, and if the given factors are checked.
+ */
+BOOST_AUTO_TEST_CASE ( FromThreeCenterIntegrals ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.dimension();  // 7
+
+    const auto g_df = completeFit(g);
+    BOOST_CHECK(g_df.dimension() == K);
+    BOOST_CHECK(g_df.numberOfAuxiliaryBasisFunctions() == K * K);
+    BOOST_CHECK(g_df.toTensor().isApprox(g, 1.0e-08));
+    BOOST_CHECK(std::abs(g_df(0,1,2,3) - g(0,1,2,3)) < 1.0e-08);
+    BOOST_CHECK(g_df.factorMatrix(0).isApprox(g_df.factorMatrix(0).transpose(), 1.0e-12));
+
+    BOOST_CHECK_THROW(GQCP::DFTwoElectronOperator(GQCP::MatrixX<double>::Zero(K * K + 1, 3), K), std::invalid_argument);
+}
+
+
+/**
+ *  Check if the Coulomb and exchange matrices, and the resulting RHF Fock matrix, match the ones that are calculated from the full tensor.
+ */
+BOOST_AUTO_TEST_CASE ( Fock_matrix ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.dimension();
+    const auto g_df = completeFit(g);
+
+    const GQCP::SquareMatrix<double> D = GQCP::SquareMatrix<double>::Random(K, K);  // not symmetric, to check the order of the contractions
+    GQCP::SquareMatrix<double> J_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    GQCP::SquareMatrix<double> K_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    J_ref(p,q) += g(p,q,r,s) * D(s,r);
+                    K_ref(p,s) += g(p,q,r,s) * D(q,r);
+                }
+            }
+        }
+    }
+    BOOST_CHECK(g_df.calculateCoulombMatrix(D).isApprox(J_ref, 1.0e-08));
+    BOOST_CHECK(g_df.calculateExchangeMatrix(D).isApprox(K_ref, 1.0e-08));
+
+    const GQCP::OneRDM<double> D_rhf = GQCP::QCModel::RHF<double>::calculateOrthonormalBasis1RDM(K, 10);
+    const auto F_ref = GQCP::QCModel::RHF<double>::calculateScalarBasisFockMatrix(D_rhf, sq_hamiltonian);
+    const auto F = GQCP::QCModel::RHF<double>::calculateScalarBasisFockMatrix(D_rhf, sq_hamiltonian.core().parameters(), g_df);
+    BOOST_CHECK(F.parameters().isApprox(F_ref.parameters(), 1.0e-08));
+}
+
+
+/**
+ *  Check if transforming the fitted factors matches the transformation of the full tensor, also for rectangular coefficient matrices.
+ */
+BOOST_AUTO_TEST_CASE ( transformed ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.dimension();
+    const auto g_df = completeFit(g);
+
+    GQCP::TransformationMatrix<double> T (K);
+    T.setRandom();
+    const auto g_ref = g.transformed(T);
+    BOOST_CHECK(g_df.transformed(T).toTensor().isApprox(g_ref, 1.0e-08));
+
+
+    // The mixed factors (i a|P) over the first and last orbitals, which give the integrals (i a|j b)
+    const size_t n_occ = 3;
+    const size_t n_virt = K - n_occ;
+    const auto B_ov = g_df.transformedFactors(T.leftCols(n_occ), T.rightCols(n_virt));
+    BOOST_CHECK(static_cast<size_t>(B_ov.rows()) == n_occ * n_virt);
+    for (size_t i = 0; i < n_occ; i++) {
+        for (size_t a = 0; a < n_virt; a++) {
+            for (size_t j = 0; j < n_occ; j++) {
+                for (size_t b = 0; b < n_virt; b++) {
+                    const double value = B_ov.row(i + n_occ * a).dot(B_ov.row(j + n_occ * b));
+                    BOOST_CHECK(std::abs(value - g_ref(i, n_occ + a, j, n_occ + b)) < 1.0e-08 * (1.0 + std::abs(value)));
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(g_df.transformed(GQCP::MatrixX<double>::Identity(K + 1, K)), std::invalid_argument);
+}
+
+
+/**
+ *  Check if the pivoted Cholesky decomposition reproduces the two-electron integrals up to the requested tolerance, using fewer vectors for a looser tolerance.
+ */
+BOOST_AUTO_TEST_CASE ( Cholesky ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const auto K = g.dimension();
+
+    const auto g_tight = GQCP::DFTwoElectronOperator::Cholesky(g, 1.0e-10);
+    BOOST_CHECK(g_tight.numberOfAuxiliaryBasisFunctions() <= K * (K + 1) / 2);  // the number of unique pairs
+    BOOST_CHECK(g_tight.toSQTwoElectronOperator().parameters().isApprox(g, 1.0e-08));
+
+    // Every element of the remaining (positive semi-definite) supermatrix is bounded by its largest diagonal element
+    const double tolerance = 1.0e-03;
+    const auto g_loose = GQCP::DFTwoElectronOperator::Cholesky(g, tolerance);
+    BOOST_CHECK(g_loose.numberOfAuxiliaryBasisFunctions() < g_tight.numberOfAuxiliaryBasisFunctions());
+
+    const auto g_approximate = g_loose.toTensor();
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    BOOST_CHECK(std::abs(g_approximate(p,q,r,s) - g(p,q,r,s)) <= tolerance);
+                }
+            }
+        }
+    }
+}
@@ -26,6 +26,8 @@
 
 #include <boost/math/constants/constants.hpp>
 
+#include <cstdio>
+
 
 /*
  *  HELPER FUNCTIONS
@@ -219,6 +221,44 @@ BOOST_AUTO_TEST_CASE ( FCIDUMP_reader_HORTON ) {
 }
 
 
+/**
+ *  Check if writing a Hamiltonian to an FCIDUMP file and reading it in again reproduces the integrals.
+ */
+BOOST_AUTO_TEST_CASE ( FCIDUMP_writer ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/beh_cation_631g_caitlin.FCIDUMP");
+    sq_hamiltonian.writeFCIDUMP("beh_cation_631g_written.FCIDUMP", 4);
+
+    const auto sq_hamiltonian_written = GQCP::SQHamiltonian<double>::ReadFCIDUMP("beh_cation_631g_written.FCIDUMP");
+    BOOST_CHECK(sq_hamiltonian_written.core().parameters().isApprox(sq_hamiltonian.core().parameters(), 1.0e-12));
+    BOOST_CHECK(sq_hamiltonian_written.twoElectron().parameters().isApprox(sq_hamiltonian.twoElectron().parameters(), 1.0e-12));
+
+    std::remove("beh_cation_631g_written.FCIDUMP");
+}
+
+
+/**
+ *  Check if writing a Hamiltonian to a binary integral file and reading it in again reproduces the integrals exactly.
+ */
+BOOST_AUTO_TEST_CASE ( binary_integrals ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/beh_cation_631g_caitlin.FCIDUMP");
+    sq_hamiltonian.writeBinaryIntegrals("beh_cation_631g.bin");
+
+    const auto sq_hamiltonian_binary = GQCP::SQHamiltonian<double>::ReadBinaryIntegrals("beh_cation_631g.bin");
+    BOOST_CHECK(sq_hamiltonian_binary.core().parameters().isApprox(sq_hamiltonian.core().parameters(), 1.0e-15));
+    BOOST_CHECK(sq_hamiltonian_binary.twoElectron().parameters().isApprox(sq_hamiltonian.twoElectron().parameters(), 1.0e-15));
+
+    const auto integral_file = GQCP::BinaryIntegralFile::Open("beh_cation_631g.bin");
+    BOOST_CHECK(integral_file.dimension() == sq_hamiltonian.dimension());
+    BOOST_CHECK(integral_file.twoElectronIntegral(7,7,2,1) == sq_hamiltonian.twoElectron().parameters()(1,2,7,7));
+
+    std::remove("beh_cation_631g.bin");
+
+    BOOST_CHECK_THROW(GQCP::BinaryIntegralFile::Open("data/h2o.xyz"), std::invalid_argument);  // not a binary integral file
+}
+
+
 
 /*
  *  UNIT TESTS - METHODS
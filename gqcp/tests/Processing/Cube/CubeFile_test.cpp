@@ -0,0 +1,184 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "CubeFile"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Basis/ScalarBasis/GTOGridEvaluator.hpp"
+#include "Processing/Cube/CubeFile.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+
+namespace {
+
+
+/**
+ *  @return a restricted spinor basis for H2 with two s-type functions on every nucleus, and its molecule
+ */
+std::pair<GQCP::Molecule, GQCP::RSpinorBasis<double, GQCP::GTOShell>> h2System() {
+
+    const GQCP::Nucleus left (1, 0.0, 0.0, -0.7);
+    const GQCP::Nucleus right (1, 0.0, 0.0, 0.7);
+    const GQCP::Molecule molecule ({left, right});
+
+    const std::vector<double> exponents {1.3, 0.3};
+    const std::vector<double> coefficients {0.6, 0.5};
+    const GQCP::ScalarBasis<GQCP::GTOShell> scalar_basis (GQCP::ShellSet<GQCP::GTOShell>({GQCP::GTOShell(0, left, exponents, coefficients), GQCP::GTOShell(0, right, exponents, coefficients), GQCP::GTOShell(1, right, {0.9}, {1.0})}));
+
+    GQCP::TransformationMatrix<double> C (5);
+    C << 0.5,  0.6,  0.1,  0.0,  0.0,
+         0.5, -0.6,  0.1,  0.0,  0.0,
+         0.1,  0.0, -0.8,  0.0,  0.0,
+         0.0,  0.1,  0.0,  1.0,  0.0,
+         0.0,  0.0,  0.2,  0.0,  1.0;
+
+    return {molecule, GQCP::RSpinorBasis<double, GQCP::GTOShell>(scalar_basis, C)};
+}
+
+
+/**
+ *  Read the contents of a cube file
+ * 
+ *  @param filename                 the name of the cube file
+ *  @param number_of_atoms          the (signed) number of atoms in the header
+ *  @param header_orbitals          the orbital line of the header, if any
+ * 
+ *  @return all values after the header
+ */
+std::vector<double> readCubeFile(const std::string& filename, long& number_of_atoms, std::vector<size_t>& header_orbitals) {
+
+    std::ifstream input (filename);
+    std::string line;
+    std::getline(input, line);  // comments
+    std::getline(input, line);
+
+    std::getline(input, line);
+    std::istringstream(line) >> number_of_atoms;
+    for (size_t n = 0; n < 3 + std::abs(number_of_atoms); n++) {
+        std::getline(input, line);
+    }
+
+    if (number_of_atoms < 0) {
+        std::getline(input, line);
+        std::istringstream orbital_line (line);
+        size_t number_of_orbitals;
+        orbital_line >> number_of_orbitals;
+        header_orbitals.resize(number_of_orbitals);
+        for (auto& index : header_orbitals) {
+            orbital_line >> index;
+        }
+    }
+
+    std::vector<double> values;
+    double value;
+    while (input >> value) {
+        values.push_back(value);
+    }
+
+    return values;
+}
+
+
+}  // namespace
+
+
+/**
+ *  Check if the written orbital values match the ones that are evaluated directly
+ */
+BOOST_AUTO_TEST_CASE ( WriteOrbitals ) {
+
+    const auto system = h2System();
+    const auto& molecule = system.first;
+    const auto& spinor_basis = system.second;
+
+    const auto grid = GQCP::CubicGrid::Enclosing(molecule, 0.5, 2.0);
+    const std::string filename = "orbitals_test.cube";
+    GQCP::CubeFile::WriteOrbitals(filename, molecule, spinor_basis, {0, 2}, grid);
+
+    long number_of_atoms;
+    std::vector<size_t> header_orbitals;
+    const auto values = readCubeFile(filename, number_of_atoms, header_orbitals);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_EQUAL(number_of_atoms, -2);
+    BOOST_CHECK(header_orbitals == std::vector<size_t>({1, 3}));
+    BOOST_REQUIRE_EQUAL(values.size(), 2 * grid.numberOfPoints());
+
+
+    // Compare with the directly evaluated orbitals, point by point with the z-index running fastest
+    const GQCP::GTOGridEvaluator evaluator (spinor_basis.scalarBasis());
+    GQCP::MatrixX<double> C_selected (5, 2);
+    C_selected.col(0) = spinor_basis.coefficientMatrix().col(0);
+    C_selected.col(1) = spinor_basis.coefficientMatrix().col(2);
+
+    size_t index = 0;
+    for (size_t i = 0; i < grid.numbersOfSteps()[0]; i++) {
+        const auto ref_values = evaluator.evaluateOrbitals(grid.slab(i), C_selected);
+        for (size_t n = 0; n < grid.numberOfPointsPerSlab(); n++) {
+            for (size_t orbital = 0; orbital < 2; orbital++) {
+                BOOST_CHECK(std::abs(values[index] - ref_values(n, orbital)) < 1.0e-05 * std::max(1.0, std::abs(ref_values(n, orbital))));
+                index++;
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(GQCP::CubeFile::WriteOrbitals(filename, molecule, spinor_basis, {5}, grid), std::invalid_argument);
+}
+
+
+/**
+ *  Check if the written density matches the sum of the squares of the occupied orbitals
+ */
+BOOST_AUTO_TEST_CASE ( WriteDensity ) {
+
+    const auto system = h2System();
+    const auto& molecule = system.first;
+    const auto& spinor_basis = system.second;
+
+    // A closed-shell 1-DM with the first orbital doubly occupied
+    GQCP::OneRDM<double> D = GQCP::OneRDM<double>::Zero(5, 5);
+    D(0, 0) = 2.0;
+
+    const auto grid = GQCP::CubicGrid::Centered(GQCP::Vector<double, 3>::Zero(), 9, 0.4);
+    const std::string filename = "density_test.cube";
+    GQCP::CubeFile::WriteDensity(filename, molecule, spinor_basis, D, grid);
+
+    long number_of_atoms;
+    std::vector<size_t> header_orbitals;
+    const auto values = readCubeFile(filename, number_of_atoms, header_orbitals);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_EQUAL(number_of_atoms, 2);
+    BOOST_REQUIRE_EQUAL(values.size(), grid.numberOfPoints());
+
+    const GQCP::GTOGridEvaluator evaluator (spinor_basis.scalarBasis());
+    const GQCP::MatrixX<double> C_occupied = spinor_basis.coefficientMatrix().col(0);
+
+    size_t index = 0;
+    for (size_t i = 0; i < 9; i++) {
+        const auto orbital_values = evaluator.evaluateOrbitals(grid.slab(i), C_occupied);
+        for (size_t n = 0; n < grid.numberOfPointsPerSlab(); n++) {
+            const double ref_density = 2 * orbital_values(n, 0) * orbital_values(n, 0);
+            BOOST_CHECK(std::abs(values[index] - ref_density) < 1.0e-05 * std::max(1.0, ref_density));
+            index++;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "CubicGrid"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Processing/Cube/CubicGrid.hpp"
+
+
+/**
+ *  Check if the constructor throws upon invalid arguments
+ */
+BOOST_AUTO_TEST_CASE ( constructor ) {
+
+    const GQCP::Vector<double, 3> origin = GQCP::Vector<double, 3>::Zero();
+
+    BOOST_CHECK_NO_THROW(GQCP::CubicGrid(origin, {2, 3, 4}, {0.1, 0.2, 0.3}));
+    BOOST_CHECK_THROW(GQCP::CubicGrid(origin, {2, 0, 4}, {0.1, 0.2, 0.3}), std::invalid_argument);
+    BOOST_CHECK_THROW(GQCP::CubicGrid(origin, {2, 3, 4}, {0.1, -0.2, 0.3}), std::invalid_argument);
+}
+
+
+/**
+ *  Check the ordering of the points in a slab
+ */
+BOOST_AUTO_TEST_CASE ( slab ) {
+
+    GQCP::Vector<double, 3> origin;
+    origin << 1.0, -1.0, 0.5;
+    const GQCP::CubicGrid grid (origin, {2, 3, 4}, {0.1, 0.2, 0.3});
+
+    BOOST_CHECK_EQUAL(grid.numberOfPoints(), 24);
+    BOOST_CHECK_EQUAL(grid.numberOfPointsPerSlab(), 12);
+
+    const auto points = grid.slab(1);
+    BOOST_REQUIRE_EQUAL(points.rows(), 12);
+    for (size_t j = 0; j < 3; j++) {
+        for (size_t k = 0; k < 4; k++) {
+            GQCP::Vector<double, 3> ref_position;
+            ref_position << 1.1, -1.0 + 0.2 * j, 0.5 + 0.3 * k;
+
+            BOOST_CHECK(points.row(j * 4 + k).transpose().isApprox(ref_position, 1.0e-12));
+        }
+    }
+
+    BOOST_CHECK_THROW(grid.slab(2), std::invalid_argument);
+}
+
+
+/**
+ *  Check the named constructors
+ */
+BOOST_AUTO_TEST_CASE ( named_constructors ) {
+
+    // A centered grid with an odd number of steps contains the center
+    GQCP::Vector<double, 3> center;
+    center << 0.5, 0.0, -0.5;
+    const auto centered = GQCP::CubicGrid::Centered(center, 11, 0.2);
+    BOOST_CHECK(centered.position(5, 5, 5).isApprox(center, 1.0e-12));
+
+
+    // An enclosing grid contains every nucleus, with the requested padding
+    const GQCP::Molecule molecule ({GQCP::Nucleus(1, 0.0, 0.0, -0.7), GQCP::Nucleus(1, 0.0, 0.0, 0.7)});
+    const auto enclosing = GQCP::CubicGrid::Enclosing(molecule, 0.25, 3.0);
+    const auto& steps = enclosing.numbersOfSteps();
+
+    GQCP::Vector<double, 3> ref_origin;
+    ref_origin << -3.0, -3.0, -3.7;
+    BOOST_CHECK(enclosing.originPosition().isApprox(ref_origin, 1.0e-12));
+    const auto last_position = enclosing.position(steps[0] - 1, steps[1] - 1, steps[2] - 1);
+    BOOST_CHECK(last_position(0) >= 3.0 && last_position(1) >= 3.0 && last_position(2) >= 3.7);
+}
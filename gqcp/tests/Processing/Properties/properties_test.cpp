@@ -154,6 +154,53 @@ BOOST_AUTO_TEST_CASE ( h2_polarizability_RHF ) {
 
 
     BOOST_CHECK(std::abs(alpha_zz - ref_alpha_zz) < 1.0e-05);
+
+    // Check if the iterative CPHF solver gives the same polarizability
+    const auto x_iterative = cphf_solver.calculateWaveFunctionResponseIterative(sq_hamiltonian, dipole_op);
+    const auto alpha_iterative = GQCP::calculateElectricPolarizability(F_p, x_iterative);
+    BOOST_CHECK(std::abs(alpha_iterative(2,2) - ref_alpha_zz) < 1.0e-05);
+}
+
+
+/**
+ *  Check if the matrix-free RHF orbital Hessian products and the iterative CPHF solver match the explicitly constructed RHF orbital Hessian and the direct solution of the response equations.
+ */
+BOOST_AUTO_TEST_CASE ( RHF_iterative_response_h2o ) {
+
+    // The FCIDUMP integrals are expressed in an orthonormal basis
+    auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const size_t N = 10;
+
+    auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(N, sq_hamiltonian, GQCP::QCMatrix<double>::Identity(K, K));
+    auto plain_rhf_scf_solver = GQCP::RHFSCFSolver<double>::Plain();
+    const GQCP::DiagonalRHFFockMatrixObjective<double> objective (sq_hamiltonian);
+    const auto rhf_parameters = GQCP::QCMethod::RHF<double>().optimize(objective, plain_rhf_scf_solver, rhf_environment).groundStateParameters();
+    sq_hamiltonian.transform(rhf_parameters.coefficientMatrix());
+
+
+    // Check the Hessian products and the diagonal
+    GQCP::RHFElectricalResponseSolver cphf_solver (N/2);
+    const auto hessian = cphf_solver.calculateParameterResponseConstant(sq_hamiltonian);
+    const auto dim = hessian.rows();
+
+    const GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(dim, 3);
+    BOOST_CHECK(cphf_solver.calculateOrbitalHessianProducts(sq_hamiltonian, X).isApprox(hessian * X, 1.0e-10));
+    BOOST_CHECK(cphf_solver.calculateOrbitalHessianDiagonal(sq_hamiltonian).isApprox(hessian.diagonal(), 1.0e-10));
+    BOOST_CHECK_THROW(cphf_solver.calculateOrbitalHessianProducts(sq_hamiltonian, GQCP::MatrixX<double>::Random(dim + 1, 1)), std::invalid_argument);
+
+
+    // Check the iterative response for a (symmetric) model dipole operator
+    std::array<GQCP::QCMatrix<double>, 3> dipole_components;
+    for (auto& component : dipole_components) {
+        const GQCP::SquareMatrix<double> random = GQCP::SquareMatrix<double>::Random(K, K);
+        component = GQCP::QCMatrix<double>(random + random.transpose());
+    }
+    const GQCP::VectorSQOneElectronOperator<double> dipole_op (dipole_components);
+
+    const auto x_direct = cphf_solver.calculateWaveFunctionResponse(sq_hamiltonian, dipole_op);
+    const auto x_iterative = cphf_solver.calculateWaveFunctionResponseIterative(sq_hamiltonian, dipole_op, 1.0e-10);
+    BOOST_CHECK(x_iterative.isApprox(x_direct, 1.0e-08));
 }
 
 
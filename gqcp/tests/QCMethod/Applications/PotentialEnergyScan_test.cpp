@@ -0,0 +1,261 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "PotentialEnergyScan"
+
+#include <boost/test/unit_test.hpp>
+
+#include "QCMethod/Applications/PotentialEnergyScan.hpp"
+
+#include "Basis/SpinorBasis/RSpinorBasis.hpp"
+#include "Basis/transform.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemSolver.hpp"
+#include "ONVBasis/SpinResolvedONVBasis.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/CI/CI.hpp"
+#include "QCMethod/CI/CIEnvironment.hpp"
+#include "QCMethod/HF/DiagonalRHFFockMatrixObjective.hpp"
+#include "QCMethod/HF/RHF.hpp"
+#include "QCMethod/HF/RHFSCFSolver.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace {
+
+
+/**
+ *  @return a factory for integral functions that model the given H-chains by Hubbard Hamiltonians in an orthonormal basis, whose hopping parameter decays with the internuclear spacing
+ */
+std::function<GQCP::PotentialEnergyScan::IntegralFunction ()> hubbardIntegralFunctionFactory(std::atomic<size_t>& number_of_integral_functions, std::atomic<size_t>& number_of_integral_calculations) {
+
+    return [&number_of_integral_functions, &number_of_integral_calculations] () -> GQCP::PotentialEnergyScan::IntegralFunction {
+        number_of_integral_functions++;
+
+        return [&number_of_integral_calculations] (const GQCP::Molecule& molecule) {
+            number_of_integral_calculations++;
+
+            const auto K = molecule.numberOfAtoms();
+            GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Zero(K, K);  // the adjacency matrix of a linear chain
+            for (size_t p = 0; p < K - 1; p++) {
+                A(p, p+1) = 1.0;
+                A(p+1, p) = 1.0;
+            }
+
+            const double t = std::exp(-0.5 * molecule.internuclearDistance(0, 1));
+            const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (GQCP::HoppingMatrix<double>(A, t, 0.5));
+
+            const GQCP::QCMatrix<double> S = GQCP::QCMatrix<double>::Identity(K, K);
+            return GQCP::PotentialEnergyScanIntegrals {S, GQCP::SQHamiltonian<double>::FromHubbard(hubbard_hamiltonian)};
+        };
+    };
+}
+
+
+}  // namespace
+
+
+/**
+ *  Check if the shells are moved along with the nuclei that they are centered on
+ */
+BOOST_AUTO_TEST_CASE ( moveShells ) {
+
+    const GQCP::Nucleus H1 (1, 0.0, 0.0, 0.0);
+    const GQCP::Nucleus H2 (1, 0.0, 0.0, 1.0);
+    const GQCP::Molecule reference ({H1, H2});
+
+    const GQCP::Nucleus H1_moved (1, 0.0, 0.0, -0.5);
+    const GQCP::Nucleus H2_moved (1, 0.0, 0.0, 1.5);
+    const GQCP::Molecule molecule ({H1_moved, H2_moved});
+
+    const GQCP::ShellSet<GQCP::GTOShell> shell_set ({
+        GQCP::GTOShell(0, H1, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454}),
+        GQCP::GTOShell(1, H1, {0.5}, {1.0}),
+        GQCP::GTOShell(0, H2, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})
+    });
+
+    const auto moved_shell_set = GQCP::PotentialEnergyScan::moveShells(shell_set, reference, molecule);
+    const GQCP::ShellSet<GQCP::GTOShell> ref_moved_shell_set ({
+        GQCP::GTOShell(0, H1_moved, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454}),
+        GQCP::GTOShell(1, H1_moved, {0.5}, {1.0}),
+        GQCP::GTOShell(0, H2_moved, {3.42525091, 0.62391373, 0.16885540}, {0.15432897, 0.53532814, 0.44463454})
+    });
+
+    BOOST_REQUIRE(moved_shell_set.numberOfShells() == ref_moved_shell_set.numberOfShells());
+    for (size_t i = 0; i < moved_shell_set.numberOfShells(); i++) {
+        BOOST_CHECK(moved_shell_set.asVector()[i] == ref_moved_shell_set.asVector()[i]);
+    }
+
+
+    // Check if a molecule with different nuclei is rejected
+    const GQCP::Molecule HeH ({GQCP::Nucleus(2, 0.0, 0.0, 0.0), H2}, 1);
+    BOOST_CHECK_THROW(GQCP::PotentialEnergyScan::moveShells(shell_set, reference, HeH), std::invalid_argument);
+}
+
+
+/**
+ *  Check if the RHF and FCI energies along an H4 chain scan, handled in multiple chunks, match the ones from separate calculations at every geometry
+ */
+BOOST_AUTO_TEST_CASE ( H4_chain_scan ) {
+
+    std::vector<GQCP::Molecule> molecules;
+    for (size_t i = 0; i < 6; i++) {
+        molecules.push_back(GQCP::Molecule::HChain(4, 1.2 + 0.2 * i));
+    }
+
+    const GQCP::PotentialEnergyScan scan ("STO-3G", true, 2);
+    const auto points = scan.calculate(molecules);
+    BOOST_REQUIRE(points.size() == molecules.size());
+
+
+    for (size_t i = 0; i < molecules.size(); i++) {
+        const auto& molecule = molecules[i];
+        const auto N = molecule.numberOfElectrons();
+
+        // Do an RHF calculation from scratch
+        GQCP::RSpinorBasis<double, GQCP::GTOShell> spinor_basis (molecule, "STO-3G");
+        auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Molecular(spinor_basis, molecule);  // in an AO basis
+
+        auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(N, sq_hamiltonian, spinor_basis.overlap().parameters());
+        auto rhf_solver = GQCP::RHFSCFSolver<double>::DIIS();
+        const GQCP::DiagonalRHFFockMatrixObjective<double> objective (sq_hamiltonian);
+        const auto rhf_qc_structure = GQCP::QCMethod::RHF<double>().optimize(objective, rhf_solver, rhf_environment);
+
+        const double repulsion = GQCP::Operator::NuclearRepulsion(molecule).value();
+        BOOST_CHECK(std::abs(points[i].rhf_energy - (rhf_qc_structure.groundStateEnergy() + repulsion)) < 1.0e-08);
+
+
+        // Do a dense FCI calculation in the RHF orbitals
+        GQCP::basisTransform(spinor_basis, sq_hamiltonian, rhf_qc_structure.groundStateParameters().coefficientMatrix());
+        const GQCP::SpinResolvedONVBasis onv_basis (spinor_basis.numberOfSpatialOrbitals(), N/2, N/2);
+
+        auto ci_solver = GQCP::EigenproblemSolver::Dense();
+        auto ci_environment = GQCP::CIEnvironment::Dense(sq_hamiltonian, onv_basis);
+        const auto fci_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(ci_solver, ci_environment).groundStateEnergy();
+
+        BOOST_CHECK(std::abs(points[i].fci_energy - (fci_energy + repulsion)) < 1.0e-06);
+        BOOST_CHECK(std::abs(points[i].fci_coefficients.norm() - 1.0) < 1.0e-08);
+    }
+}
+
+
+/**
+ *  Check if molecules with different numbers of electrons are rejected
+ */
+BOOST_AUTO_TEST_CASE ( different_number_of_electrons ) {
+
+    const std::vector<GQCP::Molecule> molecules {GQCP::Molecule::HChain(2, 1.4), GQCP::Molecule::HChain(2, 1.4, 2)};
+
+    const GQCP::PotentialEnergyScan scan ("STO-3G");
+    BOOST_CHECK_THROW(scan.calculate(molecules), std::invalid_argument);
+}
+
+
+/**
+ *  Check if odd numbers of electrons are rejected, rather than being silently truncated
+ */
+BOOST_AUTO_TEST_CASE ( odd_number_of_electrons ) {
+
+    const std::vector<GQCP::Molecule> molecules {GQCP::Molecule::HChain(3, 1.4), GQCP::Molecule::HChain(3, 1.6)};
+
+    const GQCP::PotentialEnergyScan scan ("STO-3G", true);
+    BOOST_CHECK_THROW(scan.calculate(molecules), std::invalid_argument);
+
+    std::atomic<size_t> number_of_integral_functions {0};
+    std::atomic<size_t> number_of_integral_calculations {0};
+    BOOST_CHECK_THROW(scan.calculate(molecules, hubbardIntegralFunctionFactory(number_of_integral_functions, number_of_integral_calculations)), std::invalid_argument);
+    BOOST_CHECK_EQUAL(number_of_integral_functions.load(), 0);
+}
+
+
+/**
+ *  Check, using model integrals, if a scan that is split into chunks (in which the geometries are seeded with the previous solutions) leads to the same results as one in which every geometry is calculated from scratch
+ */
+BOOST_AUTO_TEST_CASE ( chunks_and_seeding ) {
+
+    std::vector<GQCP::Molecule> molecules;
+    for (size_t i = 0; i < 7; i++) {
+        molecules.push_back(GQCP::Molecule::HChain(4, 1.2 + 0.2 * i));
+    }
+
+
+    // In the reference scan, every geometry is a chunk on its own, so nothing is seeded.
+    std::atomic<size_t> number_of_integral_functions {0};
+    std::atomic<size_t> number_of_integral_calculations {0};
+    const auto ref_points = GQCP::PotentialEnergyScan("", true, molecules.size()).calculate(molecules, hubbardIntegralFunctionFactory(number_of_integral_functions, number_of_integral_calculations));
+    BOOST_CHECK_EQUAL(number_of_integral_functions.load(), molecules.size());
+    BOOST_CHECK_EQUAL(number_of_integral_calculations.load(), molecules.size());
+
+    for (const size_t number_of_chunks : {1, 3}) {
+        number_of_integral_functions = 0;
+        number_of_integral_calculations = 0;
+        const auto points = GQCP::PotentialEnergyScan("", true, number_of_chunks).calculate(molecules, hubbardIntegralFunctionFactory(number_of_integral_functions, number_of_integral_calculations));
+        BOOST_CHECK_EQUAL(number_of_integral_functions.load(), number_of_chunks);  // one integral function per chunk
+        BOOST_CHECK_EQUAL(number_of_integral_calculations.load(), molecules.size());
+
+        BOOST_REQUIRE_EQUAL(points.size(), molecules.size());
+        for (size_t i = 0; i < molecules.size(); i++) {
+            BOOST_CHECK(std::abs(points[i].nuclear_repulsion_energy - GQCP::Operator::NuclearRepulsion(molecules[i]).value()) < 1.0e-12);
+            BOOST_CHECK(std::abs(points[i].rhf_energy - ref_points[i].rhf_energy) < 1.0e-08);
+            BOOST_CHECK(std::abs(points[i].fci_energy - ref_points[i].fci_energy) < 1.0e-06);
+            BOOST_CHECK(std::abs(points[i].fci_coefficients.norm() - 1.0) < 1.0e-08);  // the orbital phases, and therefore the coefficients' signs, depend on the seeding
+        }
+    }
+
+
+    // Without FCI, only the RHF results should be set.
+    const auto rhf_points = GQCP::PotentialEnergyScan("", false, 3).calculate(molecules, hubbardIntegralFunctionFactory(number_of_integral_functions, number_of_integral_calculations));
+    for (size_t i = 0; i < molecules.size(); i++) {
+        BOOST_CHECK(std::abs(rhf_points[i].rhf_energy - ref_points[i].rhf_energy) < 1.0e-08);
+        BOOST_CHECK(std::isnan(rhf_points[i].fci_energy));
+        BOOST_CHECK_EQUAL(rhf_points[i].fci_coefficients.size(), 0);
+    }
+}
+
+
+/**
+ *  Check if an exception that is thrown at one of the geometries is propagated out of the parallel region
+ */
+BOOST_AUTO_TEST_CASE ( failing_geometry ) {
+
+    std::vector<GQCP::Molecule> molecules;
+    for (size_t i = 0; i < 6; i++) {
+        molecules.push_back(GQCP::Molecule::HChain(2, 1.0 + 0.2 * i));
+    }
+
+    const auto failing_integral_function_factory = [] () -> GQCP::PotentialEnergyScan::IntegralFunction {
+        return [] (const GQCP::Molecule& molecule) -> GQCP::PotentialEnergyScanIntegrals {
+            if (molecule.internuclearDistance(0, 1) > 1.7) {
+                throw std::runtime_error("failing_geometry: no integrals at this geometry.");
+            }
+
+            GQCP::SquareMatrix<double> A (2);
+            A << 0.0, 1.0,
+                 1.0, 0.0;
+
+            const GQCP::QCMatrix<double> S = GQCP::QCMatrix<double>::Identity(2, 2);
+            return GQCP::PotentialEnergyScanIntegrals {S, GQCP::SQHamiltonian<double>::FromHubbard(GQCP::HubbardHamiltonian<double>(GQCP::HoppingMatrix<double>(A, 1.0, 0.5)))};
+        };
+    };
+
+    for (const size_t number_of_chunks : {1, 3}) {
+        const GQCP::PotentialEnergyScan scan ("", true, number_of_chunks);
+        BOOST_CHECK_THROW(scan.calculate(molecules, failing_integral_function_factory), std::runtime_error);
+    }
+}
@@ -0,0 +1,130 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "CISigmaVector"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mathematical/Optimization/Eigenproblem/Davidson/DavidsonSolver.hpp"
+#include "Mathematical/Optimization/Eigenproblem/EigenproblemSolver.hpp"
+#include "Operator/SecondQuantized/ModelHamiltonian/HubbardHamiltonian.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/CI/CI.hpp"
+#include "QCMethod/CI/CIEnvironment.hpp"
+#include "QCMethod/CI/CISigmaVector.hpp"
+
+
+/**
+ *  Check if the FCI sigma vector matches the product with the dense FCI Hamiltonian matrix, both for single vectors and for blocks written into a preallocated buffer
+ */
+BOOST_AUTO_TEST_CASE ( FCI_sigma_vector ) {
+
+    const size_t K = 4;
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Random(K);
+    const GQCP::SpinResolvedONVBasis onv_basis (K, 2, 2);
+
+    const GQCP::CISigmaVector<GQCP::FCI, GQCP::SQHamiltonian<double>> sigma_vector (sq_hamiltonian, onv_basis);
+    const auto H = GQCP::FCI(onv_basis).constructHamiltonian(sq_hamiltonian);
+    BOOST_REQUIRE_EQUAL(sigma_vector.dimension(), onv_basis.get_dimension());
+    BOOST_CHECK(sigma_vector.diagonal().isApprox(H.diagonal(), 1.0e-12));
+
+
+    const GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(onv_basis.get_dimension());
+    BOOST_CHECK(sigma_vector(x).isApprox(H * x, 1.0e-12));
+
+    const Eigen::MatrixXd X = Eigen::MatrixXd::Random(onv_basis.get_dimension(), 3);
+    Eigen::MatrixXd sigma = Eigen::MatrixXd::Zero(onv_basis.get_dimension(), 3);
+    sigma_vector.apply(X, sigma);
+    BOOST_CHECK(sigma.isApprox(H * X, 1.0e-12));
+
+    Eigen::MatrixXd wrong_sigma = Eigen::MatrixXd::Zero(onv_basis.get_dimension(), 2);
+    BOOST_CHECK_THROW(sigma_vector.apply(X, wrong_sigma), std::invalid_argument);
+    const GQCP::VectorX<double> wrong_x = GQCP::VectorX<double>::Zero(3);
+    BOOST_CHECK_THROW(sigma_vector(wrong_x), std::invalid_argument);
+}
+
+
+/**
+ *  Check if the DOCI and Hubbard sigma vectors match the products with the corresponding dense Hamiltonian matrices
+ */
+BOOST_AUTO_TEST_CASE ( DOCI_Hubbard_sigma_vector ) {
+
+    const size_t K = 5;
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Random(K);
+    const GQCP::SeniorityZeroONVBasis doci_onv_basis (K, 2);
+    const GQCP::CISigmaVector<GQCP::DOCI, GQCP::SQHamiltonian<double>> doci_sigma_vector (sq_hamiltonian, doci_onv_basis);
+
+    const auto H_DOCI = GQCP::DOCI(doci_onv_basis).constructHamiltonian(sq_hamiltonian);
+    const GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(doci_onv_basis.dimension());
+    BOOST_CHECK(doci_sigma_vector(x).isApprox(H_DOCI * x, 1.0e-12));
+
+
+    const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (GQCP::HoppingMatrix<double>::Random(K));
+    const GQCP::SpinResolvedONVBasis hubbard_onv_basis (K, 2, 2);
+    const GQCP::CISigmaVector<GQCP::Hubbard, GQCP::HubbardHamiltonian<double>> hubbard_sigma_vector (hubbard_hamiltonian, hubbard_onv_basis);
+
+    const auto H_Hubbard = GQCP::Hubbard(hubbard_onv_basis).constructHamiltonian(hubbard_hamiltonian);
+    const GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(hubbard_onv_basis.get_dimension(), 2);
+    BOOST_CHECK(hubbard_sigma_vector(X).isApprox(H_Hubbard * X, 1.0e-12));
+}
+
+
+/**
+ *  Check if an iterative environment that is created from a prepared sigma vector leads to the dense ground state energy
+ */
+BOOST_AUTO_TEST_CASE ( iterative_environment ) {
+
+    const size_t K = 4;
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Random(K);
+    const GQCP::SpinResolvedONVBasis onv_basis (K, 2, 2);
+
+    auto dense_solver = GQCP::EigenproblemSolver::Dense();
+    auto dense_environment = GQCP::CIEnvironment::Dense(sq_hamiltonian, onv_basis);
+    const auto dense_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(dense_solver, dense_environment).groundStateEnergy();
+
+    const GQCP::CISigmaVector<GQCP::FCI, GQCP::SQHamiltonian<double>> sigma_vector (sq_hamiltonian, onv_basis);
+    auto davidson_solver = GQCP::EigenproblemSolver::Davidson();
+    auto iterative_environment = GQCP::CIEnvironment::Iterative(sigma_vector, onv_basis.hartreeFockExpansion());
+    const auto iterative_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(davidson_solver, iterative_environment).groundStateEnergy();
+
+    BOOST_CHECK(std::abs(dense_energy - iterative_energy) < 1.0e-08);
+}
+
+
+/**
+ *  Check if the function that is returned by asVectorFunction() stays valid after the sigma vector has gone out of scope
+ */
+BOOST_AUTO_TEST_CASE ( asVectorFunction_lifetime ) {
+
+    const size_t K = 4;
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Random(K);
+    const GQCP::SpinResolvedONVBasis onv_basis (K, 2, 2);
+    const auto H = GQCP::FCI(onv_basis).constructHamiltonian(sq_hamiltonian);
+
+    GQCP::VectorFunction<double> matvec;
+    {
+        const GQCP::CISigmaVector<GQCP::FCI, GQCP::SQHamiltonian<double>> sigma_vector (sq_hamiltonian, onv_basis);
+        matvec = sigma_vector.asVectorFunction();
+    }
+
+    const GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(onv_basis.get_dimension());
+    BOOST_CHECK(matvec(x).isApprox(H * x, 1.0e-12));
+
+    const GQCP::VectorX<double> wrong_x = GQCP::VectorX<double>::Zero(3);
+    BOOST_CHECK_THROW(matvec(wrong_x), std::invalid_argument);
+}
@@ -282,6 +282,36 @@ BOOST_AUTO_TEST_CASE ( FCI_H6_dense_vs_Davidson ) {
     const auto davidson_electronic_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(dense_solver, dense_environment).groundStateEnergy();
 
 
+    // Check if the dense and Davidson energies are equal
+    BOOST_CHECK(std::abs(dense_electronic_energy - davidson_electronic_energy) < 1.0e-08);
+}
+
+
+/**
+ *  Check if the Davidson solver with a reference space preconditioner, whose block is set up from the CI matrix elements, finds the dense FCI energy for H2O//STO-3G.
+ */
+BOOST_AUTO_TEST_CASE ( FCI_H2O_dense_vs_Davidson_reference_space ) {
+
+    // Read in the Hamiltonian in an orthonormal basis and set up the full spin-resolved ONV basis.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::SpinResolvedONVBasis onv_basis (K, 5, 5);  // dimension = 441
+
+
+    // Create a dense solver and corresponding environment and put them together in the QCMethod
+    auto dense_environment = GQCP::CIEnvironment::Dense(sq_hamiltonian, onv_basis);
+    auto dense_solver = GQCP::EigenproblemSolver::Dense();
+    const auto dense_electronic_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(dense_solver, dense_environment).groundStateEnergy();
+
+
+    // Create a Davidson solver with a reference space preconditioner. The environment only provides the matrix-vector product and the matrix elements.
+    const auto x0 = onv_basis.hartreeFockExpansion();  // initial guess
+    auto davidson_environment = GQCP::CIEnvironment::Iterative(sq_hamiltonian, onv_basis, x0);
+    BOOST_CHECK_EQUAL(davidson_environment.A.size(), 0);
+    auto davidson_solver = GQCP::EigenproblemSolver::Davidson(GQCP::ReferenceSpaceCorrectionVectorCalculation<double>(1, 50));
+    const auto davidson_electronic_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(davidson_solver, davidson_environment).groundStateEnergy();
+
+
     // Check if the dense and Davidson energies are equal
     BOOST_CHECK(std::abs(dense_electronic_energy - davidson_electronic_energy) < 1.0e-08);
 }
@@ -60,3 +60,30 @@ BOOST_AUTO_TEST_CASE ( DOCI_public_methods ) {
     BOOST_CHECK_THROW(doci_builder_incompatible.constructHamiltonian(sq_hamiltonian), std::invalid_argument);
     BOOST_CHECK_THROW(doci_builder_incompatible.matrixVectorProduct(sq_hamiltonian, x, x), std::invalid_argument);
 }
+
+
+/**
+ *  Check if the matrix elements that are calculated with the Slater-Condon rules match the dense DOCI Hamiltonian matrix for H2O//STO-3G.
+ */
+BOOST_AUTO_TEST_CASE ( DOCI_matrix_elements_h2o_sto3g ) {
+
+    // Read in the Hamiltonian in an orthonormal basis and set up the seniority-zero ONV basis.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::SeniorityZeroONVBasis onv_basis (K, 5);  // dimension = 21
+
+    const GQCP::DOCI doci_builder (onv_basis);
+    const auto H = doci_builder.constructHamiltonian(sq_hamiltonian);
+
+
+    // Check every matrix element.
+    const auto dim = onv_basis.dimension();
+    GQCP::SquareMatrix<double> H_elements (dim);
+    for (size_t I = 0; I < dim; I++) {
+        for (size_t J = 0; J < dim; J++) {
+            H_elements(I,J) = doci_builder.calculateMatrixElement(sq_hamiltonian, I, J);
+        }
+    }
+
+    BOOST_CHECK(H_elements.isApprox(H, 1.0e-12));
+}
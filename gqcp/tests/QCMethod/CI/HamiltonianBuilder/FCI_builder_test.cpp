@@ -53,3 +53,30 @@ BOOST_AUTO_TEST_CASE ( FCI_public_methods ) {
     BOOST_CHECK_THROW(random_fci_invalid.constructHamiltonian(sq_hamiltonian), std::invalid_argument);
     BOOST_CHECK_THROW(random_fci_invalid.matrixVectorProduct(sq_hamiltonian, x, x), std::invalid_argument);
 }
+
+
+/**
+ *  Check if the matrix elements that are calculated with the Slater-Condon rules match the dense FCI Hamiltonian matrix for H2O//STO-3G.
+ */
+BOOST_AUTO_TEST_CASE ( FCI_matrix_elements_h2o_sto3g ) {
+
+    // Read in the Hamiltonian in an orthonormal basis and set up the full spin-resolved ONV basis.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::SpinResolvedONVBasis onv_basis (K, 5, 5);  // dimension = 441
+
+    const GQCP::FCI fci_builder (onv_basis);
+    const auto H = fci_builder.constructHamiltonian(sq_hamiltonian);
+
+
+    // Check every matrix element.
+    const auto dim = onv_basis.get_dimension();
+    GQCP::SquareMatrix<double> H_elements (dim);
+    for (size_t I = 0; I < dim; I++) {
+        for (size_t J = 0; J < dim; J++) {
+            H_elements(I,J) = fci_builder.calculateMatrixElement(sq_hamiltonian, I, J);
+        }
+    }
+
+    BOOST_CHECK(H_elements.isApprox(H, 1.0e-12));
+}
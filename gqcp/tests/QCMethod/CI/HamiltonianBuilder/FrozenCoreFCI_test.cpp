@@ -87,3 +87,30 @@ BOOST_AUTO_TEST_CASE ( SelectedCI_vs_FrozenCoreFCI ) {
     BOOST_CHECK(sci_matvec.isApprox(fci_matvec));
     BOOST_CHECK(sci_ham.isApprox(fci_ham));
 }
+
+
+/**
+ *  Check if the matrix elements that are calculated with the Slater-Condon rules match the dense frozen core FCI Hamiltonian matrix for H2O//STO-3G.
+ */
+BOOST_AUTO_TEST_CASE ( FrozenCoreFCI_matrix_elements_h2o_sto3g ) {
+
+    // Read in the Hamiltonian in an orthonormal basis and set up a frozen core ONV basis with two frozen orbitals.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::SpinResolvedFrozenONVBasis onv_basis (K, 5, 5, 2);  // dimension = 100
+
+    const GQCP::FrozenCoreFCI frozen_core_fci_builder (onv_basis);
+    const auto H = frozen_core_fci_builder.constructHamiltonian(sq_hamiltonian);
+
+
+    // Check every matrix element.
+    const auto dim = onv_basis.get_dimension();
+    GQCP::SquareMatrix<double> H_elements (dim);
+    for (size_t I = 0; I < dim; I++) {
+        for (size_t J = 0; J < dim; J++) {
+            H_elements(I,J) = frozen_core_fci_builder.calculateMatrixElement(sq_hamiltonian, I, J);
+        }
+    }
+
+    BOOST_CHECK(H_elements.isApprox(H, 1.0e-12));
+}
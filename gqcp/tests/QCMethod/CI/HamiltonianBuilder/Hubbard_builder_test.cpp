@@ -192,3 +192,72 @@ BOOST_AUTO_TEST_CASE ( Hubbard_matvec_specialized_vs_unspecialized_large ) {
     BOOST_CHECK(specialized_diagonal.isApprox(unspecialized_diagonal));
     BOOST_CHECK(spezialized_matvec.isApprox(unspecialized_matvec));
 }
+
+
+/**
+ *  Check if the single-precision matrix-vector products of the Hubbard and FCI builders agree with their double-precision counterparts, up to single precision.
+ */
+BOOST_AUTO_TEST_CASE ( Hubbard_FCI_matvec_single_precision ) {
+
+    // Create the Hubbard model Hamiltonian and an appropriate ONV basis.
+    const auto K = 6;  // number of lattice sites
+    const size_t N_P = 3;  // number of electron pairs
+
+    const auto H = GQCP::HoppingMatrix<double>::Random(K);
+    const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (H);
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::FromHubbard(hubbard_hamiltonian);
+
+    GQCP::SpinResolvedONVBasis onv_basis (K, N_P, N_P);
+    const auto dim = onv_basis.dimension();
+    const GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(dim);
+    const GQCP::VectorX<float> x_single = x.cast<float>();
+
+
+    // Check the Hubbard matrix-vector products.
+    const GQCP::Hubbard hubbard_builder (onv_basis);
+    const auto hubbard_diagonal = hubbard_builder.calculateDiagonal(hubbard_hamiltonian);
+    const GQCP::VectorX<double> hubbard_matvec = hubbard_builder.matrixVectorProduct(hubbard_hamiltonian, x, hubbard_diagonal);
+    const GQCP::VectorX<float> hubbard_matvec_single = hubbard_builder.matrixVectorProduct(hubbard_hamiltonian, x_single, GQCP::VectorX<float>(hubbard_diagonal.cast<float>()));
+
+    BOOST_CHECK(hubbard_matvec_single.cast<double>().isApprox(hubbard_matvec, 1.0e-05));
+
+
+    // Check the FCI matrix-vector products.
+    const GQCP::FCI fci_builder (onv_basis);
+    const auto fci_diagonal = fci_builder.calculateDiagonal(sq_hamiltonian);
+    const GQCP::VectorX<double> fci_matvec = fci_builder.matrixVectorProduct(sq_hamiltonian, x, fci_diagonal);
+    const GQCP::VectorX<float> fci_matvec_single = fci_builder.matrixVectorProduct(sq_hamiltonian, x_single, GQCP::VectorX<float>(fci_diagonal.cast<float>()));
+
+    BOOST_CHECK(fci_matvec_single.cast<double>().isApprox(fci_matvec, 1.0e-05));
+}
+
+
+/**
+ *  Check if the matrix elements that are calculated directly from the hopping matrix match the dense Hubbard Hamiltonian matrix.
+ */
+BOOST_AUTO_TEST_CASE ( Hubbard_matrix_elements ) {
+
+    // Create the Hubbard model Hamiltonian and an appropriate ONV basis.
+    const auto K = 6;  // number of lattice sites
+    const size_t N_P = 3;  // number of electron pairs
+
+    const auto H = GQCP::HoppingMatrix<double>::Random(K);
+    const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (H);
+
+    GQCP::SpinResolvedONVBasis onv_basis (K, N_P, N_P);
+
+    const GQCP::Hubbard hubbard_builder (onv_basis);
+    const auto H_dense = hubbard_builder.constructHamiltonian(hubbard_hamiltonian);
+
+
+    // Check every matrix element.
+    const auto dim = onv_basis.get_dimension();
+    GQCP::SquareMatrix<double> H_elements (dim);
+    for (size_t I = 0; I < dim; I++) {
+        for (size_t J = 0; J < dim; J++) {
+            H_elements(I,J) = hubbard_builder.calculateMatrixElement(hubbard_hamiltonian, I, J);
+        }
+    }
+
+    BOOST_CHECK(H_elements.isApprox(H_dense, 1.0e-12));
+}
@@ -132,3 +132,31 @@ BOOST_AUTO_TEST_CASE ( DOCI_vs_selected_CI ) {
 
     BOOST_CHECK(doci_hamiltonian_matrix.isApprox(selected_ci_hamiltonian_matrix, 1.0e-12));
 }
+
+
+/**
+ *  Check if the matrix elements that are calculated with the Slater-Condon rules match the dense selected CI Hamiltonian matrix for H2O//STO-3G.
+ */
+BOOST_AUTO_TEST_CASE ( SelectedCI_matrix_elements_h2o_sto3g ) {
+
+    // Read in the Hamiltonian in an orthonormal basis and select all the ONVs of a frozen core ONV basis.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::SpinResolvedFrozenONVBasis frozen_onv_basis (K, 5, 5, 1);
+    const GQCP::SpinResolvedSelectedONVBasis onv_basis (frozen_onv_basis);
+
+    const GQCP::SelectedCI selected_ci_builder (onv_basis);
+    const auto H = selected_ci_builder.constructHamiltonian(sq_hamiltonian);
+
+
+    // Check every matrix element.
+    const auto dim = onv_basis.get_dimension();
+    GQCP::SquareMatrix<double> H_elements (dim);
+    for (size_t I = 0; I < dim; I++) {
+        for (size_t J = 0; J < dim; J++) {
+            H_elements(I,J) = selected_ci_builder.calculateMatrixElement(sq_hamiltonian, I, J);
+        }
+    }
+
+    BOOST_CHECK(H_elements.isApprox(H, 1.0e-12));
+}
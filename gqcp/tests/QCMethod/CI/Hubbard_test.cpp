@@ -29,6 +29,8 @@
 #include "QCMethod/CI/CI.hpp"
 #include "QCMethod/CI/CIEnvironment.hpp"
 
+#include <cstdio>
+
 
 /**
  *  Check if a dense diagonalization using the specialized Hubbard routines produces the same results as when using the unspecialized routines.
@@ -248,3 +250,71 @@ BOOST_AUTO_TEST_CASE ( Hubbard_specialized_vs_unspecialized_Davidson_diagonaliza
     const auto unspecialized_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(solver, unspecialized_environment).groundStateEnergy();
     BOOST_CHECK(std::abs(specialized_energy - unspecialized_energy) < 1.0e-06);
 }
+
+
+/**
+ *  Check if an interrupted Davidson diagonalization of the Hubbard model can be continued from its checkpoint file.
+ */
+BOOST_AUTO_TEST_CASE ( Hubbard_Davidson_checkpoint_restart ) {
+
+    // Create the Hubbard model Hamiltonian and an appropriate ONV basis.
+    const auto K = 6;  // number of lattice sites
+    const auto N_P = 3;  // number of electron pairs
+
+    const auto H = GQCP::HoppingMatrix<double>::Random(K);
+    const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (H);
+
+    GQCP::SpinResolvedONVBasis onv_basis (K, N_P, N_P);
+
+
+    // Calculate the reference ground state energy through a dense diagonalization.
+    auto dense_solver = GQCP::EigenproblemSolver::Dense();
+    auto dense_environment = GQCP::CIEnvironment::Dense(hubbard_hamiltonian, onv_basis);
+    const auto ref_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(dense_solver, dense_environment).groundStateEnergy();
+
+
+    // Interrupt a Davidson diagonalization after two iterations, and continue it from its checkpoint file.
+    const std::string checkpoint_filename = "Hubbard_Davidson.chk";
+
+    auto interrupted_solver = GQCP::EigenproblemSolver::Davidson(1, 15, 1.0e-08, 1.0e-12, 2, 1.0e-03, checkpoint_filename);  // maximum_number_of_iterations=2
+    auto interrupted_environment = GQCP::CIEnvironment::Iterative(hubbard_hamiltonian, onv_basis, onv_basis.randomExpansion());
+    BOOST_CHECK_THROW(interrupted_solver.perform(interrupted_environment), std::runtime_error);
+
+    auto solver = GQCP::EigenproblemSolver::Davidson();
+    auto restarted_environment = GQCP::CIEnvironment::Iterative(hubbard_hamiltonian, onv_basis, checkpoint_filename);
+    const auto energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(solver, restarted_environment).groundStateEnergy();
+
+    BOOST_CHECK(std::abs(energy - ref_energy) < 1.0e-06);
+
+    std::remove(checkpoint_filename.c_str());
+}
+
+
+/**
+ *  Check if a mixed-precision Davidson diagonalization of the Hubbard model produces the same ground state energy as a dense diagonalization.
+ */
+BOOST_AUTO_TEST_CASE ( Hubbard_mixed_precision_Davidson ) {
+
+    // Create the Hubbard model Hamiltonian and an appropriate ONV basis.
+    const auto K = 6;  // number of lattice sites
+    const auto N_P = 3;  // number of electron pairs
+
+    const auto H = GQCP::HoppingMatrix<double>::Random(K);
+    const GQCP::HubbardHamiltonian<double> hubbard_hamiltonian (H);
+
+    GQCP::SpinResolvedONVBasis onv_basis (K, N_P, N_P);
+
+
+    // Calculate the reference ground state energy through a dense diagonalization.
+    auto dense_solver = GQCP::EigenproblemSolver::Dense();
+    auto dense_environment = GQCP::CIEnvironment::Dense(hubbard_hamiltonian, onv_basis);
+    const auto ref_energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(dense_solver, dense_environment).groundStateEnergy();
+
+
+    // Let the Davidson diagonalization switch from single to double precision once the residual norm drops below 1.0e-04.
+    auto solver = GQCP::EigenproblemSolver::MixedPrecisionDavidson();
+    auto environment = GQCP::CIEnvironment::Iterative(hubbard_hamiltonian, onv_basis, onv_basis.randomExpansion());
+    const auto energy = GQCP::QCMethod::CI<GQCP::SpinResolvedONVBasis>(onv_basis).optimize(solver, environment).groundStateEnergy();
+
+    BOOST_CHECK(std::abs(energy - ref_energy) < 1.0e-08);
+}
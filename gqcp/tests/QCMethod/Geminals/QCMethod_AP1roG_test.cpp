@@ -117,3 +117,33 @@ BOOST_AUTO_TEST_CASE ( h2_631gdp_weak_interaction_limit ) {
         BOOST_CHECK(std::abs(ap1rog_coefficients(i) - ref_ap1rog_coefficients(i)) < 1.0e-05);
     }
 }
+
+
+/**
+ *  Check if the Jacobian-free Newton-Krylov and the Broyden solvers find the same AP1roG solution as the Newton solver.
+ *  The test system is H2O in an STO-3G basis, read in from an FCIDUMP file.
+ */
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_newton_krylov_broyden ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const size_t N_P = 5;
+
+
+    // Do the reference AP1roG calculation with a Newton solver.
+    auto newton_solver = GQCP::NonLinearEquationSolver<double>::Newton();
+    auto newton_environment = GQCP::PSEnvironment::AP1roG(sq_hamiltonian, N_P);
+    const auto ref_energy = GQCP::QCMethod::AP1roG(sq_hamiltonian, N_P).optimize(newton_solver, newton_environment).groundStateEnergy();
+
+
+    // Check the Newton-Krylov and the Broyden solutions.
+    auto newton_krylov_solver = GQCP::NonLinearEquationSolver<double>::NewtonKrylov(1.0e-08, 128, 1.0e-06);
+    auto newton_krylov_environment = GQCP::PSEnvironment::AP1roG(sq_hamiltonian, N_P);
+    const auto newton_krylov_energy = GQCP::QCMethod::AP1roG(sq_hamiltonian, N_P).optimize(newton_krylov_solver, newton_krylov_environment).groundStateEnergy();
+
+    auto broyden_solver = GQCP::NonLinearEquationSolver<double>::Broyden();
+    auto broyden_environment = GQCP::PSEnvironment::AP1roG(sq_hamiltonian, N_P);
+    const auto broyden_energy = GQCP::QCMethod::AP1roG(sq_hamiltonian, N_P).optimize(broyden_solver, broyden_environment).groundStateEnergy();
+
+    BOOST_CHECK(std::abs(newton_krylov_energy - ref_energy) < 1.0e-08);
+    BOOST_CHECK(std::abs(broyden_energy - ref_energy) < 1.0e-08);
+}
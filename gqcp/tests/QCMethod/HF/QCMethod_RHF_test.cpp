@@ -21,9 +21,17 @@
 
 #include "QCMethod/HF/RHFSCFSolver.hpp"
 
+#include "Basis/Integrals/IntegralCalculator.hpp"
+#include "Mathematical/Representation/MemoryMappedRankFourTensor.hpp"
+#include "Mathematical/Representation/SymmetryPackedRankFourTensor.hpp"
+#include "Operator/SecondQuantized/DFTwoElectronOperator.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/HF/DiagonalRHFFockMatrixObjective.hpp"
+#include "QCMethod/HF/RHF.hpp"
 #include "Utilities/linalg.hpp"
 
+#include <cstdio>
+
 
 /**
  *  The following tests check if the default implementations for the RHF SCF solvers give the correct result.
@@ -344,3 +352,147 @@ BOOST_AUTO_TEST_CASE ( h2_631gdp_diis ) {
     // Check the electronic energy
     BOOST_CHECK(std::abs(rhf_environment.electronic_energies.back() - ref_electronic_energy) < 1.0e-06);
 }
+
+
+/**
+ *  Check if the DIIS RHF SCF solver with a truncated history only keeps the most recent iterates in its environment, and if it still finds the same energy as the plain RHF SCF solver.
+ */
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_diis_bounded_history ) {
+
+    // Use an orthonormal basis, so that the overlap matrix is the identity matrix
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::QCMatrix<double> S = GQCP::QCMatrix<double>::Identity(K, K);
+
+    auto plain_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, sq_hamiltonian, S);
+    GQCP::RHFSCFSolver<double>::Plain().perform(plain_rhf_environment);
+
+    auto diis_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, sq_hamiltonian, S);
+    GQCP::RHFSCFSolver<double>::DIIS(3, 4, 1.0e-08, 128, true).perform(diis_rhf_environment);
+
+
+    // Check the energy and the size of the histories
+    BOOST_CHECK(std::abs(diis_rhf_environment.electronic_energies.back() - plain_rhf_environment.electronic_energies.back()) < 1.0e-06);
+
+    BOOST_CHECK(diis_rhf_environment.density_matrices.size() <= 4);
+    BOOST_CHECK(diis_rhf_environment.fock_matrices.size() <= 4);
+    BOOST_CHECK(diis_rhf_environment.error_vectors.size() <= 4);
+    BOOST_CHECK(diis_rhf_environment.coefficient_matrices.size() <= 4);
+
+
+    // Check that the whole history is kept by default
+    auto full_diis_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, sq_hamiltonian, S);
+    GQCP::RHFSCFSolver<double>::DIIS(3, 4).perform(full_diis_rhf_environment);
+
+    BOOST_CHECK(std::abs(full_diis_rhf_environment.electronic_energies.back() - diis_rhf_environment.electronic_energies.back()) < 1.0e-10);
+    BOOST_CHECK(full_diis_rhf_environment.error_vectors.size() > 4);
+    BOOST_CHECK_EQUAL(full_diis_rhf_environment.number_of_discarded_error_vectors, 0);
+}
+
+
+/**
+ *  Check if an RHF SCF calculation that uses density-fitted two-electron integrals finds the conventional RHF energy of H2O, within the error of the density fit.
+ */
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_density_fitted ) {
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const GQCP::RSpinorBasis<double, GQCP::GTOShell> spinor_basis (water, "STO-3G");
+    const auto& scalar_basis = spinor_basis.scalarBasis();
+    const GQCP::QCMatrix<double> S = spinor_basis.overlap().parameters();
+    const auto E_nuc = GQCP::Operator::NuclearRepulsion(water).value();
+
+
+    // Do a conventional RHF calculation
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Molecular(spinor_basis, water);  // in an AO basis
+    auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(water.numberOfElectrons(), sq_hamiltonian, S);
+    GQCP::RHFSCFSolver<double>::DIIS().perform(rhf_environment);
+    const double ref_total_energy = rhf_environment.electronic_energies.back() + E_nuc;
+
+
+    // Do an RHF calculation with density-fitted integrals, which only calculates the core Hamiltonian and the two- and three-center integrals
+    const GQCP::QCMatrix<double> H_core = GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::Kinetic(), scalar_basis) + GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::NuclearAttraction(water), scalar_basis);
+    const GQCP::ScalarBasis<GQCP::GTOShell> auxiliary_scalar_basis (water, "def2-universal-jkfit");
+    const auto g_df = std::make_shared<const GQCP::DFTwoElectronOperator>(GQCP::DFTwoElectronOperator::Calculate(scalar_basis, auxiliary_scalar_basis));
+
+    auto df_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(water.numberOfElectrons(), H_core, g_df, S);
+    auto diis_rhf_scf_solver = GQCP::RHFSCFSolver<double>::DIIS();
+    const GQCP::DiagonalRHFFockMatrixObjective<double> objective (df_rhf_environment.fock_matrix_function);
+    const auto df_rhf_parameters = GQCP::QCMethod::RHF<double>().optimize(objective, diis_rhf_scf_solver, df_rhf_environment).groundStateParameters();
+
+
+    // The density-fitting error of the total energy should be well below a milli-Hartree
+    const double df_total_energy = df_rhf_environment.electronic_energies.back() + E_nuc;
+    BOOST_CHECK(std::abs(df_total_energy - ref_total_energy) < 1.0e-04);
+    BOOST_CHECK(std::abs(df_rhf_parameters.orbitalEnergies()(0) - rhf_environment.orbital_energies.back()(0)) < 1.0e-03);
+}
+
+
+/**
+ *  Check if RHF SCF calculations that use memory-mapped, symmetry-packed or (Cholesky) density-fitted two-electron integrals find the same energy as a calculation with the dense two-electron integrals.
+ */
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_packed_and_density_fitted_fock_matrix ) {
+
+    // Use an orthonormal basis, so that the overlap matrix is the identity matrix
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::QCMatrix<double> S = GQCP::QCMatrix<double>::Identity(K, K);
+    const GQCP::QCMatrix<double> H_core = sq_hamiltonian.core().parameters();
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+
+    auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, sq_hamiltonian, S);
+    GQCP::RHFSCFSolver<double>::DIIS().perform(rhf_environment);
+    const double ref_electronic_energy = rhf_environment.electronic_energies.back();
+
+
+    // The symmetry-packed integrals are exact
+    const auto g_packed = std::make_shared<const GQCP::SymmetryPackedRankFourTensor>(GQCP::SymmetryPackedRankFourTensor::FromTensor(g));
+    auto packed_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, H_core, g_packed, S);
+    GQCP::RHFSCFSolver<double>::DIIS().perform(packed_rhf_environment);
+
+    BOOST_CHECK(std::abs(packed_rhf_environment.electronic_energies.back() - ref_electronic_energy) < 1.0e-08);
+    BOOST_CHECK(packed_rhf_environment.sq_hamiltonian.twoElectron().parameters().size() == 0);  // the environment shouldn't hold the dense integrals
+
+
+    // The memory-mapped integrals are exact as well
+    {
+        const auto g_mapped = std::make_shared<const GQCP::MemoryMappedRankFourTensor>(GQCP::MemoryMappedRankFourTensor::FromTensor("g_mapped.bin", g));
+        auto mapped_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, H_core, g_mapped, S);
+        GQCP::RHFSCFSolver<double>::DIIS().perform(mapped_rhf_environment);
+
+        BOOST_CHECK(std::abs(mapped_rhf_environment.electronic_energies.back() - ref_electronic_energy) < 1.0e-08);
+    }
+    std::remove("g_mapped.bin");
+
+
+    // A tight Cholesky decomposition of the integrals should give the same energy
+    const auto g_cholesky = std::make_shared<const GQCP::DFTwoElectronOperator>(GQCP::DFTwoElectronOperator::Cholesky(g, 1.0e-10));
+    auto cholesky_rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, H_core, g_cholesky, S);
+    GQCP::RHFSCFSolver<double>::DIIS().perform(cholesky_rhf_environment);
+
+    BOOST_CHECK(std::abs(cholesky_rhf_environment.electronic_energies.back() - ref_electronic_energy) < 1.0e-08);
+}
+
+
+/**
+ *  Check if an RHF SCF calculation on Coulomb integrals that libint writes straight into a memory-mapped file finds the RHF energy of H2O from HORTON.
+ */
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_horton_memory_mapped ) {
+
+    const double ref_total_energy = -74.942080055631;
+
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    const GQCP::RSpinorBasis<double, GQCP::GTOShell> spinor_basis (water, "STO-3G");
+    const auto& scalar_basis = spinor_basis.scalarBasis();
+
+    const GQCP::QCMatrix<double> H_core = GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::Kinetic(), scalar_basis) + GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::NuclearAttraction(water), scalar_basis);
+    {
+        const auto g_mapped = std::make_shared<const GQCP::MemoryMappedRankFourTensor>(GQCP::IntegralCalculator::calculateLibintIntegrals(GQCP::Operator::Coulomb(), scalar_basis, "g_libint.bin"));
+
+        auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(water.numberOfElectrons(), H_core, g_mapped, spinor_basis.overlap().parameters());
+        GQCP::RHFSCFSolver<double>::DIIS().perform(rhf_environment);
+
+        const double total_energy = rhf_environment.electronic_energies.back() + GQCP::Operator::NuclearRepulsion(water).value();
+        BOOST_CHECK(std::abs(total_energy - ref_total_energy) < 1.0e-06);
+    }
+    std::remove("g_libint.bin");
+}
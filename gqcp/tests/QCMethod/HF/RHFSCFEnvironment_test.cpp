@@ -42,3 +42,28 @@ BOOST_AUTO_TEST_CASE ( constructor ) {
     auto h2_ion = GQCP::Molecule::ReadXYZ("data/h2_szabo.xyz", +1);
     BOOST_CHECK_THROW(const GQCP::RHFSCFEnvironment<double> rhf_environment (h2_ion.numberOfElectrons(), sq_hamiltonian, spinor_basis.overlap().parameters(), GQCP::TransformationMatrix<double>::Random(K, K)), std::invalid_argument);
 }
+
+
+/**
+ *  Check if the history of the iterates in an RHF SCF environment is correctly truncated.
+ */
+BOOST_AUTO_TEST_CASE ( truncateHistory ) {
+
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");  // in an orthonormal basis
+    const auto K = sq_hamiltonian.dimension();
+    const GQCP::QCMatrix<double> S = GQCP::QCMatrix<double>::Identity(K, K);
+
+    auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(10, sq_hamiltonian, S);
+    for (size_t i = 0; i < 5; i++) {
+        rhf_environment.density_matrices.push_back(GQCP::OneRDM<double>(GQCP::SquareMatrix<double>::Constant(K, K, i)));
+        rhf_environment.electronic_energies.push_back(i);
+    }
+
+    rhf_environment.truncateHistory(3);
+
+    BOOST_CHECK_EQUAL(rhf_environment.density_matrices.size(), 3);
+    BOOST_CHECK_EQUAL(rhf_environment.electronic_energies.size(), 3);
+    BOOST_CHECK_EQUAL(rhf_environment.coefficient_matrices.size(), 1);  // the initial guess should be kept
+    BOOST_CHECK(std::abs(rhf_environment.electronic_energies.front() - 2.0) < 1.0e-12);  // the oldest entries should be removed
+    BOOST_CHECK(std::abs(rhf_environment.density_matrices.back()(0,0) - 4.0) < 1.0e-12);
+}
@@ -42,3 +42,26 @@ BOOST_AUTO_TEST_CASE ( localization_index_raises ) {
 
     BOOST_CHECK(D_after > D_before);
 }
+
+
+/**
+ *  Check if the incrementally updated Jacobi candidates of the localizer correspond to a full recalculation, by checking that a fresh localizer also considers the localized Hamiltonian to be converged
+ */
+BOOST_AUTO_TEST_CASE ( incremental_candidates ) {
+
+    auto h2o = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    size_t N_P = h2o.numberOfElectrons()/2;
+
+    GQCP::RSpinorBasis<double, GQCP::GTOShell> spinor_basis (h2o, "STO-3G");
+    spinor_basis.lowdinOrthonormalize();
+    auto sq_hamiltonian = GQCP::SQHamiltonian<double>::Molecular(spinor_basis, h2o);  // in the Löwdin basis
+
+
+    GQCP::ERJacobiLocalizer localizer (N_P, 1.0e-04);
+    localizer.optimize(spinor_basis, sq_hamiltonian);  // now the Hamiltonian is in the localized basis
+    BOOST_REQUIRE(localizer.get_number_of_iterations() > 1);  // make sure that incremental updates have been used
+
+    GQCP::ERJacobiLocalizer fresh_localizer (N_P, 1.0e-04);
+    fresh_localizer.prepareConvergenceChecking(sq_hamiltonian);  // performs a full calculation of all Jacobi candidates
+    BOOST_CHECK(fresh_localizer.checkForConvergence(sq_hamiltonian));
+}
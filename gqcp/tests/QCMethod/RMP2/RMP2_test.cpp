@@ -74,3 +74,51 @@ BOOST_AUTO_TEST_CASE ( crawdad_sto3g_methane ) {
     double energy_correction = GQCP::calculateRMP2EnergyCorrection(sq_hamiltonian, methane, rhf_parameters);
     BOOST_CHECK(std::abs(energy_correction - ref_energy_correction) < 1.0e-08);
 }
+
+
+/**
+ *  Check if the RMP2 energy correction from Cholesky-decomposed integrals, formed in batches of occupied orbitals, matches the one from the full tensor and a direct evaluation of the RMP2 formula.
+ */
+BOOST_AUTO_TEST_CASE ( decomposed_integrals_h2o ) {
+
+    // The FCIDUMP integrals are expressed in an orthonormal basis
+    const auto water = GQCP::Molecule::ReadXYZ("data/h2o.xyz");
+    auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const auto N = water.numberOfElectrons();
+
+    auto rhf_environment = GQCP::RHFSCFEnvironment<double>::WithCoreGuess(N, sq_hamiltonian, GQCP::QCMatrix<double>::Identity(K, K));
+    auto plain_rhf_scf_solver = GQCP::RHFSCFSolver<double>::Plain();
+    const GQCP::DiagonalRHFFockMatrixObjective<double> objective (sq_hamiltonian);
+    const auto rhf_parameters = GQCP::QCMethod::RHF<double>().optimize(objective, plain_rhf_scf_solver, rhf_environment).groundStateParameters();
+
+    const auto g_cholesky = GQCP::DFTwoElectronOperator::Cholesky(sq_hamiltonian.twoElectron().parameters(), 1.0e-12);
+    sq_hamiltonian.transform(rhf_parameters.coefficientMatrix());
+
+
+    // Evaluate the RMP2 formula directly
+    const auto& g = sq_hamiltonian.twoElectron().parameters();
+    const size_t N_occ = N / 2;
+    double ref_energy_correction = 0.0;
+    for (size_t i = 0; i < N_occ; i++) {
+        for (size_t j = 0; j < N_occ; j++) {
+            for (size_t a = N_occ; a < K; a++) {
+                for (size_t b = N_occ; b < K; b++) {
+                    const double denominator = rhf_parameters.orbitalEnergy(a) + rhf_parameters.orbitalEnergy(b) - rhf_parameters.orbitalEnergy(i) - rhf_parameters.orbitalEnergy(j);
+                    ref_energy_correction -= g(a,i,b,j) * (2 * g(i,a,j,b) - g(i,b,j,a)) / denominator;
+                }
+            }
+        }
+    }
+
+
+    const double energy_correction = GQCP::calculateRMP2EnergyCorrection(sq_hamiltonian, water, rhf_parameters);
+    BOOST_CHECK(std::abs(energy_correction - ref_energy_correction) < 1.0e-10);
+
+    for (const size_t batch_size : {1, 2, 16}) {
+        const double decomposed_energy_correction = GQCP::calculateRMP2EnergyCorrection(g_cholesky, water, rhf_parameters, batch_size);
+        BOOST_CHECK(std::abs(decomposed_energy_correction - ref_energy_correction) < 1.0e-08);
+    }
+
+    BOOST_CHECK_THROW(GQCP::calculateRMP2EnergyCorrection(g_cholesky, water, rhf_parameters, 0), std::invalid_argument);
+}
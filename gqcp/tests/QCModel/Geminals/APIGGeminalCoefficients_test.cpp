@@ -150,3 +150,33 @@ BOOST_AUTO_TEST_CASE ( toLinearExpansion_example3 ) {
     GQCP::SeniorityZeroONVBasis onv_basis (K, N_P);
     BOOST_CHECK(ref_coefficients.isApprox(gem_coeff.toLinearExpansion(onv_basis).coefficients()));
 }
+
+
+/**
+ *  Check if the batched overlaps with all ONVs of an ONV basis match the overlaps that are calculated one by one.
+ */
+BOOST_AUTO_TEST_CASE ( overlaps ) {
+
+    const size_t K = 11;
+    const size_t N_P = 5;
+    const GQCP::APIGGeminalCoefficients gem_coeff (GQCP::MatrixX<double>::Random(N_P, K));
+
+    GQCP::SeniorityZeroONVBasis onv_basis (K, N_P);
+    const auto overlaps = gem_coeff.overlaps(onv_basis);
+
+
+    // Calculate the overlaps one by one and check the result.
+    const auto onv_basis_proxy = onv_basis.proxy();
+    GQCP::SpinUnresolvedONV onv = onv_basis_proxy.makeONV(0);
+    for (size_t I = 0; I < onv_basis.dimension(); I++) {
+        BOOST_CHECK(std::abs(overlaps(I) - gem_coeff.overlap(onv)) < 1.0e-12);
+
+        if (I < onv_basis.dimension() - 1) {
+            onv_basis_proxy.setNextONV(onv);
+        }
+    }
+
+
+    // Check that an incompatible ONV basis is rejected.
+    BOOST_CHECK_THROW(gem_coeff.overlaps(GQCP::SeniorityZeroONVBasis(K, N_P - 1)), std::invalid_argument);
+}
@@ -0,0 +1,74 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "QCModel_AP1roG"
+
+#include <boost/test/unit_test.hpp>
+
+#include "QCModel/Geminals/AP1roG.hpp"
+
+
+/**
+ *  Check if the PSE coordinate functions that are calculated through the pair integrals match the element-wise implementation.
+ */
+BOOST_AUTO_TEST_CASE ( PSE_coordinate_functions ) {
+
+    // Prepare the Hamiltonian and some random geminal coefficients.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const size_t N_P = 5;
+
+    const GQCP::AP1roGGeminalCoefficients G (GQCP::MatrixX<double>::Random(N_P, K-N_P));
+
+
+    // Check the coordinate functions.
+    const auto F = GQCP::QCModel::AP1roG::calculatePSECoordinateFunctions(sq_hamiltonian, G);
+
+    for (size_t i = 0; i < N_P; i++) {
+        for (size_t a = N_P; a < K; a++) {
+            BOOST_CHECK(std::abs(F(i,a) - GQCP::QCModel::AP1roG::calculatePSECoordinateFunction(sq_hamiltonian, G, i, a)) < 1.0e-12);
+        }
+    }
+}
+
+
+/**
+ *  Check if the PSE Jacobian that is calculated through the pair integrals matches the element-wise implementation.
+ */
+BOOST_AUTO_TEST_CASE ( PSE_Jacobian ) {
+
+    // Prepare the Hamiltonian and some random geminal coefficients.
+    const auto sq_hamiltonian = GQCP::SQHamiltonian<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    const auto K = sq_hamiltonian.dimension();
+    const size_t N_P = 5;
+
+    const GQCP::AP1roGGeminalCoefficients G (GQCP::MatrixX<double>::Random(N_P, K-N_P));
+
+
+    // Check the Jacobian.
+    const auto J = GQCP::QCModel::AP1roG::calculatePSEJacobian(sq_hamiltonian, G);
+
+    for (size_t i = 0; i < N_P; i++) {
+        for (size_t a = N_P; a < K; a++) {
+            for (size_t j = 0; j < N_P; j++) {
+                for (size_t b = N_P; b < K; b++) {
+                    BOOST_CHECK(std::abs(J(i,a,j,b) - GQCP::QCModel::AP1roG::calculatePSEJacobianElement(sq_hamiltonian, G, i, a, j, b)) < 1.0e-12);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "FCIDUMPParser"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utilities/FCIDUMPParser.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+
+/**
+ *  Check if the header is read correctly, and if every record is visited exactly once, also when the chunks are much smaller than the file.
+ */
+BOOST_AUTO_TEST_CASE ( forEachRecord ) {
+
+    for (const size_t chunk_size : {size_t(64 * 1024 * 1024), size_t(100), size_t(1)}) {
+        const GQCP::FCIDUMPParser parser ("data/h2o_sto3g_klaas.FCIDUMP", chunk_size);
+        BOOST_CHECK(parser.numberOfOrbitals() == 7);
+        BOOST_CHECK(parser.numberOfElectrons() == 10);
+
+        size_t number_of_records = 0;
+        double core_energy = 0.0;
+        double first_integral = 0.0;
+        parser.forEachRecord([&] (const GQCP::FCIDUMPRecord& record) {
+            number_of_records++;
+
+            if ((record.i == 0) && (record.a == 0) && (record.j == 0) && (record.b == 0)) {
+                core_energy = record.value;
+            }
+            if ((record.i == 1) && (record.a == 1) && (record.j == 1) && (record.b == 1)) {
+                first_integral = record.value;
+            }
+        });
+
+        BOOST_CHECK(number_of_records == 169);  // the number of lines after the header, the last of which has no newline
+        BOOST_CHECK(std::abs(core_energy - 9.7794061444134091) < 1.0e-15);
+        BOOST_CHECK(std::abs(first_integral - 4.7434533171556730) < 1.0e-15);
+    }
+}
+
+
+/**
+ *  Check if the records are visited in the order of the file, so that a value that is repeated in the file is always overwritten by its last occurrence.
+ */
+BOOST_AUTO_TEST_CASE ( forEachRecord_order ) {
+
+    {
+        std::ofstream file ("repeated_record.FCIDUMP");
+        file << " &FCI NORB= 2,NELEC= 2,MS2= 0,\n /\n";
+        for (size_t n = 0; n < 1000; n++) {
+            file << "  " << n << " 1 2 1 2\n";
+        }
+    }
+
+    for (const size_t chunk_size : {size_t(64 * 1024 * 1024), size_t(100), size_t(1)}) {
+        const GQCP::FCIDUMPParser parser ("repeated_record.FCIDUMP", chunk_size);
+
+        std::vector<double> values;
+        parser.forEachRecord([&values] (const GQCP::FCIDUMPRecord& record) {
+            values.push_back(record.value);
+        });
+
+        BOOST_REQUIRE(values.size() == 1000);
+        for (size_t n = 0; n < 1000; n++) {
+            BOOST_CHECK(values[n] == static_cast<double>(n));
+        }
+    }
+
+    std::remove("repeated_record.FCIDUMP");
+}
+
+
+/**
+ *  Check if invalid FCIDUMP files are rejected.
+ */
+BOOST_AUTO_TEST_CASE ( invalid_files ) {
+
+    BOOST_CHECK_THROW(GQCP::FCIDUMPParser parser ("data/h2o.xyz"), std::invalid_argument);  // wrong extension
+
+    {
+        std::ofstream file ("no_header_end.FCIDUMP");
+        file << " &FCI NORB= 2,NELEC= 2,MS2= 0,\n  1.0 1 1 1 1\n";
+    }
+    BOOST_CHECK_THROW(GQCP::FCIDUMPParser parser ("no_header_end.FCIDUMP"), std::invalid_argument);
+
+    {
+        std::ofstream file ("invalid_record.FCIDUMP");
+        file << " &FCI NORB= 2,NELEC= 2,MS2= 0,\n /\n  1.0 1 1 1\n";
+    }
+    const GQCP::FCIDUMPParser parser ("invalid_record.FCIDUMP");
+    BOOST_CHECK_THROW(parser.forEachRecord([] (const GQCP::FCIDUMPRecord& record) {}), std::invalid_argument);
+
+    std::remove("no_header_end.FCIDUMP");
+    std::remove("invalid_record.FCIDUMP");
+}
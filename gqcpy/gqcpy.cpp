@@ -62,6 +62,7 @@ void bindNucleus(py::module& module);
 // ONVBasis
 void bindSeniorityZeroONVBasis(py::module& module);
 void bindSpinResolvedONVBasis(py::module& module);
+void bindSpinResolvedSelectedONVBasis(py::module& module);
 
 
 // Operator - FirstQuantized
@@ -82,6 +83,7 @@ void bindSQTwoElectronOperator(py::module& module);
 // QCMethod - CI
 void bindCIEnvironments(py::module& module);
 void bindCIFactory(py::module& module);
+void bindCISigmaVectors(py::module& module);
 void bindQCMethodCIs(py::module& module);
 
 
@@ -166,6 +168,7 @@ PYBIND11_MODULE (gqcpy, module) {
     // ONVBasis
     gqcpy::bindSeniorityZeroONVBasis(module);
     gqcpy::bindSpinResolvedONVBasis(module);
+    gqcpy::bindSpinResolvedSelectedONVBasis(module);
 
 
     // Operator - FirstQuantized
@@ -186,6 +189,7 @@ PYBIND11_MODULE (gqcpy, module) {
     // QCMethod - CI
     gqcpy::bindCIEnvironments(module);
     gqcpy::bindCIFactory(module);
+    gqcpy::bindCISigmaVectors(module);
     gqcpy::bindQCMethodCIs(module);
 
 
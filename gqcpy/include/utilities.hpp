@@ -0,0 +1,84 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#pragma once
+
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include <stdexcept>
+
+
+namespace py = pybind11;
+
+
+namespace gqcpy {
+
+
+/**
+ *  Create a numpy array that views the data of a rank-four Eigen::Tensor, i.e. without copying the data
+ * 
+ *  @param tensor       the tensor whose data should be viewed
+ *  @param owner        the Python object that owns the tensor: it is kept alive for as long as the numpy array exists
+ * 
+ *  @return a read-only numpy array that views the data of the given tensor
+ * 
+ *  @note The tensor's storage should not be reallocated while the owner is alive. QCRankFourTensor guarantees this, since its in-place transformations write into the existing storage.
+ */
+template <typename T>
+py::array_t<T> asNumpyArray(const Eigen::Tensor<T, 4>& tensor, py::handle owner) {
+
+    // Eigen::Tensor is column-major, so the first index runs fastest
+    const auto shape = tensor.dimensions();
+    const size_t s = sizeof(T);
+
+    py::array_t<T> array ({shape[0], shape[1], shape[2], shape[3]},
+        {s, shape[0] * s, shape[0] * shape[1] * s, shape[0] * shape[1] * shape[2] * s},  // strides
+        tensor.data(),  // data pointer
+        owner  // giving a base object prevents pybind11 from copying the data
+    );
+
+    // Writing into the view would bypass the C++ object, so we mark it read-only, like Pybind11 does for const Eigen references
+    py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+
+    return array;
+}
+
+
+/**
+ *  Copy a rank-four numpy array into an Eigen::Tensor
+ * 
+ *  @param array        the numpy array; if it is already Fortran-ordered and of the right type, Pybind11 doesn't need an intermediary conversion
+ * 
+ *  @return the corresponding rank-four tensor
+ */
+template <typename T>
+Eigen::Tensor<T, 4> asEigenTensor(const py::array_t<T, py::array::f_style | py::array::forcecast>& array) {
+
+    if (array.ndim() != 4) {
+        throw std::invalid_argument("asEigenTensor(py::array_t<T>): the given array should have four dimensions.");
+    }
+
+    const Eigen::TensorMap<const Eigen::Tensor<T, 4>> map (array.data(), array.shape(0), array.shape(1), array.shape(2), array.shape(3));
+    return Eigen::Tensor<T, 4>(map);
+}
+
+
+}  // namespace gqcpy
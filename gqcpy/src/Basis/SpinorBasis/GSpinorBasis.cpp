@@ -44,6 +44,7 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 spinor_basis.lowdinOrthonormalize();
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Transform the spinor basis to the 'Löwdin basis', which is the orthonormal basis that we transform to with T = S^{-1/2}, where S is the current spinor overlap matrix."
         )
 
@@ -58,6 +59,7 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (const GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Coulomb());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the Coulomb operator expressed in this spinor basis."
         )
 
@@ -65,6 +67,7 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (const GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Kinetic());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the kinetic energy operator expressed in this spinor basis."
         )
 
@@ -72,6 +75,7 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (const GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const GQCP::Molecule& molecule) {
                 return spinor_basis.quantize(GQCP::Operator::NuclearAttraction(molecule));
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the nuclear attraction operator expressed in this spinor basis."
         )
 
@@ -79,6 +83,7 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (const GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Overlap());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the overlap operator expressed in this spinor basis."
         )
 
@@ -86,13 +91,15 @@ void bindGSpinorBasis(py::module& module) {
             [ ] (const GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::ElectronicSpin());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the electronic spin operator expressed in this spinor basis."
         )
 
-        .def("transform", [] (GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const Eigen::MatrixXd& T_matrix) {
+        .def("transform", [] (GQCP::GSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const Eigen::Ref<const Eigen::MatrixXd>& T_matrix) {
                 const GQCP::TransformationMatrix<double> T (T_matrix);
                 spinor_basis.transform(T);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Transform the current spinor basis using a given transformation matrix."
         )
     ;
@@ -44,6 +44,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const std::vector<size_t>& ao_list) {
                 return spinor_basis.calculateMullikenOperator(ao_list);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the Mulliken operator for a set of given AO indices."
         )
 
@@ -51,6 +52,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 spinor_basis.lowdinOrthonormalize();
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Transform the spinor basis to the 'Löwdin basis', which is the orthonormal basis that we transform to with T = S^{-1/2}, where S is the current overlap matrix."
         )
 
@@ -65,6 +67,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Coulomb());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the Coulomb repulsion operator expressed in this spinor basis."
         )
 
@@ -72,6 +75,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const GQCP::Vector<double, 3>& origin) {
                 return spinor_basis.quantize(GQCP::Operator::ElectronicDipole(origin));
             },
+            py::call_guard<py::gil_scoped_release>(),
             py::arg("origin") = GQCP::Vector<double, 3>::Zero(),
             "Return the electronic dipole operator expressed in this spinor basis."
         )
@@ -80,6 +84,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Kinetic());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the kinetic energy operator expressed in this spinor basis."
         )
 
@@ -87,6 +92,7 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const GQCP::Molecule& molecule) {
                 return spinor_basis.quantize(GQCP::Operator::NuclearAttraction(molecule));
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the nuclear attraction operator expressed in this spinor basis."
         )
 
@@ -94,13 +100,15 @@ void bindRSpinorBasis(py::module& module) {
             [ ] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis) {
                 return spinor_basis.quantize(GQCP::Operator::Overlap());
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Return the overlap operator expressed in this spinor basis."
         )
 
-        .def("transform", [] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const Eigen::MatrixXd& T_matrix) {
+        .def("transform", [] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const Eigen::Ref<const Eigen::MatrixXd>& T_matrix) {
                 const GQCP::TransformationMatrix<double> T (T_matrix);
                 spinor_basis.transform(T);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Transform the current spinor basis using a given transformation matrix"
         );
 }
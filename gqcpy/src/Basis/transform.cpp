@@ -32,13 +32,14 @@ namespace gqcpy {
 void bindBasisTransform(py::module& module) {
 
     module.def("basisTransform",
-        [ ] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::MatrixXd& T) {
+        [ ] (GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::Ref<const Eigen::MatrixXd>& T) {
 
             GQCP::basisTransform(spinor_basis, sq_hamiltonian, GQCP::TransformationMatrix<double>{T});
         },
         py::arg("spinor_basis"),
         py::arg("sq_hamiltonian"),
-        py::arg("T")
+        py::arg("T"),
+        py::call_guard<py::gil_scoped_release>()
     );
 }
 
@@ -54,7 +54,7 @@ void bindAlgorithm(py::module& module, const std::string& suffix, const std::str
 
 void bindAlgorithms(py::module& module) {
 
-    bindAlgorithm<GQCP::EigenproblemEnvironment>(module, "EigenproblemEnvironment", "An algorithm that only performs one collection of steps using an EigenproblemEnvironment.");
+    bindAlgorithm<GQCP::EigenproblemEnvironment<double>>(module, "EigenproblemEnvironment", "An algorithm that only performs one collection of steps using an EigenproblemEnvironment.");
     bindAlgorithm<GQCP::LinearEquationEnvironment<double>>(module, "LinearEquationEnvironment", "An algorithm that only performs one collection of steps using a LinearEquationEnvironment.");
 }
 
@@ -28,7 +28,7 @@ namespace gqcpy {
 
 void bindEigenproblemEnvironment(py::module& module) {
 
-    py::class_<GQCP::EigenproblemEnvironment>(module, "EigenproblemEnvironment", "An environment used to solve eigenvalue problems for self-adjoint matrices.");
+    py::class_<GQCP::EigenproblemEnvironment<double>>(module, "EigenproblemEnvironment", "An environment used to solve eigenvalue problems for self-adjoint matrices.");
 }
 
 
@@ -32,17 +32,30 @@ void bindEigenproblemSolver(py::module& module) {
     auto module_eigenproblem_solver = module.def_submodule("EigenproblemSolver");
 
     module_eigenproblem_solver.def("Dense",
-        &GQCP::EigenproblemSolver::Dense,
+        &GQCP::EigenproblemSolver::Dense<double>,
         "Return an algorithm that can diagonalize a dense matrix."
     );
 
     module_eigenproblem_solver.def("Davidson",
-        &GQCP::EigenproblemSolver::Davidson,
+        &GQCP::EigenproblemSolver::Davidson<double>,
         py::arg("number_of_requested_eigenpairs") = 1,
         py::arg("maximum_subspace_dimension") = 15,
         py::arg("convergence_threshold") = 1.0e-08,
         py::arg("correction_threshold") = 1.0e-12,
         py::arg("maximum_number_of_iterations") = 128,
+        py::arg("inclusion_threshold") = 1.0e-03,
+        py::arg("checkpoint_filename") = "",
+        py::arg("checkpoint_interval") = 1
+    );
+
+    module_eigenproblem_solver.def("MixedPrecisionDavidson",
+        &GQCP::EigenproblemSolver::MixedPrecisionDavidson,
+        py::arg("number_of_requested_eigenpairs") = 1,
+        py::arg("maximum_subspace_dimension") = 15,
+        py::arg("convergence_threshold") = 1.0e-08,
+        py::arg("switch_threshold") = 1.0e-04,
+        py::arg("correction_threshold") = 1.0e-12,
+        py::arg("maximum_number_of_iterations") = 128,
         py::arg("inclusion_threshold") = 1.0e-03
     );
 }
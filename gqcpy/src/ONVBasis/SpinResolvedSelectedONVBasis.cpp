@@ -0,0 +1,53 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "ONVBasis/SpinResolvedSelectedONVBasis.hpp"
+
+#include <pybind11/pybind11.h>
+
+
+namespace py = pybind11;
+
+
+namespace gqcpy {
+
+
+void bindSpinResolvedSelectedONVBasis(py::module& module) {
+    py::class_<GQCP::SpinResolvedSelectedONVBasis>(module, "SpinResolvedSelectedONVBasis", "A spin-resolved ONV basis with a flexible number of (selected) spin-resolved ONVs.")
+
+        .def(py::init<const size_t, const size_t, const size_t>(),
+            py::arg("K"),
+            py::arg("N_alpha"),
+            py::arg("N_beta")
+        )
+
+        .def(py::init<const GQCP::SeniorityZeroONVBasis&>(),
+            py::arg("onv_basis")
+        )
+
+        .def(py::init<const GQCP::SpinResolvedONVBasis&>(),
+            py::arg("onv_basis")
+        )
+
+        .def("dimension",
+            &GQCP::SpinResolvedSelectedONVBasis::get_dimension
+        )
+    ;
+}
+
+
+}  // namespace gqcpy
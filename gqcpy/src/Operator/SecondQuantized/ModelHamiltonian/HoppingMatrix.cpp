@@ -34,7 +34,7 @@ void bindHoppingMatrix(py::module& module) {
          *  The C++ constructor that is bound here takes a 'SquareMatrix' argument, but we can't implicitly convert a numpy array to our own Eigen-derived type. Therefore, we choose a Python static method for binding the C++ constructor.
          */
         .def_static("FromAdjacencyMatrix",
-            [ ] (const Eigen::MatrixXd& A, const double t, const double U) {
+            [ ] (const Eigen::Ref<const Eigen::MatrixXd>& A, const double t, const double U) {
 
                 return GQCP::HoppingMatrix<double>{GQCP::SquareMatrix<double>{A}, t, U};
             },
@@ -20,6 +20,8 @@
 #include "Molecule/Molecule.hpp"
 #include "Operator/SecondQuantized/SQHamiltonian.hpp"
 
+#include "utilities.hpp"
+
 #include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 
@@ -37,6 +39,7 @@ void bindSQHamiltonian(py::module& module) {
             [] (const GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, const GQCP::Molecule& molecule) {
                 return GQCP::SQHamiltonian<double>::Molecular(spinor_basis, molecule);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Construct the molecular Hamiltonian in a given spinor basis."
         )
 
@@ -53,30 +56,40 @@ void bindSQHamiltonian(py::module& module) {
         )
 
         .def("core",
-            &GQCP::SQHamiltonian<double>::core,
+            &GQCP::SQHamiltonian<double>::core,  // a copy, so that rotating it doesn't change the Hamiltonian
             "Return the 'core' Hamiltonian, i.e. the total of the one-electron contributions to the Hamiltonian."
         )
 
         .def("rotate",
-            [ ] (GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::MatrixXd& U) {
+            [ ] (GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::Ref<const Eigen::MatrixXd>& U) {
                 sq_hamiltonian.rotate(GQCP::TransformationMatrix<double>{U});
             },
             "In-place transform the matrix representations of Hamiltonian.",
-            py::arg("U")
+            py::arg("U"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         .def("transform",
-            [ ] (GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::MatrixXd& T) {
+            [ ] (GQCP::SQHamiltonian<double>& sq_hamiltonian, const Eigen::Ref<const Eigen::MatrixXd>& T) {
                 sq_hamiltonian.transform(GQCP::TransformationMatrix<double>{T});
             },
             "In-place transform the matrix representations of Hamiltonian.",
-            py::arg("T")
+            py::arg("T"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         .def("twoElectron",
-            &GQCP::SQHamiltonian<double>::twoElectron,
+            &GQCP::SQHamiltonian<double>::twoElectron,  // a copy, so that rotating it doesn't change the Hamiltonian
             "Return the total of the two-electron contributions to the Hamiltonian."
         )
+
+        .def("twoElectronParameters",
+            [ ] (const py::object& self) {
+                const auto& sq_hamiltonian = self.cast<const GQCP::SQHamiltonian<double>&>();
+                return asNumpyArray(sq_hamiltonian.twoElectron().parameters().Eigen(), self);  // a read-only view on the two-electron integrals, which keeps the Hamiltonian alive, so that they aren't copied
+            },
+            "Return a read-only view on the total two-electron integrals of the Hamiltonian. The view reflects later in-place rotations and transformations of the Hamiltonian."
+        )
     ;
 }
 
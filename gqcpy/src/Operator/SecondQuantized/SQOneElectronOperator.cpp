@@ -53,33 +53,35 @@ void bindSQOneElectronOperator(py::module& module, const std::string& suffix) {
         .def(double() * py::self)
 
         .def("calculateExpectationValue",
-            [ ] (const GQCP::SQOneElectronOperator<Scalar, 1>& op, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& D) {  // use an itermediary Eigen matrix for the Python binding, since Pybind11 doesn't accept our types that are derived from Eigen::Matrix
+            [ ] (const GQCP::SQOneElectronOperator<Scalar, 1>& op, const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>& D) {  // use an itermediary Eigen reference for the Python binding, since Pybind11 doesn't accept our types that are derived from Eigen::Matrix
                 return op.calculateExpectationValue(GQCP::OneRDM<Scalar>{D});
             },
             "Return the expectation value of the scalar one-electron operator given a 1-DM."
         )
 
         .def("parameters",
-            [ ] (const GQCP::SQOneElectronOperator<Scalar, 1>& op) {
-                return op.parameters().Eigen();
+            [ ] (const GQCP::SQOneElectronOperator<Scalar, 1>& op) -> Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> {
+                return op.parameters().Eigen();  // a copy: in-place rotations and transformations replace the matrix' storage
             },
             "Return the integrals encapsulated by the second-quantized one-electron operator."
         )
 
         .def("rotate",
-            [ ] (GQCP::SQOneElectronOperator<Scalar, 1>& sq_one_op, const Eigen::MatrixXd& U) {
+            [ ] (GQCP::SQOneElectronOperator<Scalar, 1>& sq_one_op, const Eigen::Ref<const Eigen::MatrixXd>& U) {
                 sq_one_op.rotate(GQCP::TransformationMatrix<double>{U});
             },
             "In-place rotate the operator to another basis.",
-            py::arg("U")
+            py::arg("U"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         .def("transform",
-            [ ] (GQCP::SQOneElectronOperator<Scalar, 1>& sq_one_op, const Eigen::MatrixXd& T) {
+            [ ] (GQCP::SQOneElectronOperator<Scalar, 1>& sq_one_op, const Eigen::Ref<const Eigen::MatrixXd>& T) {
                 sq_one_op.transform(GQCP::TransformationMatrix<double>{T});
             },
             "In-place transform the operator to another basis.",
-            py::arg("T")
+            py::arg("T"),
+            py::call_guard<py::gil_scoped_release>()
         )
     ;
 
@@ -100,26 +102,28 @@ void bindSQOneElectronOperator(py::module& module, const std::string& suffix) {
         )
 
         .def("calculateExpectationValue",
-            [ ] (const GQCP::SQOneElectronOperator<Scalar, 3>& op, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& D) {  // use an itermediary Eigen matrix for the Python binding, since Pybind11 doesn't accept our types that are derived from Eigen::Matrix
+            [ ] (const GQCP::SQOneElectronOperator<Scalar, 3>& op, const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>& D) {  // use an itermediary Eigen reference for the Python binding, since Pybind11 doesn't accept our types that are derived from Eigen::Matrix
                 return op.calculateExpectationValue(GQCP::OneRDM<Scalar>{D});
             },
             "Return the expectation value of the vector one-electron operator given a 1-DM."
         )
 
         .def("rotate",
-            [ ] (GQCP::SQOneElectronOperator<Scalar, 3>& sq_one_op, const Eigen::MatrixXd& U) {
+            [ ] (GQCP::SQOneElectronOperator<Scalar, 3>& sq_one_op, const Eigen::Ref<const Eigen::MatrixXd>& U) {
                 sq_one_op.rotate(GQCP::TransformationMatrix<double>{U});
             },
             "In-place rotate the operator to another basis.",
-            py::arg("U")
+            py::arg("U"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         .def("transform",
-            [ ] (GQCP::SQOneElectronOperator<Scalar, 3>& sq_one_op, const Eigen::MatrixXd& T) {
+            [ ] (GQCP::SQOneElectronOperator<Scalar, 3>& sq_one_op, const Eigen::Ref<const Eigen::MatrixXd>& T) {
                 sq_one_op.transform(GQCP::TransformationMatrix<double>{T});
             },
             "In-place transform the operator to another basis.",
-            py::arg("T")
+            py::arg("T"),
+            py::call_guard<py::gil_scoped_release>()
         )
     ;
 }
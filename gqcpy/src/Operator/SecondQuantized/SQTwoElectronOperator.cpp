@@ -17,6 +17,8 @@
 // 
 #include "Operator/SecondQuantized/SQTwoElectronOperator.hpp"
 
+#include "utilities.hpp"
+
 #include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 
@@ -27,57 +29,40 @@ namespace py = pybind11;
 namespace gqcpy {
 
 
-/**
- *  Convert a rank-four Eigen::Tensor as a numpy array
- * 
- *  @param tensor       the tensor that should be converted to the numpy array
- * 
- *  @return the corresponding numpy array
- */
-template <typename T>
-py::array_t<T> asNumpyArray(const Eigen::Tensor<T, 4>& tensor) {
-
-    // Implementation adapted from https://github.com/pybind/pybind11/issues/1377
-    const auto shape = tensor.dimensions();
-
-    return py::array_t<T>(shape,
-        {shape[0] * shape[1] * shape[2] * sizeof(T), shape[1] * shape[2] * sizeof(T), shape[2] * sizeof(T), sizeof(T)}, // strides
-        tensor.data()  // data pointer
-    );
-}
-
-
 void bindSQTwoElectronOperator(py::module& module) {
     py::class_<GQCP::SQTwoElectronOperator<double, 1>>(module, "SQTwoElectronOperator", "A class that represents a real, second-quantized two-electron operator")
     
         .def("calculateExpectationValue",
-            [ ] (const GQCP::SQTwoElectronOperator<double, 1>& op, const Eigen::Tensor<double, 4>& d) {  // use an itermediary Eigen Tensor for the Python binding, since Pybind11 doesn't accept our types that are derived from Eigen::Tensor
-                return op.calculateExpectationValue(GQCP::TwoRDM<double>{d});
+            [ ] (const GQCP::SQTwoElectronOperator<double, 1>& op, const py::array_t<double, py::array::f_style | py::array::forcecast>& d) {  // Pybind11 doesn't accept our types that are derived from Eigen::Tensor, so we read the 2-DM from a numpy array
+                return op.calculateExpectationValue(GQCP::TwoRDM<double>{asEigenTensor(d)});
             },
             "Return the expectation value of the scalar two-electron operator given a 2-DM."
         )
 
         .def("parameters",
-            [ ] (const GQCP::SQTwoElectronOperator<double, 1>& op) {
-                return asNumpyArray(op.parameters().Eigen());
+            [ ] (const py::object& self) {
+                const auto& op = self.cast<const GQCP::SQTwoElectronOperator<double, 1>&>();
+                return asNumpyArray(op.parameters().Eigen(), self);  // a read-only view on the integrals, which keeps the operator alive: in-place rotations and transformations write into the same storage
             },
-            "Return the integrals encapsulated by the second-quantized two-electron operator"
+            "Return a read-only view on the integrals encapsulated by the second-quantized two-electron operator. The view reflects later in-place rotations and transformations of the operator."
         )
 
         .def("rotate",
-            [ ] (GQCP::SQTwoElectronOperator<double, 1>& sq_two_op, const Eigen::MatrixXd& U) {
+            [ ] (GQCP::SQTwoElectronOperator<double, 1>& sq_two_op, const Eigen::Ref<const Eigen::MatrixXd>& U) {
                 sq_two_op.rotate(GQCP::TransformationMatrix<double>{U});
             },
             "In-place rotate the operator to another basis.",
-            py::arg("U")
+            py::arg("U"),
+            py::call_guard<py::gil_scoped_release>()
         )
 
         .def("transform",
-            [ ] (GQCP::SQTwoElectronOperator<double, 1>& sq_two_op, const Eigen::MatrixXd& T) {
+            [ ] (GQCP::SQTwoElectronOperator<double, 1>& sq_two_op, const Eigen::Ref<const Eigen::MatrixXd>& T) {
                 sq_two_op.transform(GQCP::TransformationMatrix<double>{T});
             },
             "In-place transform the operator to another basis.",
-            py::arg("T")
+            py::arg("T"),
+            py::call_guard<py::gil_scoped_release>()
         )
     ;
 }
@@ -61,16 +61,18 @@ void bindQCMethodCI(py::module& module, const std::string& suffix, const std::st
         )
 
         .def("optimize",
-            [] (const GQCP::QCMethod::CI<ONVBasis>& qc_method, GQCP::Algorithm<GQCP::EigenproblemEnvironment>& solver, GQCP::EigenproblemEnvironment& environment) {
+            [] (const GQCP::QCMethod::CI<ONVBasis>& qc_method, GQCP::Algorithm<GQCP::EigenproblemEnvironment<double>>& solver, GQCP::EigenproblemEnvironment<double>& environment) {
                 return qc_method.optimize(solver, environment);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Optimize the CI wave function model: find the linear expansion coefficients."
         )
 
         .def("optimize",
-            [] (const GQCP::QCMethod::CI<ONVBasis>& qc_method, GQCP::IterativeAlgorithm<GQCP::EigenproblemEnvironment>& solver, GQCP::EigenproblemEnvironment& environment) {
+            [] (const GQCP::QCMethod::CI<ONVBasis>& qc_method, GQCP::IterativeAlgorithm<GQCP::EigenproblemEnvironment<double>>& solver, GQCP::EigenproblemEnvironment<double>& environment) {
                 return qc_method.optimize(solver, environment);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Optimize the CI wave function model: find the linear expansion coefficients."
         )
     ;
@@ -16,6 +16,10 @@
 // along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
 // 
 #include "QCMethod/CI/CIEnvironment.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/DOCI.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/FCI.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/Hubbard.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/SelectedCI.hpp"
 
 #include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
@@ -60,6 +64,28 @@ void bindCIEnvironment(py::module& submodule, const std::string& documentation)
 }
 
 
+/**
+ *  Bind an iterative CI environment that is built from an already prepared sigma vector.
+ * 
+ *  @tparam Builder                 the type of the Hamiltonian builder
+ *  @tparam Hamiltonian             the type of the Hamiltonian
+ * 
+ *  @param submodule                the gqcpy.CIEnvironment submodule
+ */
+template <typename Builder, typename Hamiltonian>
+void bindSigmaVectorCIEnvironment(py::module& submodule) {
+
+    submodule.def("Iterative",
+        [ ] (const GQCP::CISigmaVector<Builder, Hamiltonian>& sigma_vector, const GQCP::MatrixX<double>& V) {
+            return GQCP::CIEnvironment::Iterative(sigma_vector, V);
+        },
+        py::arg("sigma_vector"),
+        py::arg("V"),
+        "Return an environment suitable for solving CI eigenvalue problems, reusing the prepared sigma vector and its diagonal."
+    );
+}
+
+
 void bindCIEnvironments(py::module& module) {
 
     auto submodule = module.def_submodule("CIEnvironment");
@@ -67,6 +93,11 @@ void bindCIEnvironments(py::module& module) {
     bindCIEnvironment<GQCP::SQHamiltonian<double>, GQCP::SeniorityZeroONVBasis>(submodule, "Return an environment suitable for solving DOCI eigenvalue problems.");
     bindCIEnvironment<GQCP::HubbardHamiltonian<double>, GQCP::SpinResolvedONVBasis>(submodule, "Return an environment suitable for solving Hubbard-related eigenvalue problems.");
     bindCIEnvironment<GQCP::SQHamiltonian<double>, GQCP::SpinResolvedONVBasis>(submodule, "Return an environment suitable for solving spin-resolved FCI eigenvalue problems.");
+
+    bindSigmaVectorCIEnvironment<GQCP::DOCI, GQCP::SQHamiltonian<double>>(submodule);
+    bindSigmaVectorCIEnvironment<GQCP::FCI, GQCP::SQHamiltonian<double>>(submodule);
+    bindSigmaVectorCIEnvironment<GQCP::Hubbard, GQCP::HubbardHamiltonian<double>>(submodule);
+    bindSigmaVectorCIEnvironment<GQCP::SelectedCI, GQCP::SQHamiltonian<double>>(submodule);
 }
 
 
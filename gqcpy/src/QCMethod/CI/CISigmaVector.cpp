@@ -0,0 +1,128 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "QCMethod/CI/CISigmaVector.hpp"
+
+#include "ONVBasis/SeniorityZeroONVBasis.hpp"
+#include "ONVBasis/SpinResolvedONVBasis.hpp"
+#include "ONVBasis/SpinResolvedSelectedONVBasis.hpp"
+#include "Operator/SecondQuantized/ModelHamiltonian/HubbardHamiltonian.hpp"
+#include "Operator/SecondQuantized/SQHamiltonian.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/DOCI.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/FCI.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/Hubbard.hpp"
+#include "QCMethod/CI/HamiltonianBuilder/SelectedCI.hpp"
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+
+namespace py = pybind11;
+
+
+namespace gqcpy {
+
+
+/**
+ *  Since CISigmaVector has template arguments for the Hamiltonian builder and the Hamiltonian, we'll have to bind each of them separately. In order to avoid duplicate code, we use a templated binding approach.
+ */
+
+/**
+ *  Bind a prepared CI matrix-vector product.
+ * 
+ *  @tparam Builder             the type of the Hamiltonian builder
+ *  @tparam Hamiltonian         the type of the Hamiltonian
+ *  @tparam ONVBasis            the type of the ONV basis
+ * 
+ *  @param module               the Pybind11 module
+ *  @param suffix               the suffix for the gqcpy class name, i.e. "SigmaVector" + suffix
+ *  @param description          the description for the gqcpy class
+ */
+template <typename Builder, typename Hamiltonian, typename ONVBasis>
+void bindCISigmaVector(py::module& module, const std::string& suffix, const std::string& description) {
+
+    using SigmaVector = GQCP::CISigmaVector<Builder, Hamiltonian>;
+
+    py::class_<SigmaVector>(module,
+        ("SigmaVector" + suffix).c_str(),
+        description.c_str()
+    )
+
+        .def(py::init<const Hamiltonian&, const ONVBasis&>(),
+            py::arg("hamiltonian"),
+            py::arg("onv_basis"),
+            py::call_guard<py::gil_scoped_release>()
+        )
+
+        // The in-place products write into preallocated numpy arrays: Pybind11 refuses arrays that can't be referenced directly (i.e. that are not contiguous float64 arrays), instead of silently writing into a copy.
+        .def("__call__",
+            [ ] (const SigmaVector& sigma_vector, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> sigma) {
+                sigma_vector.apply(x, sigma);
+            },
+            py::arg("x"),
+            py::arg("sigma").noconvert(),
+            py::call_guard<py::gil_scoped_release>(),
+            "Write the action of the Hamiltonian on the vector x into the preallocated vector sigma."
+        )
+
+        .def("matmat",
+            [ ] (const SigmaVector& sigma_vector, const Eigen::Ref<const Eigen::MatrixXd>& X, Eigen::Ref<Eigen::MatrixXd> sigma) {
+                sigma_vector.apply(X, sigma);
+            },
+            py::arg("X"),
+            py::arg("sigma").noconvert(),
+            py::call_guard<py::gil_scoped_release>(),
+            "Write the action of the Hamiltonian on every column of X into the corresponding column of the preallocated (Fortran-ordered) matrix sigma."
+        )
+
+        .def("matvec",
+            [ ] (const SigmaVector& sigma_vector, const Eigen::Ref<const Eigen::VectorXd>& x) {
+                Eigen::VectorXd sigma (x.size());
+                sigma_vector.apply(x, sigma);
+                return sigma;
+            },
+            py::arg("x"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Return the action of the Hamiltonian on the vector x, e.g. for use in a scipy.sparse.linalg.LinearOperator."
+        )
+
+        .def("diagonal",
+            [ ] (const SigmaVector& sigma_vector) -> const Eigen::VectorXd& {
+                return sigma_vector.diagonal().Eigen();
+            },
+            py::return_value_policy::reference_internal,  // return a read-only view on the diagonal, which keeps the sigma vector alive
+            "Return the diagonal of the matrix representation of the Hamiltonian in the ONV basis."
+        )
+
+        .def("dimension",
+            &SigmaVector::dimension,
+            "Return the dimension of the ONV basis."
+        )
+    ;
+}
+
+
+void bindCISigmaVectors(py::module& module) {
+
+    bindCISigmaVector<GQCP::DOCI, GQCP::SQHamiltonian<double>, GQCP::SeniorityZeroONVBasis>(module, "DOCI", "The action of the Hamiltonian in a seniority-zero ONV basis.");
+    bindCISigmaVector<GQCP::FCI, GQCP::SQHamiltonian<double>, GQCP::SpinResolvedONVBasis>(module, "FCI", "The action of the Hamiltonian in a full spin-resolved ONV basis.");
+    bindCISigmaVector<GQCP::Hubbard, GQCP::HubbardHamiltonian<double>, GQCP::SpinResolvedONVBasis>(module, "Hubbard", "The action of the Hubbard Hamiltonian in a full spin-resolved ONV basis.");
+    bindCISigmaVector<GQCP::SelectedCI, GQCP::SQHamiltonian<double>, GQCP::SpinResolvedSelectedONVBasis>(module, "SelectedCI", "The action of the Hamiltonian in a spin-resolved selected ONV basis.");
+}
+
+
+}  // namespace gqcpy
@@ -40,6 +40,7 @@ void bindQCMethodAP1roG(py::module& module) {
             [] (const GQCP::QCMethod::AP1roG& qc_method, GQCP::IterativeAlgorithm<GQCP::NonLinearEquationEnvironment<double>>& solver, GQCP::NonLinearEquationEnvironment<double>& environment) {
                 return qc_method.optimize(solver, environment);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Optimize the AP1roG wave function model."
         )
     ;
@@ -64,7 +64,8 @@ void bindAP1roGLagrangianNewtonOrbitalOptimizer(py::module& module) {
         .def("optimize",
             [ ] (GQCP::AP1roGLagrangianNewtonOrbitalOptimizer& optimizer, GQCP::RSpinorBasis<double, GQCP::GTOShell>& spinor_basis, GQCP::SQHamiltonian<double>& sq_hamiltonian) {
                 return optimizer.optimize(spinor_basis, sq_hamiltonian);
-            }
+            },
+            py::call_guard<py::gil_scoped_release>()
         )
     ;
 }
@@ -42,6 +42,7 @@ void bindQCMethodvAP1roG(py::module& module) {
             [] (const GQCP::QCMethod::vAP1roG& qc_method, GQCP::IterativeAlgorithm<GQCP::NonLinearEquationEnvironment<double>>& non_linear_solver, GQCP::NonLinearEquationEnvironment<double>& non_linear_environment, GQCP::Algorithm<GQCP::LinearEquationEnvironment<double>>& linear_solver) {
                 return qc_method.optimize(non_linear_solver, non_linear_environment, linear_solver);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Optimize the vAP1roG wave function model."
         )
     ;
@@ -38,6 +38,7 @@ void bindQCMethodRHF(py::module& module) {
             [] (const GQCP::DiagonalRHFFockMatrixObjective<double>& objective, GQCP::IterativeAlgorithm<GQCP::RHFSCFEnvironment<double>>& solver, GQCP::RHFSCFEnvironment<double>& environment) {
                 return GQCP::QCMethod::RHF<double>().optimize(objective, solver, environment);
             },
+            py::call_guard<py::gil_scoped_release>(),
             "Optimize the RHF wave function model: find the parameters satisfy the given objective."
         )
     ;
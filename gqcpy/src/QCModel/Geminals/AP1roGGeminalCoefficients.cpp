@@ -36,7 +36,7 @@ void bindAP1roGGeminalCoefficients(py::module& module) {
 
         // Define an initializer through an Eigen::Matrix.
         .def(py::init(
-                [ ] (const Eigen::MatrixXd& G) {
+                [ ] (const Eigen::Ref<const Eigen::MatrixXd>& G) {
                     return GQCP::AP1roGGeminalCoefficients(GQCP::MatrixX<double>{G});
                 }
             ),
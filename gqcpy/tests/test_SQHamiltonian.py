@@ -0,0 +1,68 @@
+# This file is part of GQCG-gqcp.
+# 
+# Copyright (C) 2017-2019  the GQCG developers
+# 
+# GQCG-gqcp is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# GQCG-gqcp is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+# 
+import unittest
+
+import numpy as np
+
+import gqcpy
+
+
+class SQHamiltonianTest(unittest.TestCase):
+
+    def setUp(self):
+        # Set up the molecular Hamiltonian for H2//STO-3G in an orthonormal spinor basis.
+        molecule = gqcpy.Molecule([gqcpy.Nucleus(1, 0.0, 0.0, 0.0), gqcpy.Nucleus(1, 0.0, 0.0, 1.4)])
+        spinor_basis = gqcpy.RSpinorBasis(molecule, "STO-3G")
+        spinor_basis.lowdinOrthonormalize()
+
+        self.sq_hamiltonian = gqcpy.SQHamiltonian.Molecular(spinor_basis, molecule)
+
+
+    def test_twoElectronParameters_matches_twoElectron(self):
+        """Check if the view on the two-electron integrals contains the same integrals as the copy."""
+        g_view = self.sq_hamiltonian.twoElectronParameters()
+        g_copy = self.sq_hamiltonian.twoElectron().parameters()
+
+        self.assertEqual(g_view.shape, (2, 2, 2, 2))
+        self.assertTrue(np.allclose(g_view, g_copy))
+
+
+    def test_twoElectronParameters_is_read_only(self):
+        """Check if writing into the view on the two-electron integrals fails and leaves the Hamiltonian unchanged."""
+        g_view = self.sq_hamiltonian.twoElectronParameters()
+        g_before = np.array(g_view)  # a copy
+
+        self.assertFalse(g_view.flags.writeable)
+        with self.assertRaises(ValueError):
+            g_view[0, 0, 0, 0] = 42.0
+
+        self.assertTrue(np.array_equal(self.sq_hamiltonian.twoElectronParameters(), g_before))
+
+
+    def test_twoElectronParameters_follows_rotation(self):
+        """Check if the view on the two-electron integrals reflects an in-place rotation of the Hamiltonian."""
+        g_view = self.sq_hamiltonian.twoElectronParameters()
+
+        U = np.array([[0.0, 1.0], [1.0, 0.0]])  # swap both orbitals
+        self.sq_hamiltonian.rotate(U)
+
+        self.assertTrue(np.allclose(g_view, self.sq_hamiltonian.twoElectron().parameters()))
+
+
+if __name__ == '__main__':
+    unittest.main()